@@ -7,10 +7,14 @@
  */
 
 #include <gtest/gtest.h>
+#include <atomic>
 #include <mutex>
 #include <numeric>
 #include <random>
 
+#include <sys/wait.h>
+#include <unistd.h>
+
 #include <executorch/backends/xnnpack/threadpool/threadpool.h>
 #include <executorch/backends/xnnpack/threadpool/threadpool_guard.h>
 
@@ -186,3 +190,28 @@ TEST(TestNoThreadPoolGuard, TestRunWithGuard) {
   }
   ASSERT_EQ(inner, 6);
 }
+
+TEST(ThreadPoolTest, ForkedChildGetsANewThreadPool) {
+  auto pool = torch::executorch::threadpool::get_threadpool();
+  std::atomic<size_t> sum{0};
+  pool->run([&](const size_t task_id) { sum += task_id; }, 100);
+  ASSERT_EQ(sum, 4950);
+  const size_t thread_count = pool->get_thread_count();
+
+  pid_t pid = fork();
+  ASSERT_GE(pid, 0);
+  if (pid == 0) {
+    // The threads of the parent's thread-pool don't exist here, so running on
+    // it would hang.
+    auto child_pool = torch::executorch::threadpool::get_threadpool();
+    std::atomic<size_t> child_sum{0};
+    child_pool->run([&](const size_t task_id) { child_sum += task_id; }, 100);
+    const bool ok = child_pool != pool && child_sum == 4950 &&
+        child_pool->get_thread_count() == thread_count;
+    _exit(ok ? 0 : 1);
+  }
+  int status = 0;
+  ASSERT_EQ(waitpid(pid, &status, 0), pid);
+  EXPECT_TRUE(WIFEXITED(status));
+  EXPECT_EQ(WEXITSTATUS(status), 0);
+}
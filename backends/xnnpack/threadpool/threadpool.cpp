@@ -25,10 +25,11 @@ namespace {
 // process' thread-pool, but since those threads don't exist, the thread-pool
 // is corrupt. It's leaked in order to prevent segfaults.
 // Ref: https://github.com/pytorch/pytorch/issues/54752#issuecomment-810315302
-bool leak_corrupted_threadpool = false;
+// Atomic so that only one thread of the child replaces the thread-pool.
+std::atomic<bool> leak_corrupted_threadpool{false};
 
 void child_atfork() {
-  leak_corrupted_threadpool = true;
+  leak_corrupted_threadpool.store(true);
 }
 
 } // namespace
@@ -117,10 +118,11 @@ ThreadPool* get_threadpool() {
   // @lint-ignore CLANGTIDY facebook-hte-std::call_once
   std::call_once(
       flag, []() { pthread_atfork(nullptr, nullptr, child_atfork); });
-  if __ET_UNLIKELY (leak_corrupted_threadpool) {
-    leak_corrupted_threadpool = false;
+  if __ET_UNLIKELY (leak_corrupted_threadpool.exchange(false)) {
     if (auto leaked = threadpool.release()) {
-      auto t = leaked->get_thread_count();
+      // Not get_thread_count(): another thread of the parent may have held
+      // the mutex of the leaked thread-pool when it forked.
+      auto t = pthreadpool_get_threads_count(leaked->threadpool_.get());
       threadpool = std::make_unique<ThreadPool>(t);
     }
   }
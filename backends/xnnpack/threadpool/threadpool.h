@@ -54,6 +54,7 @@ class ThreadPool final {
 
  private:
   friend pthreadpool_t get_pthreadpool();
+  friend ThreadPool* get_threadpool();
 
  private:
   // This mutex is used inside get_thread_count API but it is not
@@ -161,5 +161,6 @@ function(merge_yaml)
     COMMENT "Merging kernel yaml files"
     OUTPUT ${GEN_OUTPUT_DIR}/merged.yaml
     COMMAND ${_gen_command}
+    DEPENDS ${GEN_FUNCTIONS_YAML} ${GEN_FALLBACK_YAML}
     WORKING_DIRECTORY ${EXECUTORCH_ROOT})
 endfunction()
\ No newline at end of file
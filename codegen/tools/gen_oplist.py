@@ -12,12 +12,19 @@ from enum import IntEnum
 from typing import Any, Dict, List, Optional, Set
 
 import yaml
+from torchgen.executorch.model import ETKernelKey
 from torchgen.executorch.parse import strip_et_fields
 
 from torchgen.gen import LineLoader, parse_native_yaml_struct
 from torchgen.selective_build.operator import SelectiveBuildOperator
 from torchgen.selective_build.selector import merge_et_kernel_metadata
 
+try:
+    from executorch.codegen.tools.merge_yaml import expand_dtype_specializations
+except ImportError:
+    # Run as `python -m codegen.tools.gen_oplist` from the CMake build.
+    from codegen.tools.merge_yaml import expand_dtype_specializations
+
 # Output YAML file format:
 # ------------------------
 #
@@ -49,6 +56,13 @@ from torchgen.selective_build.selector import merge_et_kernel_metadata
 # <END FILE CONTENTS>
 
 
+# Kernel key selecting the fallback (`arg_meta: null`) kernel of an operator
+# that also has specialized kernels. torchgen only accepts "default" for
+# operators without specialized kernels, and keeps the fallback kernel for any
+# key that matches no specialized kernel.
+FALLBACK_KERNEL_KEY = "v1/fallback"
+
+
 class ScalarType(IntEnum):
     Byte = 0
     Char = 1
@@ -132,23 +146,59 @@ def _get_kernel_metadata_for_model(model_file: str) -> Dict[str, List[str]]:
     return op_kernel_key_list
 
 
+def _strip_line(d: Optional[Dict[str, Any]]) -> Dict[str, Any]:
+    # LineLoader adds the line number to every mapping.
+    return {k: v for k, v in (d or {}).items() if k != "__line__"}
+
+
+def _get_kernel_keys_from_ops_yaml_entry(e: Dict[str, Any]) -> List[str]:
+    """Returns the kernel keys of every kernel of a yaml entry, so that
+    selecting an operator by ops yaml keeps its specialized kernels too.
+    """
+    kernels = e.get("kernels", [])
+    if all(k.get("arg_meta") is None for k in kernels):
+        return ["default"]
+    keys = []
+    for k in kernels:
+        if k.get("arg_meta") is None:
+            keys.append(FALLBACK_KERNEL_KEY)
+            continue
+        keys.extend(
+            key.to_native_string()
+            for key in ETKernelKey.gen_from_yaml(
+                _strip_line(k["arg_meta"]),
+                _strip_line(e.get("type_alias")),
+                _strip_line(e.get("dim_order_alias")),
+            )
+        )
+    return keys
+
+
 def _get_et_kernel_metadata_from_ops_yaml(ops_yaml_path: str) -> Dict[str, List[str]]:
-    ops = []
+    ops = {}
     with open(ops_yaml_path, "r") as f:
-        es = yaml.load(f, Loader=LineLoader)
+        es = [
+            expand_dtype_specializations(e)
+            for e in yaml.load(f, Loader=LineLoader)
+        ]
         func_entries = []
         for e in es:
             if "op" in e:
-                ops.append(("aten::" if "::" not in e.get("op") else "") + e.get("op"))
+                op = ("aten::" if "::" not in e.get("op") else "") + e.get("op")
+                ops[op] = _get_kernel_keys_from_ops_yaml_entry(e)
             else:
                 func_entries.append(e)
+        func_kernel_keys = {
+            e["__line__"]: _get_kernel_keys_from_ops_yaml_entry(e)
+            for e in func_entries
+        }
         strip_et_fields(es)
         parsed_yaml = parse_native_yaml_struct(
             func_entries, set(), None, path=ops_yaml_path, skip_native_fns_gen=True
         )
-    ops.extend([f"{f.namespace}::{f.func.name}" for f in parsed_yaml.native_functions])
-    # TODO (larryliu): accept the new op yaml syntax
-    return {op: ["default"] for op in ops}
+    for f in parsed_yaml.native_functions:
+        ops[f"{f.namespace}::{f.func.name}"] = func_kernel_keys[f.loc.line]
+    return ops
 
 
 def _dump_yaml(
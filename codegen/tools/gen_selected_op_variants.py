@@ -57,6 +57,8 @@ dtype_enum_to_type = {
     "20": "Bits4x2",
     "21": "Bits8",
     "22": "Bits16",
+    "23": "Float8_e5m2",
+    "24": "Float8_e4m3fn",
 }
 
 
@@ -72,7 +74,11 @@ def write_selected_op_variants(yaml_file_path: str, output_dir: str) -> None:
         for operator_name, kernel_metadata_str in et_kernel_metadata.items():
             tensor_meta = []
             for kernel_metadata in kernel_metadata_str:
-                if kernel_metadata == "default":
+                # "v1/fallback" selects the fallback kernel of an operator with
+                # specialized kernels (see gen_oplist.py): like "default", it
+                # takes every dtype.
+                if kernel_metadata in ("default", "v1/fallback"):
+                    tensor_meta = []
                     break
                 else:
                     x = kernel_metadata.split("/")[1]
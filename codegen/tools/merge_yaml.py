@@ -18,6 +18,74 @@ except ImportError:
     from yaml import SafeLoader as Loader  # type: ignore[misc]
 
 
+# Key of the shorthand that expand_dtype_specializations() turns into explicit
+# `arg_meta` kernel entries.
+DTYPE_SPECIALIZATIONS_KEY = "dtype_specializations"
+
+# Ranks to specialize on when `ranks` is not given. Rank 0 is left to the
+# fallback kernel.
+DEFAULT_SPECIALIZED_RANKS = [1, 2, 3, 4]
+
+
+def expand_dtype_specializations(func: Dict[str, Any]) -> Dict[str, Any]:
+    """Expands the `dtype_specializations` shorthand of a yaml entry into one
+    `arg_meta` kernel entry per (dtype, rank) combination, so that the runtime
+    binds a kernel compiled for a single dtype when it resolves the operator.
+    E.g.,
+
+    - op: add.out
+      kernels:
+        - arg_meta: null
+          kernel_name: torch::executor::opt_add_out
+      dtype_specializations:
+        tensor_args: [self, other, out]
+        dtypes: [Float, Double]
+        ranks: [1, 2]
+
+    registers `torch::executor::opt_add_out_float` for Float tensors of rank 1
+    and 2 with contiguous dim order, `torch::executor::opt_add_out_double` for
+    Double, and keeps `opt_add_out` as the fallback for everything else. All
+    tensor args share the dtype and rank of a specialization. The specialized
+    kernel name is `kernel_name` (defaulting to the fallback kernel name)
+    suffixed with the lowercase dtype name.
+    """
+    if DTYPE_SPECIALIZATIONS_KEY not in func:
+        return func
+    func = dict(func)
+    spec = func.pop(DTYPE_SPECIALIZATIONS_KEY)
+    kernels = list(func.get("kernels", []))
+    kernel_name = spec.get("kernel_name")
+    if kernel_name is None:
+        fallbacks = [k for k in kernels if k.get("arg_meta") is None]
+        assert (
+            len(fallbacks) == 1
+        ), f"{DTYPE_SPECIALIZATIONS_KEY} needs a kernel_name when there is no single fallback kernel: {func}"
+        kernel_name = fallbacks[0]["kernel_name"]
+    tensor_args = spec["tensor_args"]
+    ranks = spec.get("ranks", DEFAULT_SPECIALIZED_RANKS)
+    assert all(r > 0 for r in ranks), f"Ranks must be positive: {ranks}"
+
+    type_alias = dict(func.get("type_alias") or {})
+    dim_order_alias = dict(func.get("dim_order_alias") or {})
+    for rank in ranks:
+        dim_order_alias[f"D_rank{rank}"] = list(range(rank))
+    for dtype in spec["dtypes"]:
+        type_alias[f"T_{dtype}"] = [dtype]
+        for rank in ranks:
+            kernels.append(
+                {
+                    "arg_meta": {
+                        arg: [f"T_{dtype}", f"D_rank{rank}"] for arg in tensor_args
+                    },
+                    "kernel_name": f"{kernel_name}_{dtype.lower()}",
+                }
+            )
+    func["type_alias"] = type_alias
+    func["dim_order_alias"] = dim_order_alias
+    func["kernels"] = kernels
+    return func
+
+
 class BlankLineDumper(yaml.SafeDumper):
     def write_line_break(self, data=None):
         super().write_line_break(data)
@@ -54,14 +122,16 @@ def merge(functions_yaml_path: str, fallback_yaml_path: Optional[str], output_di
         functions_obj = yaml.load(f, Loader=Loader)
         functions_dict: Dict[str, object] = defaultdict(object)
         for func in functions_obj:
-            functions_dict[get_canonical_opname(func)] = func
+            functions_dict[get_canonical_opname(func)] = expand_dtype_specializations(
+                func
+            )
     if fallback_yaml_path is not None and os.path.exists(fallback_yaml_path):
         with open(fallback_yaml_path) as f:
             fallback_obj = yaml.load(f, Loader=Loader)
             for func in fallback_obj:
                 opname = get_canonical_opname(func)
                 if opname not in functions_dict:
-                    functions_dict[opname] = func
+                    functions_dict[opname] = expand_dtype_specializations(func)
 
     with open(output_file, "w") as f:
         yaml.dump(
@@ -16,7 +16,9 @@ def define_common_targets(is_fbcode = False):
             "//executorch/...",
         ],
         external_deps = ["torchgen"],
-        deps = select({
+        deps = [
+            ":merge_yaml_lib",
+        ] + select({
             "DEFAULT": [],
             "ovr_config//os:linux": [] if runtime.is_oss else ["//executorch/codegen/tools/fb:selective_build"],  # TODO(larryliu0820) :selective_build doesn't build in OSS yet
         }),
@@ -62,6 +64,21 @@ def define_common_targets(is_fbcode = False):
         visibility = ["PUBLIC"],
     )
 
+    runtime.python_test(
+        name = "test_merge_yaml",
+        base_module = "",
+        srcs = [
+            "test/test_merge_yaml.py",
+        ],
+        deps = [
+            ":merge_yaml_lib",
+        ],
+        package_style = "inplace",
+        visibility = [
+            "//executorch/...",
+        ],
+    )
+
     runtime.python_test(
         name = "test_gen_oplist",
         base_module = "",
@@ -252,6 +252,36 @@ class TestGenOpList(unittest.TestCase):
             "default",
         )
 
+    def test_get_kernel_metadata_from_ops_yaml_with_dtype_specializations(
+        self,
+    ) -> None:
+        ops_yaml = os.path.join(self.temp_dir.name, "specialized.yaml")
+        with open(ops_yaml, "w") as f:
+            f.write(
+                """
+- op: add.out
+  kernels:
+    - arg_meta: null
+      kernel_name: torch::executor::opt_add_out
+  dtype_specializations:
+    tensor_args: [self, other, out]
+    dtypes: [Float]
+    ranks: [2]
+
+- op: mul.out
+  kernels:
+    - arg_meta: null
+      kernel_name: torch::executor::opt_mul_out
+            """
+            )
+        metadata = gen_oplist._get_et_kernel_metadata_from_ops_yaml(ops_yaml)
+        # Keeps both the specialized kernel and the fallback kernel.
+        self.assertListEqual(
+            metadata["aten::add.out"],
+            ["v1/6;0,1|6;0,1|6;0,1", gen_oplist.FALLBACK_KERNEL_KEY],
+        )
+        self.assertListEqual(metadata["aten::mul.out"], ["default"])
+
     def tearDown(self):
         self.temp_dir.cleanup()
 
@@ -0,0 +1,92 @@
+# Copyright (c) Meta Platforms, Inc. and affiliates.
+# All rights reserved.
+#
+# This source code is licensed under the BSD-style license found in the
+# LICENSE file in the root directory of this source tree.
+
+import os
+import tempfile
+import unittest
+
+import executorch.codegen.tools.merge_yaml as merge_yaml
+import yaml
+
+
+class TestMergeYaml(unittest.TestCase):
+    def setUp(self):
+        self.temp_dir = tempfile.TemporaryDirectory()
+        self.addCleanup(self.temp_dir.cleanup)
+        self.functions_yaml = os.path.join(self.temp_dir.name, "functions.yaml")
+        with open(self.functions_yaml, "w") as f:
+            f.write(
+                """
+- op: add.out
+  kernels:
+    - arg_meta: null
+      kernel_name: torch::executor::opt_add_out
+  dtype_specializations:
+    tensor_args: [self, other, out]
+    dtypes: [Float, Long]
+    ranks: [1, 2]
+
+- op: sub.out
+  kernels:
+    - arg_meta: null
+      kernel_name: torch::executor::opt_sub_out
+                """
+            )
+
+    def _merged(self):
+        merge_yaml.merge(self.functions_yaml, None, self.temp_dir.name)
+        with open(os.path.join(self.temp_dir.name, "merged.yaml")) as f:
+            return {e["op"]: e for e in yaml.safe_load(f)}
+
+    def test_expands_dtype_specializations(self) -> None:
+        add = self._merged()["add.out"]
+        self.assertNotIn(merge_yaml.DTYPE_SPECIALIZATIONS_KEY, add)
+        self.assertEqual(add["type_alias"], {"T_Float": ["Float"], "T_Long": ["Long"]})
+        self.assertEqual(add["dim_order_alias"], {"D_rank1": [0], "D_rank2": [0, 1]})
+        # Fallback first, then one kernel per (dtype, rank).
+        kernels = add["kernels"]
+        self.assertEqual(len(kernels), 5)
+        self.assertIsNone(kernels[0]["arg_meta"])
+        self.assertEqual(
+            [k["kernel_name"] for k in kernels[1:]],
+            ["torch::executor::opt_add_out_float"] * 2
+            + ["torch::executor::opt_add_out_long"] * 2,
+        )
+        self.assertEqual(
+            kernels[2]["arg_meta"],
+            {
+                "self": ["T_Float", "D_rank2"],
+                "other": ["T_Float", "D_rank2"],
+                "out": ["T_Float", "D_rank2"],
+            },
+        )
+
+    def test_entries_without_specializations_are_unchanged(self) -> None:
+        self.assertEqual(
+            self._merged()["sub.out"],
+            {
+                "op": "sub.out",
+                "kernels": [
+                    {
+                        "arg_meta": None,
+                        "kernel_name": "torch::executor::opt_sub_out",
+                    }
+                ],
+            },
+        )
+
+    def test_requires_kernel_name_without_single_fallback(self) -> None:
+        with self.assertRaises(AssertionError):
+            merge_yaml.expand_dtype_specializations(
+                {
+                    "op": "add.out",
+                    "kernels": [],
+                    "dtype_specializations": {
+                        "tensor_args": ["self", "other", "out"],
+                        "dtypes": ["Float"],
+                    },
+                }
+            )
@@ -9,6 +9,7 @@
 #include <executorch/examples/models/llama2/custom_ops/op_sdpa.h>
 
 #include <executorch/kernels/optimized/blas/CPUBlas.h>
+#include <executorch/kernels/optimized/cpu/tunable_param.h>
 #include <executorch/kernels/optimized/vec/functional.h>
 #include <executorch/kernels/optimized/vec/vec.h>
 #include <executorch/runtime/core/exec_aten/util/dim_order_util.h>
@@ -177,7 +178,7 @@ inline void fill_stub(scalar_t* data, scalar_t val, int64_t size) {
   }
 }
 
-template <typename scalar_t, int64_t q_split_size, int64_t kv_split_size>
+template <typename scalar_t>
 void cpu_flash_attention(
     Tensor& output,
     const Tensor& query,
@@ -187,7 +188,10 @@ void cpu_flash_attention(
     bool is_causal,
     const optional<Tensor>& attn_mask,
     const optional<double>& scale,
-    bool is_with_kv_cache = false) {
+    bool is_with_kv_cache,
+    int64_t q_split_size,
+    int64_t kv_split_size,
+    int64_t grain_size) {
   (void)dropout_p;
   // Query (Batch x Num_heads  x Q_seq_len  x Dim_per_head)
   // Key   (Batch x Num_heads  x KV_seq_len x Dim_per_head)
@@ -501,7 +505,73 @@ void cpu_flash_attention(
     }
   };
   torch::executor::parallel_for(
-      0, batchSize * num_head * qSlice, 1, compute_lambda);
+      0, batchSize * num_head * qSlice, grain_size, compute_lambda);
+}
+
+// Picks the split and grain sizes of cpu_flash_attention() from the kernel
+// tuning cache, keyed by the buckets of the query and key/value sequence
+// lengths, the dtype and whether the kv cache layout is used, and runs it.
+// The defaults are the split sizes that were hard-coded before tuning was
+// added; they were picked on x86 and may not suit other CPUs.
+template <typename scalar_t>
+void tuned_cpu_flash_attention(
+    Tensor& output,
+    const Tensor& query,
+    const Tensor& key,
+    const Tensor& value,
+    double dropout_p,
+    bool is_causal,
+    const optional<Tensor>& attn_mask,
+    const optional<double>& scale,
+    bool is_with_kv_cache) {
+  static const tuning::TunableParam q_split_param(
+      "llama::sdpa", "q_split_size", {32, 64, 128, 256});
+  static const tuning::TunableParam kv_split_param(
+      "llama::sdpa", "kv_split_size", {128, 256, 512, 1024});
+  static const tuning::TunableParam grain_param(
+      "llama::sdpa", "grain_size", {1, 2, 4, 8});
+
+  const int64_t q_seq_len = is_with_kv_cache ? query.size(1) : query.size(2);
+  const int64_t kv_seq_len = is_with_kv_cache ? value.size(1) : value.size(2);
+  const int64_t bucket = tuning::combine_buckets(
+      {tuning::shape_bucket(q_seq_len),
+       tuning::shape_bucket(kv_seq_len),
+       static_cast<int64_t>(query.scalar_type()),
+       is_with_kv_cache});
+  auto run = [&](int64_t q_split_size,
+                 int64_t kv_split_size,
+                 int64_t grain_size) {
+    cpu_flash_attention<scalar_t>(
+        output,
+        query,
+        key,
+        value,
+        dropout_p,
+        is_causal,
+        attn_mask,
+        scale,
+        is_with_kv_cache,
+        q_split_size,
+        kv_split_size,
+        grain_size);
+  };
+
+  // The parameters are tuned one after the other, each with the values
+  // already picked for the previous ones.
+  const int64_t default_q_split_size =
+      q_seq_len >= 768 ? 256 : (q_seq_len >= 192 ? 64 : 32);
+  const int64_t q_split_size =
+      q_split_param.select(bucket, default_q_split_size, [&](int64_t v) {
+        run(v, 512, 1);
+      });
+  const int64_t kv_split_size =
+      kv_split_param.select(bucket, 512, [&](int64_t v) {
+        run(q_split_size, v, 1);
+      });
+  const int64_t grain_size = grain_param.select(bucket, 1, [&](int64_t v) {
+    run(q_split_size, kv_split_size, v);
+  });
+  run(q_split_size, kv_split_size, grain_size);
 }
 
 bool validate_flash_attention_args(
@@ -667,44 +737,18 @@ Tensor& flash_attention_kernel_out(
       InvalidArgument,
       output);
 
-  auto q_seq_len = query.size(2);
-
   ET_SWITCH_FLOAT_TYPES(
       query.scalar_type(), ctx, "flash_attention", CTYPE, [&] {
-        // TODO we need to re-evaluate this for ARM CPUs
-        // And there can be many so instead of templatizing
-        // we might consider another appraoch
-        if (q_seq_len >= 768) {
-          cpu_flash_attention<CTYPE, 256, 512>(
-              output,
-              query,
-              key,
-              value,
-              dropout_p,
-              is_causal,
-              attn_mask,
-              scale);
-        } else if (q_seq_len >= 192) {
-          cpu_flash_attention<CTYPE, 64, 512>(
-              output,
-              query,
-              key,
-              value,
-              dropout_p,
-              is_causal,
-              attn_mask,
-              scale);
-        } else {
-          cpu_flash_attention<CTYPE, 32, 512>(
-              output,
-              query,
-              key,
-              value,
-              dropout_p,
-              is_causal,
-              attn_mask,
-              scale);
-        }
+        tuned_cpu_flash_attention<CTYPE>(
+            output,
+            query,
+            key,
+            value,
+            dropout_p,
+            is_causal,
+            attn_mask,
+            scale,
+            /*is_with_kv_cache=*/false);
       });
   return output;
 }
@@ -752,8 +796,6 @@ Tensor& sdpa_with_kv_cache_out(
   update_cache(k_projected, key_cache, start_pos, seq_len);
   update_cache(v_projected, value_cache, start_pos, seq_len);
 
-  auto q_seq_len = q_projected.size(1);
-
   std::array<exec_aten::DimOrderType, util::kKVDim> sliced_key_dim_order{
       0, 1, 2, 3};
   std::array<exec_aten::SizesType, util::kKVDim> sliced_key_sizes;
@@ -814,47 +856,18 @@ Tensor& sdpa_with_kv_cache_out(
       InvalidArgument,
       output);
 
-  // TODO(task): replace the template param selection logic
-  // with whatever apprpriately makes more sense for
   ET_SWITCH_FLOAT_TYPES(
       q_projected.scalar_type(), ctx, "flash_attention", CTYPE, [&] {
-        // TODO we need to re-evaluate this for ARM CPUs
-        // And there can be many so instead of templatizing
-        // we might consider another appraoch
-        if (q_seq_len >= 768) {
-          cpu_flash_attention<CTYPE, 256, 512>(
-              output,
-              q_projected,
-              sliced_key_cache,
-              sliced_value_cache,
-              dropout_p,
-              is_causal,
-              attn_mask,
-              scale,
-              true);
-        } else if (q_seq_len >= 192) {
-          cpu_flash_attention<CTYPE, 64, 512>(
-              output,
-              q_projected,
-              sliced_key_cache,
-              sliced_value_cache,
-              dropout_p,
-              is_causal,
-              attn_mask,
-              scale,
-              true);
-        } else {
-          cpu_flash_attention<CTYPE, 32, 512>(
-              output,
-              q_projected,
-              sliced_key_cache,
-              sliced_value_cache,
-              dropout_p,
-              is_causal,
-              attn_mask,
-              scale,
-              true);
-        }
+        tuned_cpu_flash_attention<CTYPE>(
+            output,
+            q_projected,
+            sliced_key_cache,
+            sliced_value_cache,
+            dropout_p,
+            is_causal,
+            attn_mask,
+            scale,
+            /*is_with_kv_cache=*/true);
       });
   return output;
 }
@@ -15,6 +15,9 @@ def define_common_targets():
             "//executorch/kernels/portable/cpu:scalar_utils",
             "//executorch/kernels/optimized:libblas",
             "//executorch/kernels/optimized:libvec",
+            "//executorch/kernels/optimized/cpu:tunable_param",
+            # Registers the tuner that picks the sdpa split sizes.
+            "//executorch/extension/kernel_tuning:kernel_tuning",
             "//executorch/extension/kernel_util:kernel_util",
             "//executorch/extension/parallel:thread_parallel",
             "//executorch/backends/xnnpack/threadpool:threadpool",
@@ -38,7 +38,11 @@ from sentencepiece import SentencePieceProcessor
 from .builder import DType, LlamaEdgeManager, load_llama_model, WeightType
 from .quant_lib import _get_pt2e_quantization_params, get_pt2e_quantizers
 
-from .quantize import EmbeddingQuantHandler, WeightOnlyInt8QuantHandler
+from .quantize import (
+    EmbeddingQuantHandler,
+    WeightOnlyFloat8QuantHandler,
+    WeightOnlyInt8QuantHandler,
+)
 
 
 IS_FBCODE = True  #  os.environ.get("FBCODE_PLATFORM", False)
@@ -238,7 +242,7 @@ def quantize(
     Quantizes a model by converting all weights to int8.
     Args:
         model: A model to quantize.
-        qmode: quantization mode, e.g. int8, 8da4w, 8da4w-gptq
+        qmode: quantization mode, e.g. int8, 8da4w, 8da4w-gptq, fp8_e4m3
     Returns:
         A quantized model.
     """
@@ -257,6 +261,11 @@ def quantize(
     if qmode == "int8":
         # Add quantization mode options here: group size, bit width, etc.
         return WeightOnlyInt8QuantHandler(model).quantized_model()
+    elif qmode in ["fp8_e4m3", "fp8_e5m2"]:
+        float8_dtype = torch.float8_e4m3fn if qmode == "fp8_e4m3" else torch.float8_e5m2
+        return WeightOnlyFloat8QuantHandler(
+            model, float8_dtype=float8_dtype, group_size=group_size
+        ).quantized_model()
     elif qmode == "8da4w":
         # Check for required args
         if group_size is None:
@@ -369,7 +378,7 @@ def build_args_parser() -> argparse.ArgumentParser:
         "--quantization_mode",
         type=str,
         default=None,
-        choices=["int8", "8da4w", "8da4w-gptq"],
+        choices=["int8", "8da4w", "8da4w-gptq", "fp8_e4m3", "fp8_e5m2"],
         help="type of quantization",
     )
 
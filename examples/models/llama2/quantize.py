@@ -399,6 +399,7 @@ class QuantizedGroupEmbedding(torch.nn.Module):
         group_size: Optional[int] = None,
         dtype=torch.half,
         packed=False,
+        weight_dtype=torch.int8,
     ) -> None:
         super().__init__()
         if group_size is None or group_size == 0:
@@ -410,7 +411,7 @@ class QuantizedGroupEmbedding(torch.nn.Module):
             self.register_buffer(
                 "weight",
                 torch.empty(
-                    (vocab_size, embedding_dim), dtype=torch.int8, device=device
+                    (vocab_size, embedding_dim), dtype=weight_dtype, device=device
                 ),
             )
         else:  # packed
@@ -443,3 +444,197 @@ class QuantizedGroupEmbedding(torch.nn.Module):
             return torch.ops.quantized_decomposed.embedding_4bit.dtype(
                 self.weight, self.scales, None, 0, 0, indices, dtype=self.dtype
             )
+
+
+#########################################################################
+###               Weight-only float8 per-channel code                 ###
+
+
+def dynamically_quantize_per_channel_float8(
+    x: torch.Tensor,
+    float8_dtype: torch.dtype,
+    group_size: Optional[int] = None,
+    *,
+    per_tensor: bool = False,
+    scales_dtype=torch.float16,
+):
+    """
+    Casts a 2D weight to float8_dtype, scaled so that the largest magnitude of
+    each row, or of each group of a row, maps to the largest finite float8
+    value. Needs no calibration data.
+
+    Arguments:
+        x: input tensor,
+        float8_dtype: torch.float8_e4m3fn or torch.float8_e5m2,
+        group_size: number of elements of the channel to scale together
+
+    Keyword arguments:
+        per_tensor: if True, use a single scale for the whole tensor, repeated
+            for every channel,
+        scales_dtype: data type of scale
+
+    Returns the float8 weight, and the scales of shape [rows], or
+    [rows, groups] when there are several groups per row.
+    """
+    rows, cols = x.shape
+    if group_size is None or group_size == 0:
+        group_size = cols
+    assert (
+        cols % group_size == 0
+    ), f"weights dimension 1 = {cols} must be a multiple of group size {group_size}"
+
+    x = x.float().view(rows, cols // group_size, group_size)
+    if per_tensor:
+        amax = x.abs().amax().expand(rows, cols // group_size, 1)
+    else:
+        amax = x.abs().amax(dim=-1, keepdim=True)
+
+    float8_max = torch.finfo(float8_dtype).max
+    # Round the scales to their storage type first, so that the weights are
+    # scaled by the values the runtime multiplies them with.
+    eps = torch.finfo(torch.float32).eps
+    scales = torch.clamp(amax / float8_max, min=eps).to(scales_dtype)
+    # e4m3fn has no infinity: values above its range would become NaN.
+    quant = torch.clamp(x / scales.float(), -float8_max, float8_max).to(float8_dtype)
+
+    scales = scales.view(rows, -1)
+    if scales.shape[1] == 1:
+        # squeeze makes group_size=rowsize unidimensional
+        scales = scales.squeeze(dim=-1)
+    return quant.view(rows, cols), scales
+
+
+def replace_linear_and_embedding_weight_only_float8(
+    module, device, float8_dtype, group_size: Optional[int] = None
+):
+    for name, child in module.named_children():
+        if isinstance(child, nn.Linear):
+            setattr(
+                module,
+                name,
+                WeightOnlyFloat8Linear(
+                    device,
+                    child.in_features,
+                    child.out_features,
+                    float8_dtype,
+                    group_size=group_size,
+                ),
+            )
+        elif isinstance(child, nn.Embedding):
+            setattr(
+                module,
+                name,
+                QuantizedGroupEmbedding(
+                    device=device,
+                    vocab_size=child.weight.shape[0],
+                    embedding_dim=child.weight.shape[1],
+                    group_size=group_size,
+                    weight_dtype=float8_dtype,
+                ),
+            )
+        else:
+            replace_linear_and_embedding_weight_only_float8(
+                child, device, float8_dtype, group_size
+            )
+
+
+class WeightOnlyFloat8QuantHandler(QuantHandler):
+    """
+    Stores the weights of the linear and embedding layers as float8, with
+    per-channel (or per-group, or per-tensor) scales. The runtime kernels of
+    quantized_decomposed::mixed_linear and embedding_byte decode the weights
+    as they read them, which halves the weight bandwidth compared to fp16.
+    """
+
+    def __init__(
+        self,
+        mod,
+        device="cpu",
+        *,
+        float8_dtype=torch.float8_e4m3fn,
+        group_size: Optional[int] = None,
+        per_tensor: bool = False,
+    ):
+        if float8_dtype not in [torch.float8_e4m3fn, torch.float8_e5m2]:
+            raise ValueError(f"Unsupported float8 dtype {float8_dtype}")
+        if per_tensor and group_size:
+            raise ValueError("per_tensor scales can not be used with a group size")
+        self.mod = mod
+        self.device = device
+        self.float8_dtype = float8_dtype
+        self.group_size = group_size
+        self.per_tensor = per_tensor
+
+    @torch.no_grad()
+    def create_quantized_state_dict(self) -> Dict:
+        cur_state_dict = self.mod.state_dict()
+
+        for fqn, mod in self.mod.named_modules():
+            if isinstance(mod, (nn.Linear, nn.Embedding)):
+                print(
+                    f"quantize {fqn, mod} to {self.float8_dtype} with group_size {self.group_size}"
+                )
+                weight, scales = dynamically_quantize_per_channel_float8(
+                    mod.weight,
+                    self.float8_dtype,
+                    self.group_size,
+                    per_tensor=self.per_tensor,
+                )
+                cur_state_dict[f"{fqn}.weight"] = weight.to(device=self.device)
+                cur_state_dict[f"{fqn}.scales"] = scales.to(device=self.device)
+
+        return cur_state_dict
+
+    def convert_for_runtime(self) -> nn.Module:
+        replace_linear_and_embedding_weight_only_float8(
+            self.mod, self.device, self.float8_dtype, self.group_size
+        )
+        return self.mod
+
+
+class WeightOnlyFloat8Linear(torch.nn.Module):
+    __constants__ = ["in_features", "out_features"]
+    in_features: int
+    out_features: int
+    weight: torch.Tensor
+
+    def __init__(
+        self,
+        device,
+        in_features: int,
+        out_features: int,
+        float8_dtype=torch.float8_e4m3fn,
+        group_size: Optional[int] = None,
+    ) -> None:
+        super().__init__()
+        self.in_features = in_features
+        self.out_features = out_features
+        self.register_buffer(
+            "weight",
+            torch.empty((out_features, in_features), dtype=float8_dtype, device=device),
+        )
+        if group_size is None or group_size == 0:
+            group_size = in_features
+        groups_per_row = in_features // group_size
+        if groups_per_row > 1:
+            self.register_buffer(
+                "scales",
+                torch.ones(
+                    (out_features, groups_per_row), dtype=torch.float16, device=device
+                ),
+            )
+        else:
+            self.register_buffer(
+                "scales",
+                torch.ones((out_features,), dtype=torch.float16, device=device),
+            )
+
+    def forward(self, input: torch.Tensor) -> torch.Tensor:
+        # The runtime kernel takes 2D inputs and scales of the input dtype.
+        output = torch.ops.quantized_decomposed.mixed_linear(
+            input.reshape(-1, self.in_features),
+            self.weight,
+            self.scales.to(input.dtype),
+            None,
+        )
+        return output.reshape(*input.shape[:-1], self.out_features)
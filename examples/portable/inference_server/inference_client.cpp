@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+/**
+ * @file
+ *
+ * Load generator for inference_server. --num_connections threads each open a
+ * connection and keep --depth requests in flight on it, until each sent
+ * --requests_per_connection requests. Reports the throughput and the latency
+ * percentiles of all requests. Inputs are filled with zeros.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <gflags/gflags.h>
+
+#include <executorch/examples/portable/inference_server/shm_transport.h>
+#include <executorch/runtime/platform/log.h>
+#include <executorch/runtime/platform/runtime.h>
+
+DEFINE_string(
+    socket_path,
+    "/tmp/executorch_server.sock",
+    "Path of the server's Unix domain socket.");
+DEFINE_int32(num_connections, 4, "Number of concurrent connections.");
+DEFINE_int32(requests_per_connection, 1000, "Requests sent per connection.");
+DEFINE_int32(depth, 2, "Requests in flight per connection.");
+DEFINE_int32(slot_kb, 1024, "Size of a shared-memory slot, in KiB.");
+
+using namespace torch::executor;
+using namespace torch::executor::server;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+double percentile(std::vector<double> values, double p) {
+  std::sort(values.begin(), values.end());
+  return values[std::min(values.size() - 1, size_t(p * values.size()))];
+}
+
+int connect_to_server() {
+  int socket = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+  ET_CHECK_MSG(socket >= 0, "socket() failed: %s", ::strerror(errno));
+  struct sockaddr_un address = {};
+  address.sun_family = AF_UNIX;
+  std::strncpy(
+      address.sun_path,
+      FLAGS_socket_path.c_str(),
+      sizeof(address.sun_path) - 1);
+  ET_CHECK_MSG(
+      ::connect(socket, (struct sockaddr*)&address, sizeof(address)) == 0,
+      "Cannot connect to %s: %s",
+      FLAGS_socket_path.c_str(),
+      ::strerror(errno));
+  return socket;
+}
+
+// Runs the requests of one connection, and returns their latencies in
+// microseconds.
+std::vector<double> run_connection() {
+  const size_t slot_bytes = static_cast<size_t>(FLAGS_slot_kb) * 1024;
+  auto slots = SlotRing::create(FLAGS_depth, slot_bytes);
+  ET_CHECK_MSG(slots.ok(), "Cannot allocate the slots");
+  const int socket = connect_to_server();
+
+  HelloRequest hello = {
+      kProtocolMagic, static_cast<uint32_t>(FLAGS_depth), slot_bytes};
+  ET_CHECK(
+      send_message(socket, &hello, sizeof(hello), slots->fd()) == Error::Ok);
+  HelloResponse response;
+  auto received = recv_message(socket, &response, sizeof(response));
+  ET_CHECK_MSG(
+      received.ok() && received.get(), "The server closed the connection");
+  ET_CHECK_MSG(
+      response.error == static_cast<int32_t>(Error::Ok),
+      "The server rejected the connection: 0x%" PRIx32
+      ". Is --slot_kb large enough for the inputs?",
+      (uint32_t)response.error);
+
+  // The server overwrites the inputs with the outputs, so every request
+  // writes its inputs again, as a real client would.
+  size_t inputs_bytes = kSlotDataOffset;
+  for (uint32_t i = 0; i < response.inputs.num_tensors; ++i) {
+    const TensorDesc& desc = response.inputs.tensors[i];
+    inputs_bytes = std::max<size_t>(inputs_bytes, desc.offset + desc.nbytes);
+  }
+  std::vector<uint8_t> request_template(inputs_bytes);
+  std::memcpy(
+      request_template.data(), &response.inputs, sizeof(response.inputs));
+
+  std::vector<Clock::time_point> sent(FLAGS_depth);
+  std::vector<double> latencies;
+  latencies.reserve(FLAGS_requests_per_connection);
+  int32_t num_sent = 0;
+  auto send = [&](uint32_t slot) {
+    std::memcpy(
+        slots->slot(slot), request_template.data(), request_template.size());
+    sent[slot] = Clock::now();
+    RequestMessage request = {slot};
+    ET_CHECK(send_message(socket, &request, sizeof(request)) == Error::Ok);
+    num_sent++;
+  };
+  for (int32_t slot = 0;
+       slot < FLAGS_depth && num_sent < FLAGS_requests_per_connection;
+       ++slot) {
+    send(slot);
+  }
+  while (latencies.size() < static_cast<size_t>(num_sent)) {
+    ResponseMessage result;
+    auto next = recv_message(socket, &result, sizeof(result));
+    ET_CHECK_MSG(next.ok() && next.get(), "The server closed the connection");
+    ET_CHECK_MSG(
+        result.error == static_cast<int32_t>(Error::Ok) &&
+            result.slot < static_cast<uint32_t>(FLAGS_depth),
+        "Request failed: 0x%" PRIx32,
+        (uint32_t)result.error);
+    latencies.push_back(std::chrono::duration<double, std::micro>(
+                            Clock::now() - sent[result.slot])
+                            .count());
+    if (num_sent < FLAGS_requests_per_connection) {
+      send(result.slot);
+    }
+  }
+  ::close(socket);
+  return latencies;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  runtime_init();
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+
+  std::vector<std::vector<double>> latencies(FLAGS_num_connections);
+  const auto start = Clock::now();
+  std::vector<std::thread> connections;
+  for (int32_t c = 0; c < FLAGS_num_connections; ++c) {
+    connections.emplace_back([&, c] { latencies[c] = run_connection(); });
+  }
+  for (auto& connection : connections) {
+    connection.join();
+  }
+  const double seconds =
+      std::chrono::duration<double>(Clock::now() - start).count();
+
+  std::vector<double> all;
+  for (const auto& l : latencies) {
+    all.insert(all.end(), l.begin(), l.end());
+  }
+  ET_LOG(
+      Info,
+      "%zu requests in %.2fs: %.1f QPS, latency p50 %.0fus p90 %.0fus "
+      "p99 %.0fus max %.0fus",
+      all.size(),
+      seconds,
+      all.size() / seconds,
+      percentile(all, 0.5),
+      percentile(all, 0.9),
+      percentile(all, 0.99),
+      percentile(all, 1.0));
+  return 0;
+}
@@ -0,0 +1,335 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+/**
+ * @file
+ *
+ * A local inference server: serves a method of a model to clients that
+ * connect over a Unix domain socket, and exchange tensors with the server
+ * through shared memory (see shm_transport.h).
+ *
+ * --num_workers threads each own a Module, i.e. an instance of the method
+ * with its own memory, and take requests from a shared queue, so that up to
+ * --num_workers requests run at the same time. Every client connection has a
+ * thread that queues its requests.
+ *
+ * Only methods whose inputs and outputs are all tensors are supported.
+ */
+
+#include <cinttypes>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <gflags/gflags.h>
+
+#include <executorch/examples/portable/inference_server/shm_transport.h>
+#include <executorch/extension/module/module.h>
+#include <executorch/runtime/platform/log.h>
+#include <executorch/runtime/platform/runtime.h>
+
+DEFINE_string(
+    model_path,
+    "model.pte",
+    "Model serialized in flatbuffer format.");
+DEFINE_string(method_name, "forward", "Method to serve.");
+DEFINE_string(
+    socket_path,
+    "/tmp/executorch_server.sock",
+    "Path of the Unix domain socket to listen on.");
+DEFINE_int32(num_workers, 4, "Number of method instances.");
+
+using namespace torch::executor;
+using namespace torch::executor::server;
+
+namespace {
+
+// A client connection, alive until its thread exits and its last request is
+// answered.
+struct Connection {
+  explicit Connection(int socket) : socket(socket) {}
+  ~Connection() {
+    ::close(socket);
+  }
+
+  void respond(uint32_t slot, Error err) {
+    ResponseMessage response = {slot, static_cast<int32_t>(err)};
+    std::lock_guard<std::mutex> guard(send_mutex);
+    // If the client is gone, its connection thread notices.
+    (void)send_message(socket, &response, sizeof(response));
+  }
+
+  const int socket;
+  std::unique_ptr<SlotRing> slots;
+  std::mutex send_mutex;
+};
+
+struct Job {
+  std::shared_ptr<Connection> connection;
+  uint32_t slot;
+};
+
+class JobQueue {
+ public:
+  void push(Job job) {
+    {
+      std::lock_guard<std::mutex> guard(mutex_);
+      jobs_.push_back(std::move(job));
+    }
+    ready_.notify_one();
+  }
+
+  Job pop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    ready_.wait(lock, [&] { return !jobs_.empty(); });
+    Job job = std::move(jobs_.front());
+    jobs_.pop_front();
+    return job;
+  }
+
+ private:
+  std::mutex mutex_;
+  std::condition_variable ready_;
+  std::deque<Job> jobs_;
+};
+
+// Wraps the tensors of a slot without copying them.
+struct SlotTensors {
+  std::vector<std::vector<exec_aten::SizesType>> sizes;
+  std::vector<std::vector<exec_aten::DimOrderType>> dim_orders;
+  std::vector<std::vector<exec_aten::StridesType>> strides;
+  std::vector<std::unique_ptr<TensorImpl>> impls;
+  std::vector<EValue> values;
+};
+
+Error wrap_inputs(uint8_t* slot, size_t slot_bytes, SlotTensors* tensors) {
+  // The client can write to the slot at any time, so validate a copy.
+  SlotHeader header;
+  std::memcpy(&header, slot, sizeof(header));
+  ET_CHECK_OK_OR_RETURN_ERROR(validate_header(header, slot_bytes));
+  for (uint32_t i = 0; i < header.num_tensors; ++i) {
+    const TensorDesc& desc = header.tensors[i];
+    tensors->sizes.emplace_back(desc.sizes, desc.sizes + desc.dim);
+    tensors->dim_orders.emplace_back(desc.dim);
+    tensors->strides.emplace_back(desc.dim);
+    exec_aten::StridesType stride = 1;
+    for (int32_t d = desc.dim - 1; d >= 0; --d) {
+      tensors->dim_orders.back()[d] = d;
+      tensors->strides.back()[d] = stride;
+      stride *= desc.sizes[d];
+    }
+    tensors->impls.push_back(std::make_unique<TensorImpl>(
+        static_cast<exec_aten::ScalarType>(desc.scalar_type),
+        desc.dim,
+        tensors->sizes.back().data(),
+        slot + desc.offset,
+        tensors->dim_orders.back().data(),
+        tensors->strides.back().data()));
+    tensors->values.emplace_back(
+        exec_aten::Tensor(tensors->impls.back().get()));
+  }
+  return Error::Ok;
+}
+
+Error write_outputs(
+    const std::vector<EValue>& outputs,
+    uint8_t* slot,
+    size_t slot_bytes) {
+  SlotHeader header = {};
+  header.num_tensors = outputs.size();
+  ET_CHECK_OR_RETURN_ERROR(
+      outputs.size() <= kMaxTensors, NotSupported, "Too many outputs");
+  for (size_t i = 0; i < outputs.size(); ++i) {
+    ET_CHECK_OR_RETURN_ERROR(
+        outputs[i].isTensor(), NotSupported, "Output %zu is not a tensor", i);
+    const auto& tensor = outputs[i].toTensor();
+    ET_CHECK_OR_RETURN_ERROR(
+        static_cast<size_t>(tensor.dim()) <= kMaxDims,
+        NotSupported,
+        "Output %zu has too many dims",
+        i);
+    TensorDesc& desc = header.tensors[i];
+    desc.scalar_type = static_cast<int32_t>(tensor.scalar_type());
+    desc.dim = tensor.dim();
+    for (ssize_t d = 0; d < tensor.dim(); ++d) {
+      desc.sizes[d] = tensor.size(d);
+    }
+  }
+  ET_CHECK_OK_OR_RETURN_ERROR(layout_tensors(&header, slot_bytes));
+  for (size_t i = 0; i < outputs.size(); ++i) {
+    std::memcpy(
+        slot + header.tensors[i].offset,
+        outputs[i].toTensor().const_data_ptr(),
+        header.tensors[i].nbytes);
+  }
+  std::memcpy(slot, &header, sizeof(header));
+  return Error::Ok;
+}
+
+void worker_loop(Module* module, JobQueue* queue) {
+  while (true) {
+    Job job = queue->pop();
+    SlotRing& slots = *job.connection->slots;
+    uint8_t* slot = slots.slot(job.slot);
+    SlotTensors inputs;
+    Error err = wrap_inputs(slot, slots.slot_bytes(), &inputs);
+    if (err == Error::Ok) {
+      auto outputs = module->execute(FLAGS_method_name, inputs.values);
+      err = outputs.ok()
+          ? write_outputs(outputs.get(), slot, slots.slot_bytes())
+          : outputs.error();
+    }
+    job.connection->respond(job.slot, err);
+  }
+}
+
+// Describes the inputs of the method, for clients to lay out their slots.
+Result<SlotHeader> describe_inputs(Module& module) {
+  const auto meta = ET_UNWRAP(module.method_meta(FLAGS_method_name));
+  SlotHeader header = {};
+  ET_CHECK_OR_RETURN_ERROR(
+      meta.num_inputs() <= kMaxTensors, NotSupported, "Too many inputs");
+  header.num_tensors = meta.num_inputs();
+  for (size_t i = 0; i < meta.num_inputs(); ++i) {
+    const auto info = ET_UNWRAP(meta.input_tensor_meta(i));
+    ET_CHECK_OR_RETURN_ERROR(
+        info.sizes().size() <= kMaxDims,
+        NotSupported,
+        "Input %zu has too many dims",
+        i);
+    TensorDesc& desc = header.tensors[i];
+    desc.scalar_type = static_cast<int32_t>(info.scalar_type());
+    desc.dim = info.sizes().size();
+    for (size_t d = 0; d < info.sizes().size(); ++d) {
+      desc.sizes[d] = info.sizes()[d];
+    }
+  }
+  return header;
+}
+
+void serve_connection(
+    std::shared_ptr<Connection> connection,
+    const SlotHeader& inputs,
+    JobQueue* queue) {
+  HelloRequest hello;
+  int fd = -1;
+  auto received =
+      recv_message(connection->socket, &hello, sizeof(hello), &fd);
+  HelloResponse response = {};
+  response.inputs = inputs;
+  response.error = static_cast<int32_t>(Error::InvalidArgument);
+  if (received.ok() && received.get() && hello.magic == kProtocolMagic &&
+      fd >= 0) {
+    auto slots = SlotRing::attach(fd, hello.num_slots, hello.slot_bytes);
+    fd = -1; // Owned by attach().
+    if (slots.ok()) {
+      response.error = static_cast<int32_t>(
+          layout_tensors(&response.inputs, hello.slot_bytes));
+      connection->slots = std::make_unique<SlotRing>(std::move(slots.get()));
+    }
+  }
+  if (fd >= 0) {
+    ::close(fd);
+  }
+  if (send_message(connection->socket, &response, sizeof(response)) !=
+          Error::Ok ||
+      response.error != static_cast<int32_t>(Error::Ok)) {
+    return;
+  }
+
+  while (true) {
+    RequestMessage request;
+    auto next = recv_message(connection->socket, &request, sizeof(request));
+    if (!next.ok() || !next.get()) {
+      return;
+    }
+    if (request.slot >= connection->slots->num_slots()) {
+      connection->respond(request.slot, Error::InvalidArgument);
+      continue;
+    }
+    queue->push({connection, request.slot});
+  }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  runtime_init();
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+
+  std::vector<std::unique_ptr<Module>> modules;
+  for (int32_t i = 0; i < FLAGS_num_workers; ++i) {
+    // Every Module maps the same file, so the weights are only in memory
+    // once.
+    modules.push_back(std::make_unique<Module>(
+        FLAGS_model_path, Module::MlockConfig::UseMlockIgnoreErrors));
+    Error err = modules.back()->load_method(FLAGS_method_name);
+    ET_CHECK_MSG(
+        err == Error::Ok,
+        "Failed to load %s: 0x%" PRIx32,
+        FLAGS_method_name.c_str(),
+        (uint32_t)err);
+  }
+  auto inputs = describe_inputs(*modules.front());
+  ET_CHECK_MSG(
+      inputs.ok(),
+      "Cannot serve %s: 0x%" PRIx32,
+      FLAGS_method_name.c_str(),
+      (uint32_t)inputs.error());
+
+  JobQueue queue;
+  std::vector<std::thread> workers;
+  for (auto& module : modules) {
+    workers.emplace_back(worker_loop, module.get(), &queue);
+  }
+
+  int listener = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+  ET_CHECK_MSG(listener >= 0, "socket() failed: %s", ::strerror(errno));
+  struct sockaddr_un address = {};
+  address.sun_family = AF_UNIX;
+  ET_CHECK_MSG(
+      FLAGS_socket_path.size() < sizeof(address.sun_path),
+      "Socket path is too long");
+  std::strncpy(
+      address.sun_path, FLAGS_socket_path.c_str(), sizeof(address.sun_path));
+  ::unlink(FLAGS_socket_path.c_str());
+  ET_CHECK_MSG(
+      ::bind(listener, (struct sockaddr*)&address, sizeof(address)) == 0 &&
+          ::listen(listener, SOMAXCONN) == 0,
+      "Cannot listen on %s: %s",
+      FLAGS_socket_path.c_str(),
+      ::strerror(errno));
+  ET_LOG(
+      Info,
+      "Serving %s with %d workers on %s",
+      FLAGS_model_path.c_str(),
+      FLAGS_num_workers,
+      FLAGS_socket_path.c_str());
+
+  while (true) {
+    int socket = ::accept4(listener, nullptr, nullptr, SOCK_CLOEXEC);
+    if (socket < 0) {
+      ET_LOG(Error, "accept() failed: %s", ::strerror(errno));
+      continue;
+    }
+    std::thread(
+        serve_connection,
+        std::make_shared<Connection>(socket),
+        inputs.get(),
+        &queue)
+        .detach();
+  }
+}
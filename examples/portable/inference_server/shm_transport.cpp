@@ -0,0 +1,233 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <executorch/examples/portable/inference_server/shm_transport.h>
+
+#include <cerrno>
+#include <cstring>
+
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <executorch/runtime/core/exec_aten/util/scalar_type_util.h>
+#include <executorch/runtime/platform/log.h>
+
+namespace torch {
+namespace executor {
+namespace server {
+
+size_t tensor_nbytes(const TensorDesc& desc) {
+  size_t numel = 1;
+  for (uint32_t d = 0; d < desc.dim && d < kMaxDims; ++d) {
+    numel *= static_cast<size_t>(desc.sizes[d]);
+  }
+  return numel *
+      elementSize(static_cast<exec_aten::ScalarType>(desc.scalar_type));
+}
+
+Error layout_tensors(SlotHeader* header, size_t slot_bytes) {
+  ET_CHECK_OR_RETURN_ERROR(
+      header->num_tensors <= kMaxTensors,
+      MemoryAllocationFailed,
+      "%" PRIu32 " tensors, at most %zu are supported",
+      header->num_tensors,
+      kMaxTensors);
+  size_t offset = kSlotDataOffset;
+  for (uint32_t i = 0; i < header->num_tensors; ++i) {
+    TensorDesc& desc = header->tensors[i];
+    desc.offset = offset;
+    desc.nbytes = tensor_nbytes(desc);
+    offset += (desc.nbytes + kSlotAlignment - 1) / kSlotAlignment *
+        kSlotAlignment;
+  }
+  ET_CHECK_OR_RETURN_ERROR(
+      offset <= slot_bytes,
+      MemoryAllocationFailed,
+      "Tensors take %zu bytes, slots have %zu",
+      offset,
+      slot_bytes);
+  return Error::Ok;
+}
+
+Error validate_header(const SlotHeader& header, size_t slot_bytes) {
+  ET_CHECK_OR_RETURN_ERROR(
+      header.num_tensors <= kMaxTensors,
+      InvalidArgument,
+      "Too many tensors: %" PRIu32,
+      header.num_tensors);
+  for (uint32_t i = 0; i < header.num_tensors; ++i) {
+    const TensorDesc& desc = header.tensors[i];
+    ET_CHECK_OR_RETURN_ERROR(
+        desc.dim <= kMaxDims &&
+            isValid(static_cast<exec_aten::ScalarType>(desc.scalar_type)),
+        InvalidArgument,
+        "Tensor %" PRIu32 " has an invalid dtype or dim",
+        i);
+    for (uint32_t d = 0; d < desc.dim; ++d) {
+      ET_CHECK_OR_RETURN_ERROR(
+          desc.sizes[d] >= 0,
+          InvalidArgument,
+          "Tensor %" PRIu32 " has a negative size",
+          i);
+    }
+    ET_CHECK_OR_RETURN_ERROR(
+        desc.offset >= kSlotDataOffset && desc.offset <= slot_bytes &&
+            desc.nbytes <= slot_bytes - desc.offset &&
+            desc.nbytes == tensor_nbytes(desc),
+        InvalidArgument,
+        "Tensor %" PRIu32 " is out of bounds of the slot",
+        i);
+  }
+  return Error::Ok;
+}
+
+Result<SlotRing> SlotRing::create(uint32_t num_slots, size_t slot_bytes) {
+  int fd = ::memfd_create("executorch_slots", MFD_CLOEXEC);
+  ET_CHECK_OR_RETURN_ERROR(
+      fd >= 0,
+      NotSupported,
+      "memfd_create failed: %s (%d)",
+      ::strerror(errno),
+      errno);
+  const size_t size = static_cast<size_t>(num_slots) * slot_bytes;
+  if (::ftruncate(fd, static_cast<off_t>(size)) < 0) {
+    ET_LOG(
+        Error,
+        "Failed to allocate %u slots of %zu bytes: %s (%d)",
+        num_slots,
+        slot_bytes,
+        ::strerror(errno),
+        errno);
+    ::close(fd);
+    return Error::MemoryAllocationFailed;
+  }
+  return attach(fd, num_slots, slot_bytes);
+}
+
+Result<SlotRing>
+SlotRing::attach(int fd, uint32_t num_slots, size_t slot_bytes) {
+  const size_t size = static_cast<size_t>(num_slots) * slot_bytes;
+  struct stat st;
+  if (num_slots == 0 || slot_bytes < kSlotDataOffset || ::fstat(fd, &st) < 0 ||
+      static_cast<size_t>(st.st_size) < size) {
+    ET_LOG(Error, "fd %d is too small for %u slots", fd, num_slots);
+    ::close(fd);
+    return Error::InvalidArgument;
+  }
+  void* data =
+      ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  if (data == MAP_FAILED) {
+    ET_LOG(Error, "Failed to map slots: %s (%d)", ::strerror(errno), errno);
+    ::close(fd);
+    return Error::AccessFailed;
+  }
+  return SlotRing(static_cast<uint8_t*>(data), num_slots, slot_bytes, fd);
+}
+
+SlotRing::SlotRing(SlotRing&& rhs) noexcept
+    : data_(rhs.data_),
+      num_slots_(rhs.num_slots_),
+      slot_bytes_(rhs.slot_bytes_),
+      fd_(rhs.fd_) {
+  rhs.data_ = nullptr;
+  rhs.num_slots_ = 0;
+  rhs.fd_ = -1;
+}
+
+SlotRing::~SlotRing() {
+  if (data_ != nullptr) {
+    ::munmap(data_, static_cast<size_t>(num_slots_) * slot_bytes_);
+  }
+  if (fd_ >= 0) {
+    ::close(fd_);
+  }
+}
+
+Error send_message(int socket, const void* message, size_t size, int fd) {
+  const uint8_t* bytes = static_cast<const uint8_t*>(message);
+  size_t sent = 0;
+  while (sent < size) {
+    struct iovec iov = {const_cast<uint8_t*>(bytes + sent), size - sent};
+    struct msghdr msg = {};
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    alignas(struct cmsghdr) char control[CMSG_SPACE(sizeof(int))];
+    // The descriptor goes with the first byte.
+    if (fd >= 0 && sent == 0) {
+      msg.msg_control = control;
+      msg.msg_controllen = sizeof(control);
+      struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+      cmsg->cmsg_level = SOL_SOCKET;
+      cmsg->cmsg_type = SCM_RIGHTS;
+      cmsg->cmsg_len = CMSG_LEN(sizeof(int));
+      std::memcpy(CMSG_DATA(cmsg), &fd, sizeof(int));
+    }
+    ssize_t n = ::sendmsg(socket, &msg, MSG_NOSIGNAL);
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    ET_CHECK_OR_RETURN_ERROR(
+        n > 0,
+        AccessFailed,
+        "sendmsg failed: %s (%d)",
+        ::strerror(errno),
+        errno);
+    sent += static_cast<size_t>(n);
+  }
+  return Error::Ok;
+}
+
+Result<bool> recv_message(int socket, void* message, size_t size, int* fd) {
+  if (fd != nullptr) {
+    *fd = -1;
+  }
+  uint8_t* bytes = static_cast<uint8_t*>(message);
+  size_t received = 0;
+  while (received < size) {
+    struct iovec iov = {bytes + received, size - received};
+    struct msghdr msg = {};
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    alignas(struct cmsghdr) char control[CMSG_SPACE(sizeof(int))];
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+    ssize_t n = ::recvmsg(socket, &msg, MSG_CMSG_CLOEXEC);
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    if (n == 0 && received == 0) {
+      return false;
+    }
+    ET_CHECK_OR_RETURN_ERROR(
+        n > 0,
+        AccessFailed,
+        "recvmsg failed: %s",
+        n == 0 ? "connection closed mid-message" : ::strerror(errno));
+    for (struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg != nullptr;
+         cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+      if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_RIGHTS) {
+        int received_fd;
+        std::memcpy(&received_fd, CMSG_DATA(cmsg), sizeof(int));
+        if (fd != nullptr && *fd < 0) {
+          *fd = received_fd;
+        } else {
+          // Unexpected descriptors would leak otherwise.
+          ::close(received_fd);
+        }
+      }
+    }
+    received += static_cast<size_t>(n);
+  }
+  return true;
+}
+
+} // namespace server
+} // namespace executor
+} // namespace torch
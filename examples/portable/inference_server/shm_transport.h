@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+/**
+ * @file
+ *
+ * The protocol between inference_server and its clients. Tensors never go
+ * through the socket: each client shares a memfd with the server, split into
+ * a ring of fixed-size slots. The client writes the inputs of a request into
+ * a free slot and sends the slot index over the Unix domain socket. The
+ * server runs the model on the inputs in place, writes the outputs into the
+ * same slot, and sends the index back.
+ *
+ * A slot starts with a SlotHeader that describes its tensors, followed by
+ * their data at kSlotAlignment-aligned offsets.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <executorch/runtime/core/error.h>
+#include <executorch/runtime/core/exec_aten/exec_aten.h>
+#include <executorch/runtime/core/result.h>
+
+namespace torch {
+namespace executor {
+namespace server {
+
+constexpr uint32_t kProtocolMagic = 0x56535445; // "ETSV"
+constexpr size_t kMaxTensors = 16;
+constexpr size_t kMaxDims = 8;
+constexpr size_t kSlotAlignment = 64;
+
+/// Describes a contiguous tensor in a slot.
+struct TensorDesc {
+  int32_t scalar_type;
+  uint32_t dim;
+  int32_t sizes[kMaxDims];
+  /// Offset of the data from the start of the slot.
+  uint64_t offset;
+  uint64_t nbytes;
+};
+
+/// The start of every slot.
+struct SlotHeader {
+  uint32_t num_tensors;
+  TensorDesc tensors[kMaxTensors];
+};
+
+/// Offset of the first tensor data in a slot.
+constexpr size_t kSlotDataOffset =
+    (sizeof(SlotHeader) + kSlotAlignment - 1) / kSlotAlignment *
+    kSlotAlignment;
+
+/// Sent by the client once, with the memfd of its slots attached.
+struct HelloRequest {
+  uint32_t magic;
+  uint32_t num_slots;
+  uint64_t slot_bytes;
+};
+
+/// The server's answer to HelloRequest. On success, describes the inputs the
+/// method expects, with offsets laid out for a slot.
+struct HelloResponse {
+  int32_t error;
+  SlotHeader inputs;
+};
+
+/// A request whose inputs are in the slot. The response reuses the slot.
+struct RequestMessage {
+  uint32_t slot;
+};
+
+struct ResponseMessage {
+  uint32_t slot;
+  int32_t error;
+};
+
+/**
+ * Lays out tensors one after the other in a slot, from kSlotDataOffset.
+ *
+ * @returns Error::MemoryAllocationFailed if they do not fit in slot_bytes.
+ */
+__ET_NODISCARD Error layout_tensors(SlotHeader* header, size_t slot_bytes);
+
+/**
+ * Checks that the tensors described by a header are in bounds of a slot and
+ * have consistent sizes. The header must be a private copy, since the peer
+ * can modify the shared one at any time.
+ */
+__ET_NODISCARD Error
+validate_header(const SlotHeader& header, size_t slot_bytes);
+
+/// Returns the number of bytes of a contiguous tensor.
+size_t tensor_nbytes(const TensorDesc& desc);
+
+/**
+ * A memfd mapped read-write, holding the slots of a connection.
+ */
+class SlotRing final {
+ public:
+  /// Creates a new memfd with room for num_slots slots.
+  static Result<SlotRing> create(uint32_t num_slots, size_t slot_bytes);
+
+  /// Maps a memfd received from the peer. Takes ownership of fd.
+  static Result<SlotRing>
+  attach(int fd, uint32_t num_slots, size_t slot_bytes);
+
+  SlotRing(SlotRing&& rhs) noexcept;
+  ~SlotRing();
+
+  SlotRing(const SlotRing&) = delete;
+  SlotRing& operator=(const SlotRing&) = delete;
+  SlotRing& operator=(SlotRing&&) = delete;
+
+  uint8_t* slot(uint32_t index) const {
+    return data_ + static_cast<size_t>(index) * slot_bytes_;
+  }
+
+  uint32_t num_slots() const {
+    return num_slots_;
+  }
+
+  size_t slot_bytes() const {
+    return slot_bytes_;
+  }
+
+  int fd() const {
+    return fd_;
+  }
+
+ private:
+  SlotRing(uint8_t* data, uint32_t num_slots, size_t slot_bytes, int fd)
+      : data_(data), num_slots_(num_slots), slot_bytes_(slot_bytes), fd_(fd) {}
+
+  uint8_t* data_;
+  uint32_t num_slots_;
+  size_t slot_bytes_;
+  int fd_;
+};
+
+/**
+ * Sends a fixed-size message, optionally with a file descriptor attached.
+ */
+__ET_NODISCARD Error
+send_message(int socket, const void* message, size_t size, int fd = -1);
+
+/**
+ * Receives a fixed-size message. If fd is not null, also receives a file
+ * descriptor, or -1 if none was attached.
+ *
+ * @returns true if a message was received, false if the peer closed the
+ *     connection cleanly, or an error.
+ */
+Result<bool>
+recv_message(int socket, void* message, size_t size, int* fd = nullptr);
+
+} // namespace server
+} // namespace executor
+} // namespace torch
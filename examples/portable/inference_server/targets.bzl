@@ -0,0 +1,62 @@
+load("@fbsource//xplat/executorch/build:runtime_wrapper.bzl", "runtime")
+
+def define_common_targets():
+    """Defines targets that should be shared between fbcode and xplat.
+
+    The directory containing this targets.bzl file should also contain both
+    TARGETS and BUCK files that call this function.
+    """
+
+    # The protocol shared by the server and its clients.
+    runtime.cxx_library(
+        name = "shm_transport",
+        srcs = [
+            "shm_transport.cpp",
+        ],
+        exported_headers = [
+            "shm_transport.h",
+        ],
+        visibility = [
+            "//executorch/examples/...",
+        ],
+        exported_deps = [
+            "//executorch/runtime/core:core",
+            "//executorch/runtime/core/exec_aten:lib",
+        ],
+        deps = [
+            "//executorch/runtime/core/exec_aten/util:scalar_type_util",
+            "//executorch/runtime/platform:platform",
+        ],
+    )
+
+    # Serves a method of a model over a Unix domain socket, with the tensors
+    # in shared memory.
+    runtime.cxx_binary(
+        name = "inference_server",
+        srcs = [
+            "inference_server.cpp",
+        ],
+        deps = [
+            ":shm_transport",
+            "//executorch/extension/module:module",
+            "//executorch/kernels/portable:generated_lib",
+        ],
+        external_deps = [
+            "gflags",
+        ],
+    )
+
+    # Measures the throughput and latency of inference_server.
+    runtime.cxx_binary(
+        name = "inference_client",
+        srcs = [
+            "inference_client.cpp",
+        ],
+        deps = [
+            ":shm_transport",
+            "//executorch/runtime/platform:platform",
+        ],
+        external_deps = [
+            "gflags",
+        ],
+    )
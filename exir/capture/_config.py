@@ -79,3 +79,17 @@ class ExecutorchBackendConfig:
     # If set to true, view_copy operations will be converted to lightweight
     # view operations in the ET runtime
     remove_view_copy: bool = True
+
+    # If set to true, mutable buffers whose new value can be computed directly
+    # into the buffer's storage (e.g. KV cache updates through index_put) share
+    # memory with that value, and no copy_ is inserted to write them back.
+    # Experimental, so off by default.
+    alias_mutable_buffers: bool = False
+
+    # If set, the mutable buffers of all methods (e.g. the KV cache of separate
+    # prefill and decode methods) are placed in this memory-planned buffer id,
+    # at the same offset in every method that uses them. Buffers are matched by
+    # fully qualified name. The runtime can then back this id with a single
+    # allocation for all methods, so that the state is shared between them.
+    # The memory planning pass must not use this id for anything else.
+    shared_mutable_buffer_mem_id: Optional[int] = None
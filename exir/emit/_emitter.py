@@ -1528,5 +1528,8 @@ class _TopLevelEmitter(_Emitter):
             non_const_buffer_sizes=typing.cast(
                 List[int], self.module.meta["non_const_buffer_sizes"]
             ),
+            shared_non_const_buffer_ids=self.module.meta.get(
+                "shared_non_const_buffer_ids"
+            ),
             container_meta_type=self.container_meta_type,
         )
@@ -1451,6 +1451,74 @@ class TestEmit(unittest.TestCase):
         self.assertEqual(executorch_module(torch.zeros(1))[0], torch.zeros(1))
         self.assertEqual(executorch_module(torch.zeros(1))[0], torch.zeros(1) + 1)
 
+    def test_mutable_buffers_aliased(self) -> None:
+        def count_copies(gm: torch.fx.GraphModule) -> int:
+            return sum(
+                (
+                    node.target == torch.ops.aten.copy_.default
+                    or node.target == exir_ops.edge.aten.copy_.default
+                    or node.target == torch.ops.aten.copy.out
+                )
+                for node in gm.graph.nodes
+            )
+
+        class KVCacheModule(torch.nn.Module):
+            def __init__(self):
+                super().__init__()
+                self.register_buffer("cache", torch.zeros(4, 2))
+
+            def forward(self, pos, val):
+                self.cache.index_put_((pos,), val)
+                return self.cache.sum(dim=0)
+
+        inputs = (torch.tensor([0]), torch.ones(1, 2))
+        for alias_mutable_buffers, alloc_graph_output in [
+            (True, True),
+            (True, False),
+            (False, True),
+        ]:
+            model = to_edge(export(KVCacheModule(), inputs)).to_executorch(
+                config=ExecutorchBackendConfig(
+                    memory_planning_pass=MemoryPlanningPass(
+                        "greedy", alloc_graph_output=alloc_graph_output
+                    ),
+                    alias_mutable_buffers=alias_mutable_buffers,
+                )
+            )
+            self.assertEqual(
+                count_copies(model.exported_program().graph_module),
+                0 if alias_mutable_buffers else 1,
+            )
+
+            # The buffer and the index_put output are planned at the same
+            # offset.
+            values = model.executorch_program.execution_plan[0].values
+            allocations = {
+                (
+                    value.val.allocation_info.memory_id,
+                    value.val.allocation_info.memory_offset_low,
+                )
+                for value in values
+                if isinstance(value.val, Tensor)
+                and value.val.allocation_info is not None
+                and value.val.sizes == [4, 2]
+            }
+            self.assertEqual(len(allocations) == 1, alias_mutable_buffers)
+
+            executorch_module = _load_for_executorch_from_buffer(model.buffer)
+            self.assertTrue(
+                torch.allclose(
+                    executorch_module((torch.tensor([0]), torch.ones(1, 2)))[0],
+                    torch.ones(2),
+                )
+            )
+            self.assertTrue(
+                torch.allclose(
+                    executorch_module((torch.tensor([1]), torch.ones(1, 2) * 2))[0],
+                    torch.ones(2) * 3,
+                )
+            )
+
     def test_mutable_buffers_without_memplanned_inputs(self) -> None:
         def count_copies(gm: torch.fx.GraphModule) -> int:
             return sum(
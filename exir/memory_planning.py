@@ -212,12 +212,23 @@ class Verifier:
         }
         assert "output" in check_list, f"graph module has no output: {graph_module}"
 
+        # Values computed in place of a mutable buffer share its spec and are
+        # always planned, whatever alloc_graph_output says.
+        mutable_buffer_tensors = get_mutable_buffer_tensors(
+            graph_module.graph.nodes, self.graph_signature
+        )
         for nd in graph_module.graph.nodes:
             if nd.op in check_list:
-                if not (specs := get_node_tensor_specs(nd)):
-                    continue
                 if _is_mutable_buffer(nd, self.graph_signature):
                     continue
+                if not (
+                    specs := [
+                        spec
+                        for spec in get_node_tensor_specs(nd)
+                        if spec not in mutable_buffer_tensors
+                    ]
+                ):
+                    continue
                 assert len(specs) > 0, "Expect tensor specs"
                 allocated = any(
                     spec is None or spec.mem_offset is not None for spec in specs
@@ -336,6 +347,18 @@ def get_graph_input_tensors(
     return graph_input_tensors
 
 
+def get_mutable_buffer_tensors(
+    nodes: Iterable[Node], graph_signature: Optional[ExportGraphSignature] = None
+) -> Set[TensorSpec]:
+    mutable_buffer_tensors = set()
+    for node in nodes:
+        if _is_mutable_buffer(node, graph_signature):
+            for spec in get_node_tensor_specs(node):
+                mutable_buffer_tensors.add(spec)
+
+    return mutable_buffer_tensors
+
+
 def get_graph_output_tensors(nodes: Iterable[Node]) -> Set[TensorSpec]:
     graph_output_tensors = set()
     for node in nodes:
@@ -372,7 +395,10 @@ def collect_specs_from_nodes(  # noqa: C901
         get_graph_input_tensors(nodes, graph_signature) if ignore_graph_input else set()
     )
     graph_output_tensors: Set[TensorSpec] = (
-        get_graph_output_tensors(nodes) if ignore_graph_output else set()
+        get_graph_output_tensors(nodes)
+        - get_mutable_buffer_tensors(nodes, graph_signature)
+        if ignore_graph_output
+        else set()
     )
 
     for node in nodes:
@@ -649,6 +675,129 @@ def naive(
     return bufsizes
 
 
+def _first_fit_offset(size: int, base: int, busy: List[Tuple[int, int]]) -> int:
+    r"""
+    Return the lowest offset at or above `base` where `size` bytes fit without
+    overlapping any of the `busy` [start, end) ranges, which must be sorted by
+    start.
+    """
+    offset = base
+    for start, end in busy:
+        if offset + size <= start:
+            break
+        offset = max(offset, end)
+    return offset
+
+
+@register_algo
+def greedy_by_size(
+    graph_module: torch.fx.GraphModule,
+    alignment: int,
+    graph_signature: Optional[ExportGraphSignature] = None,
+    alloc_graph_input: bool = True,
+    alloc_graph_output: bool = True,
+) -> List[int]:
+    r"""
+    Assign a byte offset to each tensor directly from the tensor lifetimes,
+    instead of grouping tensors into shared objects like `greedy` does.
+
+    Tensors are placed from largest to smallest. Each one goes to the lowest
+    offset where it does not overlap the storage of any already placed tensor
+    whose lifetime overlaps its own. This is the "greedy by size" strategy of
+    the TFLite and XNNPACK arena planners. Since a tensor only reserves its own
+    size rather than the size of the largest tenant of a shared object, the
+    planned buffers usually end up close to the peak of live bytes.
+    """
+    specs_by_mem_id: Dict[int, List[TensorSpec]] = defaultdict(list)
+    # Don't do assertion in collect_specs_from_nodes if we have already encountered
+    # and ignored some to_out_variant errors.
+    do_assertion = not getattr(graph_module, "encounter_to_out_var_failure", False)
+    for spec in collect_specs_from_nodes(
+        graph_module.graph.nodes,
+        graph_signature,
+        do_assertion=do_assertion,
+        ignore_graph_input=not alloc_graph_input,
+        ignore_graph_output=not alloc_graph_output,
+    ):
+        if spec.mem_id is None:
+            spec.mem_id = 1
+        spec.realign(alignment)
+        specs_by_mem_id[spec.mem_id].append(spec)
+
+    # Memory already used by an enclosing graph, for control flow submodules.
+    input_bufsizes = getattr(graph_module, "input_mem_buffer_sizes", None) or []
+    total_sizes = list(input_bufsizes) or [0, 0]
+    for mem_id, specs in specs_by_mem_id.items():
+        if mem_id >= len(total_sizes):
+            total_sizes.extend([0] * (mem_id - len(total_sizes) + 1))
+        base = input_bufsizes[mem_id] if mem_id < len(input_bufsizes) else 0
+        placed: List[TensorSpec] = []
+        for spec in sorted(
+            specs, key=lambda s: (-s.allocated_memory, s.lifetime[0], s.lifetime[1])
+        ):
+            busy = sorted(
+                (other.mem_offset, other.mem_offset + other.allocated_memory)
+                for other in placed
+                if Verifier.lifetime_overlap(spec, other)
+            )
+            spec.mem_offset = _first_fit_offset(spec.allocated_memory, base, busy)
+            placed.append(spec)
+            total_sizes[mem_id] = max(
+                total_sizes[mem_id], spec.mem_offset + spec.allocated_memory
+            )
+
+    if logging.getLogger().isEnabledFor(logging.DEBUG):
+        lower_bounds = compute_peak_live_bytes(
+            graph_module, graph_signature, alloc_graph_input, alloc_graph_output
+        )
+        for mem_id, peak in lower_bounds.items():
+            logging.debug(
+                f"greedy_by_size planned {total_sizes[mem_id]} bytes for mem_id "
+                f"{mem_id}, peak of live bytes is {peak}"
+            )
+    logging.debug(f"greedy_by_size algorithm returns bufsizes: {total_sizes}")
+    return total_sizes
+
+
+def compute_peak_live_bytes(
+    graph_module: torch.fx.GraphModule,
+    graph_signature: Optional[ExportGraphSignature] = None,
+    alloc_graph_input: bool = True,
+    alloc_graph_output: bool = True,
+) -> Dict[int, int]:
+    r"""
+    Return, for each mem_id, the largest number of bytes used by tensors that
+    are alive at the same time. No memory plan can be smaller than this, so it
+    is the lower bound to compare planned buffer sizes against.
+
+    Must run after the memory planning algorithm has set mem_id and the aligned
+    allocated_memory of each spec, and before insert_calls_to_free() changes
+    the node numbering that the lifetimes refer to.
+    """
+    # deltas[mem_id][node_idx] is the change of live bytes at node_idx.
+    deltas: Dict[int, Dict[int, int]] = defaultdict(lambda: defaultdict(int))
+    for spec in collect_specs_from_nodes(
+        graph_module.graph.nodes,
+        graph_signature,
+        do_assertion=False,
+        ignore_graph_input=not alloc_graph_input,
+        ignore_graph_output=not alloc_graph_output,
+    ):
+        mem_id = 1 if spec.mem_id is None else spec.mem_id
+        deltas[mem_id][spec.lifetime[0]] += spec.allocated_memory
+        deltas[mem_id][spec.lifetime[1] + 1] -= spec.allocated_memory
+
+    peaks = {}
+    for mem_id, mem_deltas in deltas.items():
+        live = 0
+        peak = 0
+        for node_idx in sorted(mem_deltas):
+            live += mem_deltas[node_idx]
+            peak = max(peak, live)
+        peaks[mem_id] = peak
+    return peaks
+
+
 def get_algo(algo_name: str) -> Callable[..., List[int]]:
     if algo_name not in REGISTERED_ALGOS:
         raise ExportError(
@@ -797,3 +946,134 @@ def apply_algo(
     graph_module.meta.update({"non_const_buffer_sizes": bufsizes})
 
     return bufsizes
+
+
+def _mutable_buffer_nodes(
+    graph_module: torch.fx.GraphModule, graph_signature: ExportGraphSignature
+) -> Iterable[Tuple[str, Node]]:
+    for node in graph_module.graph.nodes:
+        if _is_mutable_buffer(node, graph_signature):
+            yield graph_signature.inputs_to_buffers[node.target], node
+
+
+def mark_shared_mutable_buffers(
+    graph_module: torch.fx.GraphModule,
+    graph_signature: ExportGraphSignature,
+    mem_id: int,
+) -> None:
+    """
+    Place the mutable buffers of graph_module in the memory-planned buffer
+    mem_id, which is then left to them. Must run before memory planning, and be
+    followed by plan_shared_mutable_buffers() once every method is planned.
+    """
+    for _, node in _mutable_buffer_nodes(graph_module, graph_signature):
+        for spec in get_node_tensor_specs(node):
+            spec.mem_id = mem_id
+
+
+def _check_mem_id_only_has_mutable_buffers(
+    name: str,
+    graph_module: torch.fx.GraphModule,
+    graph_signature: ExportGraphSignature,
+    mem_id: int,
+) -> None:
+    """
+    Raise if memory planning put anything but the mutable buffers in mem_id,
+    e.g. because mem_id is also used by the memory planning algorithm. The
+    shared layout would overlap these tensors with the buffers.
+    """
+    buffer_specs = {
+        id(spec)
+        for _, node in _mutable_buffer_nodes(graph_module, graph_signature)
+        for spec in get_node_tensor_specs(node)
+    }
+    for module in graph_module.modules():
+        if not isinstance(module, torch.fx.GraphModule):
+            continue
+        for node in module.graph.nodes:
+            for spec in get_node_tensor_specs(node):
+                if spec.mem_id == mem_id and id(spec) not in buffer_specs:
+                    raise ExportError(
+                        ExportErrorType.VIOLATION_OF_SPEC,
+                        f"Node {node.name} of method {name} was planned in "
+                        f"mem_id {mem_id}, which is reserved for the shared "
+                        "mutable buffers. Use a mem_id that memory planning "
+                        "does not use.",
+                    )
+
+
+def plan_shared_mutable_buffers(
+    methods: Dict[str, Tuple[torch.fx.GraphModule, ExportGraphSignature]],
+    mem_id: int,
+) -> int:
+    """
+    Lay out the mutable buffers of all methods of a program in the memory-planned
+    buffer mem_id, so that each buffer has the same offset in every method that
+    uses it. Buffers are matched by fully qualified name. The runtime can then
+    back mem_id with a single allocation for all of these methods, and state
+    like a KV cache carries over between e.g. a prefill and a decode method
+    without any copy.
+
+    This replaces the per-method offsets that memory planning gave the buffers
+    marked by mark_shared_mutable_buffers(). Returns the size of the shared
+    buffer.
+    """
+    for name, (graph_module, graph_signature) in methods.items():
+        _check_mem_id_only_has_mutable_buffers(
+            name, graph_module, graph_signature, mem_id
+        )
+
+    offsets: Dict[str, int] = {}
+    first_specs: Dict[str, TensorSpec] = {}
+    total_size = 0
+    for name, (graph_module, graph_signature) in methods.items():
+        for fqn, node in _mutable_buffer_nodes(graph_module, graph_signature):
+            spec = node.meta["spec"]
+            if fqn not in first_specs:
+                if spec.shape_dynamism == TensorShapeDynamism.DYNAMIC_UNBOUND:
+                    raise ExportError(
+                        ExportErrorType.NOT_SUPPORTED,
+                        f"Mutable buffer {fqn} of method {name} has an unbound "
+                        "dynamic shape and cannot be shared between methods",
+                    )
+                first_specs[fqn] = spec
+                offsets[fqn] = total_size
+                total_size += spec.allocated_memory
+            elif (
+                first_specs[fqn].dtype != spec.dtype
+                or first_specs[fqn].shape != spec.shape
+            ):
+                raise ExportError(
+                    ExportErrorType.VIOLATION_OF_SPEC,
+                    f"Mutable buffer {fqn} is {spec.dtype}{spec.shape} in method "
+                    f"{name} but {first_specs[fqn].dtype}{first_specs[fqn].shape} "
+                    "in another method",
+                )
+
+    mem_obj_ids = {fqn: idx for idx, fqn in enumerate(offsets)}
+    for graph_module, graph_signature in methods.values():
+        has_shared_buffer = False
+        for fqn, node in _mutable_buffer_nodes(graph_module, graph_signature):
+            has_shared_buffer = True
+            spec = node.meta["spec"]
+            internal_assert(
+                spec.mem_id == mem_id,
+                f"Mutable buffer {fqn} was planned in mem_id {spec.mem_id}, "
+                f"expected {mem_id}",
+            )
+            spec.mem_obj_id = mem_obj_ids[fqn]
+            spec.mem_offset = offsets[fqn]
+        if not has_shared_buffer:
+            continue
+        bufsizes = list(graph_module.meta["non_const_buffer_sizes"])
+        if len(bufsizes) <= mem_id:
+            bufsizes.extend([0] * (mem_id - len(bufsizes) + 1))
+        bufsizes[mem_id] = total_size
+        graph_module.meta["non_const_buffer_sizes"] = bufsizes
+        graph_module.meta["shared_non_const_buffer_ids"] = [mem_id]
+
+    logging.debug(
+        f"Shared {len(offsets)} mutable buffers between methods in mem_id "
+        f"{mem_id}, using {total_size} bytes"
+    )
+    return total_size
@@ -39,6 +39,7 @@ from executorch.exir.passes.executorch_prim_ops_registry import _EXECUTORCH_SYM_
 from executorch.exir.passes.insert_write_back_for_buffers_pass import (
     insert_write_back_for_buffers_pass,
 )
+from executorch.exir.passes.memory_aware_schedule_pass import MemoryAwareSchedulePass
 from executorch.exir.passes.memory_format_ops_pass import MemoryFormatOpsPass
 from executorch.exir.passes.memory_planning_pass import MemoryPlanningPass
 from executorch.exir.passes.normalize_transpose_pass import NormalizeTransposePass
@@ -67,6 +68,7 @@ __all__ = [
     "EdgeToBackendOpsPass",
     "MemoryFormatOpsPass",
     "MemoryPlanningPass",
+    "MemoryAwareSchedulePass",
     "HintBasedSymShapeEvalPass",
     "insert_write_back_for_buffers_pass",
 ]
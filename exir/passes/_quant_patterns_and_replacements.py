@@ -46,11 +46,36 @@ quantized_decomposed_lib.define(
 )
 
 
+# Weights stored as 8-bit floats are scaled like quantized ones, but have no
+# zero points: the runtime kernels decode them to float.
+FLOAT8_DTYPES = [torch.float8_e4m3fn, torch.float8_e5m2]
+
+
+def dequantize_weight_with_scales(
+    weight: torch.Tensor, weight_scales: torch.Tensor, dtype: torch.dtype
+) -> torch.Tensor:
+    """
+    Dequantizes a 2D weight without zero points, e.g. int8 or float8, with
+    [rows] or [rows, groups] scales. The last group of a row may be shorter,
+    like in the runtime kernels.
+    """
+    if weight_scales.dim() == 1:
+        weight_scales = weight_scales.unsqueeze(-1)
+    num_groups = weight_scales.size(1)
+    group_size = (weight.size(1) + num_groups - 1) // num_groups
+    scales = weight_scales.to(torch.float32).repeat_interleave(group_size, dim=1)
+    return (weight.to(torch.float32) * scales[:, : weight.size(1)]).to(dtype)
+
+
 def embedding_weight_checks(weight, weight_scales, weight_zero_points):
     assert weight.dtype in [
         torch.int8,
         torch.uint8,
-    ], f"Expecting weights to be of dtype in [torch.int8, torch.uint8], but got {weight.dtype}"
+        *FLOAT8_DTYPES,
+    ], f"Expecting weights to be of dtype in [torch.int8, torch.uint8, torch.float8_e4m3fn, torch.float8_e5m2], but got {weight.dtype}"
+    assert (
+        weight.dtype not in FLOAT8_DTYPES or weight_zero_points is None
+    ), "Expecting float8 weights to have no weight_zero_points"
     assert (
         weight.dim() == 2
     ), f"Expecting weight tensor to have dim()==2, but found {weight.dim()}"
@@ -87,6 +112,11 @@ def embedding_byte(
     indices: torch.Tensor,
 ) -> torch.Tensor:
     embedding_weight_checks(weight, weight_scales, weight_zero_points)
+    if weight.dtype in FLOAT8_DTYPES:
+        weight = dequantize_weight_with_scales(
+            weight, weight_scales, weight_scales.dtype
+        )
+        return torch.ops.aten.embedding.default(weight, indices)
     group_size = weight.size(1) // (
         weight_scales.size(1) if weight_scales.dim() == 2 else 1
     )
@@ -134,6 +164,11 @@ def embedding_byte_dtype(
     dtype: Optional[torch.dtype],
 ) -> torch.Tensor:
     embedding_weight_checks(weight, weight_scales, weight_zero_points)
+    if weight.dtype in FLOAT8_DTYPES:
+        weight = dequantize_weight_with_scales(
+            weight, weight_scales, dtype or weight_scales.dtype
+        )
+        return torch.ops.aten.embedding.default(weight, indices)
     group_size = weight.size(1) // (
         weight_scales.size(1) if weight_scales.dim() == 2 else 1
     )
@@ -304,6 +339,47 @@ quantized_decomposed_lib.define(
     "mixed_mm(Tensor input, Tensor weight, Tensor weight_scales, Tensor? weight_zero_points) -> Tensor",
 )
 
+quantized_decomposed_lib.define(
+    "mixed_linear(Tensor input, Tensor weight, Tensor weight_scales, Tensor? weight_zero_points, "
+    "ScalarType? dtype=None) -> Tensor",
+)
+
+quantized_decomposed_lib.define(
+    "mixed_linear.out(Tensor input, Tensor weight, Tensor weight_scales, Tensor? weight_zero_points, "
+    "ScalarType? dtype=None, *, Tensor(a!) out) -> Tensor(a!)",
+)
+
+
+@impl(quantized_decomposed_lib, "mixed_linear", "CompositeExplicitAutograd")
+def mixed_linear(
+    input: torch.Tensor,
+    weight: torch.Tensor,
+    weight_scales: torch.Tensor,
+    weight_zero_points: Optional[torch.Tensor],
+    dtype: Optional[torch.dtype] = None,
+) -> torch.Tensor:
+    assert weight.dtype in [
+        torch.int8,
+        *FLOAT8_DTYPES,
+    ], f"Expecting weights to be of dtype in [torch.int8, torch.float8_e4m3fn, torch.float8_e5m2], but got {weight.dtype}"
+    assert (
+        weight_zero_points is None
+    ), "Expecting weight_zero_points to be None, zero points are not supported"
+    weight = dequantize_weight_with_scales(weight, weight_scales, input.dtype)
+    return torch.ops.aten.linear.default(input, weight).to(dtype or input.dtype)
+
+
+@impl_abstract("quantized_decomposed::mixed_linear.out")
+def mixed_linear_out_meta(
+    input: torch.Tensor,
+    weight: torch.Tensor,
+    weight_scales: torch.Tensor,
+    weight_zero_points: Optional[torch.Tensor],
+    dtype: Optional[torch.dtype],
+    out: torch.Tensor,
+) -> torch.Tensor:
+    return mixed_linear(input, weight, weight_scales, weight_zero_points, dtype)
+
 quantized_decomposed_lib.define(
     "add(Tensor a, float a_scale, int a_zero_point, int a_quant_min, int a_quant_max, Tensor b, float b_scale, int b_zero_point, int b_quant_min, int b_quant_max, float out_scale, int out_zero_point, int out_quant_min, int out_quant_max) -> Tensor qc"
 )
@@ -4,9 +4,12 @@
 # This source code is licensed under the BSD-style license found in the
 # LICENSE file in the root directory of this source tree.
 
+import operator
 from typing import Dict, List, Optional, Tuple
 
 import torch
+from executorch.exir import memory
+from executorch.exir.dialects._ops import ops as exir_ops
 
 from torch.export.exported_program import (
     ExportedProgram,
@@ -18,14 +21,129 @@ from torch.export.exported_program import (
 from torch.utils import _pytree as pytree
 
 
+# Meta key set on a node that computes the new value of a mutable buffer in
+# place of a write back copy_. The value is the target of the buffer's
+# placeholder, and SpecPropPass makes both nodes share one TensorSpec so the
+# memory planner gives them the same storage.
+ALIASED_BUFFER_KEY = "aliased_buffer"
+
+# Ops whose kernels still produce the right result when their out tensor is
+# the same memory as their first argument. The scatter kernels skip copying
+# self into out in that case, which is what makes KV cache updates zero-copy.
+_OUT_MAY_ALIAS_SELF = {
+    exir_ops.edge.aten.index_put.default,
+    exir_ops.edge.aten.slice_scatter.default,
+    exir_ops.edge.aten.select_scatter.default,
+    exir_ops.edge.aten.add.Tensor,
+    exir_ops.edge.aten.sub.Tensor,
+    exir_ops.edge.aten.mul.Tensor,
+}
+
+_VIEW_COPY_OPS = {
+    torch.ops.aten.view_copy.default,
+    exir_ops.edge.aten.view_copy.default,
+}
+
+# Ops whose output shares storage with their first argument, either already
+# or once ReplaceViewCopyWithViewPass turns view_copy into memory.view.
+_VIEW_OPS = _VIEW_COPY_OPS | {memory.view}
+
+
+def storage_readers(node: torch.fx.Node) -> List[torch.fx.Node]:
+    """
+    The nodes that read the storage of `node`: its users, and transitively the
+    users of the views of it, since a view reads the storage of its base when
+    it is consumed rather than when it is created.
+    """
+    readers: List[torch.fx.Node] = []
+    seen = {node}
+    pending = [node]
+    while pending:
+        for user in pending.pop().users:
+            if user in seen:
+                continue
+            seen.add(user)
+            readers.append(user)
+            if (
+                user.op == "call_function"
+                and user.target in _VIEW_OPS
+                and user.args[0] in seen
+            ):
+                pending.append(user)
+    return readers
+
+
+def _can_alias_buffer(
+    gm: torch.fx.GraphModule,
+    buffer_node: torch.fx.Node,
+    value_node: torch.fx.Node,
+    outputs: List[torch.fx.Node],
+) -> bool:
+    """
+    Whether the new value of a mutable buffer can be computed directly into the
+    buffer's storage instead of being copied back at the end of the graph.
+    """
+    if value_node.op != "call_function" or value_node.target in _VIEW_COPY_OPS:
+        return False
+    # SpecPropPass would only give the buffer's spec to the getitem, not to the
+    # output of the op that actually writes the value.
+    if value_node.target == operator.getitem:
+        return False
+    # Returning the value twice (as a user output too) would hand the buffer's
+    # storage to the caller.
+    if sum(1 for out in outputs if out is value_node) != 1:
+        return False
+
+    buffer_val = buffer_node.meta.get("val")
+    value_val = value_node.meta.get("val")
+    if not isinstance(buffer_val, torch.Tensor) or not isinstance(
+        value_val, torch.Tensor
+    ):
+        return False
+    if (
+        buffer_val.dtype != value_val.dtype
+        or buffer_val.shape != value_val.shape
+        or not value_val.is_contiguous()
+    ):
+        return False
+
+    # Every other read of the old value, directly or through a view that will
+    # share the buffer's storage, must happen before it is overwritten.
+    readers = storage_readers(buffer_node)
+    position = {node: i for i, node in enumerate(gm.graph.nodes)}
+    for reader in readers:
+        if reader is not value_node and position[reader] > position[value_node]:
+            return False
+
+    if value_node in readers:
+        # The kernel reads the buffer while writing into it, which is only
+        # safe for the ops above, reading it as self and nowhere else.
+        aliases = {buffer_node} | {
+            r for r in readers if r.op == "call_function" and r.target in _VIEW_OPS
+        }
+        other_args = pytree.tree_flatten((value_node.args[1:], value_node.kwargs))[0]
+        return (
+            value_node.target in _OUT_MAY_ALIAS_SELF
+            and len(value_node.args) > 0
+            and value_node.args[0] is buffer_node
+            and not any(
+                isinstance(arg, torch.fx.Node) and arg in aliases
+                for arg in other_args
+            )
+        )
+    return True
+
+
 def _insert_copy(
     gm: torch.fx.GraphModule,
     mutated_outputs: List[Optional[str]],
     input_name_to_node: Dict[str, torch.fx.Node],
+    alias_mutable_buffers: bool = False,
 ):
     """
     Find the all the buffers and inputs that were mutated and insert copy_
-    operators to reflect mutations.
+    operators to reflect mutations. If alias_mutable_buffers is set, the copy is
+    skipped for buffers whose new value can be written to the buffer directly.
     """
     output_node = None
     for node in gm.graph.nodes:
@@ -52,6 +170,13 @@ def _insert_copy(
                 f"Could not find {mutated_node_name} in either buffer or input nodes"
             )
 
+        if alias_mutable_buffers and _can_alias_buffer(
+            gm, mutated_node, return_node, outputs
+        ):
+            return_node.meta[ALIASED_BUFFER_KEY] = mutated_node.target
+            buffer_output_nodes.append(return_node)
+            continue
+
         # insert copy
         with gm.graph.inserting_before(output_node):
             buffer_output = gm.graph.call_function(
@@ -71,6 +196,7 @@ def _insert_copy(
 
 def insert_write_back_for_buffers_pass(
     ep: ExportedProgram,
+    alias_mutable_buffers: bool = False,
 ) -> Tuple[torch.fx.GraphModule, ExportGraphSignature]:
     gm: torch.fx.GraphModule = ep.graph_module
     lifted_inputs: List[Optional[str]] = [
@@ -112,7 +238,9 @@ def insert_write_back_for_buffers_pass(
     ]
 
     # insert the copy ops and update the outputs
-    buffer_output_nodes = _insert_copy(gm, mutated_outputs, input_name_to_node)
+    buffer_output_nodes = _insert_copy(
+        gm, mutated_outputs, input_name_to_node, alias_mutable_buffers
+    )
     gm.graph.lint()
     gm.graph.eliminate_dead_code()
     gm.recompile()
@@ -0,0 +1,252 @@
+# Copyright (c) Meta Platforms, Inc. and affiliates.
+# All rights reserved.
+#
+# This source code is licensed under the BSD-style license found in the
+# LICENSE file in the root directory of this source tree.
+
+# pyre-strict
+
+import _operator
+import logging
+from typing import Dict, List, Optional, Sequence, Set
+
+import torch
+from executorch.exir.pass_base import PassBase, PassResult
+from executorch.exir.passes.insert_write_back_for_buffers_pass import (
+    ALIASED_BUFFER_KEY,
+    storage_readers,
+)
+from executorch.exir.tensor import TensorSpec
+from torch.fx import GraphModule, Node
+
+
+def _value_nbytes(val: object) -> int:
+    if isinstance(val, TensorSpec):
+        return 0 if val.const else val.nbytes()
+    if isinstance(val, torch.Tensor):
+        try:
+            return int(val.numel()) * val.element_size()
+        except Exception:
+            # Unbacked symbolic sizes have no hint to estimate with.
+            return 0
+    if isinstance(val, (list, tuple)):
+        return sum(_value_nbytes(v) for v in val)
+    return 0
+
+
+def _node_nbytes(node: Node) -> int:
+    """
+    Estimated number of bytes the node allocates for its output(s). Prefers the
+    TensorSpec when SpecPropPass has already run, otherwise falls back to the
+    fake tensor recorded during export.
+    """
+    if node.op != "call_function" or node.target == _operator.getitem:
+        return 0
+    if "spec" in node.meta:
+        return _value_nbytes(node.meta["spec"])
+    return _value_nbytes(node.meta.get("val"))
+
+
+def _storage_owner(node: Node) -> Node:
+    # getitem only unpacks one output of a multi-output op; the memory belongs
+    # to the op itself.
+    while node.op == "call_function" and node.target == _operator.getitem:
+        node = node.args[0]  # pyre-ignore[9]
+    return node
+
+
+def _mutated_inputs(node: Node) -> List[Node]:
+    """
+    The inputs that the node writes to, like the destination of a copy_, from
+    the alias annotations of the op schema.
+    """
+    schema = getattr(node.target, "_schema", None)
+    if node.op != "call_function" or schema is None:
+        return []
+    mutated = []
+    for i, arg in enumerate(schema.arguments):
+        if arg.alias_info is None or not arg.alias_info.is_write:
+            continue
+        value = node.args[i] if i < len(node.args) else node.kwargs.get(arg.name)
+        if isinstance(value, Node):
+            mutated.append(value)
+    return mutated
+
+
+def estimate_peak_live_bytes(nodes: Sequence[Node]) -> int:
+    r"""
+    Estimate the peak number of bytes held by operator outputs when the nodes
+    are executed in the given order. An output is live from the node producing
+    it to its last consumer, or to the end of the graph when it is a graph
+    output. Graph inputs and constants are excluded since their lifetime does
+    not depend on the order.
+    """
+    remaining_uses: Dict[Node, int] = {}
+    for node in nodes:
+        for inp in node.all_input_nodes:
+            owner = _storage_owner(inp)
+            remaining_uses[owner] = remaining_uses.get(owner, 0) + 1
+
+    live = 0
+    peak = 0
+    for node in nodes:
+        if node.op == "output":
+            break
+        live += _node_nbytes(node)
+        peak = max(peak, live)
+        for inp in node.all_input_nodes:
+            owner = _storage_owner(inp)
+            remaining_uses[owner] -= 1
+            if remaining_uses[owner] == 0:
+                live -= _node_nbytes(owner)
+    return peak
+
+
+class MemoryAwareSchedulePass(PassBase):
+    """
+    Reorders independent operators to reduce the peak number of live bytes,
+    before memory planning assigns lifetimes from the node order.
+
+    The order is built by greedy list scheduling: among the nodes whose inputs
+    are all available, pick the one that increases live memory the least, i.e.
+    its output size minus the size of the inputs it is the last consumer of.
+    This tends to finish one branch before starting the next and to run
+    consumers of large tensors early. Ties keep the original order, and the
+    new order is only applied when its estimated peak is strictly smaller.
+
+    Placeholders and get_attr nodes stay at the top of the graph, the output
+    node stays last, impure nodes keep their relative order, and writes into
+    the storage of a node (a copy_ into a mutable buffer, or a value computed
+    in place of one) keep their order relative to every read of that storage,
+    including reads through views.
+
+    Add it to ExecutorchBackendConfig.passes to run it ahead of memory
+    planning. After the pass runs, `peak_bytes_before` and `peak_bytes_after`
+    hold the estimates for the top level graph.
+    """
+
+    def __init__(self) -> None:
+        super().__init__()
+        self.peak_bytes_before: int = 0
+        self.peak_bytes_after: int = 0
+        self._root: Optional[GraphModule] = None
+
+    def _schedule(self, graph: torch.fx.Graph) -> Optional[List[Node]]:
+        nodes = list(graph.nodes)
+        position = {node: i for i, node in enumerate(nodes)}
+        fixed = [n for n in nodes if n.op in ("placeholder", "get_attr")]
+        output = [n for n in nodes if n.op == "output"]
+        fixed_set: Set[Node] = set(fixed)
+        to_schedule = [
+            n for n in nodes if n not in fixed_set and n.op != "output"
+        ]
+
+        # Dependencies inside the schedulable set, plus a chain through impure
+        # nodes so side effects are not reordered relative to each other.
+        preds: Dict[Node, Set[Node]] = {}
+        prev_impure: Optional[Node] = None
+        for node in to_schedule:
+            preds[node] = {
+                inp for inp in node.all_input_nodes if inp not in fixed_set
+            }
+            if node.is_impure():
+                if prev_impure is not None:
+                    preds[node].add(prev_impure)
+                prev_impure = node
+        # A write into the storage of a node, like the write back copy_ of a
+        # mutable buffer or a value computed into a buffer's storage, keeps its
+        # original order relative to every read of that storage: reads of the
+        # old value stay before it and reads of the new value stay after it.
+        # All of these edges follow the original order, so they add no cycle.
+        placeholders = {n.target: n for n in fixed if n.op == "placeholder"}
+        for node in to_schedule:
+            written = _mutated_inputs(node)
+            if ALIASED_BUFFER_KEY in node.meta:
+                written.append(placeholders[node.meta[ALIASED_BUFFER_KEY]])
+            for target in written:
+                for reader in storage_readers(target):
+                    if reader is node or reader not in preds:
+                        continue
+                    if position[reader] < position[node]:
+                        preds[node].add(reader)
+                    else:
+                        preds[reader].add(node)
+        succs: Dict[Node, List[Node]] = {n: [] for n in to_schedule}
+        for node, node_preds in preds.items():
+            for p in node_preds:
+                succs[p].append(node)
+
+        remaining_uses: Dict[Node, int] = {}
+        for node in to_schedule + output:
+            for inp in node.all_input_nodes:
+                owner = _storage_owner(inp)
+                remaining_uses[owner] = remaining_uses.get(owner, 0) + 1
+
+        def delta(node: Node) -> int:
+            freed = 0
+            counted: Set[Node] = set()
+            for inp in node.all_input_nodes:
+                owner = _storage_owner(inp)
+                if owner in counted:
+                    continue
+                counted.add(owner)
+                uses = sum(
+                    1 for i in node.all_input_nodes if _storage_owner(i) is owner
+                )
+                if remaining_uses[owner] == uses:
+                    freed += _node_nbytes(owner)
+            return _node_nbytes(node) - freed
+
+        num_waiting = {n: len(p) for n, p in preds.items()}
+        ready = [n for n in to_schedule if num_waiting[n] == 0]
+        order: List[Node] = []
+        while ready:
+            node = min(ready, key=lambda n: (delta(n), position[n]))
+            ready.remove(node)
+            order.append(node)
+            for inp in node.all_input_nodes:
+                remaining_uses[_storage_owner(inp)] -= 1
+            for s in succs[node]:
+                num_waiting[s] -= 1
+                if num_waiting[s] == 0:
+                    ready.append(s)
+
+        if len(order) != len(to_schedule):
+            # Cycle through the impure chain; should not happen on a valid graph.
+            return None
+        return fixed + order + output
+
+    def _reorder(self, graph_module: GraphModule) -> bool:
+        graph = graph_module.graph
+        before = estimate_peak_live_bytes(list(graph.nodes))
+        new_order = self._schedule(graph)
+        after = (
+            before if new_order is None else estimate_peak_live_bytes(new_order)
+        )
+        if graph_module is self._root:
+            self.peak_bytes_before = before
+            self.peak_bytes_after = min(before, after)
+        if new_order is None or after >= before:
+            return False
+
+        output_node = new_order[-1]
+        for node in new_order[:-1]:
+            output_node.prepend(node)
+        graph.lint()
+        graph_module.recompile()
+        return True
+
+    def call(self, graph_module: GraphModule) -> PassResult:
+        self._root = graph_module
+        modified = False
+        for subgm in graph_module.modules():
+            if not isinstance(subgm, GraphModule):
+                continue
+            modified |= self._reorder(subgm)
+
+        logging.info(
+            f"Memory aware scheduling: estimated peak activation memory "
+            f"{self.peak_bytes_before} -> {self.peak_bytes_after} bytes "
+            f"({self.peak_bytes_before - self.peak_bytes_after} bytes saved)"
+        )
+        return PassResult(graph_module, modified)
@@ -0,0 +1,269 @@
+# Copyright (c) Meta Platforms, Inc. and affiliates.
+# All rights reserved.
+#
+# This source code is licensed under the BSD-style license found in the
+# LICENSE file in the root directory of this source tree.
+
+from typing import Dict, Iterable, Optional, Tuple
+
+import torch
+from executorch.exir.dialects._ops import ops as exir_ops
+from executorch.exir.passes.constant_prop_pass import (
+    erase_constant_node,
+    get_constant_placeholder_dict,
+    get_fake_mode,
+    get_first_user_input,
+)
+from torch.export import ExportedProgram
+from torch.export.exported_program import InputKind, InputSpec, TensorArgument
+from torch.library import impl, impl_abstract, Library
+
+# Number of output features stored next to each other in the packed layout.
+# Must match kPanelWidth in kernels/optimized/cpu/op_linear_packed.cpp.
+PANEL_WIDTH = 8
+
+prepacked_lib = Library("prepacked", "DEF")
+
+prepacked_lib.define(
+    "linear(Tensor input, Tensor packed_weight, Tensor? bias, int out_features) -> Tensor",
+)
+
+prepacked_lib.define(
+    "linear.out(Tensor input, Tensor packed_weight, Tensor? bias, int out_features, "
+    "*, Tensor(a!) out) -> Tensor(a!)",
+)
+
+
+def pack_linear_weight(
+    weight: torch.Tensor, panel_width: int = PANEL_WIDTH
+) -> torch.Tensor:
+    """
+    Packs a [out_features, in_features] linear weight into panels of
+    `panel_width` output features, giving a tensor of shape
+    [ceil(out_features / panel_width), in_features, panel_width]. Each panel
+    holds, for every input feature, the weights of its output features next to
+    each other, which is the order a register blocked GEMM kernel reads them
+    in. The last panel is zero padded.
+    """
+    assert weight.dim() == 2, f"Expecting a 2D weight, but got {weight.dim()}D"
+    out_features, in_features = weight.shape
+    num_panels = (out_features + panel_width - 1) // panel_width
+    padded = weight.new_zeros(num_panels * panel_width, in_features)
+    padded[:out_features] = weight
+    return (
+        padded.reshape(num_panels, panel_width, in_features)
+        .permute(0, 2, 1)
+        .contiguous()
+    )
+
+
+def unpack_linear_weight(
+    packed_weight: torch.Tensor, out_features: int
+) -> torch.Tensor:
+    """Inverse of pack_linear_weight()."""
+    assert (
+        packed_weight.dim() == 3
+    ), f"Expecting a 3D packed weight, but got {packed_weight.dim()}D"
+    num_panels, in_features, panel_width = packed_weight.shape
+    return packed_weight.permute(0, 2, 1).reshape(
+        num_panels * panel_width, in_features
+    )[:out_features]
+
+
+@impl(prepacked_lib, "linear", "CompositeExplicitAutograd")
+def linear(
+    input: torch.Tensor,
+    packed_weight: torch.Tensor,
+    bias: Optional[torch.Tensor],
+    out_features: int,
+) -> torch.Tensor:
+    weight = unpack_linear_weight(packed_weight, out_features)
+    return torch.nn.functional.linear(input, weight, bias)
+
+
+@impl_abstract("prepacked::linear.out")
+def linear_out_meta(
+    input: torch.Tensor,
+    packed_weight: torch.Tensor,
+    bias: Optional[torch.Tensor],
+    out_features: int,
+    out: torch.Tensor,
+) -> torch.Tensor:
+    return linear(input, packed_weight, bias, out_features)
+
+
+def _get_linear_weight(
+    node: torch.fx.Node, const_node_to_tensor
+) -> Optional[torch.Tensor]:
+    """
+    Returns the [out_features, in_features] weight of a matmul operand that is
+    either a transposed constant or a constant in the transposed layout.
+    """
+    if (
+        node.op == "call_function"
+        and node.target == exir_ops.edge.aten.permute_copy.default
+        and list(node.args[1]) == [1, 0]
+        and node.args[0] in const_node_to_tensor
+    ):
+        return const_node_to_tensor[node.args[0]]
+    if node in const_node_to_tensor:
+        return const_node_to_tensor[node].t()
+    return None
+
+
+def get_linear_args(
+    node: torch.fx.Node, const_node_to_tensor
+) -> Optional[
+    Tuple[torch.fx.Node, torch.fx.Node, Optional[torch.fx.Node], torch.Tensor]
+]:
+    """
+    Matches a linear layer, i.e. an edge mm/addmm node whose weight operand is
+    a float32 constant, and returns its input, weight operand, bias and
+    [out_features, in_features] weight. Returns None for any other node.
+    """
+    if node.op != "call_function":
+        return None
+    if node.target == exir_ops.edge.aten.mm.default:
+        bias = None
+        input, weight_node = node.args
+    elif node.target == exir_ops.edge.aten.addmm.default:
+        if node.kwargs.get("beta", 1) != 1 or node.kwargs.get("alpha", 1) != 1:
+            return None
+        bias, input, weight_node = node.args
+        if not (
+            isinstance(bias, torch.fx.Node)
+            and bias.meta["val"].dim() == 1
+            and bias.meta["val"].dtype == torch.float32
+        ):
+            return None
+    else:
+        return None
+
+    weight = _get_linear_weight(weight_node, const_node_to_tensor)
+    if weight is None or weight.dtype != torch.float32:
+        return None
+    return input, weight_node, bias, weight
+
+
+def add_constant_placeholder(
+    exported_program: ExportedProgram,
+    fqn_prefix: str,
+    tensor: torch.Tensor,
+    new_input_specs: Dict[str, InputSpec],
+) -> torch.fx.Node:
+    """
+    Adds tensor to the constants of the program, with a placeholder in front of
+    the user inputs. Its input spec is added to new_input_specs, to be merged
+    into the graph signature by remove_replaced_weights().
+    """
+    graph = exported_program.graph
+    # Before adding the placeholder, which has no fake tensor yet.
+    fake_mode = get_fake_mode(exported_program)
+    # Weights replaced by an earlier run are removed from the constants, so
+    # their count alone can name a constant that still exists.
+    index = len(exported_program.constants)
+    while f"{fqn_prefix}{index}" in exported_program.constants:
+        index += 1
+    fqn = f"{fqn_prefix}{index}"
+    exported_program.constants[fqn] = tensor
+    with graph.inserting_before(get_first_user_input(exported_program)):
+        node = graph.placeholder(fqn)
+    node.meta["val"] = fake_mode.from_tensor(tensor, static_shapes=True)
+    node.meta["val"].constant = tensor
+    new_input_specs[node.name] = InputSpec(
+        kind=InputKind.CONSTANT_TENSOR,
+        arg=TensorArgument(name=node.name),
+        target=fqn,
+        persistent=True,
+    )
+    return node
+
+
+def remove_replaced_weights(
+    exported_program: ExportedProgram,
+    weight_nodes: Iterable[torch.fx.Node],
+    new_input_specs: Dict[str, InputSpec],
+) -> None:
+    """
+    Drops the weight operands in weight_nodes that are no longer used, along
+    with the transposes and original weights that only fed them, and adds
+    new_input_specs to the graph signature.
+    """
+    graph = exported_program.graph
+    signature = exported_program.graph_signature
+    for weight_node in weight_nodes:
+        if weight_node.users:
+            continue
+        if weight_node.op == "placeholder":
+            erase_constant_node(exported_program, weight_node)
+            continue
+        source = weight_node.args[0]
+        graph.erase_node(weight_node)
+        if not source.users:
+            erase_constant_node(exported_program, source)
+
+    name_to_spec = {s.arg.name: s for s in signature.input_specs}
+    name_to_spec.update(new_input_specs)
+    signature.input_specs = [
+        name_to_spec[node.name] for node in graph.nodes if node.op == "placeholder"
+    ]
+
+    graph.eliminate_dead_code()
+    exported_program.graph_module.recompile()
+
+
+def prepack_weights_pass(
+    exported_program: ExportedProgram,
+    min_weight_numel: int = 0,
+) -> ExportedProgram:
+    """
+    Replaces linear layers (mm/addmm with a constant weight operand) by
+    prepacked::linear, whose weight is stored in the panel layout produced by
+    pack_linear_weight(). Packing happens here at export time, so the packed
+    weight is what gets serialized in the constant segment and the runtime
+    neither repacks it on every call nor keeps a second copy of it.
+
+    Only float32 weights with at least `min_weight_numel` elements are packed.
+    Weights that are no longer used after packing are removed from the program.
+    """
+    const_node_to_tensor = get_constant_placeholder_dict(exported_program)
+    if not const_node_to_tensor:
+        return exported_program
+
+    graph = exported_program.graph
+    new_input_specs = {}
+    # Weight operand -> placeholder of its packed version, so a weight shared
+    # by several layers is only packed once.
+    packed_nodes = {}
+    for node in list(graph.nodes):
+        linear_args = get_linear_args(node, const_node_to_tensor)
+        if linear_args is None:
+            continue
+        input, weight_node, bias, weight = linear_args
+        if weight.numel() < min_weight_numel:
+            continue
+
+        out_features = weight.size(0)
+        if weight_node not in packed_nodes:
+            packed_nodes[weight_node] = add_constant_placeholder(
+                exported_program,
+                "_prepacked_weight",
+                pack_linear_weight(weight),
+                new_input_specs,
+            )
+        packed_node = packed_nodes[weight_node]
+
+        with graph.inserting_before(node):
+            linear_node = graph.call_function(
+                exir_ops.edge.prepacked.linear.default,
+                (input, packed_node, bias, out_features),
+            )
+        linear_node.meta = node.meta.copy()
+        node.replace_all_uses_with(linear_node)
+        graph.erase_node(node)
+
+    if not new_input_specs:
+        return exported_program
+
+    remove_replaced_weights(exported_program, packed_nodes, new_input_specs)
+    return exported_program
@@ -0,0 +1,407 @@
+# Copyright (c) Meta Platforms, Inc. and affiliates.
+# All rights reserved.
+#
+# This source code is licensed under the BSD-style license found in the
+# LICENSE file in the root directory of this source tree.
+
+from typing import Optional, Tuple
+
+import torch
+from executorch.exir.dialects._ops import ops as exir_ops
+from executorch.exir.passes.constant_prop_pass import get_constant_placeholder_dict
+from executorch.exir.passes.prepack_weights_pass import (
+    add_constant_placeholder,
+    get_linear_args,
+    remove_replaced_weights,
+)
+from torch.export import ExportedProgram
+from torch.library import impl, impl_abstract, Library
+
+# Number of consecutive output features that are kept or pruned together in
+# the block sparse format. Must match kBlockSize in
+# kernels/optimized/cpu/op_linear_sparse.cpp.
+BLOCK_SIZE = 16
+
+# Largest fraction of kept blocks for which the block sparse kernel beats the
+# dense prepacked::linear one, see
+# kernels/optimized/test/sparse_linear_benchmark.cpp.
+DEFAULT_MAX_BLOCK_DENSITY = 0.5
+
+# The sparse linear ops live next to prepacked::linear, and their kernels are
+# registered through the same kernels/optimized/prepacked.yaml.
+sparse_lib = Library("prepacked", "FRAGMENT")
+
+sparse_lib.define(
+    "sparse_linear_2_4(Tensor input, Tensor values, Tensor metadata, "
+    "Tensor? weight_scales, Tensor? bias) -> Tensor",
+)
+
+sparse_lib.define(
+    "sparse_linear_2_4.out(Tensor input, Tensor values, Tensor metadata, "
+    "Tensor? weight_scales, Tensor? bias, *, Tensor(a!) out) -> Tensor(a!)",
+)
+
+sparse_lib.define(
+    "sparse_linear_block(Tensor input, Tensor values, Tensor col_indices, "
+    "Tensor row_offsets, Tensor? weight_scales, Tensor? bias, int out_features) "
+    "-> Tensor",
+)
+
+sparse_lib.define(
+    "sparse_linear_block.out(Tensor input, Tensor values, Tensor col_indices, "
+    "Tensor row_offsets, Tensor? weight_scales, Tensor? bias, int out_features, "
+    "*, Tensor(a!) out) -> Tensor(a!)",
+)
+
+
+def quantize_per_channel(weight: torch.Tensor) -> Tuple[torch.Tensor, torch.Tensor]:
+    """
+    Quantizes each row of weight to int8, symmetrically around 0, and returns
+    the int8 weight and the float scale of each row. Rows of zeros get a scale
+    of 1.
+    """
+    max_abs = weight.abs().reshape(weight.size(0), -1).amax(dim=1)
+    scales = torch.where(max_abs > 0, max_abs / 127, torch.ones_like(max_abs))
+    scale_shape = (-1,) + (1,) * (weight.dim() - 1)
+    quantized = torch.round(weight / scales.reshape(scale_shape)).clamp(-127, 127)
+    return quantized.to(torch.int8), scales.to(torch.float32)
+
+
+def is_2_4_sparse(weight: torch.Tensor) -> bool:
+    """
+    Returns whether every group of 4 consecutive input features of each output
+    feature of a [out_features, in_features] weight has at most 2 nonzeros.
+    """
+    out_features, in_features = weight.shape
+    if in_features == 0 or in_features % 4 != 0:
+        return False
+    groups = weight.reshape(out_features, in_features // 4, 4)
+    return bool(((groups != 0).sum(dim=-1) <= 2).all())
+
+
+def pack_2_4_weight(
+    weight: torch.Tensor, dtype: torch.dtype = torch.float32
+) -> Tuple[torch.Tensor, torch.Tensor, Optional[torch.Tensor]]:
+    """
+    Compresses a 2:4 sparse [N, K] weight into:
+    - values, of shape [N, K / 2], the 2 kept weights of every group of 4 input
+      features, in increasing position. Groups with fewer than 2 nonzeros keep
+      zeros to make up 2.
+    - metadata, a uint8 tensor of shape [N, ceil(K / 8)], the positions of the
+      kept weights within their group. Each group takes a nibble, the first
+      position in its low 2 bits. The even groups take the low nibbles.
+    - weight_scales, the scale of each output feature when dtype is int8, in
+      which case values is quantized with quantize_per_channel(). None
+      otherwise.
+    """
+    assert is_2_4_sparse(weight), "Expecting a 2:4 sparse weight"
+    out_features, in_features = weight.shape
+    num_groups = in_features // 4
+    groups = weight.reshape(out_features, num_groups, 4)
+    # The nonzeros of each group first, in order, then its zeros.
+    order = torch.argsort((groups == 0).to(torch.int8), dim=-1, stable=True)
+    positions = order[..., :2].sort(dim=-1).values
+    values = groups.gather(-1, positions).reshape(out_features, num_groups * 2)
+
+    nibbles = positions[..., 0] | (positions[..., 1] << 2)
+    if num_groups % 2 != 0:
+        nibbles = torch.cat([nibbles, nibbles.new_zeros(out_features, 1)], dim=1)
+    metadata = (nibbles[:, 0::2] | (nibbles[:, 1::2] << 4)).to(torch.uint8)
+
+    weight_scales = None
+    if dtype == torch.int8:
+        values, weight_scales = quantize_per_channel(values)
+    return values.contiguous(), metadata.contiguous(), weight_scales
+
+
+def unpack_2_4_weight(
+    values: torch.Tensor,
+    metadata: torch.Tensor,
+    weight_scales: Optional[torch.Tensor],
+) -> torch.Tensor:
+    """Inverse of pack_2_4_weight(), up to the int8 quantization."""
+    out_features = values.size(0)
+    num_groups = values.size(1) // 2
+    nibbles = torch.stack([metadata & 0xF, metadata >> 4], dim=-1)
+    nibbles = nibbles.reshape(out_features, -1)[:, :num_groups].to(torch.int64)
+    positions = torch.stack([nibbles & 0x3, nibbles >> 2], dim=-1)
+    kept = values.to(torch.float32).reshape(out_features, num_groups, 2)
+    if weight_scales is not None:
+        kept = kept * weight_scales.reshape(-1, 1, 1)
+    weight = kept.new_zeros(out_features, num_groups, 4).scatter(-1, positions, kept)
+    return weight.reshape(out_features, num_groups * 4)
+
+
+def _block_mask(weight: torch.Tensor, block_size: int) -> torch.Tensor:
+    """
+    Returns the [ceil(N / block_size), K] mask of the blocks of block_size
+    output features and 1 input feature of a [N, K] weight with a nonzero.
+    """
+    out_features, in_features = weight.shape
+    num_blocks = (out_features + block_size - 1) // block_size
+    padded = weight.new_zeros(num_blocks * block_size, in_features)
+    padded[:out_features] = weight
+    return (padded.reshape(num_blocks, block_size, in_features) != 0).any(dim=1)
+
+
+def block_density(weight: torch.Tensor, block_size: int = BLOCK_SIZE) -> float:
+    """Returns the fraction of the blocks of weight that have a nonzero."""
+    if weight.numel() == 0:
+        return 1.0
+    return _block_mask(weight, block_size).float().mean().item()
+
+
+def pack_block_sparse_weight(
+    weight: torch.Tensor,
+    dtype: torch.dtype = torch.float32,
+    block_size: int = BLOCK_SIZE,
+) -> Tuple[torch.Tensor, torch.Tensor, torch.Tensor, Optional[torch.Tensor]]:
+    """
+    Compresses a [N, K] weight into its blocks of `block_size` consecutive
+    output features and 1 input feature that have a nonzero, stored like the
+    rows of a CSR matrix, with the output blocks as rows:
+    - values, of shape [num_kept, block_size], the weights of each kept block.
+      The last output block is zero padded.
+    - col_indices, the int32 input feature of each kept block.
+    - row_offsets, int32 of shape [ceil(N / block_size) + 1]. The kept blocks of
+      output block b are row_offsets[b] to row_offsets[b + 1].
+    - weight_scales, the scale of each output feature when dtype is int8, in
+      which case values is quantized with quantize_per_channel(). None
+      otherwise.
+    """
+    out_features, in_features = weight.shape
+    num_blocks = (out_features + block_size - 1) // block_size
+    mask = _block_mask(weight, block_size)
+
+    weight_scales = None
+    if dtype == torch.int8:
+        weight, weight_scales = quantize_per_channel(weight)
+    padded = weight.new_zeros(num_blocks * block_size, in_features)
+    padded[:out_features] = weight
+    blocks = padded.reshape(num_blocks, block_size, in_features).permute(0, 2, 1)
+
+    values = blocks[mask]
+    col_indices = mask.nonzero()[:, 1].to(torch.int32).contiguous()
+    row_offsets = torch.cat(
+        [torch.zeros(1, dtype=torch.int64), mask.sum(dim=1).cumsum(dim=0)]
+    ).to(torch.int32)
+    return values.contiguous(), col_indices, row_offsets, weight_scales
+
+
+def unpack_block_sparse_weight(
+    values: torch.Tensor,
+    col_indices: torch.Tensor,
+    row_offsets: torch.Tensor,
+    weight_scales: Optional[torch.Tensor],
+    out_features: int,
+    in_features: int,
+) -> torch.Tensor:
+    """Inverse of pack_block_sparse_weight(), up to the int8 quantization."""
+    num_blocks, block_size = row_offsets.numel() - 1, values.size(1)
+    block_ids = torch.repeat_interleave(
+        torch.arange(num_blocks), (row_offsets[1:] - row_offsets[:-1]).long()
+    )
+    blocks = torch.zeros(num_blocks, in_features, block_size)
+    blocks[block_ids, col_indices.long()] = values.to(torch.float32)
+    weight = blocks.permute(0, 2, 1).reshape(num_blocks * block_size, in_features)
+    weight = weight[:out_features]
+    if weight_scales is not None:
+        weight = weight * weight_scales.reshape(-1, 1)
+    return weight
+
+
+def _linear_out_shape(input: torch.Tensor, out_features: int) -> torch.Tensor:
+    return input.new_empty(input.shape[:-1] + (out_features,))
+
+
+@impl(sparse_lib, "sparse_linear_2_4", "CompositeExplicitAutograd")
+def sparse_linear_2_4(
+    input: torch.Tensor,
+    values: torch.Tensor,
+    metadata: torch.Tensor,
+    weight_scales: Optional[torch.Tensor],
+    bias: Optional[torch.Tensor],
+) -> torch.Tensor:
+    weight = unpack_2_4_weight(values, metadata, weight_scales)
+    return torch.nn.functional.linear(input, weight, bias)
+
+
+@impl_abstract("prepacked::sparse_linear_2_4")
+def sparse_linear_2_4_meta(
+    input: torch.Tensor,
+    values: torch.Tensor,
+    metadata: torch.Tensor,
+    weight_scales: Optional[torch.Tensor],
+    bias: Optional[torch.Tensor],
+) -> torch.Tensor:
+    return _linear_out_shape(input, values.size(0))
+
+
+@impl_abstract("prepacked::sparse_linear_2_4.out")
+def sparse_linear_2_4_out_meta(
+    input: torch.Tensor,
+    values: torch.Tensor,
+    metadata: torch.Tensor,
+    weight_scales: Optional[torch.Tensor],
+    bias: Optional[torch.Tensor],
+    out: torch.Tensor,
+) -> torch.Tensor:
+    return _linear_out_shape(input, values.size(0))
+
+
+@impl(sparse_lib, "sparse_linear_block", "CompositeExplicitAutograd")
+def sparse_linear_block(
+    input: torch.Tensor,
+    values: torch.Tensor,
+    col_indices: torch.Tensor,
+    row_offsets: torch.Tensor,
+    weight_scales: Optional[torch.Tensor],
+    bias: Optional[torch.Tensor],
+    out_features: int,
+) -> torch.Tensor:
+    weight = unpack_block_sparse_weight(
+        values, col_indices, row_offsets, weight_scales, out_features, input.size(-1)
+    )
+    return torch.nn.functional.linear(input, weight, bias)
+
+
+# The number of kept blocks of each output block is only known from the data
+# of row_offsets, so the shape functions do not unpack the weight.
+@impl_abstract("prepacked::sparse_linear_block")
+def sparse_linear_block_meta(
+    input: torch.Tensor,
+    values: torch.Tensor,
+    col_indices: torch.Tensor,
+    row_offsets: torch.Tensor,
+    weight_scales: Optional[torch.Tensor],
+    bias: Optional[torch.Tensor],
+    out_features: int,
+) -> torch.Tensor:
+    return _linear_out_shape(input, out_features)
+
+
+@impl_abstract("prepacked::sparse_linear_block.out")
+def sparse_linear_block_out_meta(
+    input: torch.Tensor,
+    values: torch.Tensor,
+    col_indices: torch.Tensor,
+    row_offsets: torch.Tensor,
+    weight_scales: Optional[torch.Tensor],
+    bias: Optional[torch.Tensor],
+    out_features: int,
+    out: torch.Tensor,
+) -> torch.Tensor:
+    return _linear_out_shape(input, out_features)
+
+
+def _add_constants(exported_program, tensors, new_input_specs):
+    return tuple(
+        (
+            add_constant_placeholder(
+                exported_program, "_sparse_weight", tensor, new_input_specs
+            )
+            if tensor is not None
+            else None
+        )
+        for tensor in tensors
+    )
+
+
+def sparse_weights_pass(
+    exported_program: ExportedProgram,
+    dtype: torch.dtype = torch.float32,
+    max_block_density: float = DEFAULT_MAX_BLOCK_DENSITY,
+    min_weight_numel: int = 0,
+    allow_float32_2_4: bool = False,
+) -> ExportedProgram:
+    """
+    Replaces linear layers (mm/addmm with a constant weight operand) whose
+    weight was pruned to a structured sparsity by prepacked::sparse_linear_2_4
+    or prepacked::sparse_linear_block, whose weight is stored compressed with
+    pack_2_4_weight() or pack_block_sparse_weight(). Only the compressed weight
+    is serialized, and the runtime kernels only multiply the kept weights.
+
+    The pass does not prune: it looks at the zeros already in each float32
+    weight with at least `min_weight_numel` elements.
+    - If at most `max_block_density` of its BLOCK_SIZE x 1 blocks have a
+      nonzero, the weight is stored block sparse.
+    - Otherwise, if every group of 4 input features has at most 2 nonzeros, it
+      is stored 2:4 sparse, if dtype is int8 or `allow_float32_2_4` is set.
+    - Otherwise it is left dense, e.g. for prepack_weights_pass() to pack.
+    With float32 values, 2:4 halves the weight but runs at about 0.4x the speed
+    of prepacked::linear on single rows (token by token decoding), so it is
+    opt-in. It is faster on batches of rows, and with int8 values.
+
+    With dtype=torch.int8, the kept weights are also quantized, with a
+    symmetric scale per output feature. Weights that are no longer used are
+    removed from the program.
+    """
+    assert dtype in (
+        torch.float32,
+        torch.int8,
+    ), f"Expecting float32 or int8 values, but got {dtype}"
+    const_node_to_tensor = get_constant_placeholder_dict(exported_program)
+    if not const_node_to_tensor:
+        return exported_program
+
+    graph = exported_program.graph
+    new_input_specs = {}
+    # Weight operand -> (op, args before and after the bias) of its compressed
+    # version, or None if it stays dense. A weight shared by several layers is
+    # only compressed once.
+    compressed = {}
+    for node in list(graph.nodes):
+        linear_args = get_linear_args(node, const_node_to_tensor)
+        if linear_args is None:
+            continue
+        input, weight_node, bias, weight = linear_args
+        if weight.numel() < min_weight_numel:
+            continue
+
+        if weight_node not in compressed:
+            out_features = weight.size(0)
+            if block_density(weight) <= max_block_density:
+                compressed[weight_node] = (
+                    exir_ops.edge.prepacked.sparse_linear_block.default,
+                    _add_constants(
+                        exported_program,
+                        pack_block_sparse_weight(weight, dtype),
+                        new_input_specs,
+                    ),
+                    (out_features,),
+                )
+            elif (dtype == torch.int8 or allow_float32_2_4) and is_2_4_sparse(
+                weight
+            ):
+                compressed[weight_node] = (
+                    exir_ops.edge.prepacked.sparse_linear_2_4.default,
+                    _add_constants(
+                        exported_program,
+                        pack_2_4_weight(weight, dtype),
+                        new_input_specs,
+                    ),
+                    (),
+                )
+            else:
+                compressed[weight_node] = None
+        if compressed[weight_node] is None:
+            continue
+        target, weight_args, extra_args = compressed[weight_node]
+
+        with graph.inserting_before(node):
+            sparse_node = graph.call_function(
+                target, (input, *weight_args, bias, *extra_args)
+            )
+        sparse_node.meta = node.meta.copy()
+        node.replace_all_uses_with(sparse_node)
+        graph.erase_node(node)
+
+    if not new_input_specs:
+        return exported_program
+
+    remove_replaced_weights(
+        exported_program,
+        [weight_node for weight_node, c in compressed.items() if c is not None],
+        new_input_specs,
+    )
+    return exported_program
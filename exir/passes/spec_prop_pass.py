@@ -11,6 +11,9 @@ from typing import List, Optional
 import torch
 from executorch.exir.delegate import executorch_call_delegate
 from executorch.exir.pass_base import ExportPass, NodeMetadata, ProxyValue
+from executorch.exir.passes.insert_write_back_for_buffers_pass import (
+    ALIASED_BUFFER_KEY,
+)
 from executorch.exir.tensor import TensorSpec
 from torch.export.exported_program import ExportGraphSignature
 from torch.fx.node import Node
@@ -64,8 +67,10 @@ class SpecPropPass(ExportPass):
     ) -> None:
         """
         Update the tensor specs for all placeholder nodes such that
-        placeholders that are parameters are marked as constant.
+        placeholders that are parameters are marked as constant, and nodes that
+        compute a mutable buffer's new value in place share the buffer's spec.
         """
+        placeholders = {}
         for node in graph_module.graph.nodes:
             if node.op != "placeholder":
                 continue
@@ -80,6 +85,17 @@ class SpecPropPass(ExportPass):
                 )
             ):
                 spec.const = True
+            placeholders[node.target] = node
+
+        for node in graph_module.graph.nodes:
+            if ALIASED_BUFFER_KEY not in node.meta:
+                continue
+            buffer_node = placeholders[node.meta[ALIASED_BUFFER_KEY]]
+            if not _is_mutable_buffer(buffer_node, exported_program.graph_signature):
+                raise RuntimeError(
+                    f"{node} aliases {buffer_node} which is not a mutable buffer"
+                )
+            node.meta["spec"] = buffer_node.meta["spec"]
 
     # pyre-ignore
     def placeholder(self, name: str, arg, meta):
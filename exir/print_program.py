@@ -62,6 +62,8 @@ def _scalar_type_str(scalar_type: ScalarType) -> str:
         ScalarType.BFLOAT16: "bf16",
         ScalarType.QUINT4x2: "qui4x2",
         ScalarType.QUINT2x4: "qui2x4",
+        ScalarType.FLOAT8_E5M2: "f8e5m2",
+        ScalarType.FLOAT8_E4M3FN: "f8e4m3fn",
     }
     if not (ret := type2str.get(scalar_type, None)):
         raise RuntimeError(f"Unrecognized scalar_type: {scalar_type}")
@@ -7,7 +7,7 @@
 import copy
 import io
 import logging
-from typing import Any, Dict, List, Optional, Sequence, Set, Union
+from typing import Any, Dict, List, Optional, Sequence, Set, Tuple, Union
 
 import torch
 import torch._export
@@ -20,6 +20,10 @@ from executorch.exir.capture._config import EdgeCompileConfig, ExecutorchBackend
 from executorch.exir.emit import emit_program, EmitterOutput
 from executorch.exir.emit._emitter import _DelegateDebugIdentifierMap
 from executorch.exir.error import ExportError
+from executorch.exir.memory_planning import (
+    mark_shared_mutable_buffers,
+    plan_shared_mutable_buffers,
+)
 from executorch.exir.pass_manager import PassType
 from executorch.exir.passes import (
     base_post_op_replace_passes,
@@ -891,9 +895,14 @@ class EdgeProgramManager:
         config = config if config else ExecutorchBackendConfig()
 
         execution_programs: Dict[str, ExportedProgram] = {}
+        planned_methods: Dict[
+            str, Tuple[torch.fx.GraphModule, ExportGraphSignature]
+        ] = {}
         for name, program in self._edge_programs.items():
             program = unsafe_remove_auto_functionalized_pass(program)
-            gm, new_signature = insert_write_back_for_buffers_pass(program)
+            gm, new_signature = insert_write_back_for_buffers_pass(
+                program, config.alias_mutable_buffers
+            )
             new_gm = program.graph_module
             for p in edge_to_executorch_passes(config):
                 new_gm_res = p(new_gm)
@@ -912,6 +921,11 @@ class EdgeProgramManager:
                     # TODO(who?)
                     p.update_placeholder_tensor_specs(program, new_gm)
 
+            if config.shared_mutable_buffer_mem_id is not None:
+                mark_shared_mutable_buffers(
+                    new_gm, new_signature, config.shared_mutable_buffer_mem_id
+                )
+
             # TODO(jakeszwe): Follow up with compiler on if the deepcopy is necessary and if so how to make it work
             if hasattr(config.memory_planning_pass, "run"):
                 new_gm_res = config.memory_planning_pass.run(  # pyre-ignore[16]
@@ -924,6 +938,12 @@ class EdgeProgramManager:
 
             _copy_module(program.graph_module, new_gm)
             execution_programs[name] = program
+            planned_methods[name] = (program.graph_module, new_signature)
+
+        if config.shared_mutable_buffer_mem_id is not None:
+            plan_shared_mutable_buffers(
+                planned_methods, config.shared_mutable_buffer_mem_id
+            )
 
         return ExecutorchProgramManager(
             execution_programs, self._config_methods, config
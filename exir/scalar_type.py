@@ -26,3 +26,5 @@ class ScalarType(IntEnum):
     BFLOAT16 = 15
     QUINT4x2 = 16
     QUINT2x4 = 17
+    FLOAT8_E5M2 = 23
+    FLOAT8_E4M3FN = 24
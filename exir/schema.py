@@ -243,6 +243,9 @@ class ExecutionPlan:
     # Runtime should use the len(constant_buffer) as the ground truch of
     # constant memory buffer size, and ignore non_const_buffer_sizes[0].
     non_const_buffer_sizes: List[int]
+    # Memory buffer ids whose contents are shared with the other execution
+    # plans of the program that list them.
+    shared_non_const_buffer_ids: Optional[List[int]] = None
 
 
 @dataclass
@@ -254,6 +254,8 @@ scalar_type_table: Dict[torch.dtype, ScalarType] = {
     torch.qint32: ScalarType.QINT32,
     torch.bfloat16: ScalarType.BFLOAT16,
     torch.quint4x2: ScalarType.QUINT4x2,
+    torch.float8_e5m2: ScalarType.FLOAT8_E5M2,
+    torch.float8_e4m3fn: ScalarType.FLOAT8_E4M3FN,
 }
 
 
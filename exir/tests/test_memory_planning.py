@@ -14,7 +14,11 @@ import executorch.exir as exir
 
 import torch
 from executorch.exir import ExecutorchBackendConfig, to_edge
+from executorch.exir.dialects._ops import ops as exir_ops
+from executorch.exir.error import ExportError
 from executorch.exir.memory_planning import (
+    _first_fit_offset,
+    compute_peak_live_bytes,
     filter_nodes,
     get_node_tensor_specs,
     Verifier,
@@ -22,10 +26,14 @@ from executorch.exir.memory_planning import (
 from executorch.exir.pass_base import PassResult
 from executorch.exir.pass_manager import PassManager
 from executorch.exir.passes import (  # noqa
+    MemoryAwareSchedulePass,
     MemoryPlanningPass,
     SpecPropPass,
     ToOutVarPass,
 )
+from executorch.exir.passes.insert_write_back_for_buffers_pass import (
+    insert_write_back_for_buffers_pass,
+)
 from executorch.exir.passes.sym_shape_eval_pass import ConstraintBasedSymShapeEvalPass
 from parameterized import parameterized
 
@@ -225,6 +233,7 @@ def maketest(
                 ("naive", False),
                 # greedy algorithm should reuse tensor storages in the testing model
                 ("greedy", True),
+                ("greedy_by_size", True),
             ]
 
         for algo, expect_reuse in criteria:
@@ -381,6 +390,160 @@ class TestMemoryPlanning(unittest.TestCase):
             case(self)
 
 
+class TestGreedyBySize(unittest.TestCase):
+    def test_first_fit_offset(self) -> None:
+        # Nothing in the way.
+        self.assertEqual(_first_fit_offset(16, 0, []), 0)
+        self.assertEqual(_first_fit_offset(16, 32, []), 32)
+        # Fits in the gap between two busy ranges.
+        self.assertEqual(_first_fit_offset(16, 0, [(0, 16), (32, 48)]), 16)
+        # Gap too small, goes after the last busy range.
+        self.assertEqual(_first_fit_offset(32, 0, [(0, 16), (32, 48)]), 48)
+        # Busy ranges may overlap each other.
+        self.assertEqual(_first_fit_offset(16, 0, [(0, 32), (16, 48)]), 48)
+
+    def _plan(self, module: torch.nn.Module, algo: str) -> Tuple[int, int]:
+        graph_module = (
+            to_edge(export(module, module.get_random_inputs()))
+            .exported_program()
+            .graph_module
+        )
+        graph_module = PassManager(
+            passes=[SpecPropPass(), ToOutVarPass(), MemoryPlanningPass(algo)]
+        )(graph_module).graph_module
+        Verifier(
+            graph_module, alloc_graph_input=True, alloc_graph_output=True
+        ).verify_storage_reuse()
+        planned = graph_module.meta["non_const_buffer_sizes"][1]
+        lower_bound = compute_peak_live_bytes(graph_module)[1]
+        return planned, lower_bound
+
+    def test_planned_size_vs_lower_bound(self) -> None:
+        for module_cls in [
+            ToyModelForMemPlanning,
+            ModelWithDifferentTensorSizes,
+            ModuleReturnTwo,
+            ModuleListArg,
+        ]:
+            greedy_size, lower_bound = self._plan(module_cls().eval(), "greedy")
+            by_size, _ = self._plan(module_cls().eval(), "greedy_by_size")
+            self.assertGreaterEqual(greedy_size, lower_bound)
+            self.assertGreaterEqual(by_size, lower_bound)
+            # Placing tensors by offset never needs more than grouping them
+            # into shared objects on these models.
+            self.assertLessEqual(by_size, greedy_size, module_cls.__name__)
+
+
+class InterleavedBranches(torch.nn.Module):
+    def forward(self, x: torch.Tensor) -> torch.Tensor:
+        # Traced order computes both large tensors before reducing either.
+        a = x * 2
+        b = x * 3
+        return a.sum() + b.sum()
+
+    def get_random_inputs(self) -> Tuple[torch.Tensor]:
+        return (torch.randn(64, 64),)
+
+
+class ReadBufferThenUpdate(torch.nn.Module):
+    def __init__(self) -> None:
+        super().__init__()
+        self.register_buffer("state", torch.zeros(64, 64))
+
+    def forward(self, x: torch.Tensor) -> torch.Tensor:
+        # The read of the old value has a larger output than the update, so
+        # scheduling by memory alone would run the write back first.
+        old = torch.cat([self.state, self.state])
+        self.state.copy_(x)
+        return old
+
+    def get_random_inputs(self) -> Tuple[torch.Tensor]:
+        return (torch.randn(64, 64),)
+
+
+class TestMemoryAwareSchedule(unittest.TestCase):
+    def test_reorders_branches(self) -> None:
+        module = InterleavedBranches().eval()
+        graph_module = (
+            to_edge(export(module, module.get_random_inputs()))
+            .exported_program()
+            .graph_module
+        )
+        schedule_pass = MemoryAwareSchedulePass()
+        result = schedule_pass(graph_module)
+        self.assertIsNotNone(result)
+        self.assertTrue(result.modified)
+
+        # In the traced order, a.sum() allocates its 4 byte output while a and
+        # b are both live.
+        large = 64 * 64 * 4
+        self.assertEqual(schedule_pass.peak_bytes_before, 2 * large + 4)
+        self.assertLess(schedule_pass.peak_bytes_after, 2 * large)
+
+        # The first reduction now runs before the second large tensor is
+        # computed.
+        targets = [
+            n.target
+            for n in result.graph_module.graph.nodes
+            if n.op == "call_function"
+        ]
+        self.assertEqual(targets[0], exir_ops.edge.aten.mul.Tensor)
+        self.assertNotEqual(targets[1], exir_ops.edge.aten.mul.Tensor)
+        result.graph_module.graph.lint()
+
+    def test_buffer_read_stays_before_write_back(self) -> None:
+        module = ReadBufferThenUpdate().eval()
+        inputs = module.get_random_inputs()
+        graph_module, _ = insert_write_back_for_buffers_pass(
+            to_edge(export(module, inputs)).exported_program()
+        )
+        result = MemoryAwareSchedulePass()(graph_module)
+        self.assertIsNotNone(result)
+
+        nodes = list(result.graph_module.graph.nodes)
+        (write_back,) = [
+            n for n in nodes if n.target == torch.ops.aten.copy_.default
+        ]
+        (read,) = [n for n in nodes if n.target == exir_ops.edge.aten.cat.default]
+        self.assertLess(nodes.index(read), nodes.index(write_back))
+        result.graph_module.graph.lint()
+
+        # The scheduled graph still returns the old value of the buffer.
+        state = torch.ones(64, 64)
+        (_, old) = result.graph_module(state, *inputs)
+        self.assertTrue(torch.equal(old, torch.ones(128, 64)))
+
+    def test_no_regression(self) -> None:
+        # Straight line graphs have a single topological order.
+        module = ToyModelForMemPlanning().eval()
+        graph_module = (
+            to_edge(export(module, module.get_random_inputs()))
+            .exported_program()
+            .graph_module
+        )
+        schedule_pass = MemoryAwareSchedulePass()
+        result = schedule_pass(graph_module)
+        self.assertIsNotNone(result)
+        self.assertLessEqual(
+            schedule_pass.peak_bytes_after, schedule_pass.peak_bytes_before
+        )
+
+    def test_to_executorch(self) -> None:
+        module = InterleavedBranches().eval()
+        inputs = module.get_random_inputs()
+
+        def planned_size(config: ExecutorchBackendConfig) -> int:
+            prog = to_edge(export(module, inputs)).to_executorch(config)
+            graph_module = prog.exported_program().graph_module
+            return graph_module.meta["non_const_buffer_sizes"][1]
+
+        baseline = planned_size(ExecutorchBackendConfig())
+        scheduled = planned_size(
+            ExecutorchBackendConfig(passes=[MemoryAwareSchedulePass()])
+        )
+        self.assertLess(scheduled, baseline)
+
+
 class TestVerifier(unittest.TestCase):
     def test_overlap(self) -> None:
         # first enclose second
@@ -591,3 +754,64 @@ class TestMisc(unittest.TestCase):
             num_placeholders,
             5,
         )
+
+    def test_shared_mutable_buffers(self) -> None:
+        class Cache(torch.nn.Module):
+            def __init__(self) -> None:
+                super().__init__()
+                self.register_buffer("cache", torch.zeros(8, 4))
+                self.register_buffer("count", torch.zeros(1))
+
+            def forward(self, x: torch.Tensor) -> torch.Tensor:
+                self.cache[: x.shape[0]] = x
+                self.count.add_(1)
+                return self.cache.clone()
+
+        # Prefill and decode are specialized for different shapes but use the
+        # same buffers.
+        model = Cache()
+        program = to_edge(
+            {
+                "prefill": export(model, (torch.ones(4, 4),)),
+                "decode": export(model, (torch.ones(1, 4),)),
+            }
+        ).to_executorch(ExecutorchBackendConfig(shared_mutable_buffer_mem_id=2))
+
+        offsets = {}
+        for method_name in ("prefill", "decode"):
+            ep = program.exported_program(method_name)
+            inputs_to_buffers = ep.graph_signature.inputs_to_buffers
+            for node in ep.graph_module.graph.nodes:
+                if node.op == "placeholder" and node.target in inputs_to_buffers:
+                    spec = node.meta["spec"]
+                    self.assertEqual(spec.mem_id, 2)
+                    offsets.setdefault(inputs_to_buffers[node.target], set()).add(
+                        spec.mem_offset
+                    )
+        self.assertEqual(set(offsets.keys()), {"cache", "count"})
+        for buffer_offsets in offsets.values():
+            self.assertEqual(len(buffer_offsets), 1)
+
+        plans = program.executorch_program.execution_plan
+        self.assertEqual(len(plans), 2)
+        for plan in plans:
+            self.assertEqual(plan.shared_non_const_buffer_ids, [2])
+        self.assertEqual(
+            plans[0].non_const_buffer_sizes[2], plans[1].non_const_buffer_sizes[2]
+        )
+
+    def test_shared_mutable_buffers_in_planned_mem_id(self) -> None:
+        class Counter(torch.nn.Module):
+            def __init__(self) -> None:
+                super().__init__()
+                self.register_buffer("count", torch.zeros(1))
+
+            def forward(self, x: torch.Tensor) -> torch.Tensor:
+                self.count.add_(1)
+                return x + self.count
+
+        # mem_id 1 is where memory planning puts the other tensors.
+        model = Counter()
+        edge = to_edge({"forward": export(model, (torch.ones(1),))})
+        with self.assertRaises(ExportError):
+            edge.to_executorch(ExecutorchBackendConfig(shared_mutable_buffer_mem_id=1))
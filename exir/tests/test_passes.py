@@ -5,6 +5,7 @@
 # LICENSE file in the root directory of this source tree.
 
 # pyre-strict
+import operator
 import os
 import tempfile
 import unittest
@@ -34,11 +35,19 @@ from executorch.exir.passes import (
 from executorch.exir.passes.constant_prop_pass import constant_prop_pass
 from executorch.exir.passes.debug_handle_generator_pass import DebugHandleGeneratorPass
 from executorch.exir.passes.insert_write_back_for_buffers_pass import (
+    _can_alias_buffer,
+    ALIASED_BUFFER_KEY,
     insert_write_back_for_buffers_pass,
 )
 from executorch.exir.passes.normalize_view_copy_base_pass import (
     NormalizeViewCopyBasePass,
 )
+from executorch.exir.passes.prepack_weights_pass import (
+    pack_linear_weight,
+    PANEL_WIDTH,
+    prepack_weights_pass,
+    unpack_linear_weight,
+)
 
 from executorch.exir.passes.remove_graph_asserts_pass import RemoveGraphAssertsPass
 from executorch.exir.passes.remove_mixed_type_operators import RemoveMixedTypeOperators
@@ -47,6 +56,15 @@ from executorch.exir.passes.replace_view_copy_with_view_pass import (
     ReplaceViewCopyWithViewPass,
 )
 from executorch.exir.passes.scalar_to_tensor_pass import ScalarToTensorPass
+from executorch.exir.passes.sparse_weights_pass import (
+    block_density,
+    BLOCK_SIZE,
+    pack_2_4_weight,
+    pack_block_sparse_weight,
+    sparse_weights_pass,
+    unpack_2_4_weight,
+    unpack_block_sparse_weight,
+)
 from executorch.exir.passes.spec_prop_pass import SpecPropPass
 from executorch.exir.passes.sym_to_tensor_pass import SymToTensorPass
 from executorch.exir.program._program import lift_constant_tensor_pass
@@ -1313,6 +1331,253 @@ class TestPasses(unittest.TestCase):
         ):
             _ = constant_prop_pass(edge.exported_program())
 
+    def test_pack_linear_weight(self) -> None:
+        weight = torch.randn(11, 5)
+        packed = pack_linear_weight(weight)
+        self.assertEqual(packed.shape, (2, 5, PANEL_WIDTH))
+        # Output feature 9 lives in slot 1 of the second panel.
+        self.assertTrue(torch.equal(packed[1, :, 1], weight[9]))
+        # The last panel is zero padded.
+        self.assertTrue(torch.equal(packed[1, :, 3:], torch.zeros(5, 5)))
+        self.assertTrue(torch.equal(unpack_linear_weight(packed, 11), weight))
+
+    def test_prepack_weights_pass(self) -> None:
+        class M(torch.nn.Module):
+            def __init__(self):
+                super().__init__()
+                self.linear1 = torch.nn.Linear(5, 11)
+                self.linear2 = torch.nn.Linear(11, 3, bias=False)
+
+            def forward(self, x):
+                return self.linear2(self.linear1(x).relu())
+
+        model = M()
+        x = torch.randn(4, 5)
+        expected = model(x)
+
+        edge = to_edge(export(model, (x,)))
+        ep = prepack_weights_pass(edge.exported_program())
+
+        targets = [
+            node.target for node in ep.graph.nodes if node.op == "call_function"
+        ]
+        self.assertEqual(targets.count(exir_ops.edge.prepacked.linear.default), 2)
+        self.assertNotIn(exir_ops.edge.aten.addmm.default, targets)
+        self.assertNotIn(exir_ops.edge.aten.mm.default, targets)
+        self.assertNotIn(exir_ops.edge.aten.permute_copy.default, targets)
+
+        # Only the packed weights and the bias are left.
+        self.assertNotIn("linear1.weight", ep.state_dict)
+        self.assertNotIn("linear2.weight", ep.state_dict)
+        self.assertIn("linear1.bias", ep.state_dict)
+        self.assertEqual(
+            sum(
+                spec.kind == InputKind.CONSTANT_TENSOR
+                for spec in ep.graph_signature.input_specs
+            ),
+            2,
+        )
+        self.assertTrue(torch.allclose(ep.module()(x), expected, atol=1e-5))
+
+        # The pass updates the program in place, so it lowers to the out
+        # variant of the custom op.
+        executorch_program = edge.to_executorch()
+        operators = executorch_program.executorch_program.execution_plan[0].operators
+        self.assertIn("prepacked::linear", [op.name for op in operators])
+
+    def test_prepack_weights_pass_unique_constant_names(self) -> None:
+        model = torch.nn.Linear(4, 2)
+        x = torch.randn(1, 4)
+        ep = to_edge(export(model, (x,))).exported_program()
+        # A constant left by an earlier pass, named like the next packed weight.
+        existing = torch.randn(3)
+        ep.constants[f"_prepacked_weight{len(ep.constants) + 1}"] = existing
+        names_before = set(ep.constants)
+
+        ep = prepack_weights_pass(ep)
+        (packed_name,) = set(ep.constants) - names_before
+        self.assertTrue(packed_name.startswith("_prepacked_weight"))
+        for name in names_before:
+            self.assertIn(name, ep.constants)
+        self.assertIs(
+            ep.constants[f"_prepacked_weight{len(names_before)}"], existing
+        )
+
+    def test_prepack_weights_pass_min_numel(self) -> None:
+        model = torch.nn.Linear(4, 2)
+        edge = to_edge(export(model, (torch.randn(1, 4),)))
+        ep = prepack_weights_pass(edge.exported_program(), min_weight_numel=9)
+        self.assertNotIn(
+            exir_ops.edge.prepacked.linear.default,
+            [node.target for node in ep.graph.nodes],
+        )
+        self.assertIn("weight", ep.state_dict)
+
+    def test_pack_2_4_weight(self) -> None:
+        weight = torch.zeros(3, 12)
+        weight[0, 1], weight[0, 3] = 1.0, -2.0
+        weight[1, 6] = 3.0
+        weight[2, 8:10] = torch.tensor([0.5, 0.25])
+        values, metadata, weight_scales = pack_2_4_weight(weight)
+        self.assertEqual(values.shape, (3, 6))
+        # 3 groups need 2 metadata bytes per output feature.
+        self.assertEqual(metadata.shape, (3, 2))
+        self.assertEqual(metadata.dtype, torch.uint8)
+        self.assertIsNone(weight_scales)
+        # Positions 1 and 3 of the first group of output feature 0.
+        self.assertEqual(metadata[0, 0].item() & 0xF, 1 | 3 << 2)
+        self.assertTrue(torch.equal(values[0, :2], torch.tensor([1.0, -2.0])))
+        self.assertTrue(
+            torch.equal(unpack_2_4_weight(values, metadata, weight_scales), weight)
+        )
+
+        values, metadata, weight_scales = pack_2_4_weight(weight, torch.int8)
+        self.assertEqual(values.dtype, torch.int8)
+        self.assertEqual(weight_scales.shape, (3,))
+        self.assertTrue(
+            torch.allclose(
+                unpack_2_4_weight(values, metadata, weight_scales), weight, atol=1e-2
+            )
+        )
+
+    def test_pack_block_sparse_weight(self) -> None:
+        # The first block of output features keeps input features 1 and 4, the
+        # second, partial one keeps input feature 0.
+        weight = torch.zeros(BLOCK_SIZE + 4, 5)
+        weight[:BLOCK_SIZE, 1] = torch.arange(BLOCK_SIZE, dtype=torch.float32)
+        weight[3, 4] = 2.0
+        weight[BLOCK_SIZE + 2, 0] = -1.0
+        self.assertAlmostEqual(block_density(weight), 3 / 10)
+
+        values, col_indices, row_offsets, weight_scales = pack_block_sparse_weight(
+            weight
+        )
+        self.assertEqual(values.shape, (3, BLOCK_SIZE))
+        self.assertEqual(col_indices.tolist(), [1, 4, 0])
+        self.assertEqual(row_offsets.tolist(), [0, 2, 3])
+        self.assertEqual(col_indices.dtype, torch.int32)
+        self.assertEqual(row_offsets.dtype, torch.int32)
+        # The partial block is zero padded.
+        self.assertTrue(torch.equal(values[2, 4:], torch.zeros(BLOCK_SIZE - 4)))
+        self.assertTrue(
+            torch.equal(
+                unpack_block_sparse_weight(
+                    values, col_indices, row_offsets, weight_scales, BLOCK_SIZE + 4, 5
+                ),
+                weight,
+            )
+        )
+
+    def _sparse_model(self) -> torch.nn.Module:
+        class M(torch.nn.Module):
+            def __init__(self):
+                super().__init__()
+                self.linear1 = torch.nn.Linear(8, 2 * BLOCK_SIZE)
+                self.linear2 = torch.nn.Linear(2 * BLOCK_SIZE, 6, bias=False)
+                self.linear3 = torch.nn.Linear(6, 3)
+
+            def forward(self, x):
+                x = self.linear1(x).relu()
+                return self.linear3(self.linear2(x).relu())
+
+        model = M()
+        with torch.no_grad():
+            # Block b of linear1 keeps a third of the input features.
+            blocks = model.linear1.weight.view(2, BLOCK_SIZE, 8)
+            for b in range(2):
+                for k in range(8):
+                    if (b + k) % 3 != 0:
+                        blocks[b, :, k] = 0
+            # Output feature n of linear2 keeps positions n % 4 and
+            # (n + 1) % 4 of each group of 4.
+            groups = model.linear2.weight.view(6, 2 * BLOCK_SIZE // 4, 4)
+            for n in range(6):
+                for i in range(4):
+                    if i not in (n % 4, (n + 1) % 4):
+                        groups[n, :, i] = 0
+        return model
+
+    def test_sparse_weights_pass(self) -> None:
+        model = self._sparse_model()
+        x = torch.randn(4, 8)
+        expected = model(x)
+
+        edge = to_edge(export(model, (x,)))
+        ep = sparse_weights_pass(edge.exported_program(), allow_float32_2_4=True)
+
+        targets = [
+            node.target for node in ep.graph.nodes if node.op == "call_function"
+        ]
+        self.assertEqual(
+            targets.count(exir_ops.edge.prepacked.sparse_linear_block.default), 1
+        )
+        self.assertEqual(
+            targets.count(exir_ops.edge.prepacked.sparse_linear_2_4.default), 1
+        )
+        # linear3 is dense and stays an addmm.
+        self.assertEqual(targets.count(exir_ops.edge.aten.addmm.default), 1)
+        self.assertNotIn(exir_ops.edge.aten.mm.default, targets)
+
+        self.assertNotIn("linear1.weight", ep.state_dict)
+        self.assertNotIn("linear2.weight", ep.state_dict)
+        self.assertIn("linear3.weight", ep.state_dict)
+        self.assertTrue(torch.allclose(ep.module()(x), expected, atol=1e-5))
+
+        executorch_program = edge.to_executorch()
+        operators = executorch_program.executorch_program.execution_plan[0].operators
+        names = [op.name for op in operators]
+        self.assertIn("prepacked::sparse_linear_block", names)
+        self.assertIn("prepacked::sparse_linear_2_4", names)
+
+    def test_sparse_weights_pass_float32_2_4_is_opt_in(self) -> None:
+        model = self._sparse_model()
+        x = torch.randn(4, 8)
+        expected = model(x)
+
+        edge = to_edge(export(model, (x,)))
+        ep = sparse_weights_pass(edge.exported_program())
+
+        targets = [
+            node.target for node in ep.graph.nodes if node.op == "call_function"
+        ]
+        self.assertEqual(
+            targets.count(exir_ops.edge.prepacked.sparse_linear_block.default), 1
+        )
+        self.assertNotIn(exir_ops.edge.prepacked.sparse_linear_2_4.default, targets)
+        # linear2 stays a dense mm.
+        self.assertEqual(targets.count(exir_ops.edge.aten.mm.default), 1)
+        self.assertIn("linear2.weight", ep.state_dict)
+        self.assertTrue(torch.allclose(ep.module()(x), expected, atol=1e-5))
+
+    def test_sparse_weights_pass_int8(self) -> None:
+        model = self._sparse_model()
+        x = torch.randn(4, 8)
+        expected = model(x)
+
+        edge = to_edge(export(model, (x,)))
+        ep = sparse_weights_pass(edge.exported_program(), dtype=torch.int8)
+
+        sparse_nodes = [
+            node
+            for node in ep.graph.nodes
+            if node.target
+            in (
+                exir_ops.edge.prepacked.sparse_linear_block.default,
+                exir_ops.edge.prepacked.sparse_linear_2_4.default,
+            )
+        ]
+        self.assertEqual(len(sparse_nodes), 2)
+        for node in sparse_nodes:
+            self.assertEqual(node.args[1].meta["val"].dtype, torch.int8)
+            # weight_scales comes right before the bias.
+            scales_index = (
+                4
+                if node.target == exir_ops.edge.prepacked.sparse_linear_block.default
+                else 3
+            )
+            self.assertIsNotNone(node.args[scales_index])
+        self.assertTrue(torch.allclose(ep.module()(x), expected, atol=1e-2))
+
     def test_mutable_buffers(self) -> None:
         def count_copies(gm: torch.fx.GraphModule) -> int:
             return sum(
@@ -1359,6 +1624,107 @@ class TestPasses(unittest.TestCase):
         #     return (copy__default, aten_add_tensor)
         self.assertEqual(count_copies(gm), 1)
 
+    def test_mutable_buffers_aliased(self) -> None:
+        class MutableStateModule(torch.nn.Module):
+            def __init__(self):
+                super().__init__()
+                self.register_buffer("state", torch.zeros(1))
+
+            def forward(self, x):
+                y = x + self.state
+                self.state.add_(1)
+                return y
+
+        model = to_edge(
+            export(
+                MutableStateModule(),
+                (torch.zeros(1),),
+            )
+        )
+        gm, signature = insert_write_back_for_buffers_pass(
+            model.exported_program(), alias_mutable_buffers=True
+        )
+
+        # The read of the old state comes before the add that produces the new
+        # one, so the add writes into the buffer and no copy_ is needed.
+        self.assertFalse(
+            any(node.target == torch.ops.aten.copy_.default for node in gm.graph.nodes)
+        )
+        output_node = next(n for n in gm.graph.nodes if n.op == "output")
+        new_state = output_node.args[0][0]
+        buffer_target = next(
+            name
+            for name, fqn in signature.inputs_to_buffers.items()
+            if fqn == "state"
+        )
+        self.assertEqual(new_state.meta[ALIASED_BUFFER_KEY], buffer_target)
+        self.assertEqual(signature.output_specs[0].arg.name, new_state.name)
+
+    def _buffer_update_graph(
+        self, read_view_after_update: bool
+    ) -> Tuple[torch.fx.GraphModule, List[torch.fx.Node]]:
+        # state: f32[4, 4] is a mutable buffer, and the value written back to it
+        # is computed in between two reads of a view of it.
+        graph = torch.fx.Graph()
+        state = graph.placeholder("state")
+        x = graph.placeholder("x")
+        view = graph.call_function(exir_ops.edge.aten.view_copy.default, (state, [16]))
+        if not read_view_after_update:
+            read = graph.call_function(exir_ops.edge.aten.mul.Tensor, (view, view))
+        new_state = graph.call_function(exir_ops.edge.aten.add.Tensor, (state, x))
+        if read_view_after_update:
+            read = graph.call_function(exir_ops.edge.aten.mul.Tensor, (view, view))
+        graph.output((new_state, read))
+        for node in (state, x, new_state):
+            node.meta["val"] = torch.zeros(4, 4)
+        return torch.fx.GraphModule(torch.nn.Module(), graph), [
+            state,
+            new_state,
+            read,
+        ]
+
+    def test_mutable_buffer_not_aliased_with_view_read_after_update(self) -> None:
+        gm, (state, new_state, read) = self._buffer_update_graph(
+            read_view_after_update=False
+        )
+        self.assertTrue(_can_alias_buffer(gm, state, new_state, [new_state, read]))
+
+        # Once view_copy becomes memory.view, the read after the update would
+        # see the new value.
+        gm, (state, new_state, read) = self._buffer_update_graph(
+            read_view_after_update=True
+        )
+        self.assertFalse(_can_alias_buffer(gm, state, new_state, [new_state, read]))
+
+    def test_mutable_buffer_not_aliased_with_op_reading_view(self) -> None:
+        # mm reads its input while writing its output, so it can not write into
+        # the buffer that its input is a view of.
+        graph = torch.fx.Graph()
+        state = graph.placeholder("state")
+        w = graph.placeholder("w")
+        view = graph.call_function(
+            exir_ops.edge.aten.view_copy.default, (state, [4, 4])
+        )
+        new_state = graph.call_function(exir_ops.edge.aten.mm.default, (view, w))
+        graph.output((new_state,))
+        for node in (state, w, new_state):
+            node.meta["val"] = torch.zeros(4, 4)
+        gm = torch.fx.GraphModule(torch.nn.Module(), graph)
+        self.assertFalse(_can_alias_buffer(gm, state, new_state, [new_state]))
+
+    def test_mutable_buffer_not_aliased_with_getitem(self) -> None:
+        graph = torch.fx.Graph()
+        state = graph.placeholder("state")
+        x = graph.placeholder("x")
+        max_dim = graph.call_function(exir_ops.edge.aten.max.dim, (x, 0))
+        new_state = graph.call_function(operator.getitem, (max_dim, 0))
+        graph.output((new_state,))
+        state.meta["val"] = torch.zeros(4)
+        x.meta["val"] = torch.zeros(2, 4)
+        new_state.meta["val"] = torch.zeros(4)
+        gm = torch.fx.GraphModule(torch.nn.Module(), graph)
+        self.assertFalse(_can_alias_buffer(gm, state, new_state, [new_state]))
+
     def test_remove_quantized_op_noop_pass(self) -> None:
         class TestAddSliceNoop(torch.nn.Module):
             def __init__(self):
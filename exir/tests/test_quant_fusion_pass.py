@@ -379,3 +379,21 @@ class TestQuantFusionPass(unittest.TestCase):
             # ).run(
             #     m.dump_graph_module().code
             # )
+
+    def test_float8_weights(self) -> None:
+        weight = torch.randn(4, 8)
+        weight_scales = weight.abs().amax(dim=1) / torch.finfo(torch.float8_e4m3fn).max
+        qweight = (weight / weight_scales.unsqueeze(-1)).to(torch.float8_e4m3fn)
+        dequantized = qweight.float() * weight_scales.unsqueeze(-1)
+
+        x = torch.randn(2, 8)
+        out = torch.ops.quantized_decomposed.mixed_linear(
+            x, qweight, weight_scales, None
+        )
+        self.assertTrue(torch.allclose(out, F.linear(x, dequantized)))
+
+        indices = torch.tensor([3, 0])
+        out = torch.ops.quantized_decomposed.embedding_byte(
+            qweight, weight_scales, None, 0, 0, indices
+        )
+        self.assertTrue(torch.allclose(out, dequantized[indices]))
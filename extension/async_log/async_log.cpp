@@ -0,0 +1,387 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <executorch/extension/async_log/async_log.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <executorch/runtime/platform/clock.h>
+#include <executorch/runtime/platform/compiler.h>
+#include <executorch/runtime/platform/platform.h>
+
+namespace torch {
+namespace executor {
+
+namespace {
+
+// Same as the longest message that vlogf() passes to the PAL.
+constexpr size_t kMaxMessageLength = 256;
+
+// Room for a message and the prefix that format_message() adds.
+constexpr size_t kMaxLineLength = kMaxMessageLength + 256;
+
+struct Message {
+  et_timestamp_t timestamp;
+  et_pal_log_level_t level;
+  // Filenames come from __FILE__, so they outlive the message.
+  const char* filename;
+  size_t line;
+  size_t length;
+  char text[kMaxMessageLength];
+};
+
+// Formats a message like the Posix PAL, and returns the length of the line.
+size_t format_message(const Message& message, char* out, size_t size) {
+  uint64_t us = ticks_to_ns(message.timestamp) / 1000;
+  const unsigned long int micros = us % 1000000;
+  us /= 1000000; // To seconds
+  const unsigned int sec = us % 60;
+  us /= 60; // To minutes
+  const unsigned int min = us % 60;
+  us /= 60; // To hours
+  const unsigned int hour = us;
+  const int length = snprintf(
+      out,
+      size,
+      "%c %02u:%02u:%02u.%06lu executorch:%s:%zu] %.*s\n",
+      message.level,
+      hour,
+      min,
+      sec,
+      micros,
+      message.filename,
+      message.line,
+      static_cast<int>(message.length),
+      message.text);
+  if (length < 0) {
+    return 0;
+  }
+  return std::min(static_cast<size_t>(length), size - 1);
+}
+
+void write_now(std::FILE* file, const Message& message) {
+  char line[kMaxLineLength];
+  const size_t length = format_message(message, line, sizeof(line));
+  fwrite(line, 1, length, file);
+  fflush(file);
+}
+
+/**
+ * A bounded multi-producer queue of messages, after Dmitry Vyukov's. Every
+ * cell has a sequence number that tells whose turn it is: a producer claims a
+ * cell by advancing the enqueue position, fills it, and publishes it by
+ * bumping its sequence. Producers never wait for each other or for the
+ * consumer, and fail instead when the queue is full.
+ */
+class MessageRing final {
+ public:
+  explicit MessageRing(size_t capacity)
+      : cells_(capacity), mask_(capacity - 1) {
+    for (size_t i = 0; i < capacity; ++i) {
+      cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  bool try_push(
+      et_timestamp_t timestamp,
+      et_pal_log_level_t level,
+      const char* filename,
+      size_t line,
+      const char* text,
+      size_t length) {
+    size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+    Cell* cell;
+    while (true) {
+      cell = &cells_[pos & mask_];
+      const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+      const intptr_t diff =
+          static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+      if (diff == 0) {
+        if (enqueue_pos_.compare_exchange_weak(
+                pos, pos + 1, std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        // The consumer has not freed this cell yet: the queue is full.
+        return false;
+      } else {
+        pos = enqueue_pos_.load(std::memory_order_relaxed);
+      }
+    }
+    Message& message = cell->message;
+    message.timestamp = timestamp;
+    message.level = level;
+    message.filename = filename;
+    message.line = line;
+    message.length = std::min(length, kMaxMessageLength);
+    std::memcpy(message.text, text, message.length);
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  /// Returns the next message, or null if none is published yet. Must only
+  /// be called by the consumer, which must call pop() once done with it.
+  const Message* front() const {
+    const Cell& cell = cells_[dequeue_pos_ & mask_];
+    if (cell.sequence.load(std::memory_order_acquire) != dequeue_pos_ + 1) {
+      return nullptr;
+    }
+    return &cell.message;
+  }
+
+  void pop() {
+    cells_[dequeue_pos_ & mask_].sequence.store(
+        dequeue_pos_ + mask_ + 1, std::memory_order_release);
+    dequeue_pos_++;
+  }
+
+ private:
+  struct Cell {
+    std::atomic<size_t> sequence;
+    Message message;
+  };
+
+  std::vector<Cell> cells_;
+  const size_t mask_;
+  // Producers and the consumer write these, so keep them on separate cache
+  // lines.
+  alignas(64) std::atomic<size_t> enqueue_pos_{0};
+  alignas(64) size_t dequeue_pos_ = 0;
+};
+
+class AsyncLogger final {
+ public:
+  AsyncLogger(const AsyncLogConfig& config, size_t capacity)
+      : ring_(capacity),
+        file_(config.file),
+        poll_interval_(config.poll_interval),
+        thread_([this] { drain_loop(); }) {}
+
+  ~AsyncLogger() {
+    stop();
+  }
+
+  // Writes the queued messages and joins the thread. Producers must be gone.
+  void stop() {
+    {
+      std::lock_guard<std::mutex> guard(mutex_);
+      stopping_ = true;
+    }
+    wake_.notify_one();
+    if (thread_.joinable()) {
+      thread_.join();
+    }
+  }
+
+  bool try_push(
+      et_timestamp_t timestamp,
+      et_pal_log_level_t level,
+      const char* filename,
+      size_t line,
+      const char* text,
+      size_t length) {
+    if (ring_.try_push(timestamp, level, filename, line, text, length)) {
+      return true;
+    }
+    dropped_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+
+  std::FILE* file() const {
+    return file_;
+  }
+
+  AsyncLogStats stats() const {
+    return {
+        written_.load(std::memory_order_relaxed),
+        dropped_.load(std::memory_order_relaxed)};
+  }
+
+ private:
+  // Writes the queued messages with one write and one flush, and returns
+  // whether there were any.
+  bool drain() {
+    size_t count = 0;
+    while (const Message* message = ring_.front()) {
+      if (buffer_.size() - used_ < kMaxLineLength) {
+        flush_buffer();
+      }
+      used_ += format_message(*message, &buffer_[used_], kMaxLineLength);
+      ring_.pop();
+      count++;
+    }
+    const uint64_t dropped = dropped_.load(std::memory_order_relaxed);
+    if (dropped != reported_dropped_) {
+      if (buffer_.size() - used_ < kMaxLineLength) {
+        flush_buffer();
+      }
+      Message notice = {};
+      notice.timestamp = et_pal_current_ticks();
+      notice.level = et_pal_log_level_t::kError;
+      notice.filename = __ET_SHORT_FILENAME;
+      notice.line = __LINE__;
+      notice.length = snprintf(
+          notice.text,
+          sizeof(notice.text),
+          "Dropped %llu log messages: the ring buffer was full",
+          static_cast<unsigned long long>(dropped - reported_dropped_));
+      used_ += format_message(notice, &buffer_[used_], kMaxLineLength);
+      reported_dropped_ = dropped;
+    }
+    flush_buffer();
+    written_.fetch_add(count, std::memory_order_relaxed);
+    return count > 0;
+  }
+
+  void flush_buffer() {
+    if (used_ > 0) {
+      fwrite(buffer_.data(), 1, used_, file_);
+      fflush(file_);
+      used_ = 0;
+    }
+  }
+
+  void drain_loop() {
+    while (true) {
+      if (drain()) {
+        continue;
+      }
+      std::unique_lock<std::mutex> lock(mutex_);
+      if (stopping_) {
+        break;
+      }
+      wake_.wait_for(lock, poll_interval_);
+    }
+    // Producers are gone by now, so this drains everything.
+    drain();
+  }
+
+  MessageRing ring_;
+  std::FILE* const file_;
+  const std::chrono::microseconds poll_interval_;
+
+  // Only used by the thread.
+  std::vector<char> buffer_ = std::vector<char>(64 * 1024);
+  size_t used_ = 0;
+  uint64_t reported_dropped_ = 0;
+
+  std::atomic<uint64_t> written_{0};
+  std::atomic<uint64_t> dropped_{0};
+
+  std::mutex mutex_;
+  std::condition_variable wake_;
+  bool stopping_ = false;
+
+  std::thread thread_;
+};
+
+// Serializes start_async_logging() and stop_async_logging().
+std::mutex control_mutex;
+
+// The running logger, if any.
+std::atomic<AsyncLogger*> current_logger{nullptr};
+
+// Number of threads that may be using current_logger. stop_async_logging()
+// waits for it to drop to zero before it deletes the logger.
+std::atomic<size_t> active_producers{0};
+
+// Counters of the last logger, once stopped.
+AsyncLogStats last_stats = {0, 0};
+
+// Drains and joins the background thread at exit, after main() returns.
+struct StopAtExit {
+  ~StopAtExit() {
+    stop_async_logging();
+  }
+} stop_at_exit;
+
+} // namespace
+
+Error start_async_logging(const AsyncLogConfig& config) {
+  ET_CHECK_OR_RETURN_ERROR(
+      config.capacity > 0 && config.file != nullptr,
+      InvalidArgument,
+      "capacity must be positive, and file must not be null");
+  size_t capacity = 1;
+  while (capacity < config.capacity) {
+    capacity *= 2;
+  }
+  std::lock_guard<std::mutex> guard(control_mutex);
+  ET_CHECK_OR_RETURN_ERROR(
+      current_logger.load() == nullptr,
+      InvalidState,
+      "Async logging is already started");
+  current_logger.store(new AsyncLogger(config, capacity));
+  return Error::Ok;
+}
+
+void stop_async_logging() {
+  std::lock_guard<std::mutex> guard(control_mutex);
+  AsyncLogger* logger = current_logger.exchange(nullptr);
+  if (logger == nullptr) {
+    return;
+  }
+  // New messages are written synchronously from now on. Wait for the ones
+  // that are being queued.
+  while (active_producers.load() != 0) {
+    std::this_thread::yield();
+  }
+  std::unique_ptr<AsyncLogger> owned(logger);
+  owned->stop();
+  last_stats = owned->stats();
+}
+
+AsyncLogStats async_logging_stats() {
+  std::lock_guard<std::mutex> guard(control_mutex);
+  AsyncLogger* logger = current_logger.load();
+  return logger != nullptr ? logger->stats() : last_stats;
+}
+
+} // namespace executor
+} // namespace torch
+
+/**
+ * Overrides the weak Posix implementation. Queues the message if async
+ * logging is started, and writes it synchronously otherwise.
+ */
+void et_pal_emit_log_message(
+    et_timestamp_t timestamp,
+    et_pal_log_level_t level,
+    const char* filename,
+    __ET_UNUSED const char* function,
+    size_t line,
+    const char* message,
+    size_t length) {
+  using namespace torch::executor;
+  active_producers.fetch_add(1);
+  AsyncLogger* logger = current_logger.load();
+  if (logger != nullptr && level != et_pal_log_level_t::kFatal) {
+    // If the ring is full, the message is dropped and counted.
+    (void)logger->try_push(timestamp, level, filename, line, message, length);
+    active_producers.fetch_sub(1);
+    return;
+  }
+  std::FILE* file = logger != nullptr ? logger->file() : stderr;
+  active_producers.fetch_sub(1);
+
+  Message sync = {};
+  sync.timestamp = timestamp;
+  sync.level = level;
+  sync.filename = filename;
+  sync.line = line;
+  sync.length = std::min(length, kMaxMessageLength);
+  std::memcpy(sync.text, message, sync.length);
+  write_now(file, sync);
+}
@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+/**
+ * @file
+ *
+ * An asynchronous backend for ET_LOG, for Posix systems where writing logs on
+ * the calling thread shows up in the latency of the runtime.
+ *
+ * Linking this library overrides et_pal_emit_log_message(). Until
+ * start_async_logging() is called, and after stop_async_logging(), messages
+ * are written synchronously, in the format of the Posix PAL. In between, the
+ * calling thread only copies the formatted message into a lock-free ring
+ * buffer, and a background thread writes the messages in batches. If the
+ * ring is full, messages are dropped rather than blocking the caller, and
+ * counted.
+ *
+ * Fatal messages are always written synchronously, since the runtime aborts
+ * right after them. They can appear before messages that are still queued.
+ */
+
+#pragma once
+
+// @nolint PATTERNLINT Ok to use stdlib for this optional library
+#include <chrono>
+// @nolint PATTERNLINT Ok to use stdlib for this optional library
+#include <cstdint>
+// @nolint PATTERNLINT Ok to use stdlib for this optional library
+#include <cstdio>
+
+#include <executorch/runtime/core/error.h>
+
+namespace torch {
+namespace executor {
+
+struct AsyncLogConfig {
+  /// Number of messages the ring buffer holds. Rounded up to a power of two.
+  size_t capacity = 1024;
+
+  /// How long the background thread sleeps when there is nothing to write.
+  std::chrono::microseconds poll_interval{1000};
+
+  /// Where to write the messages. Not closed by stop_async_logging().
+  std::FILE* file = stderr;
+};
+
+struct AsyncLogStats {
+  /// Messages written by the background thread.
+  uint64_t written;
+
+  /// Messages dropped because the ring buffer was full.
+  uint64_t dropped;
+};
+
+/**
+ * Starts writing ET_LOG messages on a background thread. Call after
+ * runtime_init().
+ *
+ * @returns Error::Ok, Error::InvalidState if already started, or
+ *     Error::InvalidArgument if the capacity is zero.
+ */
+__ET_NODISCARD Error start_async_logging(const AsyncLogConfig& config = {});
+
+/**
+ * Writes the queued messages, and stops the background thread. Messages
+ * logged afterwards are written synchronously again. Does nothing if not
+ * started. Also called at exit.
+ */
+void stop_async_logging();
+
+/// Returns the counters of the current or last background thread.
+AsyncLogStats async_logging_stats();
+
+} // namespace executor
+} // namespace torch
@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+/**
+ * @file
+ *
+ * Measures the latency of ET_LOG calls: --num_threads threads each log
+ * --messages_per_thread Info messages, synchronously and then through the
+ * async backend, and the latency percentiles of the calls are reported.
+ * Messages go to --output, /dev/null by default, so that the terminal does
+ * not slow down the synchronous case.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+#include <gflags/gflags.h>
+
+#include <executorch/extension/async_log/async_log.h>
+#include <executorch/runtime/platform/assert.h>
+#include <executorch/runtime/platform/log.h>
+#include <executorch/runtime/platform/runtime.h>
+
+DEFINE_int32(num_threads, 4, "Number of threads logging at once.");
+DEFINE_int32(messages_per_thread, 10000, "Messages logged by each thread.");
+DEFINE_int32(capacity, 4096, "Ring buffer capacity, in messages.");
+DEFINE_string(output, "/dev/null", "Where the logs are written.");
+
+using namespace torch::executor;
+
+namespace {
+
+double percentile(std::vector<double> values, double p) {
+  std::sort(values.begin(), values.end());
+  return values[std::min(values.size() - 1, size_t(p * values.size()))];
+}
+
+// Returns the latency of every ET_LOG call, in nanoseconds.
+std::vector<double> run() {
+  std::vector<std::vector<double>> latencies(FLAGS_num_threads);
+  std::vector<std::thread> threads;
+  for (int32_t t = 0; t < FLAGS_num_threads; ++t) {
+    threads.emplace_back([&, t] {
+      latencies[t].reserve(FLAGS_messages_per_thread);
+      for (int32_t i = 0; i < FLAGS_messages_per_thread; ++i) {
+        const auto start = std::chrono::steady_clock::now();
+        ET_LOG(Info, "Thread %d message %d of the benchmark", t, i);
+        latencies[t].push_back(std::chrono::duration<double, std::nano>(
+                                   std::chrono::steady_clock::now() - start)
+                                   .count());
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  std::vector<double> all;
+  for (const auto& l : latencies) {
+    all.insert(all.end(), l.begin(), l.end());
+  }
+  return all;
+}
+
+void report(const char* name, const std::vector<double>& latencies) {
+  std::fprintf(
+      stdout,
+      "%s: p50 %.0fns p99 %.0fns p99.9 %.0fns max %.0fns\n",
+      name,
+      percentile(latencies, 0.5),
+      percentile(latencies, 0.99),
+      percentile(latencies, 0.999),
+      percentile(latencies, 1.0));
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  runtime_init();
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+
+  // Synchronous messages go to stderr, so point it at the output too.
+  std::FILE* output = std::freopen(FLAGS_output.c_str(), "w", stderr);
+  ET_CHECK_MSG(output != nullptr, "Cannot open %s", FLAGS_output.c_str());
+  report("sync", run());
+
+  AsyncLogConfig config;
+  config.capacity = FLAGS_capacity;
+  config.file = output;
+  ET_CHECK(start_async_logging(config) == Error::Ok);
+  const std::vector<double> latencies = run();
+  stop_async_logging();
+  report("async", latencies);
+  const AsyncLogStats stats = async_logging_stats();
+  std::fprintf(
+      stdout,
+      "async: %" PRIu64 " written, %" PRIu64 " dropped\n",
+      stats.written,
+      stats.dropped);
+  return 0;
+}
@@ -0,0 +1,46 @@
+load("@fbsource//xplat/executorch/build:runtime_wrapper.bzl", "runtime")
+
+def define_common_targets():
+    """Defines targets that should be shared between fbcode and xplat.
+
+    The directory containing this targets.bzl file should also contain both
+    TARGETS and BUCK files that call this function.
+    """
+
+    # Overrides et_pal_emit_log_message(), so it must be linked whole, like
+    # other PAL implementations.
+    runtime.cxx_library(
+        name = "async_log",
+        srcs = [
+            "async_log.cpp",
+        ],
+        exported_headers = [
+            "async_log.h",
+        ],
+        visibility = [
+            "//executorch/...",
+            "@EXECUTORCH_CLIENTS",
+        ],
+        exported_deps = [
+            "//executorch/runtime/core:core",
+        ],
+        deps = [
+            "//executorch/runtime/platform:platform",
+        ],
+        link_whole = True,
+    )
+
+    # Measures the latency of ET_LOG calls with and without async logging.
+    runtime.cxx_binary(
+        name = "async_log_benchmark",
+        srcs = [
+            "async_log_benchmark.cpp",
+        ],
+        deps = [
+            ":async_log",
+            "//executorch/runtime/platform:platform",
+        ],
+        external_deps = [
+            "gflags",
+        ],
+    )
@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <executorch/extension/async_log/async_log.h>
+
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <executorch/runtime/platform/log.h>
+#include <executorch/runtime/platform/runtime.h>
+
+#include <gtest/gtest.h>
+
+using namespace ::testing;
+using torch::executor::AsyncLogConfig;
+using torch::executor::async_logging_stats;
+using torch::executor::Error;
+using torch::executor::runtime_init;
+using torch::executor::start_async_logging;
+using torch::executor::stop_async_logging;
+
+class AsyncLogTest : public ::testing::Test {
+ protected:
+  static void SetUpTestSuite() {
+    runtime_init();
+  }
+
+  void SetUp() override {
+    file_ = std::tmpfile();
+    ASSERT_NE(file_, nullptr);
+  }
+
+  void TearDown() override {
+    stop_async_logging();
+    std::fclose(file_);
+  }
+
+  // Returns what was written to the file so far.
+  std::string contents() {
+    std::fflush(file_);
+    std::rewind(file_);
+    std::string text;
+    char buffer[4096];
+    size_t n;
+    while ((n = std::fread(buffer, 1, sizeof(buffer), file_)) > 0) {
+      text.append(buffer, n);
+    }
+    return text;
+  }
+
+  std::FILE* file_ = nullptr;
+};
+
+TEST_F(AsyncLogTest, WritesMessagesInOrder) {
+  AsyncLogConfig config;
+  config.file = file_;
+  ASSERT_EQ(start_async_logging(config), Error::Ok);
+  for (int i = 0; i < 100; ++i) {
+    ET_LOG(Info, "message %d", i);
+  }
+  stop_async_logging();
+
+  const std::string text = contents();
+  size_t pos = 0;
+  for (int i = 0; i < 100; ++i) {
+    const std::string expected = "] message " + std::to_string(i) + "\n";
+    pos = text.find(expected, pos);
+    ASSERT_NE(pos, std::string::npos) << expected;
+  }
+  EXPECT_EQ(text.find("I 00:"), 0);
+  EXPECT_EQ(async_logging_stats().written, 100);
+  EXPECT_EQ(async_logging_stats().dropped, 0);
+}
+
+TEST_F(AsyncLogTest, ConcurrentProducers) {
+  AsyncLogConfig config;
+  config.file = file_;
+  config.capacity = 1 << 14;
+  ASSERT_EQ(start_async_logging(config), Error::Ok);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([t] {
+      for (int i = 0; i < 1000; ++i) {
+        ET_LOG(Info, "thread %d message %d", t, i);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  stop_async_logging();
+
+  const std::string text = contents();
+  size_t lines = 0;
+  for (char c : text) {
+    lines += c == '\n';
+  }
+  const auto stats = async_logging_stats();
+  EXPECT_EQ(stats.written + stats.dropped, 4000);
+  EXPECT_EQ(lines, stats.written + (stats.dropped > 0 ? 1 : 0));
+}
+
+TEST_F(AsyncLogTest, DropsMessagesWhenFull) {
+  AsyncLogConfig config;
+  config.file = file_;
+  config.capacity = 4;
+  // Keep the background thread asleep until stop_async_logging().
+  config.poll_interval = std::chrono::seconds(60);
+  ASSERT_EQ(start_async_logging(config), Error::Ok);
+  for (int i = 0; i < 100; ++i) {
+    ET_LOG(Info, "message %d", i);
+  }
+  stop_async_logging();
+
+  const auto stats = async_logging_stats();
+  EXPECT_EQ(stats.written, 4);
+  EXPECT_EQ(stats.dropped, 96);
+  EXPECT_NE(contents().find("Dropped 96 log messages"), std::string::npos);
+}
+
+TEST_F(AsyncLogTest, FatalMessagesAreWrittenImmediately) {
+  AsyncLogConfig config;
+  config.file = file_;
+  config.poll_interval = std::chrono::seconds(60);
+  ASSERT_EQ(start_async_logging(config), Error::Ok);
+  ET_LOG(Info, "queued");
+  ET_LOG(Fatal, "immediate");
+
+  std::string text = contents();
+  EXPECT_NE(text.find("] immediate"), std::string::npos);
+  EXPECT_EQ(text.find("] queued"), std::string::npos);
+  stop_async_logging();
+  EXPECT_NE(contents().find("] queued"), std::string::npos);
+}
+
+TEST_F(AsyncLogTest, RejectsInvalidStarts) {
+  AsyncLogConfig config;
+  config.file = file_;
+  config.capacity = 0;
+  EXPECT_EQ(start_async_logging(config), Error::InvalidArgument);
+
+  config.capacity = 16;
+  ASSERT_EQ(start_async_logging(config), Error::Ok);
+  EXPECT_EQ(start_async_logging(config), Error::InvalidState);
+  stop_async_logging();
+  // Stopping twice is fine, and so is starting again.
+  stop_async_logging();
+  EXPECT_EQ(start_async_logging(config), Error::Ok);
+}
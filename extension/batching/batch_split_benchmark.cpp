@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+/**
+ * @file
+ *
+ * Measures the offline throughput of BatchSplitter: runs a batch of --rows
+ * rows --iterations times, for every number of replicas in --num_replicas,
+ * and reports rows/s and the speedup over the first count. Inputs are filled
+ * with zeros.
+ */
+
+#include <chrono>
+#include <cinttypes>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <gflags/gflags.h>
+
+#include <executorch/extension/batching/batch_splitter.h>
+#include <executorch/runtime/platform/log.h>
+
+DEFINE_string(
+    model_path,
+    "model.pte",
+    "Model serialized in flatbuffer format, with a batch dimension.");
+DEFINE_string(method_name, "forward", "Method to run.");
+DEFINE_int32(rows, 4096, "Rows in the batch.");
+DEFINE_int32(iterations, 10, "Number of times the batch runs.");
+DEFINE_string(num_replicas, "1,2,4,8", "Comma separated replica counts.");
+
+using namespace torch::executor;
+
+namespace {
+
+std::vector<int64_t> parse_list(const std::string& list) {
+  std::vector<int64_t> values;
+  std::stringstream stream(list);
+  std::string item;
+  while (std::getline(stream, item, ',')) {
+    values.push_back(std::stoll(item));
+  }
+  return values;
+}
+
+// A contiguous tensor that owns its data.
+struct OwnedTensor {
+  std::vector<exec_aten::SizesType> sizes;
+  std::vector<exec_aten::DimOrderType> dim_order;
+  std::vector<uint8_t> data;
+  std::unique_ptr<TensorImpl> impl;
+
+  OwnedTensor(
+      exec_aten::ScalarType type,
+      std::vector<exec_aten::SizesType> tensor_sizes,
+      size_t nbytes)
+      : sizes(std::move(tensor_sizes)),
+        dim_order(sizes.size()),
+        data(nbytes) {
+    for (size_t d = 0; d < dim_order.size(); ++d) {
+      dim_order[d] = d;
+    }
+    impl = std::make_unique<TensorImpl>(
+        type, sizes.size(), sizes.data(), data.data(), dim_order.data());
+  }
+};
+
+} // namespace
+
+int main(int argc, char** argv) {
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+
+  double baseline = 0;
+  for (int64_t num_replicas : parse_list(FLAGS_num_replicas)) {
+    std::vector<std::unique_ptr<Module>> replicas;
+    for (int64_t r = 0; r < num_replicas; ++r) {
+      replicas.push_back(std::make_unique<Module>(FLAGS_model_path));
+    }
+    auto meta = replicas.front()->method_meta(FLAGS_method_name);
+    ET_CHECK_MSG(
+        meta.ok(),
+        "Failed to load %s: 0x%" PRIx32,
+        FLAGS_method_name.c_str(),
+        (uint32_t)meta.error());
+    auto splitter =
+        BatchSplitter::create(std::move(replicas), FLAGS_method_name);
+    ET_CHECK_MSG(
+        splitter.ok(),
+        "Cannot split %s: 0x%" PRIx32,
+        FLAGS_method_name.c_str(),
+        (uint32_t)splitter.error());
+
+    std::vector<std::unique_ptr<OwnedTensor>> tensors;
+    std::vector<EValue> inputs;
+    for (size_t i = 0; i < meta->num_inputs(); ++i) {
+      auto info = meta->input_tensor_meta(i);
+      ET_CHECK_MSG(info.ok(), "Input %zu is not a tensor", i);
+      std::vector<exec_aten::SizesType> sizes(
+          info->sizes().begin(), info->sizes().end());
+      const size_t row_bytes = info->nbytes() / sizes[0];
+      sizes[0] = FLAGS_rows;
+      tensors.push_back(std::make_unique<OwnedTensor>(
+          info->scalar_type(), sizes, row_bytes * FLAGS_rows));
+      inputs.emplace_back(exec_aten::Tensor(tensors.back()->impl.get()));
+    }
+    std::vector<exec_aten::Tensor> outputs;
+    for (size_t o = 0; o < meta->num_outputs(); ++o) {
+      auto info = meta->output_tensor_meta(o);
+      ET_CHECK_MSG(info.ok(), "Output %zu is not a tensor", o);
+      tensors.push_back(std::make_unique<OwnedTensor>(
+          info->scalar_type(),
+          splitter.get()->output_sizes(o, FLAGS_rows),
+          info->nbytes() / info->sizes()[0] * FLAGS_rows));
+      outputs.emplace_back(tensors.back()->impl.get());
+    }
+
+    // Warm up every replica.
+    ET_CHECK(splitter.get()->execute(inputs, outputs) == Error::Ok);
+    const auto start = std::chrono::steady_clock::now();
+    for (int32_t i = 0; i < FLAGS_iterations; ++i) {
+      ET_CHECK(splitter.get()->execute(inputs, outputs) == Error::Ok);
+    }
+    const double seconds = std::chrono::duration<double>(
+                               std::chrono::steady_clock::now() - start)
+                               .count();
+    const double rows_per_second =
+        double(FLAGS_rows) * FLAGS_iterations / seconds;
+    if (baseline == 0) {
+      baseline = rows_per_second;
+    }
+    ET_LOG(
+        Info,
+        "%" PRId64 " replicas, %zu rows per chunk: %.1f rows/s, %.2fx",
+        num_replicas,
+        splitter.get()->chunk_rows(),
+        rows_per_second,
+        rows_per_second / baseline);
+  }
+  return 0;
+}
@@ -0,0 +1,449 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <executorch/extension/batching/batch_splitter.h>
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstring>
+
+#include <executorch/runtime/core/exec_aten/util/tensor_util.h>
+#include <executorch/runtime/platform/log.h>
+
+namespace torch::executor {
+
+namespace {
+
+// A contiguous tensor over some rows of a buffer.
+struct RowsView {
+  std::vector<exec_aten::SizesType> sizes;
+  std::vector<exec_aten::DimOrderType> dim_order;
+  std::vector<exec_aten::StridesType> strides;
+  std::unique_ptr<TensorImpl> impl;
+
+  explicit RowsView(const std::vector<exec_aten::SizesType>& planned_sizes)
+      : sizes(planned_sizes),
+        dim_order(planned_sizes.size()),
+        strides(planned_sizes.size()) {
+    exec_aten::StridesType stride = 1;
+    for (ssize_t d = sizes.size() - 1; d >= 0; --d) {
+      dim_order[d] = d;
+      strides[d] = stride;
+      stride *= sizes[d];
+    }
+  }
+
+  // Points the view at rows of data. Strides do not depend on dim 0.
+  EValue bind(exec_aten::ScalarType type, size_t rows, void* data) {
+    sizes[0] = rows;
+    impl = std::make_unique<TensorImpl>(
+        type,
+        sizes.size(),
+        sizes.data(),
+        data,
+        dim_order.data(),
+        strides.data());
+    return EValue(exec_aten::Tensor(impl.get()));
+  }
+};
+
+// Whether a tensor has the dtype and sizes of a planned tensor, apart from
+// dim 0, and can be split in rows.
+bool fits_layout(
+    const exec_aten::Tensor& t,
+    exec_aten::ScalarType type,
+    const std::vector<exec_aten::SizesType>& sizes) {
+  return t.scalar_type() == type &&
+      static_cast<size_t>(t.dim()) == sizes.size() &&
+      std::equal(sizes.begin() + 1, sizes.end(), t.sizes().begin() + 1) &&
+      tensor_is_contiguous(t);
+}
+
+} // namespace
+
+struct BatchSplitter::Replica {
+  std::unique_ptr<Module> module;
+  Method* method = nullptr;
+  // Views of the chunk for every tensor input. Null for scalars.
+  std::vector<std::unique_ptr<RowsView>> input_views;
+  // Full chunks for the padded last chunk of static methods.
+  std::vector<std::vector<uint8_t>> input_padding;
+  std::vector<std::vector<uint8_t>> output_padding;
+};
+
+BatchSplitter::BatchSplitter(std::vector<std::unique_ptr<Module>> replicas) {
+  for (auto& module : replicas) {
+    replicas_.push_back(std::make_unique<Replica>());
+    replicas_.back()->module = std::move(module);
+  }
+}
+
+Result<std::unique_ptr<BatchSplitter>> BatchSplitter::create(
+    std::vector<std::unique_ptr<Module>> replicas,
+    const std::string& method_name) {
+  ET_CHECK_OR_RETURN_ERROR(
+      !replicas.empty(), InvalidArgument, "At least one replica is needed");
+  for (const auto& module : replicas) {
+    ET_CHECK_OR_RETURN_ERROR(
+        module != nullptr, InvalidArgument, "Replicas must not be null");
+  }
+  std::unique_ptr<BatchSplitter> splitter(
+      new BatchSplitter(std::move(replicas)));
+  ET_CHECK_OK_OR_RETURN_ERROR(splitter->init(method_name));
+  for (size_t r = 1; r < splitter->replicas_.size(); ++r) {
+    splitter->threads_.emplace_back(
+        [s = splitter.get(), r] { s->worker_loop(r); });
+  }
+  return splitter;
+}
+
+BatchSplitter::~BatchSplitter() {
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    stopping_ = true;
+  }
+  job_ready_.notify_all();
+  for (auto& thread : threads_) {
+    thread.join();
+  }
+}
+
+Error BatchSplitter::init(const std::string& method_name) {
+  for (auto& replica : replicas_) {
+    replica->method =
+        ET_UNWRAP(replica->module->experimental_get_method(method_name));
+  }
+  // Replicas run the same program, so the first one describes them all.
+  Method* method = replicas_.front()->method;
+  const MethodMeta meta = method->method_meta();
+
+  bool has_tensor_input = false;
+  std::vector<EValue> method_inputs(meta.num_inputs());
+  ET_CHECK_OK_OR_RETURN_ERROR(
+      method->get_inputs(method_inputs.data(), method_inputs.size()));
+  inputs_.resize(method_inputs.size());
+  for (size_t i = 0; i < inputs_.size(); ++i) {
+    const EValue& input = method_inputs[i];
+    if (input.isInt() || input.isDouble() || input.isBool()) {
+      continue;
+    }
+    ET_CHECK_OR_RETURN_ERROR(
+        input.isTensor(),
+        NotSupported,
+        "Input %zu is neither a tensor nor a scalar",
+        i);
+    auto info = ET_UNWRAP(meta.input_tensor_meta(i));
+    ET_CHECK_OR_RETURN_ERROR(
+        info.sizes().size() > 0 && info.dim_order()[0] == 0 &&
+            info.sizes()[0] > 0,
+        NotSupported,
+        "Input %zu has no outermost batch dimension",
+        i);
+    const bool dynamic =
+        input.toTensor().unsafeGetTensorImpl()->shape_dynamism() !=
+        TensorShapeDynamism::STATIC;
+    if (!has_tensor_input) {
+      chunk_rows_ = info.sizes()[0];
+      dynamic_batch_ = dynamic;
+      has_tensor_input = true;
+    }
+    ET_CHECK_OR_RETURN_ERROR(
+        static_cast<size_t>(info.sizes()[0]) == chunk_rows_ &&
+            dynamic == dynamic_batch_,
+        NotSupported,
+        "Input %zu has batch size %zu (%s), input 0 has %zu (%s)",
+        i,
+        static_cast<size_t>(info.sizes()[0]),
+        dynamic ? "dynamic" : "static",
+        chunk_rows_,
+        dynamic_batch_ ? "dynamic" : "static");
+    TensorLayout& layout = inputs_[i];
+    layout.sizes.assign(info.sizes().begin(), info.sizes().end());
+    layout.type = info.scalar_type();
+    layout.row_bytes = info.nbytes() / chunk_rows_;
+  }
+  ET_CHECK_OR_RETURN_ERROR(
+      has_tensor_input, NotSupported, "Method has no tensor inputs");
+
+  outputs_.resize(method->outputs_size());
+  for (size_t o = 0; o < outputs_.size(); ++o) {
+    const EValue& output = method->get_output(o);
+    ET_CHECK_OR_RETURN_ERROR(
+        output.isTensor(), NotSupported, "Output %zu is not a tensor", o);
+    auto info = ET_UNWRAP(meta.output_tensor_meta(o));
+    const bool dynamic =
+        output.toTensor().unsafeGetTensorImpl()->shape_dynamism() !=
+        TensorShapeDynamism::STATIC;
+    ET_CHECK_OR_RETURN_ERROR(
+        info.sizes().size() > 0 && info.dim_order()[0] == 0 &&
+            static_cast<size_t>(info.sizes()[0]) == chunk_rows_ &&
+            dynamic == dynamic_batch_,
+        NotSupported,
+        "Output %zu does not have the batch dimension of the inputs",
+        o);
+    TensorLayout& layout = outputs_[o];
+    layout.sizes.assign(info.sizes().begin(), info.sizes().end());
+    layout.type = info.scalar_type();
+    layout.row_bytes = info.nbytes() / chunk_rows_;
+    // Outputs that are not memory planned have no data until they are bound.
+    layout.planned = output.toTensor().const_data_ptr() != nullptr;
+  }
+
+  for (auto& replica : replicas_) {
+    ET_CHECK_OR_RETURN_ERROR(
+        replica->method->inputs_size() == inputs_.size() &&
+            replica->method->outputs_size() == outputs_.size(),
+        InvalidArgument,
+        "Replicas must be modules of the same program");
+    replica->input_views.resize(inputs_.size());
+    replica->input_padding.resize(inputs_.size());
+    for (size_t i = 0; i < inputs_.size(); ++i) {
+      if (!inputs_[i].sizes.empty()) {
+        replica->input_views[i] =
+            std::make_unique<RowsView>(inputs_[i].sizes);
+      }
+    }
+    replica->output_padding.resize(outputs_.size());
+  }
+  return Error::Ok;
+}
+
+std::vector<exec_aten::SizesType> BatchSplitter::output_sizes(
+    size_t index,
+    size_t rows) const {
+  std::vector<exec_aten::SizesType> sizes = outputs_[index].sizes;
+  sizes[0] = rows;
+  return sizes;
+}
+
+Error BatchSplitter::validate(const Job& job) const {
+  const std::vector<EValue>& inputs = *job.inputs;
+  ET_CHECK_OR_RETURN_ERROR(
+      inputs.size() == inputs_.size(),
+      InvalidArgument,
+      "Got %zu inputs, the method has %zu",
+      inputs.size(),
+      inputs_.size());
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    if (inputs_[i].sizes.empty()) {
+      // Replicas check scalars against the traced values in set_input().
+      continue;
+    }
+    ET_CHECK_OR_RETURN_ERROR(
+        inputs[i].isTensor() &&
+            fits_layout(
+                inputs[i].toTensor(), inputs_[i].type, inputs_[i].sizes),
+        InvalidArgument,
+        "Input %zu is not a contiguous tensor with the dtype and sizes of "
+        "the method's input",
+        i);
+    ET_CHECK_OR_RETURN_ERROR(
+        static_cast<size_t>(inputs[i].toTensor().size(0)) == job.rows,
+        InvalidArgument,
+        "Input %zu has %zu rows, expected %zu",
+        i,
+        static_cast<size_t>(inputs[i].toTensor().size(0)),
+        job.rows);
+  }
+
+  const std::vector<exec_aten::Tensor>& outputs = *job.outputs;
+  ET_CHECK_OR_RETURN_ERROR(
+      outputs.size() == outputs_.size(),
+      InvalidArgument,
+      "Got %zu outputs, the method has %zu",
+      outputs.size(),
+      outputs_.size());
+  for (size_t o = 0; o < outputs.size(); ++o) {
+    ET_CHECK_OR_RETURN_ERROR(
+        fits_layout(outputs[o], outputs_[o].type, outputs_[o].sizes) &&
+            static_cast<size_t>(outputs[o].size(0)) == job.rows,
+        InvalidArgument,
+        "Output %zu is not a contiguous tensor of %zu rows with the dtype "
+        "and sizes of the method's output",
+        o,
+        job.rows);
+  }
+  return Error::Ok;
+}
+
+void BatchSplitter::row_range(
+    size_t replica,
+    size_t rows,
+    size_t* begin,
+    size_t* end) const {
+  const size_t n = replicas_.size();
+  if (dynamic_batch_) {
+    // Any number of rows can run at once, so balance the rows.
+    *begin = rows * replica / n;
+    *end = rows * (replica + 1) / n;
+    return;
+  }
+  // Balance whole chunks, so that only the last chunk is padded.
+  const size_t chunks = (rows + chunk_rows_ - 1) / chunk_rows_;
+  *begin = std::min(rows, chunks * replica / n * chunk_rows_);
+  *end = std::min(rows, chunks * (replica + 1) / n * chunk_rows_);
+}
+
+Error BatchSplitter::run_chunk(
+    Replica& replica,
+    const Job& job,
+    size_t row,
+    size_t rows) {
+  Method* method = replica.method;
+  // Static methods always run on full chunks.
+  const size_t run_rows = dynamic_batch_ ? rows : chunk_rows_;
+  const bool padded = run_rows != rows;
+
+  for (size_t i = 0; i < inputs_.size(); ++i) {
+    const EValue& input = (*job.inputs)[i];
+    if (inputs_[i].sizes.empty()) {
+      ET_CHECK_OK_OR_RETURN_ERROR(method->set_input(input, i));
+      continue;
+    }
+    const size_t row_bytes = inputs_[i].row_bytes;
+    uint8_t* data = const_cast<uint8_t*>(
+        input.toTensor().const_data_ptr<uint8_t>() + row * row_bytes);
+    if (padded) {
+      std::vector<uint8_t>& padding = replica.input_padding[i];
+      padding.assign(run_rows * row_bytes, 0);
+      std::memcpy(padding.data(), data, rows * row_bytes);
+      data = padding.data();
+    }
+    // Shares the data if the input is not memory planned, copies it
+    // otherwise.
+    ET_CHECK_OK_OR_RETURN_ERROR(method->set_input(
+        replica.input_views[i]->bind(inputs_[i].type, run_rows, data), i));
+  }
+
+  for (size_t o = 0; o < outputs_.size(); ++o) {
+    if (outputs_[o].planned) {
+      continue;
+    }
+    const size_t row_bytes = outputs_[o].row_bytes;
+    uint8_t* data =
+        (*job.outputs)[o].mutable_data_ptr<uint8_t>() + row * row_bytes;
+    if (padded) {
+      replica.output_padding[o].resize(run_rows * row_bytes);
+      data = replica.output_padding[o].data();
+    }
+    // set_output_data_ptr() checks the buffer against the current sizes of
+    // the output, which are those of the previous chunk.
+    const std::vector<exec_aten::SizesType> sizes = output_sizes(o, run_rows);
+    ET_CHECK_OK_OR_RETURN_ERROR(resize_tensor(
+        method->get_output(o).toTensor(), {sizes.data(), sizes.size()}));
+    ET_CHECK_OK_OR_RETURN_ERROR(
+        method->set_output_data_ptr(data, run_rows * row_bytes, o));
+  }
+
+  ET_CHECK_OK_OR_RETURN_ERROR(method->execute());
+
+  for (size_t o = 0; o < outputs_.size(); ++o) {
+    const exec_aten::Tensor& result = method->get_output(o).toTensor();
+    ET_CHECK_OR_RETURN_ERROR(
+        static_cast<size_t>(result.size(0)) == run_rows,
+        InvalidState,
+        "Output %zu has %zu rows, expected %zu",
+        o,
+        static_cast<size_t>(result.size(0)),
+        run_rows);
+    if (outputs_[o].planned || padded) {
+      const size_t row_bytes = outputs_[o].row_bytes;
+      std::memcpy(
+          (*job.outputs)[o].mutable_data_ptr<uint8_t>() + row * row_bytes,
+          result.const_data_ptr(),
+          rows * row_bytes);
+    }
+  }
+  return Error::Ok;
+}
+
+Error BatchSplitter::run_rows(size_t replica, const Job& job) {
+  size_t begin = 0;
+  size_t end = 0;
+  row_range(replica, job.rows, &begin, &end);
+  for (size_t row = begin; row < end; row += chunk_rows_) {
+    const size_t rows = std::min(chunk_rows_, end - row);
+    const Error err = run_chunk(*replicas_[replica], job, row, rows);
+    if (err != Error::Ok) {
+      ET_LOG(
+          Error,
+          "Replica %zu failed on rows %zu to %zu: 0x%" PRIx32,
+          replica,
+          row,
+          row + rows,
+          static_cast<uint32_t>(err));
+      return err;
+    }
+  }
+  return Error::Ok;
+}
+
+Error BatchSplitter::execute(
+    const std::vector<EValue>& inputs,
+    const std::vector<exec_aten::Tensor>& outputs) {
+  Job job;
+  job.inputs = &inputs;
+  job.outputs = &outputs;
+  for (size_t i = 0; i < inputs_.size(); ++i) {
+    if (!inputs_[i].sizes.empty() && i < inputs.size() &&
+        inputs[i].isTensor() && inputs[i].toTensor().dim() > 0) {
+      job.rows = inputs[i].toTensor().size(0);
+      break;
+    }
+  }
+  ET_CHECK_OK_OR_RETURN_ERROR(validate(job));
+  if (job.rows == 0) {
+    return Error::Ok;
+  }
+
+  std::lock_guard<std::mutex> execute_guard(execute_mutex_);
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    job_ = job;
+    generation_++;
+    pending_replicas_ = threads_.size();
+    job_error_ = Error::Ok;
+  }
+  job_ready_.notify_all();
+
+  // The calling thread runs the first replica.
+  const Error err = run_rows(0, job);
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  job_done_.wait(lock, [this] { return pending_replicas_ == 0; });
+  return err != Error::Ok ? err : job_error_;
+}
+
+void BatchSplitter::worker_loop(size_t replica) {
+  size_t generation = 0;
+  while (true) {
+    Job job;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      job_ready_.wait(lock, [&] {
+        return stopping_ || generation_ != generation;
+      });
+      if (stopping_) {
+        return;
+      }
+      generation = generation_;
+      job = job_;
+    }
+    const Error err = run_rows(replica, job);
+    {
+      std::lock_guard<std::mutex> guard(mutex_);
+      if (job_error_ == Error::Ok) {
+        job_error_ = err;
+      }
+      pending_replicas_--;
+    }
+    job_done_.notify_all();
+  }
+}
+
+} // namespace torch::executor
@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+// @nolint PATTERNLINT Ok to use stdlib for this optional library
+#include <condition_variable>
+// @nolint PATTERNLINT Ok to use stdlib for this optional library
+#include <memory>
+// @nolint PATTERNLINT Ok to use stdlib for this optional library
+#include <mutex>
+// @nolint PATTERNLINT Ok to use stdlib for this optional library
+#include <string>
+// @nolint PATTERNLINT Ok to use stdlib for this optional library
+#include <thread>
+// @nolint PATTERNLINT Ok to use stdlib for this optional library
+#include <vector>
+
+#include <executorch/extension/module/module.h>
+
+namespace torch::executor {
+
+/**
+ * Runs a method on a large batch by splitting its batch dimension (dim 0 of
+ * every tensor input and output) across several replicas of the method, each
+ * on its own thread. Meant for offline scoring, where a single request holds
+ * many more rows than the method can run at once, and the kernels have little
+ * or no intra-op parallelism.
+ *
+ * Every replica gets a contiguous range of the rows, and runs it in chunks of
+ * at most the planned batch size of the method:
+ * - If dim 0 of the inputs is dynamic, the rows are split evenly and every
+ *   chunk runs on exactly its rows.
+ * - If it is static, the rows are split in whole chunks of the planned batch
+ *   size. The last chunk is padded with zeros, and only its real rows are
+ *   written to the outputs.
+ *
+ * Chunks are bound to the caller's tensors without copies where the method
+ * allows it: inputs that are not memory planned point into the rows of the
+ * caller's inputs, and outputs that are not memory planned are written
+ * directly into the rows of the caller's outputs. Memory-planned inputs and
+ * outputs cost one copy of their rows. Export with
+ * `MemoryPlanningPass(alloc_graph_input=False, alloc_graph_output=False)` to
+ * avoid both.
+ *
+ * Requirements on the method:
+ * - All inputs are tensors or scalars, and all outputs are tensors. All
+ *   tensors have an outermost batch dimension of the same planned size.
+ * - The rows of the outputs only depend on the same rows of the inputs.
+ */
+class BatchSplitter final {
+ public:
+  /**
+   * Loads the method in every replica and starts one thread per replica
+   * after the first, which runs on the calling thread.
+   *
+   * @param[in] replicas Modules of the same program. Each one holds its own
+   *     instance of the method, with its own memory.
+   * @param[in] method_name The method to run.
+   *
+   * @returns The splitter, Error::NotSupported if the method does not meet
+   *     the requirements above, or an error loading the method.
+   */
+  static Result<std::unique_ptr<BatchSplitter>> create(
+      std::vector<std::unique_ptr<Module>> replicas,
+      const std::string& method_name = "forward");
+
+  ~BatchSplitter();
+
+  BatchSplitter(const BatchSplitter&) = delete;
+  BatchSplitter& operator=(const BatchSplitter&) = delete;
+  BatchSplitter(BatchSplitter&&) = delete;
+  BatchSplitter& operator=(BatchSplitter&&) = delete;
+
+  /**
+   * Runs the method on all rows of the inputs, and blocks until every row of
+   * the outputs is written. Calls are serialized.
+   *
+   * @param[in] inputs The inputs of the method. Tensors must be contiguous,
+   *     have the dtype and sizes of the method's inputs except for dim 0,
+   *     and all have the same number of rows. Scalars must match the traced
+   *     values.
+   * @param[in] outputs Contiguous tensors allocated by the caller, one per
+   *     output of the method, with the same number of rows as the inputs.
+   *
+   * @returns Error::Ok, Error::InvalidArgument if the tensors do not fit the
+   *     method, or the first error of a replica.
+   */
+  __ET_NODISCARD Error execute(
+      const std::vector<EValue>& inputs,
+      const std::vector<exec_aten::Tensor>& outputs);
+
+  /// Returns the number of replicas, i.e. of chunks that run at once.
+  size_t num_replicas() const {
+    return replicas_.size();
+  }
+
+  /// Returns the largest number of rows the method runs at once.
+  size_t chunk_rows() const {
+    return chunk_rows_;
+  }
+
+  /**
+   * Returns the sizes of an output for a batch of rows, to allocate the
+   * outputs passed to execute().
+   */
+  std::vector<exec_aten::SizesType> output_sizes(size_t index, size_t rows)
+      const;
+
+  /// Returns the dtype of an output.
+  exec_aten::ScalarType output_type(size_t index) const {
+    return outputs_[index].type;
+  }
+
+ private:
+  struct Replica;
+
+  // The planned layout of a tensor input or output.
+  struct TensorLayout {
+    std::vector<exec_aten::SizesType> sizes;
+    exec_aten::ScalarType type = exec_aten::ScalarType::Undefined;
+    size_t row_bytes = 0;
+    // Whether the data of an output is memory planned. Inputs do not need
+    // it, since set_input() copies or shares their data as appropriate.
+    bool planned = false;
+  };
+
+  // A call to execute(), shared with the threads of the replicas.
+  struct Job {
+    const std::vector<EValue>* inputs = nullptr;
+    const std::vector<exec_aten::Tensor>* outputs = nullptr;
+    size_t rows = 0;
+  };
+
+  explicit BatchSplitter(std::vector<std::unique_ptr<Module>> replicas);
+
+  Error init(const std::string& method_name);
+  Error validate(const Job& job) const;
+  void row_range(size_t replica, size_t rows, size_t* begin, size_t* end)
+      const;
+  Error run_chunk(Replica& replica, const Job& job, size_t row, size_t rows);
+  Error run_rows(size_t replica, const Job& job);
+  void worker_loop(size_t replica);
+
+  std::vector<std::unique_ptr<Replica>> replicas_;
+  // Planned size of dim 0 of every tensor, i.e. the rows of a chunk.
+  size_t chunk_rows_ = 0;
+  // Whether dim 0 of the inputs can be resized.
+  bool dynamic_batch_ = false;
+  // Layouts of the inputs, with empty sizes for scalars, and of the outputs.
+  std::vector<TensorLayout> inputs_;
+  std::vector<TensorLayout> outputs_;
+
+  // Serializes calls to execute().
+  std::mutex execute_mutex_;
+
+  std::mutex mutex_;
+  // Signaled when a job starts, or when the threads should stop.
+  std::condition_variable job_ready_;
+  // Signaled when a replica finishes its rows of the job.
+  std::condition_variable job_done_;
+  Job job_;
+  // Incremented for every job, so that threads run each job once.
+  size_t generation_ = 0;
+  size_t pending_replicas_ = 0;
+  Error job_error_ = Error::Ok;
+  bool stopping_ = false;
+  std::vector<std::thread> threads_;
+};
+
+} // namespace torch::executor
@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+/**
+ * @file
+ *
+ * Measures the latency/throughput tradeoff of RequestBatcher: --num_clients
+ * threads send single-row requests back to back, for every combination of
+ * --batch_sizes and --max_wait_us. Batch size 1 is the unbatched baseline.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gflags/gflags.h>
+
+#include <executorch/extension/batching/request_batcher.h>
+#include <executorch/runtime/platform/log.h>
+
+DEFINE_string(
+    model_path,
+    "model.pte",
+    "Model serialized in flatbuffer format, with a batch dimension.");
+DEFINE_string(method_name, "forward", "Method to run.");
+DEFINE_int32(num_clients, 8, "Number of threads sending requests.");
+DEFINE_int32(requests_per_client, 100, "Requests sent by each thread.");
+DEFINE_string(batch_sizes, "1,2,4,8", "Comma separated max_batch_size values.");
+DEFINE_string(max_wait_us, "0,500,2000", "Comma separated max_wait values.");
+
+using namespace torch::executor;
+
+namespace {
+
+std::vector<int64_t> parse_list(const std::string& list) {
+  std::vector<int64_t> values;
+  std::stringstream stream(list);
+  std::string item;
+  while (std::getline(stream, item, ',')) {
+    values.push_back(std::stoll(item));
+  }
+  return values;
+}
+
+// A single-row input tensor filled with zeros.
+struct RowInput {
+  std::vector<exec_aten::SizesType> sizes;
+  std::vector<exec_aten::DimOrderType> dim_order;
+  std::vector<uint8_t> data;
+  std::unique_ptr<TensorImpl> impl;
+};
+
+double percentile(std::vector<double> values, double p) {
+  std::sort(values.begin(), values.end());
+  return values[std::min(values.size() - 1, size_t(p * values.size()))];
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+
+  Module module(FLAGS_model_path);
+  auto meta = module.method_meta(FLAGS_method_name);
+  ET_CHECK_MSG(
+      meta.ok(),
+      "Failed to load %s: 0x%" PRIx32,
+      FLAGS_method_name.c_str(),
+      (uint32_t)meta.error());
+
+  std::vector<RowInput> rows(meta->num_inputs());
+  std::vector<EValue> inputs;
+  for (size_t i = 0; i < meta->num_inputs(); ++i) {
+    auto info = meta->input_tensor_meta(i);
+    ET_CHECK_MSG(info.ok(), "Input %zu is not a tensor", i);
+    RowInput& row = rows[i];
+    row.sizes.assign(info->sizes().begin(), info->sizes().end());
+    row.dim_order.assign(info->dim_order().begin(), info->dim_order().end());
+    row.data.resize(info->nbytes() / row.sizes[0]);
+    row.sizes[0] = 1;
+    row.impl = std::make_unique<TensorImpl>(
+        info->scalar_type(),
+        row.sizes.size(),
+        row.sizes.data(),
+        row.data.data(),
+        row.dim_order.data());
+    inputs.emplace_back(exec_aten::Tensor(row.impl.get()));
+  }
+
+  for (int64_t batch_size : parse_list(FLAGS_batch_sizes)) {
+    for (int64_t max_wait_us : parse_list(FLAGS_max_wait_us)) {
+      BatchingConfig config;
+      config.max_batch_size = batch_size;
+      config.max_wait = std::chrono::microseconds(max_wait_us);
+      auto batcher =
+          RequestBatcher::create(&module, FLAGS_method_name, config);
+      ET_CHECK_MSG(
+          batcher.ok(),
+          "Cannot batch %s: 0x%" PRIx32,
+          FLAGS_method_name.c_str(),
+          (uint32_t)batcher.error());
+
+      std::vector<std::vector<double>> latencies(FLAGS_num_clients);
+      const auto start = std::chrono::steady_clock::now();
+      std::vector<std::thread> clients;
+      for (int32_t c = 0; c < FLAGS_num_clients; ++c) {
+        clients.emplace_back([&, c] {
+          for (int32_t r = 0; r < FLAGS_requests_per_client; ++r) {
+            const auto sent = std::chrono::steady_clock::now();
+            Error err = batcher.get()->execute(
+                inputs, [](const std::vector<EValue>&) {});
+            ET_CHECK_MSG(err == Error::Ok, "Request failed");
+            latencies[c].push_back(
+                std::chrono::duration<double, std::micro>(
+                    std::chrono::steady_clock::now() - sent)
+                    .count());
+          }
+        });
+      }
+      for (auto& client : clients) {
+        client.join();
+      }
+      const double seconds = std::chrono::duration<double>(
+                                 std::chrono::steady_clock::now() - start)
+                                 .count();
+
+      std::vector<double> all;
+      for (const auto& l : latencies) {
+        all.insert(all.end(), l.begin(), l.end());
+      }
+      ET_LOG(
+          Info,
+          "batch %" PRId64 " wait %" PRId64
+          "us: %.1f requests/s, %.2f requests/batch, "
+          "latency p50 %.0fus p99 %.0fus",
+          batch_size,
+          max_wait_us,
+          all.size() / seconds,
+          double(batcher.get()->num_requests()) / batcher.get()->num_batches(),
+          percentile(all, 0.5),
+          percentile(all, 0.99));
+    }
+  }
+  return 0;
+}
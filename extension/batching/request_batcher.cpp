@@ -0,0 +1,385 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <executorch/extension/batching/request_batcher.h>
+
+#include <algorithm>
+#include <cinttypes>
+#include <cmath>
+#include <cstring>
+
+#include <executorch/runtime/core/exec_aten/util/tensor_util.h>
+#include <executorch/runtime/platform/log.h>
+
+namespace torch::executor {
+
+namespace {
+
+// Same comparison as Method::set_input(), which scalar inputs must pass.
+bool same_scalar(const EValue& a, const EValue& b) {
+  if (a.tag != b.tag) {
+    return false;
+  }
+  if (a.isInt()) {
+    return a.toInt() == b.toInt();
+  }
+  if (a.isBool()) {
+    return a.toBool() == b.toBool();
+  }
+  const double lhs = a.toDouble();
+  const double rhs = b.toDouble();
+  if (std::isnan(lhs) && std::isnan(rhs)) {
+    return true;
+  }
+  if (!std::isfinite(lhs) && !std::isfinite(rhs)) {
+    return (lhs > 0) == (rhs > 0);
+  }
+  return std::abs(lhs - rhs) <= 1e-4 + std::abs(1e-5 * rhs);
+}
+
+} // namespace
+
+/// A tensor with the rows of one request of a batched output.
+struct RequestBatcher::TensorView {
+  std::vector<exec_aten::SizesType> sizes;
+  std::vector<exec_aten::DimOrderType> dim_order;
+  std::vector<exec_aten::StridesType> strides;
+  std::unique_ptr<TensorImpl> impl;
+};
+
+struct RequestBatcher::Request {
+  const std::vector<EValue>* inputs = nullptr;
+  size_t rows = 0;
+  std::chrono::steady_clock::time_point arrival;
+
+  // Set by the worker when the batch is done, or by the destructor if the
+  // request never ran. Only requests that ran in a batch have outputs to
+  // release.
+  bool done = false;
+  bool in_batch = false;
+  Error error = Error::Ok;
+  std::vector<EValue> outputs;
+  std::vector<TensorView> views;
+};
+
+RequestBatcher::RequestBatcher(Method* method, const BatchingConfig& config)
+    : method_(method), max_wait_(config.max_wait) {}
+
+Result<std::unique_ptr<RequestBatcher>> RequestBatcher::create(
+    Module* module,
+    const std::string& method_name,
+    const BatchingConfig& config) {
+  ET_CHECK_OR_RETURN_ERROR(
+      module != nullptr, InvalidArgument, "Module must not be null");
+  ET_CHECK_OR_RETURN_ERROR(
+      config.max_batch_size > 0,
+      InvalidArgument,
+      "max_batch_size must be positive");
+  Method* method = ET_UNWRAP(module->experimental_get_method(method_name));
+
+  std::unique_ptr<RequestBatcher> batcher(new RequestBatcher(method, config));
+  ET_CHECK_OK_OR_RETURN_ERROR(
+      batcher->init(method->method_meta(), config.max_batch_size));
+  batcher->worker_ = std::thread([b = batcher.get()] { b->worker_loop(); });
+  return batcher;
+}
+
+RequestBatcher::~RequestBatcher() {
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    stopping_ = true;
+  }
+  request_ready_.notify_all();
+  batch_done_.notify_all();
+  if (worker_.joinable()) {
+    worker_.join();
+  }
+
+  // Fail the requests that the worker did not get to, and wait for their
+  // callers, and those of the last batch, to return from execute().
+  std::unique_lock<std::mutex> lock(mutex_);
+  for (Request* request : queue_) {
+    request->error = Error::Cancelled;
+    request->done = true;
+  }
+  queue_.clear();
+  queued_rows_ = 0;
+  batch_done_.notify_all();
+  batch_done_.wait(lock, [this] { return num_callers_ == 0; });
+}
+
+Error RequestBatcher::init(const MethodMeta& meta, size_t max_batch_size) {
+  const size_t num_inputs = meta.num_inputs();
+  method_inputs_.resize(num_inputs);
+  ET_CHECK_OK_OR_RETURN_ERROR(
+      method_->get_inputs(method_inputs_.data(), num_inputs));
+  input_sizes_.resize(num_inputs);
+  input_types_.resize(num_inputs, exec_aten::ScalarType::Undefined);
+  bool has_tensor_input = false;
+  for (size_t i = 0; i < num_inputs; ++i) {
+    const EValue& input = method_inputs_[i];
+    if (input.isInt() || input.isDouble() || input.isBool()) {
+      continue;
+    }
+    ET_CHECK_OR_RETURN_ERROR(
+        input.isTensor(),
+        NotSupported,
+        "Input %zu is neither a tensor nor a scalar",
+        i);
+    const exec_aten::Tensor& t = input.toTensor();
+    ET_CHECK_OR_RETURN_ERROR(
+        t.const_data_ptr() != nullptr,
+        NotSupported,
+        "Input %zu is not memory planned",
+        i);
+    auto info = ET_UNWRAP(meta.input_tensor_meta(i));
+    ET_CHECK_OR_RETURN_ERROR(
+        info.sizes().size() > 0 && info.dim_order()[0] == 0,
+        NotSupported,
+        "Input %zu has no outermost batch dimension",
+        i);
+    input_sizes_[i].assign(info.sizes().begin(), info.sizes().end());
+    input_types_[i] = info.scalar_type();
+
+    const size_t planned = input_sizes_[i][0];
+    const bool dynamic = t.unsafeGetTensorImpl()->shape_dynamism() !=
+        TensorShapeDynamism::STATIC;
+    if (!has_tensor_input) {
+      planned_batch_size_ = planned;
+      dynamic_batch_ = dynamic;
+      has_tensor_input = true;
+    }
+    ET_CHECK_OR_RETURN_ERROR(
+        planned == planned_batch_size_ && dynamic == dynamic_batch_,
+        NotSupported,
+        "Input %zu has batch size %zu (%s), input 0 has %zu (%s)",
+        i,
+        planned,
+        dynamic ? "dynamic" : "static",
+        planned_batch_size_,
+        dynamic_batch_ ? "dynamic" : "static");
+  }
+  ET_CHECK_OR_RETURN_ERROR(
+      has_tensor_input, NotSupported, "Method has no tensor inputs");
+  max_batch_size_ = std::min(max_batch_size, planned_batch_size_);
+  return Error::Ok;
+}
+
+Error RequestBatcher::validate(const std::vector<EValue>& inputs, size_t* rows)
+    const {
+  ET_CHECK_OR_RETURN_ERROR(
+      inputs.size() == input_sizes_.size(),
+      InvalidArgument,
+      "Got %zu inputs, the method has %zu",
+      inputs.size(),
+      input_sizes_.size());
+  *rows = 0;
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    const std::vector<exec_aten::SizesType>& sizes = input_sizes_[i];
+    if (sizes.empty()) {
+      // Scalar inputs are never modified, so reading them concurrently with
+      // the worker is fine.
+      ET_CHECK_OR_RETURN_ERROR(
+          same_scalar(inputs[i], method_inputs_[i]),
+          InvalidArgument,
+          "Input %zu does not match the traced value",
+          i);
+      continue;
+    }
+    ET_CHECK_OR_RETURN_ERROR(
+        inputs[i].isTensor(), InvalidArgument, "Input %zu is not a tensor", i);
+    const exec_aten::Tensor& t = inputs[i].toTensor();
+    ET_CHECK_OR_RETURN_ERROR(
+        t.scalar_type() == input_types_[i] &&
+            static_cast<size_t>(t.dim()) == sizes.size() &&
+            std::equal(sizes.begin() + 1, sizes.end(), t.sizes().begin() + 1),
+        InvalidArgument,
+        "Input %zu does not have the dtype and sizes of the method's input",
+        i);
+    if (*rows == 0) {
+      *rows = t.size(0);
+    }
+    ET_CHECK_OR_RETURN_ERROR(
+        static_cast<size_t>(t.size(0)) == *rows,
+        InvalidArgument,
+        "Input %zu has %zu rows, expected %zu",
+        i,
+        static_cast<size_t>(t.size(0)),
+        *rows);
+  }
+  ET_CHECK_OR_RETURN_ERROR(
+      *rows > 0 && *rows <= max_batch_size_,
+      InvalidArgument,
+      "Requests must have between 1 and %zu rows, got %zu",
+      max_batch_size_,
+      *rows);
+  return Error::Ok;
+}
+
+Error RequestBatcher::execute(
+    const std::vector<EValue>& inputs,
+    const OutputCallback& on_outputs) {
+  Request request;
+  request.inputs = &inputs;
+  ET_CHECK_OK_OR_RETURN_ERROR(validate(inputs, &request.rows));
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  ET_CHECK_OR_RETURN_ERROR(
+      !stopping_, InvalidState, "The batcher is being destroyed");
+  num_callers_++;
+  request.arrival = std::chrono::steady_clock::now();
+  queue_.push_back(&request);
+  queued_rows_ += request.rows;
+  request_ready_.notify_one();
+  batch_done_.wait(lock, [&] { return request.done; });
+
+  if (request.in_batch) {
+    lock.unlock();
+    if (request.error == Error::Ok) {
+      on_outputs(request.outputs);
+    }
+    lock.lock();
+    // The worker reuses the outputs once every request of the batch is done
+    // with them.
+    pending_callbacks_--;
+  }
+  num_callers_--;
+  batch_done_.notify_all();
+  return request.error;
+}
+
+Error RequestBatcher::run_batch(
+    const std::vector<Request*>& batch,
+    size_t rows) {
+  const size_t batch_rows = dynamic_batch_ ? rows : planned_batch_size_;
+
+  // Copy the inputs of the requests one after the other into the planned
+  // input tensors, instead of going through set_input().
+  for (size_t i = 0; i < input_sizes_.size(); ++i) {
+    if (input_sizes_[i].empty()) {
+      continue;
+    }
+    exec_aten::Tensor dst = method_inputs_[i].toTensor();
+    std::vector<exec_aten::SizesType> sizes = input_sizes_[i];
+    sizes[0] = batch_rows;
+    ET_CHECK_OK_OR_RETURN_ERROR(
+        resize_tensor(dst, {sizes.data(), sizes.size()}));
+    uint8_t* data = dst.mutable_data_ptr<uint8_t>();
+    for (const Request* request : batch) {
+      const exec_aten::Tensor& src = (*request->inputs)[i].toTensor();
+      std::memcpy(data, src.const_data_ptr(), src.nbytes());
+      data += src.nbytes();
+    }
+    // Pad static batches.
+    uint8_t* end = dst.mutable_data_ptr<uint8_t>() + dst.nbytes();
+    std::memset(data, 0, end - data);
+  }
+
+  ET_CHECK_OK_OR_RETURN_ERROR(method_->execute());
+  const size_t num_outputs = method_->outputs_size();
+  std::vector<EValue> outputs(num_outputs);
+  ET_CHECK_OK_OR_RETURN_ERROR(method_->get_outputs(outputs.data(), num_outputs));
+
+  // Give every request a view of its rows of the batched outputs.
+  size_t row = 0;
+  for (Request* request : batch) {
+    request->outputs = outputs;
+    request->views.reserve(num_outputs);
+    for (size_t o = 0; o < num_outputs; ++o) {
+      if (!outputs[o].isTensor()) {
+        continue;
+      }
+      const exec_aten::Tensor& t = outputs[o].toTensor();
+      if (t.dim() == 0 || static_cast<size_t>(t.size(0)) != batch_rows ||
+          t.dim_order()[0] != 0) {
+        continue;
+      }
+      TensorView view;
+      view.sizes.assign(t.sizes().begin(), t.sizes().end());
+      view.sizes[0] = request->rows;
+      view.dim_order.assign(t.dim_order().begin(), t.dim_order().end());
+      view.strides.assign(t.strides().begin(), t.strides().end());
+      view.impl = std::make_unique<TensorImpl>(
+          t.scalar_type(),
+          t.dim(),
+          view.sizes.data(),
+          t.mutable_data_ptr<uint8_t>() + row * (t.nbytes() / batch_rows),
+          view.dim_order.data(),
+          view.strides.data());
+      request->outputs[o] = EValue(exec_aten::Tensor(view.impl.get()));
+      request->views.push_back(std::move(view));
+    }
+    row += request->rows;
+  }
+  return Error::Ok;
+}
+
+void RequestBatcher::worker_loop() {
+  while (true) {
+    std::vector<Request*> batch;
+    size_t rows = 0;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      batch_done_.wait(
+          lock, [this] { return stopping_ || pending_callbacks_ == 0; });
+      request_ready_.wait(
+          lock, [this] { return stopping_ || !queue_.empty(); });
+      if (stopping_) {
+        return;
+      }
+      // Wait for more requests, up to max_wait_ after the first one arrived.
+      const auto deadline = queue_.front()->arrival + max_wait_;
+      request_ready_.wait_until(lock, deadline, [this] {
+        return stopping_ || queued_rows_ >= max_batch_size_;
+      });
+      if (stopping_) {
+        return;
+      }
+      while (!queue_.empty() &&
+             rows + queue_.front()->rows <= max_batch_size_) {
+        rows += queue_.front()->rows;
+        batch.push_back(queue_.front());
+        queue_.pop_front();
+      }
+      queued_rows_ -= rows;
+    }
+
+    const Error err = run_batch(batch, rows);
+    if (err != Error::Ok) {
+      ET_LOG(
+          Error,
+          "Batch of %zu requests failed: 0x%" PRIx32,
+          batch.size(),
+          static_cast<uint32_t>(err));
+    }
+    {
+      std::lock_guard<std::mutex> guard(mutex_);
+      for (Request* request : batch) {
+        request->error = err;
+        request->done = true;
+        request->in_batch = true;
+      }
+      pending_callbacks_ = batch.size();
+      num_batches_++;
+      num_requests_ += batch.size();
+    }
+    batch_done_.notify_all();
+  }
+}
+
+size_t RequestBatcher::num_batches() const {
+  std::lock_guard<std::mutex> guard(mutex_);
+  return num_batches_;
+}
+
+size_t RequestBatcher::num_requests() const {
+  std::lock_guard<std::mutex> guard(mutex_);
+  return num_requests_;
+}
+
+} // namespace torch::executor
@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+// @nolint PATTERNLINT Ok to use stdlib for this optional library
+#include <chrono>
+// @nolint PATTERNLINT Ok to use stdlib for this optional library
+#include <condition_variable>
+// @nolint PATTERNLINT Ok to use stdlib for this optional library
+#include <deque>
+// @nolint PATTERNLINT Ok to use stdlib for this optional library
+#include <functional>
+// @nolint PATTERNLINT Ok to use stdlib for this optional library
+#include <memory>
+// @nolint PATTERNLINT Ok to use stdlib for this optional library
+#include <mutex>
+// @nolint PATTERNLINT Ok to use stdlib for this optional library
+#include <string>
+// @nolint PATTERNLINT Ok to use stdlib for this optional library
+#include <thread>
+// @nolint PATTERNLINT Ok to use stdlib for this optional library
+#include <vector>
+
+#include <executorch/extension/module/module.h>
+
+namespace torch::executor {
+
+/**
+ * Options for grouping requests into batches.
+ */
+struct BatchingConfig {
+  /// Largest number of rows (elements of dim 0) in a batch. Also capped by the
+  /// upper bound of dim 0 of the method's inputs.
+  size_t max_batch_size = 8;
+
+  /// How long the first request of a batch may wait for more requests. Zero
+  /// runs every batch as soon as the worker is free, with whatever requests
+  /// arrived in the meantime.
+  std::chrono::microseconds max_wait{1000};
+};
+
+/**
+ * Runs a method of a Module on batches of requests that arrive concurrently,
+ * for models exported with a batch dimension (dim 0 of every tensor input and
+ * output) that is either dynamic with an upper bound or static.
+ *
+ * Callers submit requests of one or more rows from any number of threads. A
+ * worker thread collects requests until the batch is full or the first one
+ * has waited max_wait, copies their tensor inputs one after the other into
+ * the method's memory-planned input tensors, and executes the method once.
+ * Every caller then gets views of its rows of the outputs, without copies.
+ *
+ * If dim 0 of an input is dynamic, the input is resized to the number of rows
+ * in the batch. If it is static, the rows after the last request are filled
+ * with zeros and the method always runs on full batches.
+ *
+ * Requirements on the method:
+ * - All inputs are tensors or scalars. Tensor inputs are memory planned, and
+ *   all of them have a batch dimension.
+ * - The rows of the outputs only depend on the same rows of the inputs.
+ * - Outputs whose dim 0 is not the batch size, and scalar outputs, are passed
+ *   to every request as they are.
+ *
+ * The Module must outlive the RequestBatcher, and the method must not be
+ * executed directly while the RequestBatcher exists.
+ */
+class RequestBatcher final {
+ public:
+  /**
+   * Receives the outputs of a request. Tensor outputs are views into the
+   * method's memory that are only valid until the callback returns. The
+   * worker waits for the callbacks of a batch before it runs the next one,
+   * so callbacks should copy what they need and return.
+   */
+  using OutputCallback = std::function<void(const std::vector<EValue>&)>;
+
+  /**
+   * Loads the method if needed and starts the worker thread.
+   *
+   * @returns The batcher, Error::NotSupported if the method does not meet the
+   *     requirements above, or an error loading the method.
+   */
+  static Result<std::unique_ptr<RequestBatcher>> create(
+      Module* module,
+      const std::string& method_name = "forward",
+      const BatchingConfig& config = {});
+
+  /**
+   * Stops the worker after the batch it is running, if any. Requests still
+   * waiting for a batch fail with Error::Cancelled. Waits for every caller to
+   * return from execute().
+   */
+  ~RequestBatcher();
+
+  RequestBatcher(const RequestBatcher&) = delete;
+  RequestBatcher& operator=(const RequestBatcher&) = delete;
+  RequestBatcher(RequestBatcher&&) = delete;
+  RequestBatcher& operator=(RequestBatcher&&) = delete;
+
+  /**
+   * Runs a request as part of a batch, and blocks until its outputs are
+   * available. Thread safe.
+   *
+   * @param[in] inputs The inputs of the request. Tensors must have the same
+   *     dtype and sizes as the method's inputs, except for dim 0, and the
+   *     same number of rows. Scalars must match the traced values.
+   * @param[in] on_outputs Called on the calling thread with the outputs of the
+   *     request, if it succeeds.
+   *
+   * @returns Error::Ok, Error::InvalidArgument if the inputs do not fit the
+   *     method, Error::Cancelled if the batcher was destroyed before the
+   *     request ran, or the error of the batch.
+   */
+  __ET_NODISCARD Error
+  execute(const std::vector<EValue>& inputs, const OutputCallback& on_outputs);
+
+  /// Returns the largest number of rows in a batch.
+  size_t max_batch_size() const {
+    return max_batch_size_;
+  }
+
+  /// Returns the number of batches run so far.
+  size_t num_batches() const;
+
+  /// Returns the number of requests run so far.
+  size_t num_requests() const;
+
+ private:
+  struct Request;
+  struct TensorView;
+
+  RequestBatcher(Method* method, const BatchingConfig& config);
+
+  Error init(const MethodMeta& meta, size_t max_batch_size);
+  Error validate(const std::vector<EValue>& inputs, size_t* rows) const;
+  Error run_batch(const std::vector<Request*>& batch, size_t rows);
+  void worker_loop();
+
+  Method* method_;
+  const std::chrono::microseconds max_wait_;
+  size_t max_batch_size_ = 0;
+  // Sizes of dim 0 of the tensor inputs and outputs of the method, as
+  // planned. Static inputs always run with this many rows.
+  size_t planned_batch_size_ = 0;
+  // Whether dim 0 of the tensor inputs can be resized.
+  bool dynamic_batch_ = false;
+  // The method's inputs, from get_inputs(). The tensors share their
+  // TensorImpl with the method's inputs, so that resizing and writing them
+  // updates the method's inputs.
+  std::vector<EValue> method_inputs_;
+  // Planned sizes and dtypes of the tensor inputs. Empty sizes for scalars.
+  std::vector<std::vector<exec_aten::SizesType>> input_sizes_;
+  std::vector<exec_aten::ScalarType> input_types_;
+
+  mutable std::mutex mutex_;
+  // Signaled when a request is queued, or when the worker should stop.
+  std::condition_variable request_ready_;
+  // Signaled when a batch finished, when a request is done with its outputs,
+  // and when a caller returns from execute().
+  std::condition_variable batch_done_;
+  std::deque<Request*> queue_;
+  size_t queued_rows_ = 0;
+  // Requests of the last batch that still use its outputs.
+  size_t pending_callbacks_ = 0;
+  // Callers inside execute() that queued a request.
+  size_t num_callers_ = 0;
+  size_t num_batches_ = 0;
+  size_t num_requests_ = 0;
+  bool stopping_ = false;
+  std::thread worker_;
+};
+
+} // namespace torch::executor
@@ -0,0 +1,82 @@
+load("@fbsource//xplat/executorch/build:runtime_wrapper.bzl", "runtime")
+
+def define_common_targets():
+    """Defines targets that should be shared between fbcode and xplat.
+
+    The directory containing this targets.bzl file should also contain both
+    TARGETS and BUCK files that call this function.
+    """
+
+    runtime.cxx_library(
+        name = "request_batcher",
+        srcs = [
+            "request_batcher.cpp",
+        ],
+        exported_headers = [
+            "request_batcher.h",
+        ],
+        visibility = [
+            "//executorch/...",
+            "@EXECUTORCH_CLIENTS",
+        ],
+        exported_deps = [
+            "//executorch/extension/module:module",
+        ],
+        deps = [
+            "//executorch/runtime/core/exec_aten/util:tensor_util",
+            "//executorch/runtime/platform:platform",
+        ],
+    )
+
+    runtime.cxx_library(
+        name = "batch_splitter",
+        srcs = [
+            "batch_splitter.cpp",
+        ],
+        exported_headers = [
+            "batch_splitter.h",
+        ],
+        visibility = [
+            "//executorch/...",
+            "@EXECUTORCH_CLIENTS",
+        ],
+        exported_deps = [
+            "//executorch/extension/module:module",
+        ],
+        deps = [
+            "//executorch/runtime/core/exec_aten/util:tensor_util",
+            "//executorch/runtime/platform:platform",
+        ],
+    )
+
+    # Measures the latency and throughput of concurrent requests for a range of
+    # batch sizes and batching windows.
+    runtime.cxx_binary(
+        name = "batching_benchmark",
+        srcs = [
+            "batching_benchmark.cpp",
+        ],
+        deps = [
+            ":request_batcher",
+            "//executorch/kernels/portable:generated_lib",
+        ],
+        external_deps = [
+            "gflags",
+        ],
+    )
+
+    # Measures the offline throughput of BatchSplitter for a range of replica
+    # counts.
+    runtime.cxx_binary(
+        name = "batch_split_benchmark",
+        srcs = [
+            "batch_split_benchmark.cpp",
+        ],
+        deps = [
+            ":batch_splitter",
+            "//executorch/kernels/portable:generated_lib",
+        ],
+        external_deps = [
+            "gflags",
+        ],
+    )
@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <executorch/extension/batching/batch_splitter.h>
+
+#include <cstdlib>
+#include <vector>
+
+#include <executorch/runtime/core/exec_aten/testing_util/tensor_factory.h>
+#include <executorch/runtime/core/exec_aten/testing_util/tensor_util.h>
+#include <gtest/gtest.h>
+
+using namespace ::testing;
+using exec_aten::ScalarType;
+using exec_aten::Tensor;
+using torch::executor::testing::TensorFactory;
+
+namespace torch::executor {
+
+class BatchSplitterTest : public ::testing::Test {
+ protected:
+  // ModuleLinear computes 3 * x + 2 on a static 2x2 input, i.e. a batch of
+  // two rows.
+  static std::vector<std::unique_ptr<Module>> replicas(
+      size_t count,
+      const char* env = "ET_MODULE_LINEAR_PATH") {
+    std::vector<std::unique_ptr<Module>> modules;
+    for (size_t i = 0; i < count; ++i) {
+      modules.push_back(std::make_unique<Module>(std::getenv(env)));
+    }
+    return modules;
+  }
+};
+
+TEST_F(BatchSplitterTest, SplitsRowsAcrossReplicas) {
+  auto splitter = BatchSplitter::create(replicas(2));
+  ASSERT_EQ(splitter.error(), Error::Ok);
+  EXPECT_EQ(splitter.get()->num_replicas(), 2);
+  EXPECT_EQ(splitter.get()->chunk_rows(), 2);
+
+  // Five rows: the second replica runs a full chunk and a padded one.
+  TensorFactory<ScalarType::Float> tf;
+  std::vector<float> values;
+  std::vector<float> expected;
+  for (int i = 0; i < 10; ++i) {
+    values.push_back(i);
+    expected.push_back(3.0f * i + 2);
+  }
+  const Tensor input = tf.make({5, 2}, values);
+  const Tensor output = tf.zeros({5, 2});
+  EXPECT_EQ(splitter.get()->execute({EValue(input)}, {output}), Error::Ok);
+  EXPECT_TENSOR_EQ(output, tf.make({5, 2}, expected));
+
+  // Fewer rows than replicas.
+  const Tensor one_row = tf.zeros({1, 2});
+  EXPECT_EQ(
+      splitter.get()->execute({EValue(tf.ones({1, 2}))}, {one_row}),
+      Error::Ok);
+  EXPECT_TENSOR_EQ(one_row, tf.make({1, 2}, {5, 5}));
+}
+
+TEST_F(BatchSplitterTest, DescribesOutputs) {
+  auto splitter = BatchSplitter::create(replicas(1));
+  ASSERT_EQ(splitter.error(), Error::Ok);
+  EXPECT_EQ(
+      splitter.get()->output_sizes(0, 7),
+      std::vector<exec_aten::SizesType>({7, 2}));
+  EXPECT_EQ(splitter.get()->output_type(0), ScalarType::Float);
+}
+
+TEST_F(BatchSplitterTest, RejectsTensorsThatDoNotFit) {
+  auto splitter = BatchSplitter::create(replicas(2));
+  ASSERT_EQ(splitter.error(), Error::Ok);
+  TensorFactory<ScalarType::Float> tf;
+
+  // Wrong row size.
+  EXPECT_EQ(
+      splitter.get()->execute({EValue(tf.ones({4, 3}))}, {tf.zeros({4, 3})}),
+      Error::InvalidArgument);
+  // Outputs with the wrong number of rows.
+  EXPECT_EQ(
+      splitter.get()->execute({EValue(tf.ones({4, 2}))}, {tf.zeros({3, 2})}),
+      Error::InvalidArgument);
+  // Wrong number of outputs.
+  EXPECT_EQ(
+      splitter.get()->execute({EValue(tf.ones({4, 2}))}, {}),
+      Error::InvalidArgument);
+}
+
+TEST_F(BatchSplitterTest, RejectsOutputsWithoutTheBatchDimension) {
+  // ModuleDynamicCatUnallocatedIO appends a row to its input, so its rows do
+  // not map to the rows of its output.
+  auto splitter = BatchSplitter::create(
+      replicas(2, "ET_MODULE_DYNAMIC_CAT_UNALLOCATED_IO_PATH"));
+  EXPECT_EQ(splitter.error(), Error::NotSupported);
+}
+
+TEST_F(BatchSplitterTest, RejectsNoReplicas) {
+  EXPECT_EQ(BatchSplitter::create({}).error(), Error::InvalidArgument);
+}
+
+} // namespace torch::executor
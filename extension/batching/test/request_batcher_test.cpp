@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <executorch/extension/batching/request_batcher.h>
+
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+#include <executorch/runtime/core/exec_aten/testing_util/tensor_factory.h>
+#include <executorch/runtime/core/exec_aten/testing_util/tensor_util.h>
+#include <gtest/gtest.h>
+
+using namespace ::testing;
+using exec_aten::ScalarType;
+using exec_aten::Tensor;
+using torch::executor::testing::TensorFactory;
+
+namespace torch::executor {
+
+class RequestBatcherTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    // ModuleLinear computes 3 * x + 2 on a static 2x2 input, i.e. a batch of
+    // two rows.
+    module_ = std::make_unique<Module>(std::getenv("ET_MODULE_LINEAR_PATH"));
+  }
+
+  std::unique_ptr<Module> module_;
+};
+
+TEST_F(RequestBatcherTest, ConcurrentRequestsShareABatch) {
+  BatchingConfig config;
+  config.max_batch_size = 2;
+  // Long enough for both requests to arrive; the batch runs as soon as it is
+  // full.
+  config.max_wait = std::chrono::seconds(10);
+  auto batcher = RequestBatcher::create(module_.get(), "forward", config);
+  ASSERT_EQ(batcher.error(), Error::Ok);
+  EXPECT_EQ(batcher.get()->max_batch_size(), 2);
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 2; ++i) {
+    threads.emplace_back([&, i] {
+      TensorFactory<ScalarType::Float> tf;
+      const Tensor input = tf.make({1, 2}, {float(i), float(10 * i)});
+      const Error err = batcher.get()->execute(
+          {EValue(input)}, [&](const std::vector<EValue>& outputs) {
+            ASSERT_EQ(outputs.size(), 1);
+            EXPECT_TENSOR_EQ(
+                outputs[0].toTensor(),
+                tf.make({1, 2}, {3.0f * i + 2, 30.0f * i + 2}));
+          });
+      EXPECT_EQ(err, Error::Ok);
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(batcher.get()->num_batches(), 1);
+  EXPECT_EQ(batcher.get()->num_requests(), 2);
+}
+
+TEST_F(RequestBatcherTest, LoneRequestRunsAfterTheWindow) {
+  BatchingConfig config;
+  config.max_wait = std::chrono::microseconds(100);
+  auto batcher = RequestBatcher::create(module_.get(), "forward", config);
+  ASSERT_EQ(batcher.error(), Error::Ok);
+
+  TensorFactory<ScalarType::Float> tf;
+  bool called = false;
+  const Error err = batcher.get()->execute(
+      {EValue(tf.make({1, 2}, {1, 2}))},
+      [&](const std::vector<EValue>& outputs) {
+        called = true;
+        // The static batch was padded, but only this request's row is
+        // returned.
+        EXPECT_TENSOR_EQ(outputs[0].toTensor(), tf.make({1, 2}, {5, 8}));
+      });
+  EXPECT_EQ(err, Error::Ok);
+  EXPECT_TRUE(called);
+  EXPECT_EQ(batcher.get()->num_batches(), 1);
+}
+
+TEST_F(RequestBatcherTest, RejectsRequestsThatDoNotFit) {
+  auto batcher = RequestBatcher::create(module_.get());
+  ASSERT_EQ(batcher.error(), Error::Ok);
+  TensorFactory<ScalarType::Float> tf;
+  auto unused = [](const std::vector<EValue>&) { FAIL(); };
+
+  // Wrong row size.
+  EXPECT_EQ(
+      batcher.get()->execute({EValue(tf.ones({1, 3}))}, unused),
+      Error::InvalidArgument);
+  // More rows than the batch.
+  EXPECT_EQ(
+      batcher.get()->execute({EValue(tf.ones({3, 2}))}, unused),
+      Error::InvalidArgument);
+  // Wrong number of inputs.
+  EXPECT_EQ(batcher.get()->execute({}, unused), Error::InvalidArgument);
+  EXPECT_EQ(batcher.get()->num_requests(), 0);
+}
+
+TEST_F(RequestBatcherTest, DestructionCancelsQueuedRequests) {
+  BatchingConfig config;
+  config.max_batch_size = 2;
+  // The lone request keeps waiting for a second one.
+  config.max_wait = std::chrono::seconds(60);
+  auto batcher = RequestBatcher::create(module_.get(), "forward", config);
+  ASSERT_EQ(batcher.error(), Error::Ok);
+  RequestBatcher* raw_batcher = batcher.get().get();
+
+  Error err = Error::Ok;
+  std::thread caller([&] {
+    TensorFactory<ScalarType::Float> tf;
+    err = raw_batcher->execute(
+        {EValue(tf.ones({1, 2}))},
+        [](const std::vector<EValue>&) { FAIL(); });
+  });
+  // Give the request time to be queued.
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  batcher.get().reset();
+  caller.join();
+  EXPECT_EQ(err, Error::Cancelled);
+}
+
+} // namespace torch::executor
@@ -0,0 +1,41 @@
+load("@fbsource//xplat/executorch/build:runtime_wrapper.bzl", "runtime")
+
+def define_common_targets(is_fbcode = False):
+    """Defines targets that should be shared between fbcode and xplat.
+
+    The directory containing this targets.bzl file should also contain both
+    TARGETS and BUCK files that call this function.
+    """
+
+    # The test reads a model file from fbcode, so it only runs there.
+    if not runtime.is_oss and is_fbcode:
+        runtime.cxx_test(
+            name = "request_batcher_test",
+            srcs = [
+                "request_batcher_test.cpp",
+            ],
+            deps = [
+                "//executorch/extension/batching:request_batcher",
+                "//executorch/kernels/portable:generated_lib",
+                "//executorch/runtime/core/exec_aten/testing_util:tensor_util",
+            ],
+            env = {
+                "ET_MODULE_LINEAR_PATH": "$(location fbcode//executorch/test/models:exported_programs[ModuleLinear.pte])",
+            },
+        )
+
+        runtime.cxx_test(
+            name = "batch_splitter_test",
+            srcs = [
+                "batch_splitter_test.cpp",
+            ],
+            deps = [
+                "//executorch/extension/batching:batch_splitter",
+                "//executorch/kernels/portable:generated_lib",
+                "//executorch/runtime/core/exec_aten/testing_util:tensor_util",
+            ],
+            env = {
+                "ET_MODULE_DYNAMIC_CAT_UNALLOCATED_IO_PATH": "$(location fbcode//executorch/test/models:exported_programs[ModuleDynamicCatUnallocatedIO.pte])",
+                "ET_MODULE_LINEAR_PATH": "$(location fbcode//executorch/test/models:exported_programs[ModuleLinear.pte])",
+            },
+        )
@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+/**
+ * @file
+ *
+ * Forks --num_workers processes that each load and run the first method of a
+ * model, and reports their memory while all of them are alive: once with a
+ * program that every worker reads with its own FileDataLoader, and once with a
+ * program loaded into a SharedMemoryDataLoader before the fork.
+ *
+ * RSS counts shared pages in every process that maps them, PSS splits them
+ * between those processes, so the sum of the PSS is the memory the workers
+ * actually take together.
+ */
+
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <gflags/gflags.h>
+
+#include <executorch/extension/data_loader/file_data_loader.h>
+#include <executorch/extension/data_loader/shared_memory_data_loader.h>
+#include <executorch/extension/runner_util/inputs.h>
+#include <executorch/runtime/executor/program.h>
+#include <executorch/runtime/platform/log.h>
+#include <executorch/runtime/platform/runtime.h>
+
+DEFINE_string(
+    model_path,
+    "model.pte",
+    "Model serialized in flatbuffer format.");
+DEFINE_int32(num_workers, 4, "Number of worker processes.");
+
+using namespace torch::executor;
+using torch::executor::util::FileDataLoader;
+using torch::executor::util::SharedMemoryDataLoader;
+
+namespace {
+
+struct MemoryUsage {
+  size_t rss_kb = 0;
+  size_t pss_kb = 0;
+};
+
+MemoryUsage read_memory_usage() {
+  MemoryUsage usage;
+  FILE* file = std::fopen("/proc/self/smaps_rollup", "r");
+  ET_CHECK_MSG(file != nullptr, "Cannot read /proc/self/smaps_rollup");
+  char line[256];
+  while (std::fgets(line, sizeof(line), file) != nullptr) {
+    std::sscanf(line, "Rss: %zu kB", &usage.rss_kb);
+    std::sscanf(line, "Pss: %zu kB", &usage.pss_kb);
+  }
+  std::fclose(file);
+  return usage;
+}
+
+// Loads and runs the first method of the program, then reports the memory of
+// the process.
+MemoryUsage run_worker(DataLoader* loader) {
+  Result<Program> program = Program::load(loader);
+  ET_CHECK_MSG(program.ok(), "Failed to parse %s", FLAGS_model_path.c_str());
+  const char* method_name = program->get_method_name(0).get();
+  Result<MethodMeta> meta = program->method_meta(method_name);
+  ET_CHECK_MSG(meta.ok(), "Failed to get method_meta");
+
+  std::vector<std::vector<uint8_t>> planned_buffers;
+  std::vector<Span<uint8_t>> planned_spans;
+  for (size_t id = 0; id < meta->num_memory_planned_buffers(); ++id) {
+    planned_buffers.emplace_back(
+        static_cast<size_t>(meta->memory_planned_buffer_size(id).get()));
+  }
+  for (auto& buffer : planned_buffers) {
+    planned_spans.emplace_back(buffer.data(), buffer.size());
+  }
+  HierarchicalAllocator planned_memory(
+      {planned_spans.data(), planned_spans.size()});
+  std::vector<uint8_t> method_allocator_pool(4 * 1024U * 1024U);
+  MemoryAllocator method_allocator(
+      method_allocator_pool.size(), method_allocator_pool.data());
+  MemoryManager memory_manager(&method_allocator, &planned_memory);
+
+  Result<Method> method = program->load_method(method_name, &memory_manager);
+  ET_CHECK_MSG(
+      method.ok(),
+      "Loading of method %s failed with status 0x%" PRIx32,
+      method_name,
+      (uint32_t)method.error());
+  auto inputs = util::prepare_input_tensors(*method);
+  ET_CHECK_MSG(inputs.ok(), "Could not prepare inputs");
+  Error err = method->execute();
+  ET_CHECK_MSG(
+      err == Error::Ok, "Execution failed: 0x%" PRIx32, (uint32_t)err);
+  return read_memory_usage();
+}
+
+// Forks the workers, and reports their memory once all of them ran. If
+// shared_loader is null, every worker opens the file itself.
+void measure(const char* label, DataLoader* shared_loader) {
+  int reports[2];
+  int release[2];
+  ET_CHECK_MSG(pipe(reports) == 0 && pipe(release) == 0, "pipe() failed");
+
+  std::vector<pid_t> workers;
+  for (int32_t i = 0; i < FLAGS_num_workers; ++i) {
+    pid_t pid = fork();
+    ET_CHECK_MSG(pid >= 0, "fork() failed");
+    if (pid == 0) {
+      close(reports[0]);
+      close(release[1]);
+      MemoryUsage usage;
+      if (shared_loader != nullptr) {
+        usage = run_worker(shared_loader);
+      } else {
+        Result<FileDataLoader> loader =
+            FileDataLoader::from(FLAGS_model_path.c_str());
+        ET_CHECK_MSG(
+            loader.ok(), "Failed to open %s", FLAGS_model_path.c_str());
+        usage = run_worker(&loader.get());
+      }
+      ET_CHECK(write(reports[1], &usage, sizeof(usage)) == sizeof(usage));
+      // Stay alive until every worker reported, so that shared pages are
+      // split between all of them.
+      char c;
+      (void)read(release[0], &c, 1);
+      _exit(0);
+    }
+    workers.push_back(pid);
+  }
+  close(reports[1]);
+  close(release[0]);
+
+  MemoryUsage total;
+  for (int32_t i = 0; i < FLAGS_num_workers; ++i) {
+    MemoryUsage usage;
+    ET_CHECK(read(reports[0], &usage, sizeof(usage)) == sizeof(usage));
+    total.rss_kb += usage.rss_kb;
+    total.pss_kb += usage.pss_kb;
+  }
+  close(release[1]);
+  for (pid_t pid : workers) {
+    waitpid(pid, nullptr, 0);
+  }
+  close(reports[0]);
+
+  ET_LOG(
+      Info,
+      "%s: %d workers, per worker RSS %zu kB PSS %zu kB, total PSS %zu kB",
+      label,
+      FLAGS_num_workers,
+      total.rss_kb / FLAGS_num_workers,
+      total.pss_kb / FLAGS_num_workers,
+      total.pss_kb);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  runtime_init();
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+
+  measure("private copies", nullptr);
+
+  Result<SharedMemoryDataLoader> loader =
+      SharedMemoryDataLoader::from(FLAGS_model_path.c_str());
+  ET_CHECK_MSG(
+      loader.ok(),
+      "Failed to load %s into shared memory: 0x%" PRIx32,
+      FLAGS_model_path.c_str(),
+      (uint32_t)loader.error());
+  measure("shared memory", &loader.get());
+  return 0;
+}
@@ -0,0 +1,266 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <executorch/extension/data_loader/shared_memory_data_loader.h>
+
+#include <cerrno>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#if defined(__ANDROID__)
+#include <linux/memfd.h>
+#include <sys/syscall.h>
+#endif
+
+#include <executorch/runtime/core/error.h>
+#include <executorch/runtime/core/result.h>
+#include <executorch/runtime/platform/log.h>
+
+namespace torch {
+namespace executor {
+namespace util {
+
+#if defined(__linux__)
+
+namespace {
+
+// Seals that make the contents of the memfd immutable.
+constexpr int kSeals = F_SEAL_SEAL | F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE;
+
+int create_memfd(const char* name, unsigned int flags) {
+#if defined(__ANDROID__) && __ANDROID_API__ < 30
+  // Bionic only declares memfd_create() from API level 30, but the kernel has
+  // had the syscall since Linux 3.17. Older kernels fail with ENOSYS.
+  return static_cast<int>(::syscall(__NR_memfd_create, name, flags));
+#else
+  return ::memfd_create(name, flags);
+#endif
+}
+
+// Copies the contents of src_fd into dst, which has room for size bytes.
+Error read_all(int src_fd, const char* file_name, uint8_t* dst, size_t size) {
+  size_t done = 0;
+  while (done < size) {
+    ssize_t n = ::read(src_fd, dst + done, size - done);
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    if (n <= 0) {
+      ET_LOG(
+          Error,
+          "Failed to read %s at offset %zu: %s (%d)",
+          file_name,
+          done,
+          n == 0 ? "unexpected end of file" : ::strerror(errno),
+          errno);
+      return Error::AccessFailed;
+    }
+    done += static_cast<size_t>(n);
+  }
+  return Error::Ok;
+}
+
+} // namespace
+
+SharedMemoryDataLoader::~SharedMemoryDataLoader() {
+  if (data_ != nullptr) {
+    ::munmap(const_cast<void*>(data_), size_);
+  }
+  // fd_ can be -1 if this instance was moved from, but closing a negative fd is
+  // safe (though it will return an error).
+  ::close(fd_);
+}
+
+Result<SharedMemoryDataLoader> SharedMemoryDataLoader::from(
+    const char* file_name) {
+  int file_fd = ::open(file_name, O_RDONLY);
+  if (file_fd < 0) {
+    ET_LOG(
+        Error,
+        "Failed to open %s: %s (%d)",
+        file_name,
+        ::strerror(errno),
+        errno);
+    return Error::AccessFailed;
+  }
+  struct stat st;
+  if (::fstat(file_fd, &st) < 0) {
+    ET_LOG(
+        Error,
+        "Could not get length of %s: %s (%d)",
+        file_name,
+        ::strerror(errno),
+        errno);
+    ::close(file_fd);
+    return Error::AccessFailed;
+  }
+  const size_t size = st.st_size;
+
+  int fd = create_memfd("executorch_program", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+  if (fd < 0) {
+    ET_LOG(Error, "memfd_create failed: %s (%d)", ::strerror(errno), errno);
+    ::close(file_fd);
+    return Error::NotSupported;
+  }
+  if (::ftruncate(fd, static_cast<off_t>(size)) < 0) {
+    ET_LOG(
+        Error,
+        "Failed to allocate %zu bytes of shared memory: %s (%d)",
+        size,
+        ::strerror(errno),
+        errno);
+    ::close(file_fd);
+    ::close(fd);
+    return Error::MemoryAllocationFailed;
+  }
+
+  // Fill the memfd through a temporary writable mapping. It must be unmapped
+  // before the memfd can be sealed against writes.
+  Error err = Error::Ok;
+  if (size > 0) {
+    void* pages =
+        ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (pages == MAP_FAILED) {
+      ET_LOG(
+          Error,
+          "Failed to map %zu bytes of shared memory: %s (%d)",
+          size,
+          ::strerror(errno),
+          errno);
+      err = Error::MemoryAllocationFailed;
+    } else {
+      err = read_all(file_fd, file_name, static_cast<uint8_t*>(pages), size);
+      ::munmap(pages, size);
+    }
+  }
+  ::close(file_fd);
+  if (err != Error::Ok) {
+    ::close(fd);
+    return err;
+  }
+
+  if (::fcntl(fd, F_ADD_SEALS, kSeals) < 0) {
+    ET_LOG(Error, "Failed to seal memfd: %s (%d)", ::strerror(errno), errno);
+    ::close(fd);
+    return Error::AccessFailed;
+  }
+  return map_sealed(fd, size);
+}
+
+Result<SharedMemoryDataLoader> SharedMemoryDataLoader::from_fd(int fd) {
+  const int seals = ::fcntl(fd, F_GET_SEALS);
+  ET_CHECK_OR_RETURN_ERROR(
+      seals >= 0 && (seals & F_SEAL_WRITE) && (seals & F_SEAL_SHRINK),
+      InvalidArgument,
+      "fd %d is not a memfd sealed against writes",
+      fd);
+  struct stat st;
+  ET_CHECK_OR_RETURN_ERROR(
+      ::fstat(fd, &st) == 0,
+      AccessFailed,
+      "Could not get length of fd %d: %s (%d)",
+      fd,
+      ::strerror(errno),
+      errno);
+  const int owned_fd = ::fcntl(fd, F_DUPFD_CLOEXEC, 0);
+  ET_CHECK_OR_RETURN_ERROR(
+      owned_fd >= 0,
+      AccessFailed,
+      "Failed to duplicate fd %d: %s (%d)",
+      fd,
+      ::strerror(errno),
+      errno);
+  return map_sealed(owned_fd, static_cast<size_t>(st.st_size));
+}
+
+Result<SharedMemoryDataLoader> SharedMemoryDataLoader::map_sealed(
+    int fd,
+    size_t size) {
+  // mmap() fails if the size is zero.
+  const void* data = nullptr;
+  if (size > 0) {
+    void* pages = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    if (pages == MAP_FAILED) {
+      ET_LOG(
+          Error,
+          "Failed to map memfd: mmap(..., size=%zu, ..., fd=%d): %s (%d)",
+          size,
+          fd,
+          ::strerror(errno),
+          errno);
+      ::close(fd);
+      return Error::AccessFailed;
+    }
+    data = pages;
+  }
+  return SharedMemoryDataLoader(data, size, fd);
+}
+
+Result<FreeableBuffer> SharedMemoryDataLoader::Load(
+    size_t offset,
+    size_t size) {
+  ET_CHECK_OR_RETURN_ERROR(
+      // Probably had its value moved to another instance.
+      fd_ >= 0,
+      InvalidState,
+      "Uninitialized");
+  ET_CHECK_OR_RETURN_ERROR(
+      offset + size <= size_,
+      InvalidArgument,
+      "offset %zu + size %zu > size_ %zu",
+      offset,
+      size,
+      size_);
+  // The mapping lives as long as the loader, so there is nothing to free.
+  return FreeableBuffer(
+      static_cast<const uint8_t*>(data_) + offset, size, /*free_fn=*/nullptr);
+}
+
+Result<size_t> SharedMemoryDataLoader::size() const {
+  ET_CHECK_OR_RETURN_ERROR(
+      // Probably had its value moved to another instance.
+      fd_ >= 0,
+      InvalidState,
+      "Uninitialized");
+  return size_;
+}
+
+#else // !defined(__linux__)
+
+SharedMemoryDataLoader::~SharedMemoryDataLoader() {}
+
+Result<SharedMemoryDataLoader> SharedMemoryDataLoader::from(
+    const char* file_name) {
+  ET_LOG(
+      Error, "SharedMemoryDataLoader requires memfd_create(): %s", file_name);
+  return Error::NotSupported;
+}
+
+Result<SharedMemoryDataLoader> SharedMemoryDataLoader::from_fd(int fd) {
+  ET_LOG(Error, "SharedMemoryDataLoader requires memfd_create(): fd %d", fd);
+  return Error::NotSupported;
+}
+
+Result<FreeableBuffer> SharedMemoryDataLoader::Load(size_t, size_t) {
+  return Error::NotSupported;
+}
+
+Result<size_t> SharedMemoryDataLoader::size() const {
+  return Error::NotSupported;
+}
+
+#endif // defined(__linux__)
+
+} // namespace util
+} // namespace executor
+} // namespace torch
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <executorch/runtime/core/data_loader.h>
+#include <executorch/runtime/core/result.h>
+#include <executorch/runtime/platform/compiler.h>
+
+namespace torch {
+namespace executor {
+namespace util {
+
+/**
+ * A DataLoader that serves segments from a read-only copy of a file in
+ * anonymous shared memory, for servers that load a model once and then fork
+ * worker processes.
+ *
+ * `from()` copies the file into a sealed memfd and maps it once. Every Load()
+ * returns a view into that mapping without copying, and forked children
+ * inherit the mapping, so all processes read the same physical pages: a
+ * Program and its constant segments (including weights that were prepacked at
+ * export time) take memory once, rather than once per worker. Since the
+ * mapping is read-only and the memfd is sealed against writes, nothing can
+ * break that sharing with copy-on-write faults.
+ *
+ * Processes that are not forked from the loading process can attach to the
+ * same memory with `from_fd()`, given the descriptor returned by `fd()`, e.g.
+ * passed over a Unix socket.
+ *
+ * Delegates that bind a thread pool when their method is loaded (e.g.
+ * XNNPACK) must load their methods after the fork, because the threads of
+ * the parent do not exist in the child. Program::load() is safe to call
+ * before the fork.
+ *
+ * Only supported on Linux. On other platforms, `from()` and `from_fd()` return
+ * Error::NotSupported.
+ */
+class SharedMemoryDataLoader : public DataLoader {
+ public:
+  /**
+   * Creates a new SharedMemoryDataLoader holding a copy of the named file.
+   *
+   * @param[in] file_name The path to the file to copy. The file is closed
+   *     once copied.
+   */
+  static Result<SharedMemoryDataLoader> from(const char* file_name);
+
+  /**
+   * Creates a new SharedMemoryDataLoader that maps the memfd of another one,
+   * typically created by another process.
+   *
+   * @param[in] fd The descriptor returned by `fd()`. It is duplicated, and the
+   *     caller keeps ownership of it. Fails with Error::InvalidArgument if the
+   *     memfd is not sealed against writes.
+   */
+  static Result<SharedMemoryDataLoader> from_fd(int fd);
+
+  // Movable to be compatible with Result.
+  SharedMemoryDataLoader(SharedMemoryDataLoader&& rhs) noexcept
+      : data_(rhs.data_), size_(rhs.size_), fd_(rhs.fd_) {
+    rhs.data_ = nullptr;
+    rhs.size_ = 0;
+    rhs.fd_ = -1;
+  }
+
+  ~SharedMemoryDataLoader() override;
+
+  __ET_NODISCARD Result<FreeableBuffer> Load(size_t offset, size_t size)
+      override;
+
+  __ET_NODISCARD Result<size_t> size() const override;
+
+  /// Returns the sealed memfd holding the data. Owned by the instance, and
+  /// closed on exec().
+  int fd() const {
+    return fd_;
+  }
+
+ private:
+  SharedMemoryDataLoader(const void* data, size_t size, int fd)
+      : data_(data), size_(size), fd_(fd) {}
+
+  // Maps the whole sealed memfd read-only. Takes ownership of fd.
+  static Result<SharedMemoryDataLoader> map_sealed(int fd, size_t size);
+
+  // Not safely copyable.
+  SharedMemoryDataLoader(const SharedMemoryDataLoader&) = delete;
+  SharedMemoryDataLoader& operator=(const SharedMemoryDataLoader&) = delete;
+  SharedMemoryDataLoader& operator=(SharedMemoryDataLoader&&) = delete;
+
+  const void* data_; // Mapping owned by the instance.
+  size_t size_;
+  int fd_; // Owned by the instance.
+};
+
+} // namespace util
+} // namespace executor
+} // namespace torch
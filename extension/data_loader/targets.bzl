@@ -67,3 +67,34 @@ def define_common_targets():
             "//executorch/runtime/core:core",
         ],
     )
+
+    runtime.cxx_library(
+        name = "shared_memory_data_loader",
+        srcs = ["shared_memory_data_loader.cpp"],
+        exported_headers = ["shared_memory_data_loader.h"],
+        visibility = [
+            "//executorch/extension/pybindings/...",
+            "//executorch/extension/data_loader/test/...",
+            "@EXECUTORCH_CLIENTS",
+        ],
+        exported_deps = [
+            "//executorch/runtime/core:core",
+        ],
+    )
+
+    # Reports the memory of forked workers that run the same model, with the
+    # program in shared memory or copied by each worker.
+    runtime.cxx_binary(
+        name = "prefork_benchmark",
+        srcs = ["prefork_benchmark.cpp"],
+        deps = [
+            ":file_data_loader",
+            ":shared_memory_data_loader",
+            "//executorch/extension/runner_util:inputs",
+            "//executorch/kernels/portable:generated_lib",
+            "//executorch/runtime/executor:program",
+        ],
+        external_deps = [
+            "gflags",
+        ],
+    )
@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <executorch/extension/data_loader/shared_memory_data_loader.h>
+
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+
+#include <executorch/extension/testing_util/temp_file.h>
+#include <executorch/runtime/core/result.h>
+#include <executorch/runtime/platform/runtime.h>
+
+using namespace ::testing;
+using torch::executor::Error;
+using torch::executor::FreeableBuffer;
+using torch::executor::Result;
+using torch::executor::testing::TempFile;
+using torch::executor::util::SharedMemoryDataLoader;
+
+class SharedMemoryDataLoaderTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    // Since these tests cause ET_LOG to be called, the PAL must be initialized
+    // first.
+    torch::executor::runtime_init();
+
+    // Create some heterogeneous data.
+    data_size_ = 3 * sysconf(_SC_PAGESIZE) + 123;
+    data_ = std::make_unique<uint8_t[]>(data_size_);
+    for (size_t i = 0; i < data_size_; ++i) {
+      data_[i] = static_cast<uint8_t>(i * 7);
+    }
+    file_ = std::make_unique<TempFile>(data_.get(), data_size_);
+  }
+
+  size_t data_size_;
+  std::unique_ptr<uint8_t[]> data_;
+  std::unique_ptr<TempFile> file_;
+};
+
+TEST_F(SharedMemoryDataLoaderTest, InBoundsLoadsSucceed) {
+  Result<SharedMemoryDataLoader> loader =
+      SharedMemoryDataLoader::from(file_->path().c_str());
+  ASSERT_EQ(loader.error(), Error::Ok);
+
+  Result<size_t> size = loader->size();
+  ASSERT_EQ(size.error(), Error::Ok);
+  EXPECT_EQ(*size, data_size_);
+
+  const size_t offset = 1000;
+  const size_t length = data_size_ - offset;
+  Result<FreeableBuffer> fb = loader->Load(offset, length);
+  ASSERT_EQ(fb.error(), Error::Ok);
+  EXPECT_EQ(fb->size(), length);
+  EXPECT_EQ(0, std::memcmp(fb->data(), &data_[offset], length));
+
+  // Loads are views of the same mapping, not copies.
+  Result<FreeableBuffer> again = loader->Load(offset, 10);
+  ASSERT_EQ(again.error(), Error::Ok);
+  EXPECT_EQ(again->data(), fb->data());
+
+  // Loading zero-sized data succeeds, even at the end of the data.
+  Result<FreeableBuffer> empty = loader->Load(data_size_, 0);
+  ASSERT_EQ(empty.error(), Error::Ok);
+  EXPECT_EQ(empty->size(), 0);
+}
+
+TEST_F(SharedMemoryDataLoaderTest, OutOfBoundsLoadFails) {
+  Result<SharedMemoryDataLoader> loader =
+      SharedMemoryDataLoader::from(file_->path().c_str());
+  ASSERT_EQ(loader.error(), Error::Ok);
+
+  Result<FreeableBuffer> fb = loader->Load(data_size_ - 1, 2);
+  EXPECT_NE(fb.error(), Error::Ok);
+}
+
+TEST_F(SharedMemoryDataLoaderTest, FromMissingFileFails) {
+  Result<SharedMemoryDataLoader> loader =
+      SharedMemoryDataLoader::from("/no/such/file/exists");
+  EXPECT_NE(loader.error(), Error::Ok);
+}
+
+TEST_F(SharedMemoryDataLoaderTest, MemfdIsSealed) {
+  Result<SharedMemoryDataLoader> loader =
+      SharedMemoryDataLoader::from(file_->path().c_str());
+  ASSERT_EQ(loader.error(), Error::Ok);
+
+  // Nobody can modify the contents, so they can't diverge between processes.
+  EXPECT_EQ(::write(loader->fd(), "x", 1), -1);
+  EXPECT_EQ(
+      ::mmap(
+          nullptr, data_size_, PROT_WRITE, MAP_SHARED, loader->fd(), /*off=*/0),
+      MAP_FAILED);
+}
+
+TEST_F(SharedMemoryDataLoaderTest, FromFdSharesTheMemory) {
+  Result<SharedMemoryDataLoader> loader =
+      SharedMemoryDataLoader::from(file_->path().c_str());
+  ASSERT_EQ(loader.error(), Error::Ok);
+
+  Result<SharedMemoryDataLoader> attached =
+      SharedMemoryDataLoader::from_fd(loader->fd());
+  ASSERT_EQ(attached.error(), Error::Ok);
+  EXPECT_NE(attached->fd(), loader->fd());
+  EXPECT_EQ(*attached->size(), data_size_);
+  Result<FreeableBuffer> fb = attached->Load(0, data_size_);
+  ASSERT_EQ(fb.error(), Error::Ok);
+  EXPECT_EQ(0, std::memcmp(fb->data(), data_.get(), data_size_));
+}
+
+TEST_F(SharedMemoryDataLoaderTest, FromFdRejectsUnsealedFiles) {
+  int fd = ::open(file_->path().c_str(), O_RDONLY);
+  ASSERT_GE(fd, 0);
+  Result<SharedMemoryDataLoader> loader = SharedMemoryDataLoader::from_fd(fd);
+  EXPECT_EQ(loader.error(), Error::InvalidArgument);
+  ::close(fd);
+}
+
+TEST_F(SharedMemoryDataLoaderTest, ForkedChildReadsTheSameMemory) {
+  Result<SharedMemoryDataLoader> loader =
+      SharedMemoryDataLoader::from(file_->path().c_str());
+  ASSERT_EQ(loader.error(), Error::Ok);
+  Result<FreeableBuffer> fb = loader->Load(0, data_size_);
+  ASSERT_EQ(fb.error(), Error::Ok);
+
+  pid_t pid = fork();
+  ASSERT_GE(pid, 0);
+  if (pid == 0) {
+    // The inherited view is still valid and holds the data.
+    _exit(std::memcmp(fb->data(), data_.get(), data_size_) == 0 ? 0 : 1);
+  }
+  int status = 0;
+  ASSERT_EQ(waitpid(pid, &status, 0), pid);
+  EXPECT_TRUE(WIFEXITED(status));
+  EXPECT_EQ(WEXITSTATUS(status), 0);
+}
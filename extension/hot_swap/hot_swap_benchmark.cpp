@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+/**
+ * @file
+ *
+ * Measures the latency of --num_clients threads that run the model back to
+ * back, first with a fixed model, then while the model is swapped for a new
+ * copy of itself every --swap_interval_ms. A swap that pauses serving shows
+ * up in the p99 and max latencies.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cinttypes>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <gflags/gflags.h>
+
+#include <executorch/extension/hot_swap/hot_swap_module.h>
+#include <executorch/runtime/platform/log.h>
+
+DEFINE_string(
+    model_path,
+    "model.pte",
+    "Model serialized in flatbuffer format.");
+DEFINE_int32(num_clients, 4, "Number of threads sending requests.");
+DEFINE_int32(duration_ms, 2000, "How long to send requests, per run.");
+DEFINE_int32(swap_interval_ms, 200, "Time between swaps.");
+
+using namespace torch::executor;
+
+namespace {
+
+// A tensor input of the planned size, filled with zeros.
+struct Input {
+  std::vector<exec_aten::SizesType> sizes;
+  std::vector<exec_aten::DimOrderType> dim_order;
+  std::vector<uint8_t> data;
+  std::unique_ptr<TensorImpl> impl;
+};
+
+double percentile(std::vector<double> values, double p) {
+  std::sort(values.begin(), values.end());
+  return values[std::min(values.size() - 1, size_t(p * values.size()))];
+}
+
+void measure(
+    const char* label,
+    HotSwapModule& module,
+    const std::vector<EValue>& inputs,
+    bool swap) {
+  std::atomic<bool> stop{false};
+  std::vector<std::vector<double>> latencies(FLAGS_num_clients);
+  std::vector<std::thread> clients;
+  for (int32_t c = 0; c < FLAGS_num_clients; ++c) {
+    clients.emplace_back([&, c] {
+      while (!stop) {
+        const auto sent = std::chrono::steady_clock::now();
+        auto outputs = module.forward(inputs);
+        ET_CHECK_MSG(outputs.ok(), "Request failed");
+        latencies[c].push_back(std::chrono::duration<double, std::micro>(
+                                   std::chrono::steady_clock::now() - sent)
+                                   .count());
+      }
+    });
+  }
+
+  size_t num_swaps = 0;
+  const auto end = std::chrono::steady_clock::now() +
+      std::chrono::milliseconds(FLAGS_duration_ms);
+  while (std::chrono::steady_clock::now() < end) {
+    std::this_thread::sleep_for(
+        std::chrono::milliseconds(FLAGS_swap_interval_ms));
+    if (swap) {
+      Error err = module.swap(std::make_unique<Module>(FLAGS_model_path));
+      ET_CHECK_MSG(
+          err == Error::Ok, "Swap failed: 0x%" PRIx32, (uint32_t)err);
+      num_swaps++;
+    }
+  }
+  stop = true;
+  for (auto& client : clients) {
+    client.join();
+  }
+
+  std::vector<double> all;
+  for (const auto& l : latencies) {
+    all.insert(all.end(), l.begin(), l.end());
+  }
+  ET_LOG(
+      Info,
+      "%s: %zu requests, %zu swaps, latency p50 %.0fus p99 %.0fus max %.0fus",
+      label,
+      all.size(),
+      num_swaps,
+      percentile(all, 0.5),
+      percentile(all, 0.99),
+      percentile(all, 1.0));
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+
+  auto module = std::make_unique<Module>(FLAGS_model_path);
+  auto meta = module->method_meta("forward");
+  ET_CHECK_MSG(
+      meta.ok(), "Failed to load forward: 0x%" PRIx32, (uint32_t)meta.error());
+  std::vector<Input> tensors(meta->num_inputs());
+  std::vector<EValue> inputs;
+  for (size_t i = 0; i < meta->num_inputs(); ++i) {
+    auto info = meta->input_tensor_meta(i);
+    ET_CHECK_MSG(info.ok(), "Input %zu is not a tensor", i);
+    Input& input = tensors[i];
+    input.sizes.assign(info->sizes().begin(), info->sizes().end());
+    input.dim_order.assign(info->dim_order().begin(), info->dim_order().end());
+    input.data.resize(info->nbytes());
+    input.impl = std::make_unique<TensorImpl>(
+        info->scalar_type(),
+        input.sizes.size(),
+        input.sizes.data(),
+        input.data.data(),
+        input.dim_order.data());
+    inputs.emplace_back(exec_aten::Tensor(input.impl.get()));
+  }
+
+  auto hot_swap_module = HotSwapModule::create(std::move(module));
+  ET_CHECK_MSG(
+      hot_swap_module.ok(),
+      "Failed to prepare the model: 0x%" PRIx32,
+      (uint32_t)hot_swap_module.error());
+
+  measure("fixed model", *hot_swap_module.get(), inputs, /*swap=*/false);
+  measure("with swaps", *hot_swap_module.get(), inputs, /*swap=*/true);
+  return 0;
+}
@@ -0,0 +1,199 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <executorch/extension/hot_swap/hot_swap_module.h>
+
+#include <algorithm>
+#include <unordered_map>
+
+#include <executorch/extension/runner_util/inputs.h>
+#include <executorch/runtime/platform/log.h>
+
+namespace torch::executor {
+
+namespace {
+
+// Returns the bytes of memory-planned buffers that Module::load_method()
+// allocates for the given methods. Shared buffers are allocated once.
+Result<size_t> planned_bytes(
+    Module& module,
+    const std::vector<std::string>& method_names) {
+  size_t total = 0;
+  std::unordered_map<size_t, size_t> shared;
+  for (const auto& method_name : method_names) {
+    // Only loads the program, not the method.
+    const auto meta = ET_UNWRAP(module.method_meta(method_name));
+    for (size_t id = 0; id < meta.num_memory_planned_buffers(); ++id) {
+      const auto size =
+          static_cast<size_t>(ET_UNWRAP(meta.memory_planned_buffer_size(id)));
+      if (ET_UNWRAP(meta.memory_planned_buffer_is_shared(id))) {
+        shared[id] = std::max(shared[id], size);
+      } else {
+        total += size;
+      }
+    }
+  }
+  for (const auto& entry : shared) {
+    total += entry.second;
+  }
+  return total;
+}
+
+} // namespace
+
+HotSwapModule::HotSwapModule(const HotSwapConfig& config) : config_(config) {}
+
+Result<std::unique_ptr<HotSwapModule>> HotSwapModule::create(
+    std::unique_ptr<Module> module,
+    const HotSwapConfig& config) {
+  std::unique_ptr<HotSwapModule> hot_swap_module(new HotSwapModule(config));
+  auto version = hot_swap_module->prepare(std::move(module));
+  if (!version.ok()) {
+    return version.error();
+  }
+  hot_swap_module->current_ = std::move(version.get());
+  return hot_swap_module;
+}
+
+HotSwapModule::~HotSwapModule() {
+  if (swap_thread_.joinable()) {
+    swap_thread_.join();
+  }
+}
+
+Result<std::vector<EValue>> HotSwapModule::execute(
+    const std::string& method_name,
+    const std::vector<EValue>& input) {
+  Version* version;
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    version = current_.get();
+    version->in_flight++;
+  }
+  Result<std::vector<EValue>> outputs = [&] {
+    std::lock_guard<std::mutex> guard(version->execute_mutex);
+    return version->module->execute(method_name, input);
+  }();
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    if (--version->in_flight == 0) {
+      drained_.notify_all();
+    }
+  }
+  return outputs;
+}
+
+Error HotSwapModule::swap(std::unique_ptr<Module> module) {
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    ET_CHECK_OR_RETURN_ERROR(
+        !swapping_, InvalidState, "Another swap is running");
+    swapping_ = true;
+  }
+  const Error err = do_swap(std::move(module));
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    swapping_ = false;
+  }
+  return err;
+}
+
+Error HotSwapModule::swap_async(
+    std::unique_ptr<Module> module,
+    std::function<void(Error)> on_done) {
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    ET_CHECK_OR_RETURN_ERROR(
+        !swapping_, InvalidState, "Another swap is running");
+    swapping_ = true;
+  }
+  // The previous swap thread cleared swapping_, so it is about to exit.
+  if (swap_thread_.joinable()) {
+    swap_thread_.join();
+  }
+  swap_thread_ = std::thread([this,
+                              module = std::move(module),
+                              on_done = std::move(on_done)]() mutable {
+    const Error err = do_swap(std::move(module));
+    {
+      std::lock_guard<std::mutex> guard(mutex_);
+      swapping_ = false;
+    }
+    if (on_done) {
+      on_done(err);
+    }
+  });
+  return Error::Ok;
+}
+
+size_t HotSwapModule::version() const {
+  std::lock_guard<std::mutex> guard(mutex_);
+  return version_;
+}
+
+Result<std::unique_ptr<HotSwapModule::Version>> HotSwapModule::prepare(
+    std::unique_ptr<Module> module) {
+  ET_CHECK_OR_RETURN_ERROR(
+      module != nullptr, InvalidArgument, "Module must not be null");
+  auto version = std::make_unique<Version>();
+  version->module = std::move(module);
+  Module& incoming = *version->module;
+  ET_CHECK_OK_OR_RETURN_ERROR(incoming.load());
+
+  // Check the budget before allocating anything for the methods.
+  version->planned_bytes =
+      ET_UNWRAP(planned_bytes(incoming, config_.method_names));
+  if (config_.memory_budget_bytes > 0) {
+    size_t serving_bytes = 0;
+    {
+      std::lock_guard<std::mutex> guard(mutex_);
+      if (current_ != nullptr) {
+        serving_bytes = current_->planned_bytes;
+      }
+    }
+    ET_CHECK_OR_RETURN_ERROR(
+        serving_bytes + version->planned_bytes <= config_.memory_budget_bytes,
+        MemoryAllocationFailed,
+        "Serving %zu and incoming %zu planned bytes exceed the budget of %zu",
+        serving_bytes,
+        version->planned_bytes,
+        config_.memory_budget_bytes);
+  }
+
+  for (const auto& method_name : config_.method_names) {
+    ET_CHECK_OK_OR_RETURN_ERROR(incoming.load_method(method_name));
+    if (!config_.warm_up) {
+      continue;
+    }
+    Method& method = *ET_UNWRAP(incoming.experimental_get_method(method_name));
+    auto inputs = util::prepare_input_tensors(method);
+    ET_CHECK_OK_OR_RETURN_ERROR(inputs.error());
+    ET_CHECK_OK_OR_RETURN_ERROR(method.execute());
+  }
+  return version;
+}
+
+Error HotSwapModule::do_swap(std::unique_ptr<Module> module) {
+  auto incoming = ET_UNWRAP(prepare(std::move(module)));
+  std::unique_ptr<Version> old;
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    old = std::move(current_);
+    current_ = std::move(incoming);
+    version_++;
+    // New requests only see current_, so this only waits for the ones that
+    // were already running on the old version.
+    drained_.wait(lock, [&] { return old->in_flight == 0; });
+  }
+  ET_LOG(Info, "Swapped to model version %zu", version());
+  // Freed here rather than by the last request that used it.
+  old.reset();
+  return Error::Ok;
+}
+
+} // namespace torch::executor
@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+// @nolint PATTERNLINT Ok to use stdlib for this optional library
+#include <condition_variable>
+// @nolint PATTERNLINT Ok to use stdlib for this optional library
+#include <functional>
+// @nolint PATTERNLINT Ok to use stdlib for this optional library
+#include <memory>
+// @nolint PATTERNLINT Ok to use stdlib for this optional library
+#include <mutex>
+// @nolint PATTERNLINT Ok to use stdlib for this optional library
+#include <string>
+// @nolint PATTERNLINT Ok to use stdlib for this optional library
+#include <thread>
+// @nolint PATTERNLINT Ok to use stdlib for this optional library
+#include <vector>
+
+#include <executorch/extension/module/module.h>
+
+namespace torch::executor {
+
+/**
+ * Options for preparing a new version of the model.
+ */
+struct HotSwapConfig {
+  /// Methods to load and warm up before a version serves requests. Other
+  /// methods are loaded on their first execution.
+  std::vector<std::string> method_names = {"forward"};
+
+  /// Largest number of bytes of memory-planned buffers that the serving and
+  /// the incoming version may hold together during a swap. Zero means no
+  /// limit. A swap that would exceed it fails, and the serving version stays.
+  size_t memory_budget_bytes = 0;
+
+  /// Whether to execute every method once, with inputs filled with ones,
+  /// before the version serves requests. This pages in the weights and runs
+  /// the one-time setup of kernels and delegates off the serving path.
+  bool warm_up = true;
+};
+
+/**
+ * Serves requests from a Module, and replaces it with a new version of the
+ * model without pausing the callers.
+ *
+ * A swap loads the program and the methods of the incoming Module, and warms
+ * them up, while the serving Module keeps answering requests. Once the
+ * incoming Module is ready, requests that start afterwards run on it, while
+ * the ones already running finish on the old Module. The old Module is
+ * destroyed once they are done, on the thread that performs the swap, so
+ * callers never pay for freeing it.
+ *
+ * Executions of one version are serialized, like those of a Module.
+ */
+class HotSwapModule final {
+ public:
+  /**
+   * Loads and warms up the methods of the initial Module.
+   *
+   * @returns The HotSwapModule, or an error preparing the Module.
+   */
+  static Result<std::unique_ptr<HotSwapModule>> create(
+      std::unique_ptr<Module> module,
+      const HotSwapConfig& config = {});
+
+  /// Waits for a pending swap_async().
+  ~HotSwapModule();
+
+  HotSwapModule(const HotSwapModule&) = delete;
+  HotSwapModule& operator=(const HotSwapModule&) = delete;
+  HotSwapModule(HotSwapModule&&) = delete;
+  HotSwapModule& operator=(HotSwapModule&&) = delete;
+
+  /**
+   * Executes a method of the serving version. Thread safe.
+   *
+   * @param[in] method_name The name of the method to execute.
+   * @param[in] input A vector of input values to be passed to the method.
+   *
+   * @returns A Result object containing either a vector of output values
+   *          from the method or an error to indicate failure.
+   */
+  __ET_NODISCARD
+  Result<std::vector<EValue>> execute(
+      const std::string& method_name,
+      const std::vector<EValue>& input);
+
+  /**
+   * Executes the 'forward' method of the serving version. Thread safe.
+   */
+  __ET_NODISCARD
+  Result<std::vector<EValue>> forward(const std::vector<EValue>& input) {
+    return execute("forward", input);
+  }
+
+  /**
+   * Prepares a new version of the model, switches new requests over to it,
+   * and destroys the old version once its requests finished. Blocks until
+   * then.
+   *
+   * @returns Error::Ok, Error::InvalidState if another swap is running,
+   *     Error::MemoryAllocationFailed if both versions do not fit in the
+   *     memory budget, or an error preparing the new version. On failure the
+   *     serving version stays.
+   */
+  __ET_NODISCARD Error swap(std::unique_ptr<Module> module);
+
+  /**
+   * Like swap(), but on a background thread.
+   *
+   * @param[in] module The new version of the model.
+   * @param[in] on_done Called on the background thread with the result of
+   *     the swap. Must not start another swap.
+   *
+   * @returns Error::Ok if the swap started, or Error::InvalidState if another
+   *     swap is running.
+   */
+  __ET_NODISCARD Error swap_async(
+      std::unique_ptr<Module> module,
+      std::function<void(Error)> on_done = nullptr);
+
+  /// Returns how many swaps succeeded. Starts at zero.
+  size_t version() const;
+
+ private:
+  struct Version {
+    std::unique_ptr<Module> module;
+    // Bytes of memory-planned buffers of the warmed-up methods.
+    size_t planned_bytes = 0;
+    // Serializes executions, since a Module is not thread safe.
+    std::mutex execute_mutex;
+    // Requests that are running on this version. Guarded by mutex_.
+    size_t in_flight = 0;
+  };
+
+  explicit HotSwapModule(const HotSwapConfig& config);
+
+  // Loads and warms up the methods of a module, without touching the serving
+  // version.
+  Result<std::unique_ptr<Version>> prepare(std::unique_ptr<Module> module);
+  Error do_swap(std::unique_ptr<Module> module);
+
+  const HotSwapConfig config_;
+
+  mutable std::mutex mutex_;
+  // Signaled when the last request of a version finishes.
+  std::condition_variable drained_;
+  std::unique_ptr<Version> current_;
+  size_t version_ = 0;
+  bool swapping_ = false;
+  std::thread swap_thread_;
+};
+
+} // namespace torch::executor
@@ -0,0 +1,45 @@
+load("@fbsource//xplat/executorch/build:runtime_wrapper.bzl", "runtime")
+
+def define_common_targets():
+    """Defines targets that should be shared between fbcode and xplat.
+
+    The directory containing this targets.bzl file should also contain both
+    TARGETS and BUCK files that call this function.
+    """
+
+    runtime.cxx_library(
+        name = "hot_swap_module",
+        srcs = [
+            "hot_swap_module.cpp",
+        ],
+        exported_headers = [
+            "hot_swap_module.h",
+        ],
+        visibility = [
+            "//executorch/...",
+            "@EXECUTORCH_CLIENTS",
+        ],
+        exported_deps = [
+            "//executorch/extension/module:module",
+        ],
+        deps = [
+            "//executorch/extension/runner_util:inputs",
+            "//executorch/runtime/platform:platform",
+        ],
+    )
+
+    # Measures the latency of concurrent requests while the model is swapped
+    # back and forth.
+    runtime.cxx_binary(
+        name = "hot_swap_benchmark",
+        srcs = [
+            "hot_swap_benchmark.cpp",
+        ],
+        deps = [
+            ":hot_swap_module",
+            "//executorch/kernels/portable:generated_lib",
+        ],
+        external_deps = [
+            "gflags",
+        ],
+    )
@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <executorch/extension/hot_swap/hot_swap_module.h>
+
+#include <cstdlib>
+#include <future>
+#include <thread>
+#include <vector>
+
+#include <executorch/runtime/core/exec_aten/testing_util/tensor_factory.h>
+#include <executorch/runtime/core/exec_aten/testing_util/tensor_util.h>
+#include <gtest/gtest.h>
+
+using namespace ::testing;
+using exec_aten::ScalarType;
+using exec_aten::Tensor;
+using torch::executor::testing::TensorFactory;
+
+namespace torch::executor {
+
+class HotSwapModuleTest : public ::testing::Test {
+ protected:
+  // ModuleLinear computes 3 * x + 2 on a 2x2 input.
+  static std::unique_ptr<Module> make_module() {
+    return std::make_unique<Module>(std::getenv("ET_MODULE_LINEAR_PATH"));
+  }
+
+  // Runs forward on ones, and checks that it computed 3 + 2.
+  static void expect_forward(HotSwapModule& module) {
+    TensorFactory<ScalarType::Float> tf;
+    auto outputs = module.forward({EValue(tf.ones({2, 2}))});
+    ASSERT_EQ(outputs.error(), Error::Ok);
+    EXPECT_TENSOR_EQ(outputs.get()[0].toTensor(), tf.full({2, 2}, 5.0f));
+  }
+};
+
+TEST_F(HotSwapModuleTest, ServesTheNewVersionAfterASwap) {
+  auto module = HotSwapModule::create(make_module());
+  ASSERT_EQ(module.error(), Error::Ok);
+  EXPECT_EQ(module.get()->version(), 0);
+  expect_forward(*module.get());
+
+  EXPECT_EQ(module.get()->swap(make_module()), Error::Ok);
+  EXPECT_EQ(module.get()->version(), 1);
+  expect_forward(*module.get());
+}
+
+TEST_F(HotSwapModuleTest, SwapOverTheBudgetKeepsTheServingVersion) {
+  // Room for exactly one version.
+  auto sizing = make_module();
+  auto meta = sizing->method_meta("forward");
+  ASSERT_EQ(meta.error(), Error::Ok);
+  HotSwapConfig config;
+  for (size_t id = 0; id < meta->num_memory_planned_buffers(); ++id) {
+    config.memory_budget_bytes += meta->memory_planned_buffer_size(id).get();
+  }
+  ASSERT_GT(config.memory_budget_bytes, 0);
+
+  auto module = HotSwapModule::create(make_module(), config);
+  ASSERT_EQ(module.error(), Error::Ok);
+  EXPECT_EQ(module.get()->swap(make_module()), Error::MemoryAllocationFailed);
+  EXPECT_EQ(module.get()->version(), 0);
+  expect_forward(*module.get());
+}
+
+TEST_F(HotSwapModuleTest, RequestsKeepRunningDuringAnAsyncSwap) {
+  auto module = HotSwapModule::create(make_module());
+  ASSERT_EQ(module.error(), Error::Ok);
+
+  std::promise<Error> swapped;
+  ASSERT_EQ(
+      module.get()->swap_async(
+          make_module(), [&](Error err) { swapped.set_value(err); }),
+      Error::Ok);
+  std::vector<std::thread> clients;
+  for (int c = 0; c < 4; ++c) {
+    clients.emplace_back([&] {
+      for (int r = 0; r < 50; ++r) {
+        expect_forward(*module.get());
+      }
+    });
+  }
+  for (auto& client : clients) {
+    client.join();
+  }
+  EXPECT_EQ(swapped.get_future().get(), Error::Ok);
+  EXPECT_EQ(module.get()->version(), 1);
+  expect_forward(*module.get());
+}
+
+} // namespace torch::executor
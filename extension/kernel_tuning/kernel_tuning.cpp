@@ -0,0 +1,361 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <executorch/extension/kernel_tuning/kernel_tuning.h>
+
+#include <atomic>
+#include <chrono>
+#include <cinttypes>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#if defined(__APPLE__)
+#include <sys/sysctl.h>
+#endif
+
+#include <executorch/runtime/platform/log.h>
+
+namespace torch::executor::tuning {
+
+namespace {
+
+// The cache file has one tuned value per line, as tab separated fields:
+//   <cpu model> <kernel> <param> <shape bucket> <value>
+// Lines starting with '#' are comments.
+constexpr const char* kCacheFileHeader = "# executorch kernel tuning cache v1";
+
+struct State {
+  std::mutex mutex;
+  // Whether the environment variables have been consulted.
+  bool initialized = false;
+  bool enabled = false;
+  int32_t iterations = 3;
+  // Where newly tuned values are saved. Empty if no cache was loaded.
+  std::string path;
+  // Tuned values of the current CPU model, keyed by make_key().
+  std::map<std::string, int64_t> values;
+  // Lines of the loaded cache file that belong to other CPU models.
+  std::vector<std::string> other_cpu_lines;
+  // Bumped, with the mutex held, whenever values or enabled change. Entries of
+  // the per-thread selection caches are only valid for the generation they
+  // were filled at.
+  std::atomic<uint64_t> generation{1};
+};
+
+State& state() {
+  static State state;
+  return state;
+}
+
+void invalidate_selections_locked(State& s) {
+  s.generation.fetch_add(1, std::memory_order_release);
+}
+
+// What select() found for a parameter and bucket, cached per thread so that
+// repeated calls take no lock and build no key.
+struct CachedSelection {
+  const TunableParam* param = nullptr;
+  int64_t bucket = 0;
+  // 0 never matches State::generation.
+  uint64_t generation = 0;
+  // Whether the tuning cache has a value. If not, select() returns the
+  // caller's default, which may differ between calls.
+  bool found = false;
+  int64_t value = 0;
+};
+
+constexpr size_t kSelectionCacheSize = 64;
+thread_local CachedSelection selection_cache[kSelectionCacheSize];
+
+CachedSelection& selection_cache_slot(
+    const TunableParam* param,
+    int64_t bucket) {
+  uint64_t h = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(param)) ^
+      (static_cast<uint64_t>(bucket) * 0x9e3779b97f4a7c15ULL);
+  h ^= h >> 32;
+  return selection_cache[h % kSelectionCacheSize];
+}
+
+std::string make_key(const char* kernel, const char* name, int64_t bucket) {
+  std::string key(kernel);
+  key += '\t';
+  key += name;
+  key += '\t';
+  key += std::to_string(bucket);
+  return key;
+}
+
+std::string trim(const std::string& s) {
+  const char* kWhitespace = " \t\r\n";
+  const size_t begin = s.find_first_not_of(kWhitespace);
+  if (begin == std::string::npos) {
+    return "";
+  }
+  const size_t end = s.find_last_not_of(kWhitespace);
+  return s.substr(begin, end - begin + 1);
+}
+
+std::string read_cpu_model() {
+#if defined(__APPLE__)
+  char brand[256];
+  size_t size = sizeof(brand);
+  if (sysctlbyname("machdep.cpu.brand_string", brand, &size, nullptr, 0) ==
+      0) {
+    return brand;
+  }
+#elif defined(__linux__)
+  std::ifstream cpuinfo("/proc/cpuinfo");
+  std::string line;
+  // x86 reports a "model name"; arm64 only reports implementer and part
+  // numbers. On big.LITTLE systems this is the part of the first core.
+  std::string implementer;
+  std::string part;
+  while (std::getline(cpuinfo, line)) {
+    const size_t colon = line.find(':');
+    if (colon == std::string::npos) {
+      continue;
+    }
+    const std::string field = trim(line.substr(0, colon));
+    const std::string value = trim(line.substr(colon + 1));
+    if (field == "model name" && !value.empty()) {
+      return value;
+    }
+    if (field == "CPU implementer" && implementer.empty()) {
+      implementer = value;
+    } else if (field == "CPU part" && part.empty()) {
+      part = value;
+    }
+  }
+  if (!part.empty()) {
+    return "arm implementer " + implementer + " part " + part;
+  }
+#endif
+  return "unknown";
+}
+
+Error load_locked(State& s, const char* path) {
+  invalidate_selections_locked(s);
+  s.path = path;
+  s.values.clear();
+  s.other_cpu_lines.clear();
+
+  std::ifstream file(path);
+  if (!file.is_open()) {
+    ET_LOG(Info, "No kernel tuning cache at %s", path);
+    return Error::AccessFailed;
+  }
+  std::string line;
+  size_t num_loaded = 0;
+  while (std::getline(file, line)) {
+    if (line.empty() || line[0] == '#') {
+      continue;
+    }
+    // Split off the CPU model and the value; the rest is the key.
+    const size_t first_tab = line.find('\t');
+    const size_t last_tab = line.rfind('\t');
+    if (first_tab == std::string::npos || first_tab == last_tab) {
+      ET_LOG(Error, "Ignoring malformed kernel tuning entry: %s", line.c_str());
+      continue;
+    }
+    if (line.compare(0, first_tab, cpu_model()) != 0) {
+      s.other_cpu_lines.push_back(line);
+      continue;
+    }
+    const std::string key =
+        line.substr(first_tab + 1, last_tab - first_tab - 1);
+    s.values[key] = std::strtoll(line.c_str() + last_tab + 1, nullptr, 10);
+    num_loaded++;
+  }
+  ET_LOG(
+      Info,
+      "Loaded %zu kernel tuning entries for '%s' from %s",
+      num_loaded,
+      cpu_model().c_str(),
+      path);
+  return Error::Ok;
+}
+
+Error save_locked(const State& s, const char* path) {
+  std::ofstream file(path, std::ios::trunc);
+  if (!file.is_open()) {
+    ET_LOG(Error, "Failed to write kernel tuning cache %s", path);
+    return Error::AccessFailed;
+  }
+  file << kCacheFileHeader << '\n';
+  for (const auto& line : s.other_cpu_lines) {
+    file << line << '\n';
+  }
+  for (const auto& entry : s.values) {
+    file << cpu_model() << '\t' << entry.first << '\t' << entry.second << '\n';
+  }
+  return file.good() ? Error::Ok : Error::AccessFailed;
+}
+
+void init_from_env_locked(State& s) {
+  if (s.initialized) {
+    return;
+  }
+  s.initialized = true;
+  const char* enabled = std::getenv("ET_KERNEL_TUNING");
+  if (enabled != nullptr && std::strcmp(enabled, "1") == 0) {
+    s.enabled = true;
+  }
+  const char* path = std::getenv("ET_KERNEL_TUNING_CACHE");
+  if (path != nullptr && path[0] != '\0') {
+    // A missing file is fine: a tuning run creates it.
+    (void)load_locked(s, path);
+  }
+}
+
+// The tuner registered by this library. See KernelTuner.
+class CacheFileTuner final : public KernelTuner {
+ public:
+  bool find_cached(const TunableParam& param, int64_t bucket, int64_t* value)
+      override {
+    State& s = state();
+    CachedSelection& cached = selection_cache_slot(&param, bucket);
+    if (cached.param == &param && cached.bucket == bucket &&
+        cached.generation == s.generation.load(std::memory_order_acquire)) {
+      if (cached.found) {
+        *value = cached.value;
+      }
+      return true;
+    }
+
+    const std::string key = make_key(param.kernel(), param.name(), bucket);
+    std::lock_guard<std::mutex> guard(s.mutex);
+    init_from_env_locked(s);
+    const auto it = s.values.find(key);
+    const bool found = it != s.values.end();
+    if (found || !s.enabled || param.candidates().empty()) {
+      cached.param = &param;
+      cached.bucket = bucket;
+      cached.generation = s.generation.load(std::memory_order_relaxed);
+      cached.found = found;
+      cached.value = found ? it->second : 0;
+      if (found) {
+        *value = it->second;
+      }
+      return true;
+    }
+    return false;
+  }
+
+  int64_t tune(
+      const TunableParam& param,
+      int64_t bucket,
+      int64_t default_value,
+      void (*run)(void* context, int64_t value),
+      void* context) override {
+    State& s = state();
+    const std::string key = make_key(param.kernel(), param.name(), bucket);
+    int32_t iterations = 0;
+    {
+      std::lock_guard<std::mutex> guard(s.mutex);
+      iterations = s.iterations;
+    }
+
+    // Benchmark without holding the lock, so that run() may select other
+    // parameters.
+    int64_t best_value = default_value;
+    auto best_time = std::chrono::steady_clock::duration::max();
+    for (const int64_t candidate : param.candidates()) {
+      run(context, candidate); // Warmup
+      const auto start = std::chrono::steady_clock::now();
+      for (int32_t i = 0; i < iterations; ++i) {
+        run(context, candidate);
+      }
+      const auto elapsed = std::chrono::steady_clock::now() - start;
+      if (elapsed < best_time) {
+        best_time = elapsed;
+        best_value = candidate;
+      }
+    }
+
+    std::lock_guard<std::mutex> guard(s.mutex);
+    s.values[key] = best_value;
+    invalidate_selections_locked(s);
+    ET_LOG(
+        Info,
+        "Tuned %s %s for shape bucket %" PRId64 ": %" PRId64,
+        param.kernel(),
+        param.name(),
+        bucket,
+        best_value);
+    if (!s.path.empty()) {
+      (void)save_locked(s, s.path.c_str());
+    }
+    return best_value;
+  }
+};
+
+CacheFileTuner cache_file_tuner;
+
+const bool cache_file_tuner_registered =
+    (set_kernel_tuner(&cache_file_tuner), true);
+
+} // namespace
+
+const std::string& cpu_model() {
+  static const std::string model = read_cpu_model();
+  return model;
+}
+
+Error load_tuning_cache(const char* path) {
+  State& s = state();
+  std::lock_guard<std::mutex> guard(s.mutex);
+  init_from_env_locked(s);
+  return load_locked(s, path);
+}
+
+Error save_tuning_cache(const char* path) {
+  State& s = state();
+  std::lock_guard<std::mutex> guard(s.mutex);
+  init_from_env_locked(s);
+  return save_locked(s, path);
+}
+
+void set_tuning_enabled(bool enabled) {
+  State& s = state();
+  std::lock_guard<std::mutex> guard(s.mutex);
+  init_from_env_locked(s);
+  s.enabled = enabled;
+  invalidate_selections_locked(s);
+}
+
+bool tuning_enabled() {
+  State& s = state();
+  std::lock_guard<std::mutex> guard(s.mutex);
+  init_from_env_locked(s);
+  return s.enabled;
+}
+
+void set_tuning_iterations(int32_t iterations) {
+  State& s = state();
+  std::lock_guard<std::mutex> guard(s.mutex);
+  s.iterations = iterations > 0 ? iterations : 1;
+}
+
+void reset_tuning_cache() {
+  State& s = state();
+  std::lock_guard<std::mutex> guard(s.mutex);
+  s.initialized = true;
+  s.enabled = false;
+  invalidate_selections_locked(s);
+  s.path.clear();
+  s.values.clear();
+  s.other_cpu_lines.clear();
+}
+
+} // namespace torch::executor::tuning
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstdint>
+// @nolint PATTERNLINT Ok to use stdlib for this optional library
+#include <string>
+
+#include <executorch/kernels/optimized/cpu/tunable_param.h>
+#include <executorch/runtime/core/error.h>
+
+// Tuned values for the TunableParams of kernels (see
+// kernels/optimized/cpu/tunable_param.h), kept per CPU model in a cache file.
+// Linking this library registers its tuner with set_kernel_tuner().
+//
+// During a tuning run (see set_tuning_enabled()), the first select() for a
+// shape bucket that has no cached value benchmarks every candidate and caches
+// the fastest one. Otherwise, select() returns the cached value, or the
+// kernel's default when there is none.
+//
+// Each thread remembers what select() found for the buckets it asked for, so
+// that repeated calls take no lock. A TunableParam must therefore not be
+// destroyed while another one may be created at its address and used with the
+// same buckets, which static parameters never are.
+namespace torch::executor::tuning {
+
+/**
+ * Returns a description of the CPU this process runs on, e.g. the "model name"
+ * of /proc/cpuinfo. Tuned values are only used on the CPU model they were
+ * measured on.
+ */
+const std::string& cpu_model();
+
+/**
+ * Loads the tuned values of the current CPU model from the cache file at path,
+ * replacing the ones loaded before. Entries of other CPU models are kept and
+ * written back by later saves. The path is remembered: values found by later
+ * tuning runs are saved to it.
+ *
+ * If no cache was loaded explicitly, the first select() loads the file named
+ * by the ET_KERNEL_TUNING_CACHE environment variable, if set.
+ *
+ * @returns Error::AccessFailed if the file cannot be opened. The path is still
+ *     remembered, so a tuning run can create the file.
+ */
+Error load_tuning_cache(const char* path);
+
+/**
+ * Writes all tuned values to the cache file at path.
+ */
+Error save_tuning_cache(const char* path);
+
+/**
+ * Enables or disables tuning runs. Tuning is off by default, and is turned on
+ * at startup when the ET_KERNEL_TUNING environment variable is set to 1.
+ */
+void set_tuning_enabled(bool enabled);
+
+bool tuning_enabled();
+
+/**
+ * Sets the number of timed runs per candidate during a tuning run, after one
+ * untimed warmup run. Defaults to 3.
+ */
+void set_tuning_iterations(int32_t iterations);
+
+/**
+ * Forgets all tuned values and the remembered cache path, and disables tuning.
+ * The environment variables are not consulted afterwards. Meant for tests.
+ */
+void reset_tuning_cache();
+
+} // namespace torch::executor::tuning
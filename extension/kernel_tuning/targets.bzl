@@ -0,0 +1,32 @@
+load("@fbsource//xplat/executorch/build:runtime_wrapper.bzl", "runtime")
+
+def define_common_targets():
+    """Defines targets that should be shared between fbcode and xplat.
+
+    The directory containing this targets.bzl file should also contain both
+    TARGETS and BUCK files that call this function.
+    """
+
+    runtime.cxx_library(
+        name = "kernel_tuning",
+        srcs = [
+            "kernel_tuning.cpp",
+        ],
+        exported_headers = [
+            "kernel_tuning.h",
+        ],
+        visibility = [
+            "//executorch/...",
+            "@EXECUTORCH_CLIENTS",
+        ],
+        exported_deps = [
+            "//executorch/kernels/optimized/cpu:tunable_param",
+            "//executorch/runtime/core:core",
+        ],
+        deps = [
+            "//executorch/runtime/platform:platform",
+        ],
+        # Registers its tuner from a static initializer.
+        # @lint-ignore BUCKLINT link_whole
+        link_whole = True,
+    )
@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <executorch/extension/kernel_tuning/kernel_tuning.h>
+#include <executorch/runtime/platform/runtime.h>
+
+using namespace ::testing;
+
+namespace torch::executor::tuning {
+
+class KernelTuningTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    runtime_init();
+    reset_tuning_cache();
+    path_ = ::testing::TempDir() + "kernel_tuning_test_cache.txt";
+    std::remove(path_.c_str());
+  }
+
+  void TearDown() override {
+    reset_tuning_cache();
+    std::remove(path_.c_str());
+  }
+
+  std::string path_;
+};
+
+TEST_F(KernelTuningTest, ReturnsDefaultWhenNotTuning) {
+  TunableParam param("test::kernel", "block", {1, 2, 4});
+  bool ran = false;
+  EXPECT_EQ(param.select(8, 2, [&](int64_t) { ran = true; }), 2);
+  // The default is not remembered across calls.
+  EXPECT_EQ(param.select(8, 4, [&](int64_t) { ran = true; }), 4);
+  EXPECT_FALSE(ran);
+}
+
+TEST_F(KernelTuningTest, TuningPicksAFastCandidateAndCachesIt) {
+  TunableParam param("test::kernel", "block", {1, 2, 4});
+  set_tuning_enabled(true);
+  set_tuning_iterations(1);
+
+  std::vector<int64_t> tried;
+  volatile int64_t sink = 0;
+  auto run = [&](int64_t value) {
+    tried.push_back(value);
+    // Candidate 4 does far less work than the others.
+    const int64_t work = value == 4 ? 1 : 2000000;
+    for (int64_t i = 0; i < work; ++i) {
+      sink = sink + i;
+    }
+  };
+  EXPECT_EQ(param.select(8, 1, run), 4);
+  // One warmup and one timed run per candidate.
+  EXPECT_EQ(tried, (std::vector<int64_t>{1, 1, 2, 2, 4, 4}));
+
+  // Cached: no more runs, for this bucket only.
+  tried.clear();
+  EXPECT_EQ(param.select(8, 1, run), 4);
+  EXPECT_TRUE(tried.empty());
+  set_tuning_enabled(false);
+  EXPECT_EQ(param.select(16, 1, run), 1);
+}
+
+TEST_F(KernelTuningTest, RunIsNotCopied) {
+  struct CountingRun {
+    CountingRun() = default;
+    CountingRun(const CountingRun&) = delete;
+    void operator()(int64_t) {
+      ++calls;
+    }
+    int calls = 0;
+  };
+  TunableParam param("test::kernel", "block", {1, 2});
+  set_tuning_enabled(true);
+  set_tuning_iterations(1);
+  CountingRun run;
+  param.select(8, 1, run);
+  EXPECT_EQ(run.calls, 4);
+  param.select(8, 1, run);
+  EXPECT_EQ(run.calls, 4);
+}
+
+TEST_F(KernelTuningTest, TunedValuesRoundTripThroughCacheFile) {
+  TunableParam param("test::kernel", "grain", {8, 16});
+  EXPECT_EQ(load_tuning_cache(path_.c_str()), Error::AccessFailed);
+  set_tuning_enabled(true);
+  set_tuning_iterations(1);
+  const int64_t tuned = param.select(32, 8, [](int64_t) {});
+
+  // The remembered path was written by the tuning run.
+  reset_tuning_cache();
+  EXPECT_EQ(param.select(32, 0, [](int64_t) {}), 0);
+  EXPECT_EQ(load_tuning_cache(path_.c_str()), Error::Ok);
+  EXPECT_EQ(param.select(32, 0, [](int64_t) {}), tuned);
+}
+
+TEST_F(KernelTuningTest, SelectSeesValuesLoadedAfterEarlierCalls) {
+  TunableParam param("test::kernel", "grain", {8, 16});
+  EXPECT_EQ(param.select(32, 8, [](int64_t) {}), 8);
+  {
+    std::ofstream file(path_);
+    file << cpu_model() << "\ttest::kernel\tgrain\t32\t16\n";
+  }
+  EXPECT_EQ(load_tuning_cache(path_.c_str()), Error::Ok);
+  EXPECT_EQ(param.select(32, 8, [](int64_t) {}), 16);
+  EXPECT_EQ(param.select(32, 8, [](int64_t) {}), 16);
+
+  // Selections made by another thread are not shared, but agree.
+  int64_t other_thread_value = 0;
+  std::thread thread(
+      [&]() { other_thread_value = param.select(32, 8, [](int64_t) {}); });
+  thread.join();
+  EXPECT_EQ(other_thread_value, 16);
+
+  reset_tuning_cache();
+  EXPECT_EQ(param.select(32, 8, [](int64_t) {}), 8);
+}
+
+TEST_F(KernelTuningTest, EntriesOfOtherCpusAreIgnoredAndKept) {
+  {
+    std::ofstream file(path_);
+    file << "# comment\n";
+    file << "some other cpu\ttest::kernel\tgrain\t32\t64\n";
+    file << cpu_model() << "\ttest::kernel\tgrain\t32\t16\n";
+  }
+  TunableParam param("test::kernel", "grain", {8, 16, 64});
+  EXPECT_EQ(load_tuning_cache(path_.c_str()), Error::Ok);
+  EXPECT_EQ(param.select(32, 8, [](int64_t) {}), 16);
+
+  EXPECT_EQ(save_tuning_cache(path_.c_str()), Error::Ok);
+  std::ifstream file(path_);
+  std::string contents(
+      (std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+  EXPECT_NE(
+      contents.find("some other cpu\ttest::kernel\tgrain\t32\t64"),
+      std::string::npos);
+}
+
+} // namespace torch::executor::tuning
@@ -110,6 +110,23 @@ Error Module::load_method(const std::string& method_name) {
     for (auto index = 0; index < planned_buffersCount; ++index) {
       const auto buffer_size =
           method_metadata.memory_planned_buffer_size(index).get();
+      if (method_metadata.memory_planned_buffer_is_shared(index).get()) {
+        auto& shared_buffer = shared_planned_buffers_[index];
+        if (shared_buffer.empty()) {
+          shared_buffer.resize(buffer_size);
+        }
+        ET_CHECK_OR_RETURN_ERROR(
+            shared_buffer.size() == static_cast<size_t>(buffer_size),
+            InvalidProgram,
+            "Shared planned buffer %d of method %s has size %zu, expected %zu",
+            index,
+            method_name.c_str(),
+            static_cast<size_t>(buffer_size),
+            shared_buffer.size());
+        method_holder.planned_spans.emplace_back(
+            shared_buffer.data(), buffer_size);
+        continue;
+      }
       method_holder.planned_buffers.emplace_back(buffer_size);
       method_holder.planned_spans.emplace_back(
           method_holder.planned_buffers.back().data(), buffer_size);
@@ -133,8 +150,14 @@ bool Module::is_method_loaded(const std::string& method_name) const {
 }
 
 Result<MethodMeta> Module::method_meta(const std::string& method_name) {
+  ET_CHECK_OK_OR_RETURN_ERROR(load());
+  return program_->method_meta(method_name.c_str());
+}
+
+Result<Method*> Module::experimental_get_method(
+    const std::string& method_name) {
   ET_CHECK_OK_OR_RETURN_ERROR(load_method(method_name));
-  return methods_.at(method_name).method->method_meta();
+  return methods_.at(method_name).method.get();
 }
 
 Result<std::vector<EValue>> Module::execute(
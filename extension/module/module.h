@@ -18,6 +18,10 @@
 
 namespace torch::executor {
 
+class BatchSplitter;
+class HotSwapModule;
+class RequestBatcher;
+
 /**
  * A facade class for loading programs and executing methods within them.
  */
@@ -95,6 +99,10 @@ class Module final {
   /**
    * Load a specific method from the program and set up memory management if
    * needed. The loaded method is cached to reuse the next time it's executed.
+   * Memory-planned buffers that the program shares between methods (see
+   * MethodMeta::memory_planned_buffer_is_shared()) are allocated once and
+   * bound to every method that uses them, so their state carries over from
+   * one method to the next.
    *
    * @param[in] method_name The name of the method to load.
    *
@@ -115,15 +123,31 @@ class Module final {
 
   /**
    * Get a method metadata struct by method name.
-   * Loads the program and method if needed.
+   * Loads the program if needed, but not the method.
    *
    * @param[in] method_name The name of the method to get the metadata for.
    *
-   * @returns A method metadata, or an error if the program or method failed to
-   * load.
+   * @returns A method metadata, or an error if the program failed to load or
+   * has no such method.
    */
   Result<MethodMeta> method_meta(const std::string& method_name);
 
+  /**
+   * EXPERIMENTAL: Returns the Method with the given name, for callers that
+   * drive it directly, e.g. to write inputs into its memory-planned buffers.
+   * Loads the program and method if needed.
+   *
+   * The Method is owned by the Module and stays valid until the Module is
+   * destroyed. It must not run concurrently with execute() of the same method.
+   *
+   * @param[in] method_name The name of the method to get.
+   *
+   * @returns A pointer to the loaded method, or an error if the program or
+   * method failed to load.
+   */
+  __ET_NODISCARD
+  Result<Method*> experimental_get_method(const std::string& method_name);
+
   /**
    * Execute a specific method with the given input and retrieve output.
    * Loads the program and method before executing if needed.
@@ -207,6 +231,7 @@ class Module final {
   std::unique_ptr<MemoryAllocator> memory_allocator_;
   std::unique_ptr<EventTracer> event_tracer_;
   std::unique_ptr<Program> program_;
+  std::unordered_map<size_t, std::vector<uint8_t>> shared_planned_buffers_;
   std::unordered_map<std::string, MethodHolder> methods_;
 };
 
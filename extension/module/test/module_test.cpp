@@ -98,6 +98,9 @@ TEST_F(ModuleTest, TestMethodMeta) {
   EXPECT_EQ(output_meta->scalar_type(), ScalarType::Float);
   EXPECT_EQ(output_meta->sizes().size(), 1);
   EXPECT_EQ(output_meta->sizes()[0], 1);
+
+  EXPECT_TRUE(module.is_loaded());
+  EXPECT_FALSE(module.is_method_loaded("forward"));
 }
 
 TEST_F(ModuleTest, TestNonExistentMethodMeta) {
@@ -107,6 +110,18 @@ TEST_F(ModuleTest, TestNonExistentMethodMeta) {
   EXPECT_FALSE(meta.ok());
 }
 
+TEST_F(ModuleTest, TestExperimentalGetMethod) {
+  Module module(std::getenv("RESOURCES_PATH") + std::string("/model.pte"));
+
+  const auto method = module.experimental_get_method("forward");
+  EXPECT_TRUE(method.ok());
+  EXPECT_TRUE(module.is_method_loaded("forward"));
+  EXPECT_EQ(method.get()->inputs_size(), 1);
+  EXPECT_EQ(module.experimental_get_method("forward").get(), method.get());
+
+  EXPECT_FALSE(module.experimental_get_method("backward").ok());
+}
+
 TEST_F(ModuleTest, TestExecute) {
   Module module(std::getenv("RESOURCES_PATH") + std::string("/model.pte"));
 
@@ -235,4 +250,31 @@ TEST_F(ModuleTest, TestForwardWithInvalidInputs) {
   EXPECT_FALSE(result.ok());
 }
 
+TEST_F(ModuleTest, TestMethodsShareMutableState) {
+  Module module(std::getenv("ET_MODULE_SHARED_STATE_PATH"));
+
+  const auto meta = module.method_meta("forward");
+  EXPECT_TRUE(meta.ok());
+  EXPECT_EQ(meta->num_memory_planned_buffers(), 2);
+  EXPECT_FALSE(meta->memory_planned_buffer_is_shared(0).get());
+  EXPECT_TRUE(meta->memory_planned_buffer_is_shared(1).get());
+  EXPECT_FALSE(meta->memory_planned_buffer_is_shared(2).ok());
+
+  std::array<float, 4> input{1, 1, 1, 1};
+  std::array<int32_t, 2> sizes{2, 2};
+  TensorImpl tensor(
+      ScalarType::Float, sizes.size(), sizes.data(), input.data());
+
+  // Both methods accumulate the input into the same state buffer.
+  EXPECT_TRUE(module.execute("forward", {EValue(Tensor(&tensor))}).ok());
+  EXPECT_TRUE(module.execute("forward", {EValue(Tensor(&tensor))}).ok());
+  const auto result = module.execute("forward2", {EValue(Tensor(&tensor))});
+  EXPECT_TRUE(result.ok());
+  EXPECT_NEAR(result->at(0).toTensor().const_data_ptr<float>()[0], 3, 1e-5);
+
+  const auto result2 = module.execute("forward", {EValue(Tensor(&tensor))});
+  EXPECT_TRUE(result2.ok());
+  EXPECT_NEAR(result2->at(0).toTensor().const_data_ptr<float>()[0], 4, 1e-5);
+}
+
 } // namespace torch::executor
@@ -17,6 +17,7 @@ def define_common_targets():
             "//executorch/extension/module:module",
         ],
         env = {
+            "ET_MODULE_SHARED_STATE_PATH": "$(location fbcode//executorch/test/models:exported_programs[ModuleSharedState.pte])",
             "RESOURCES_PATH": "$(location :resources)/resources",
         },
     )
@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+/**
+ * @file
+ *
+ * Measures the throughput of a model run as a PipelinedMethod, for 1 to
+ * --max_stages stages. Every request uses the same inputs, with all tensor
+ * elements set to one.
+ */
+
+#include <chrono>
+#include <cinttypes>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include <gflags/gflags.h>
+
+#include <executorch/extension/data_loader/file_data_loader.h>
+#include <executorch/extension/pipeline/pipelined_method.h>
+#include <executorch/extension/runner_util/inputs.h>
+#include <executorch/runtime/executor/method.h>
+#include <executorch/runtime/executor/program.h>
+#include <executorch/runtime/platform/log.h>
+#include <executorch/runtime/platform/runtime.h>
+
+static uint8_t method_allocator_pool[4 * 1024U * 1024U]; // 4 MB
+
+DEFINE_string(
+    model_path,
+    "model.pte",
+    "Model serialized in flatbuffer format.");
+DEFINE_int32(num_requests, 100, "Number of requests per measurement.");
+DEFINE_int32(max_stages, 4, "Largest number of pipeline stages to measure.");
+DEFINE_bool(
+    measure_costs,
+    true,
+    "Balance the stages with measured instruction durations instead of "
+    "tensor sizes.");
+
+using namespace torch::executor;
+using torch::executor::util::FileDataLoader;
+
+namespace {
+
+// A copy of an input tensor that does not live in the method's memory.
+struct OwnedTensor {
+  std::vector<exec_aten::SizesType> sizes;
+  std::vector<exec_aten::DimOrderType> dim_order;
+  std::vector<exec_aten::StridesType> strides;
+  std::unique_ptr<uint8_t[]> data;
+  std::unique_ptr<TensorImpl> impl;
+};
+
+EValue copy_input(const EValue& input, std::vector<OwnedTensor>& storage) {
+  if (!input.isTensor()) {
+    return input;
+  }
+  const exec_aten::Tensor& t = input.toTensor();
+  OwnedTensor owned;
+  owned.sizes.assign(t.sizes().begin(), t.sizes().end());
+  owned.dim_order.assign(t.dim_order().begin(), t.dim_order().end());
+  owned.strides.assign(t.strides().begin(), t.strides().end());
+  owned.data = std::make_unique<uint8_t[]>(t.nbytes());
+  std::memcpy(owned.data.get(), t.const_data_ptr(), t.nbytes());
+  owned.impl = std::make_unique<TensorImpl>(
+      t.scalar_type(),
+      t.dim(),
+      owned.sizes.data(),
+      owned.data.get(),
+      owned.dim_order.data(),
+      owned.strides.data());
+  storage.push_back(std::move(owned));
+  return EValue(exec_aten::Tensor(storage.back().impl.get()));
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  runtime_init();
+
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  if (argc != 1) {
+    ET_LOG(Error, "Extra commandline args");
+    return 1;
+  }
+
+  const char* model_path = FLAGS_model_path.c_str();
+  Result<FileDataLoader> loader = FileDataLoader::from(model_path);
+  ET_CHECK_MSG(
+      loader.ok(),
+      "FileDataLoader::from() failed: 0x%" PRIx32,
+      (uint32_t)loader.error());
+  Result<Program> program = Program::load(&loader.get());
+  ET_CHECK_MSG(program.ok(), "Failed to parse model file %s", model_path);
+
+  const auto method_name_result = program->get_method_name(0);
+  ET_CHECK_MSG(method_name_result.ok(), "Program has no methods");
+  const char* method_name = *method_name_result;
+  Result<MethodMeta> method_meta = program->method_meta(method_name);
+  ET_CHECK_MSG(method_meta.ok(), "Failed to get method_meta");
+
+  MemoryAllocator method_allocator{
+      MemoryAllocator(sizeof(method_allocator_pool), method_allocator_pool)};
+  std::vector<std::unique_ptr<uint8_t[]>> planned_buffers;
+  std::vector<Span<uint8_t>> planned_spans;
+  for (size_t id = 0; id < method_meta->num_memory_planned_buffers(); ++id) {
+    size_t buffer_size =
+        static_cast<size_t>(method_meta->memory_planned_buffer_size(id).get());
+    planned_buffers.push_back(std::make_unique<uint8_t[]>(buffer_size));
+    planned_spans.push_back({planned_buffers.back().get(), buffer_size});
+  }
+  HierarchicalAllocator planned_memory(
+      {planned_spans.data(), planned_spans.size()});
+  MemoryManager memory_manager(&method_allocator, &planned_memory);
+
+  Result<Method> method = program->load_method(method_name, &memory_manager);
+  ET_CHECK_MSG(
+      method.ok(),
+      "Loading of method %s failed with status 0x%" PRIx32,
+      method_name,
+      (uint32_t)method.error());
+
+  auto input_buffers = util::prepare_input_tensors(*method);
+  ET_CHECK_MSG(
+      input_buffers.ok(),
+      "Could not prepare inputs: 0x%" PRIx32,
+      (uint32_t)input_buffers.error());
+  std::vector<EValue> inputs(method->inputs_size());
+  Error err = method->get_inputs(inputs.data(), inputs.size());
+  ET_CHECK_MSG(
+      err == Error::Ok, "Could not get inputs: 0x%" PRIx32, (uint32_t)err);
+  std::vector<OwnedTensor> input_storage;
+  input_storage.reserve(inputs.size());
+  for (EValue& input : inputs) {
+    input = copy_input(input, input_storage);
+  }
+  std::vector<EValue> outputs(method->outputs_size());
+
+  std::vector<double> costs;
+  if (FLAGS_measure_costs) {
+    Result<std::vector<double>> measured = measure_instruction_costs(&*method);
+    ET_CHECK_MSG(
+        measured.ok(),
+        "Failed to measure instruction costs: 0x%" PRIx32,
+        (uint32_t)measured.error());
+    costs = std::move(measured.get());
+  }
+
+  double single_stage_rate = 0;
+  for (int32_t num_stages = 1; num_stages <= FLAGS_max_stages; ++num_stages) {
+    PipelineConfig config;
+    config.num_stages = num_stages;
+    config.instruction_costs = costs;
+    auto pipeline = PipelinedMethod::load(&*method, config);
+    if (!pipeline.ok()) {
+      ET_LOG(
+          Error,
+          "Cannot pipeline %s in %" PRId32 " stages: 0x%" PRIx32,
+          method_name,
+          num_stages,
+          (uint32_t)pipeline.error());
+      break;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    int32_t num_done = 0;
+    for (int32_t step = 0; num_done < FLAGS_num_requests; ++step) {
+      const bool new_request = step < FLAGS_num_requests;
+      Result<bool> done = pipeline.get()->step(
+          new_request ? inputs.data() : nullptr,
+          new_request ? inputs.size() : 0,
+          outputs.data(),
+          outputs.size());
+      ET_CHECK_MSG(
+          done.ok(), "Pipeline step failed: 0x%" PRIx32, (uint32_t)done.error());
+      num_done += done.get() ? 1 : 0;
+    }
+    const double seconds = std::chrono::duration<double>(
+                               std::chrono::steady_clock::now() - start)
+                               .count();
+    const double rate = num_done / seconds;
+    if (num_stages == 1) {
+      single_stage_rate = rate;
+    }
+    ET_LOG(
+        Info,
+        "%" PRId32 " stages: %.1f requests/s (%.2fx)",
+        num_stages,
+        rate,
+        rate / single_stage_rate);
+  }
+  return 0;
+}
@@ -0,0 +1,669 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <executorch/extension/pipeline/pipelined_method.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <cstring>
+#include <limits>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include <executorch/runtime/core/exec_aten/util/tensor_util.h>
+#include <executorch/runtime/core/span.h>
+#include <executorch/runtime/platform/log.h>
+#include <executorch/schema/program_generated.h>
+
+namespace torch::executor {
+
+namespace {
+
+constexpr size_t kUnused = std::numeric_limits<size_t>::max();
+
+/**
+ * Splits costs into num_stages consecutive non-empty ranges, minimizing the
+ * cost of the most expensive range. Returns the index of the first element of
+ * each range.
+ */
+std::vector<size_t> balance_stages(
+    const std::vector<double>& costs,
+    size_t num_stages) {
+  // Number of ranges needed if no range may cost more than limit.
+  auto num_ranges = [&](double limit) {
+    size_t ranges = 1;
+    double cost = 0;
+    for (double c : costs) {
+      if (cost + c > limit && cost > 0) {
+        ranges++;
+        cost = 0;
+      }
+      cost += c;
+    }
+    return ranges;
+  };
+  double lo = 0;
+  double hi = 0;
+  for (double c : costs) {
+    lo = std::max(lo, c);
+    hi += c;
+  }
+  // Binary search the smallest limit that needs at most num_stages ranges.
+  for (int i = 0; i < 64 && lo < hi; ++i) {
+    const double mid = lo + (hi - lo) / 2;
+    if (num_ranges(mid) <= num_stages) {
+      hi = mid;
+    } else {
+      lo = mid;
+    }
+  }
+
+  // Cut greedily under that limit, and also whenever every remaining element
+  // is needed to give the remaining stages one element each.
+  std::vector<size_t> begins = {0};
+  double cost = 0;
+  for (size_t i = 0; i < costs.size(); ++i) {
+    const size_t stages_left = num_stages - begins.size();
+    const size_t elements_left = costs.size() - i;
+    if (i > begins.back() && stages_left > 0 &&
+        (cost + costs[i] > hi || elements_left == stages_left)) {
+      begins.push_back(i);
+      cost = 0;
+    }
+    cost += costs[i];
+  }
+  return begins;
+}
+
+size_t serialized_nbytes(const executorch_flatbuffer::Tensor* s_tensor) {
+  size_t numel = 1;
+  for (int32_t size : *s_tensor->sizes()) {
+    numel *= static_cast<size_t>(size);
+  }
+  return numel *
+      elementSize(static_cast<exec_aten::ScalarType>(s_tensor->scalar_type()));
+}
+
+size_t allocation_offset(const executorch_flatbuffer::AllocationDetails* info) {
+  return static_cast<size_t>(info->memory_offset_low()) |
+      (static_cast<size_t>(info->memory_offset_high()) << 32);
+}
+
+/// Returns the indices of the values held by a list value, -1 for None.
+std::vector<int64_t> list_items(const executorch_flatbuffer::EValue* s_value) {
+  switch (s_value->val_type()) {
+    case executorch_flatbuffer::KernelTypes::IntList: {
+      const auto* items = s_value->val_as_IntList()->items();
+      return std::vector<int64_t>(items->begin(), items->end());
+    }
+    case executorch_flatbuffer::KernelTypes::TensorList: {
+      const auto* items = s_value->val_as_TensorList()->items();
+      return std::vector<int64_t>(items->begin(), items->end());
+    }
+    case executorch_flatbuffer::KernelTypes::OptionalTensorList: {
+      const auto* items = s_value->val_as_OptionalTensorList()->items();
+      return std::vector<int64_t>(items->begin(), items->end());
+    }
+    default:
+      return {};
+  }
+}
+
+} // namespace
+
+/// A tensor of a stage other than the first, with its own metadata.
+struct PipelinedMethod::TensorCopy {
+  std::vector<exec_aten::SizesType> sizes;
+  std::vector<exec_aten::DimOrderType> dim_order;
+  std::vector<exec_aten::StridesType> strides;
+  std::unique_ptr<TensorImpl> impl;
+};
+
+struct PipelinedMethod::Stage {
+  /// Range of instructions of the stage.
+  size_t begin = 0;
+  size_t end = 0;
+  /// Whether the stage holds a request.
+  bool occupied = false;
+  /// Result of the last run of the stage.
+  Error error = Error::Ok;
+
+  // The fields below are only used by stages other than the first.
+
+  /// Values of the stage, indexed like the values of the method. Values that
+  /// the stage does not use are None.
+  std::vector<EValue> values;
+  /// Argument lists of the stage's instructions, pointing into values.
+  std::vector<std::vector<EValue*>> args;
+  /// Values to copy from the previous stage before every step.
+  std::vector<size_t> live_in;
+  /// Copy of the range [buffer_begins[i], buffer_ends[i]) of planned buffer i.
+  std::vector<std::unique_ptr<uint8_t[]>> buffers;
+  std::vector<size_t> buffer_begins;
+  std::vector<size_t> buffer_ends;
+  /// Storage of the tensors and lists in values.
+  std::vector<std::unique_ptr<TensorCopy>> tensors;
+  std::vector<std::vector<EValue*>> boxed_lists;
+  std::vector<std::vector<int64_t>> int_lists;
+  std::vector<std::vector<exec_aten::Tensor>> tensor_lists;
+  std::vector<std::vector<exec_aten::optional<exec_aten::Tensor>>>
+      optional_tensor_lists;
+
+  std::thread thread;
+};
+
+Result<std::unique_ptr<PipelinedMethod>> PipelinedMethod::load(
+    Method* method,
+    const PipelineConfig& config) {
+  ET_CHECK_OR_RETURN_ERROR(
+      method != nullptr && method->initialized(),
+      InvalidArgument,
+      "Method must be initialized");
+  std::unique_ptr<PipelinedMethod> pipeline(new PipelinedMethod(method));
+  Error err = pipeline->init(config);
+  if (err != Error::Ok) {
+    pipeline->stop_threads();
+    return err;
+  }
+  return pipeline;
+}
+
+PipelinedMethod::PipelinedMethod(Method* method) : method_(method) {}
+
+PipelinedMethod::~PipelinedMethod() {
+  stop_threads();
+}
+
+size_t PipelinedMethod::stage_begin(size_t stage) const {
+  return stages_[stage]->begin;
+}
+
+size_t PipelinedMethod::stage_end(size_t stage) const {
+  return stages_[stage]->end;
+}
+
+size_t PipelinedMethod::num_in_flight() const {
+  size_t count = 0;
+  for (const auto& stage : stages_) {
+    count += stage->occupied ? 1 : 0;
+  }
+  return count;
+}
+
+Error PipelinedMethod::init(const PipelineConfig& config) {
+  const auto* plan = method_->experimental_execution_plan();
+  const size_t num_chains = plan->chains()->size();
+  ET_CHECK_OR_RETURN_ERROR(
+      num_chains == 1,
+      NotSupported,
+      "Pipelining needs a single chain, found %zu",
+      num_chains);
+  ET_CHECK_OR_RETURN_ERROR(
+      method_->get_event_tracer() == nullptr,
+      NotSupported,
+      "Pipelining does not support an EventTracer");
+  const auto* instructions = plan->chains()->Get(0)->instructions();
+  const size_t num_instructions = instructions->size();
+  const size_t num_stages = config.num_stages;
+  ET_CHECK_OR_RETURN_ERROR(
+      num_stages > 0 && num_stages <= std::max<size_t>(num_instructions, 1),
+      InvalidArgument,
+      "Cannot split %zu instructions into %zu stages",
+      num_instructions,
+      num_stages);
+  ET_CHECK_OR_RETURN_ERROR(
+      config.instruction_costs.empty() ||
+          config.instruction_costs.size() == num_instructions,
+      InvalidArgument,
+      "Got %zu instruction costs for %zu instructions",
+      config.instruction_costs.size(),
+      num_instructions);
+
+  std::vector<double> costs = config.instruction_costs;
+  for (size_t i = 0; i < num_instructions; ++i) {
+    const auto type = instructions->Get(i)->instr_args_type();
+    ET_CHECK_OR_RETURN_ERROR(
+        type == executorch_flatbuffer::InstructionArguments::KernelCall ||
+            type == executorch_flatbuffer::InstructionArguments::DelegateCall,
+        NotSupported,
+        "Instruction %zu is not a kernel or delegate call",
+        i);
+    if (config.instruction_costs.empty()) {
+      // Without measurements, assume that the cost of an instruction is
+      // proportional to the memory it touches.
+      double cost = 1;
+      for (EValue* arg : method_->experimental_instruction_args(0, i)) {
+        if (arg->isTensor()) {
+          cost += arg->toTensor().nbytes();
+        }
+      }
+      costs.push_back(cost);
+    }
+  }
+  std::vector<size_t> begins = num_instructions > 0
+      ? balance_stages(costs, num_stages)
+      : std::vector<size_t>{0};
+  for (size_t s = 0; s < begins.size(); ++s) {
+    auto stage = std::make_unique<Stage>();
+    stage->begin = begins[s];
+    stage->end = s + 1 < begins.size() ? begins[s + 1] : num_instructions;
+    stages_.push_back(std::move(stage));
+  }
+
+  // Find the range of stages that uses each value. Values that cross a stage
+  // boundary are carried through every stage in between.
+  const auto* s_values = plan->values();
+  first_stage_.assign(s_values->size(), kUnused);
+  last_stage_.assign(s_values->size(), kUnused);
+  auto mark_used = [&](size_t value, size_t stage) {
+    if (first_stage_[value] == kUnused || stage < first_stage_[value]) {
+      first_stage_[value] = stage;
+    }
+    if (last_stage_[value] == kUnused || stage > last_stage_[value]) {
+      last_stage_[value] = stage;
+    }
+  };
+  std::vector<size_t> delegate_stage(
+      plan->delegates() == nullptr ? 0 : plan->delegates()->size(), kUnused);
+  for (size_t s = 0; s < stages_.size(); ++s) {
+    for (size_t i = stages_[s]->begin; i < stages_[s]->end; ++i) {
+      const auto* instruction = instructions->Get(i);
+      if (instruction->instr_args_type() ==
+          executorch_flatbuffer::InstructionArguments::DelegateCall) {
+        const size_t delegate =
+            instruction->instr_args_as_DelegateCall()->delegate_index();
+        ET_CHECK_OR_RETURN_ERROR(
+            delegate_stage[delegate] == kUnused || delegate_stage[delegate] == s,
+            NotSupported,
+            "Delegate %zu is called from stages %zu and %zu",
+            delegate,
+            delegate_stage[delegate],
+            s);
+        delegate_stage[delegate] = s;
+      }
+      for (EValue* arg : method_->experimental_instruction_args(0, i)) {
+        const size_t value = arg - method_->experimental_values();
+        mark_used(value, s);
+        for (int64_t item : list_items(s_values->Get(value))) {
+          if (item >= 0) {
+            mark_used(item, s);
+          }
+        }
+      }
+    }
+  }
+  for (size_t i = 0; i < method_->inputs_size(); ++i) {
+    mark_used(plan->inputs()->Get(i), 0);
+  }
+  for (size_t i = 0; i < method_->outputs_size(); ++i) {
+    mark_used(plan->outputs()->Get(i), stages_.size() - 1);
+  }
+
+  for (size_t s = 1; s < stages_.size(); ++s) {
+    ET_CHECK_OK_OR_RETURN_ERROR(init_stage_values(s));
+  }
+
+  for (size_t s = 0; s < stages_.size(); ++s) {
+    stages_[s]->thread = std::thread([this, s] { stage_thread_loop(s); });
+#if defined(__linux__)
+    if (s < config.stage_cpus.size() && !config.stage_cpus[s].empty()) {
+      cpu_set_t cpus;
+      CPU_ZERO(&cpus);
+      for (int cpu : config.stage_cpus[s]) {
+        CPU_SET(cpu, &cpus);
+      }
+      if (pthread_setaffinity_np(
+              stages_[s]->thread.native_handle(), sizeof(cpus), &cpus) != 0) {
+        ET_LOG(Error, "Failed to pin pipeline stage %zu", s);
+      }
+    }
+#endif
+  }
+
+  for (size_t s = 0; s < stages_.size(); ++s) {
+    ET_LOG(
+        Info,
+        "Pipeline stage %zu: instructions [%zu, %zu), %zu values copied in",
+        s,
+        stages_[s]->begin,
+        stages_[s]->end,
+        stages_[s]->live_in.size());
+  }
+  return Error::Ok;
+}
+
+Error PipelinedMethod::init_stage_values(size_t s) {
+  Stage& stage = *stages_[s];
+  const auto* s_values = method_->experimental_execution_plan()->values();
+  const size_t n_value = s_values->size();
+  const EValue* method_values = method_->experimental_values();
+  auto in_stage = [&](size_t value) {
+    return first_stage_[value] != kUnused && first_stage_[value] <= s &&
+        s <= last_stage_[value];
+  };
+
+  // Find the part of each planned buffer that the stage's tensors live in.
+  for (size_t v = 0; v < n_value; ++v) {
+    if (!in_stage(v) || !method_values[v].isTensor()) {
+      continue;
+    }
+    const auto* s_tensor = s_values->Get(v)->val_as_Tensor();
+    if (s_tensor->constant_buffer_idx() > 0) {
+      continue;
+    }
+    const auto* info = s_tensor->allocation_info();
+    ET_CHECK_OR_RETURN_ERROR(
+        info != nullptr,
+        NotSupported,
+        "Tensor value %zu is not memory planned",
+        v);
+    const size_t id = info->memory_id() - 1;
+    const size_t begin = allocation_offset(info);
+    const size_t end = begin + serialized_nbytes(s_tensor);
+    if (id >= stage.buffer_begins.size()) {
+      stage.buffer_begins.resize(id + 1, kUnused);
+      stage.buffer_ends.resize(id + 1, 0);
+    }
+    stage.buffer_begins[id] = std::min(stage.buffer_begins[id], begin);
+    stage.buffer_ends[id] = std::max(stage.buffer_ends[id], end);
+  }
+  // Start from the contents of the method's buffers, so that values the stage
+  // reads before writing them, e.g. mutable buffers, have the same initial
+  // values as when the method runs by itself.
+  HierarchicalAllocator* planned_memory =
+      method_->experimental_planned_memory();
+  stage.buffers.resize(stage.buffer_begins.size());
+  for (size_t id = 0; id < stage.buffers.size(); ++id) {
+    const size_t begin = stage.buffer_begins[id];
+    const size_t end = stage.buffer_ends[id];
+    if (begin >= end) {
+      continue;
+    }
+    Result<void*> src = planned_memory->get_offset_address(
+        static_cast<uint32_t>(id), begin, end - begin);
+    ET_CHECK_OK_OR_RETURN_ERROR(src.error());
+    stage.buffers[id].reset(new uint8_t[end - begin]);
+    std::memcpy(stage.buffers[id].get(), src.get(), end - begin);
+  }
+
+  // Copy the values, pointing tensors into the stage's buffers. Lists are
+  // done last, since they point to other values of the stage.
+  stage.values.resize(n_value);
+  for (size_t v = 0; v < n_value; ++v) {
+    if (!in_stage(v)) {
+      continue;
+    }
+    const EValue& value = method_values[v];
+    if (value.isTensor()) {
+      const auto* s_tensor = s_values->Get(v)->val_as_Tensor();
+      if (s_tensor->constant_buffer_idx() > 0) {
+        stage.values[v] = value;
+        continue;
+      }
+      const auto* info = s_tensor->allocation_info();
+      const size_t id = info->memory_id() - 1;
+      const exec_aten::Tensor& t = value.toTensor();
+      auto copy = std::make_unique<TensorCopy>();
+      copy->sizes.assign(t.sizes().begin(), t.sizes().end());
+      copy->dim_order.assign(t.dim_order().begin(), t.dim_order().end());
+      copy->strides.assign(t.strides().begin(), t.strides().end());
+      copy->impl = std::make_unique<TensorImpl>(
+          t.scalar_type(),
+          t.dim(),
+          copy->sizes.data(),
+          stage.buffers[id].get() + allocation_offset(info) -
+              stage.buffer_begins[id],
+          copy->dim_order.data(),
+          copy->strides.data(),
+          static_cast<TensorShapeDynamism>(s_tensor->shape_dynamism()));
+      stage.values[v] = EValue(exec_aten::Tensor(copy->impl.get()));
+      stage.tensors.push_back(std::move(copy));
+    } else if (
+        value.isIntList() || value.isTensorList() ||
+        value.isListOptionalTensor()) {
+      continue;
+    } else {
+      // Scalars, strings, and lists of constants.
+      stage.values[v] = value;
+    }
+    if (first_stage_[v] < s && (value.isTensor() || value.isScalar())) {
+      stage.live_in.push_back(v);
+    }
+  }
+  for (size_t v = 0; v < n_value; ++v) {
+    const EValue& value = method_values[v];
+    if (!in_stage(v) ||
+        !(value.isIntList() || value.isTensorList() ||
+          value.isListOptionalTensor())) {
+      continue;
+    }
+    std::vector<EValue*> boxed;
+    for (int64_t item : list_items(s_values->Get(v))) {
+      boxed.push_back(item >= 0 ? &stage.values[item] : nullptr);
+    }
+    const int size = static_cast<int>(boxed.size());
+    if (value.isIntList()) {
+      stage.int_lists.emplace_back(boxed.size());
+      stage.values[v] = EValue(BoxedEvalueList<int64_t>(
+          boxed.data(), stage.int_lists.back().data(), size));
+    } else if (value.isTensorList()) {
+      std::vector<exec_aten::Tensor> tensors;
+      tensors.reserve(boxed.size());
+      for (EValue* item : boxed) {
+        tensors.push_back(item->toTensor());
+      }
+      stage.tensor_lists.push_back(std::move(tensors));
+      stage.values[v] = EValue(BoxedEvalueList<exec_aten::Tensor>(
+          boxed.data(), stage.tensor_lists.back().data(), size));
+    } else {
+      stage.optional_tensor_lists.emplace_back(boxed.size());
+      stage.values[v] =
+          EValue(BoxedEvalueList<exec_aten::optional<exec_aten::Tensor>>(
+              boxed.data(), stage.optional_tensor_lists.back().data(), size));
+    }
+    // The vector's heap storage, which the list points to, stays put when the
+    // vector is moved.
+    stage.boxed_lists.push_back(std::move(boxed));
+  }
+
+  for (size_t i = stage.begin; i < stage.end; ++i) {
+    std::vector<EValue*> args;
+    for (EValue* arg : method_->experimental_instruction_args(0, i)) {
+      args.push_back(&stage.values[arg - method_values]);
+    }
+    stage.args.push_back(std::move(args));
+  }
+  return Error::Ok;
+}
+
+EValue* PipelinedMethod::stage_value(size_t stage, size_t value_index) {
+  if (stage == 0) {
+    return &method_->experimental_values()[value_index];
+  }
+  return &stages_[stage]->values[value_index];
+}
+
+Error PipelinedMethod::copy_from_previous_stage(size_t s) {
+  for (size_t v : stages_[s]->live_in) {
+    const EValue& src = *stage_value(s - 1, v);
+    EValue& dst = *stage_value(s, v);
+    if (!src.isTensor()) {
+      dst = src;
+      continue;
+    }
+    const exec_aten::Tensor& src_tensor = src.toTensor();
+    exec_aten::Tensor dst_tensor = dst.toTensor();
+    ET_CHECK_OK_OR_RETURN_ERROR(resize_tensor(dst_tensor, src_tensor.sizes()));
+    if (src_tensor.nbytes() > 0) {
+      std::memcpy(
+          dst_tensor.mutable_data_ptr(),
+          src_tensor.const_data_ptr(),
+          src_tensor.nbytes());
+    }
+  }
+  return Error::Ok;
+}
+
+Error PipelinedMethod::run_stage(size_t s) {
+  Stage& stage = *stages_[s];
+  for (size_t i = stage.begin; i < stage.end; ++i) {
+    InstructionArgs args = s == 0
+        ? method_->experimental_instruction_args(0, i)
+        : InstructionArgs(
+              stage.args[i - stage.begin].data(),
+              stage.args[i - stage.begin].size());
+    size_t next_instr_idx = i + 1;
+    Error err = method_->experimental_execute_instruction(
+        0, i, args, &next_instr_idx);
+    if (err != Error::Ok) {
+      ET_LOG(
+          Error,
+          "Pipeline stage %zu failed at instruction %zu: 0x%" PRIx32,
+          s,
+          i,
+          static_cast<uint32_t>(err));
+      return err;
+    }
+  }
+  return Error::Ok;
+}
+
+void PipelinedMethod::stage_thread_loop(size_t s) {
+  uint64_t seen_generation = 0;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      work_ready_.wait(
+          lock, [&] { return stopping_ || generation_ != seen_generation; });
+      if (stopping_) {
+        return;
+      }
+      seen_generation = generation_;
+    }
+    Stage& stage = *stages_[s];
+    stage.error = stage.occupied ? run_stage(s) : Error::Ok;
+    {
+      std::lock_guard<std::mutex> guard(mutex_);
+      if (--pending_ == 0) {
+        work_done_.notify_one();
+      }
+    }
+  }
+}
+
+void PipelinedMethod::stop_threads() {
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    stopping_ = true;
+  }
+  work_ready_.notify_all();
+  for (auto& stage : stages_) {
+    if (stage->thread.joinable()) {
+      stage->thread.join();
+    }
+  }
+}
+
+Result<bool> PipelinedMethod::step(
+    const EValue* inputs,
+    size_t num_inputs,
+    EValue* outputs,
+    size_t num_outputs) {
+  const size_t num_method_outputs = method_->outputs_size();
+  ET_CHECK_OR_RETURN_ERROR(
+      num_outputs >= num_method_outputs,
+      InvalidArgument,
+      "outputs has %zu elements, the method has %zu outputs",
+      num_outputs,
+      num_method_outputs);
+  ET_CHECK_OR_RETURN_ERROR(
+      inputs == nullptr || num_inputs == method_->inputs_size(),
+      InvalidArgument,
+      "Got %zu inputs, the method has %zu",
+      num_inputs,
+      method_->inputs_size());
+
+  auto fail = [this](Error err) {
+    for (auto& stage : stages_) {
+      stage->occupied = false;
+    }
+    return err;
+  };
+
+  // Move every request to the next stage, starting from the end so that no
+  // value is overwritten before it has been copied.
+  for (size_t s = stages_.size() - 1; s > 0; --s) {
+    if (stages_[s - 1]->occupied) {
+      Error err = copy_from_previous_stage(s);
+      if (err != Error::Ok) {
+        return fail(err);
+      }
+    }
+    stages_[s]->occupied = stages_[s - 1]->occupied;
+  }
+  stages_[0]->occupied = false;
+  if (inputs != nullptr) {
+    for (size_t i = 0; i < num_inputs; ++i) {
+      Error err = method_->set_input(inputs[i], i);
+      if (err != Error::Ok) {
+        return fail(err);
+      }
+    }
+    stages_[0]->occupied = true;
+  }
+
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    generation_++;
+    pending_ = stages_.size();
+    work_ready_.notify_all();
+    work_done_.wait(lock, [this] { return pending_ == 0; });
+  }
+  for (auto& stage : stages_) {
+    if (stage->error != Error::Ok) {
+      return fail(stage->error);
+    }
+  }
+
+  if (!stages_.back()->occupied) {
+    return false;
+  }
+  for (size_t i = 0; i < num_outputs; ++i) {
+    outputs[i] = i < num_method_outputs
+        ? *stage_value(
+              stages_.size() - 1,
+              method_->experimental_execution_plan()->outputs()->Get(i))
+        : EValue();
+  }
+  return true;
+}
+
+Result<std::vector<double>> measure_instruction_costs(Method* method) {
+  std::vector<double> costs;
+  while (true) {
+    const auto start = std::chrono::steady_clock::now();
+    Error err = method->experimental_step();
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    if (err == Error::EndOfMethod) {
+      break;
+    }
+    if (err != Error::Ok) {
+      return err;
+    }
+    costs.push_back(
+        std::chrono::duration<double, std::nano>(elapsed).count());
+  }
+  ET_CHECK_OK_OR_RETURN_ERROR(method->experimental_reset_execution());
+  return costs;
+}
+
+} // namespace torch::executor
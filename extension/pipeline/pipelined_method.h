@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+// @nolint PATTERNLINT Ok to use stdlib for this optional library
+#include <condition_variable>
+// @nolint PATTERNLINT Ok to use stdlib for this optional library
+#include <memory>
+// @nolint PATTERNLINT Ok to use stdlib for this optional library
+#include <mutex>
+// @nolint PATTERNLINT Ok to use stdlib for this optional library
+#include <thread>
+// @nolint PATTERNLINT Ok to use stdlib for this optional library
+#include <vector>
+
+#include <executorch/runtime/executor/method.h>
+
+namespace torch::executor {
+
+/**
+ * Options for splitting a Method into pipeline stages.
+ */
+struct PipelineConfig {
+  /// Number of stages. Each stage runs on its own thread.
+  size_t num_stages = 2;
+
+  /// Cost of each instruction of the method, used to balance the stages, e.g.
+  /// as returned by measure_instruction_costs(). If empty, the cost of an
+  /// instruction is estimated from the sizes of its tensor arguments.
+  std::vector<double> instruction_costs;
+
+  /// CPUs to pin the thread of each stage to, indexed by stage. A stage with
+  /// no entry, or an empty one, is not pinned. Only supported on Linux.
+  std::vector<std::vector<int>> stage_cpus;
+};
+
+/**
+ * Runs a Method as a pipeline, for streaming workloads where throughput
+ * matters more than the latency of a single request.
+ *
+ * The instructions of the method are split into consecutive stages of about
+ * equal cost. Each stage runs on its own thread, and consecutive requests flow
+ * through the stages concurrently: while the last stage finishes request n,
+ * the first one starts request n + K - 1.
+ *
+ * The first stage runs on the values and memory-planned buffers of the Method
+ * itself. Every other stage gets its own copy of the values it uses, backed by
+ * a copy of the part of the planned buffers that these values live in, so that
+ * the stages never touch the same memory. The copies start with the contents
+ * of the Method's buffers when the pipeline is loaded. Between steps, the
+ * values that cross a stage boundary are copied to the next stage. The
+ * weights, delegates and kernels are shared by all stages.
+ *
+ * Requirements on the method:
+ * - A single chain, without control flow (jumps and moves).
+ * - All non-constant tensors are memory planned, including the inputs and
+ *   outputs.
+ * - No delegate is called from more than one stage.
+ * - State kept across requests, e.g. mutable buffers, is only used by the
+ *   instructions of one stage. Each stage has its own copy, so the updates
+ *   made by one stage are not seen by the others.
+ * - No EventTracer, which is not thread safe.
+ *
+ * The Method must outlive the PipelinedMethod, and must not be executed or
+ * have its inputs set directly while the PipelinedMethod exists.
+ */
+class PipelinedMethod final {
+ public:
+  /**
+   * Splits the instructions of an initialized method into stages and starts
+   * the stage threads.
+   *
+   * @returns The pipeline, Error::NotSupported if the method does not meet the
+   *     requirements above, or Error::InvalidArgument if the config does not
+   *     match the method.
+   */
+  static Result<std::unique_ptr<PipelinedMethod>> load(
+      Method* method,
+      const PipelineConfig& config);
+
+  ~PipelinedMethod();
+
+  PipelinedMethod(const PipelinedMethod&) = delete;
+  PipelinedMethod& operator=(const PipelinedMethod&) = delete;
+  PipelinedMethod(PipelinedMethod&&) = delete;
+  PipelinedMethod& operator=(PipelinedMethod&&) = delete;
+
+  /**
+   * Advances the pipeline by one step.
+   *
+   * Every request moves to the next stage. If inputs is not null, a new
+   * request with these inputs enters the first stage. All stages that hold a
+   * request then run concurrently. Pass null inputs to drain the pipeline.
+   *
+   * @param[in] inputs The inputs of the new request, or null.
+   * @param[in] num_inputs The number of elements in inputs.
+   * @param[out] outputs If a request left the last stage during this step, set
+   *     to its outputs. They point into the pipeline's memory and are valid
+   *     until the next call to step().
+   * @param[in] num_outputs The number of elements in outputs. Must be at least
+   *     the number of outputs of the method.
+   *
+   * @returns True if a request finished during this step and its outputs were
+   *     written, false otherwise, or an error. After an error the pipeline is
+   *     empty.
+   */
+  __ET_NODISCARD Result<bool> step(
+      const EValue* inputs,
+      size_t num_inputs,
+      EValue* outputs,
+      size_t num_outputs);
+
+  /// Returns the number of stages.
+  size_t num_stages() const {
+    return stages_.size();
+  }
+
+  /// Returns the index of the first instruction of the given stage.
+  size_t stage_begin(size_t stage) const;
+
+  /// Returns the index past the last instruction of the given stage.
+  size_t stage_end(size_t stage) const;
+
+  /// Returns the number of requests in the pipeline.
+  size_t num_in_flight() const;
+
+ private:
+  struct TensorCopy;
+  struct Stage;
+
+  explicit PipelinedMethod(Method* method);
+
+  Error init(const PipelineConfig& config);
+  Error init_stage_values(size_t stage);
+  EValue* stage_value(size_t stage, size_t value_index);
+  Error copy_from_previous_stage(size_t stage);
+  Error run_stage(size_t stage);
+  void stage_thread_loop(size_t stage);
+  void stop_threads();
+
+  Method* method_;
+  std::vector<std::unique_ptr<Stage>> stages_;
+  // Index of the first stage that uses each value, and of the last one.
+  std::vector<size_t> first_stage_;
+  std::vector<size_t> last_stage_;
+
+  // Hands out work to the stage threads. Each step increments generation_,
+  // and every thread decrements pending_ when done with it.
+  std::mutex mutex_;
+  std::condition_variable work_ready_;
+  std::condition_variable work_done_;
+  uint64_t generation_ = 0;
+  size_t pending_ = 0;
+  bool stopping_ = false;
+};
+
+/**
+ * Runs the method once with the inputs that are currently set, one
+ * instruction at a time, and returns the duration of each instruction in
+ * nanoseconds. Meant to be passed as PipelineConfig::instruction_costs.
+ */
+Result<std::vector<double>> measure_instruction_costs(Method* method);
+
+} // namespace torch::executor
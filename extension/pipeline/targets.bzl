@@ -0,0 +1,47 @@
+load("@fbsource//xplat/executorch/build:runtime_wrapper.bzl", "runtime")
+
+def define_common_targets():
+    """Defines targets that should be shared between fbcode and xplat.
+
+    The directory containing this targets.bzl file should also contain both
+    TARGETS and BUCK files that call this function.
+    """
+
+    runtime.cxx_library(
+        name = "pipeline",
+        srcs = [
+            "pipelined_method.cpp",
+        ],
+        exported_headers = [
+            "pipelined_method.h",
+        ],
+        visibility = [
+            "//executorch/...",
+            "@EXECUTORCH_CLIENTS",
+        ],
+        exported_deps = [
+            "//executorch/runtime/executor:program",
+        ],
+        deps = [
+            "//executorch/runtime/core/exec_aten/util:tensor_util",
+            "//executorch/runtime/platform:platform",
+        ],
+    )
+
+    # Measures the throughput of a model for an increasing number of pipeline
+    # stages.
+    runtime.cxx_binary(
+        name = "pipeline_benchmark",
+        srcs = [
+            "pipeline_benchmark.cpp",
+        ],
+        deps = [
+            ":pipeline",
+            "//executorch/extension/data_loader:file_data_loader",
+            "//executorch/extension/runner_util:inputs",
+            "//executorch/kernels/portable:generated_lib",
+        ],
+        external_deps = [
+            "gflags",
+        ],
+    )
@@ -0,0 +1,248 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <executorch/extension/pipeline/pipelined_method.h>
+
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+#include <executorch/extension/data_loader/file_data_loader.h>
+#include <executorch/runtime/core/exec_aten/exec_aten.h>
+#include <executorch/runtime/core/exec_aten/testing_util/tensor_factory.h>
+#include <executorch/runtime/core/exec_aten/testing_util/tensor_util.h>
+#include <executorch/runtime/executor/program.h>
+#include <executorch/runtime/executor/test/managed_memory_manager.h>
+#include <executorch/runtime/platform/runtime.h>
+#include <gtest/gtest.h>
+
+using namespace ::testing;
+using exec_aten::ScalarType;
+using exec_aten::Tensor;
+using torch::executor::Error;
+using torch::executor::EValue;
+using torch::executor::Method;
+using torch::executor::PipelineConfig;
+using torch::executor::PipelinedMethod;
+using torch::executor::Program;
+using torch::executor::Result;
+using torch::executor::testing::ManagedMemoryManager;
+using torch::executor::testing::TensorFactory;
+using torch::executor::util::FileDataLoader;
+
+class PipelinedMethodTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    torch::executor::runtime_init();
+
+    // ModuleLinear computes 3 * x + 2 with a mul and an add instruction.
+    method_ = load_method("ET_MODULE_LINEAR_PATH");
+    ASSERT_NE(method_, nullptr);
+  }
+
+  // Loads the forward method of the program file named by the environment
+  // variable, with its own planned memory. Returns null on failure.
+  std::unique_ptr<Method> load_method(const char* path_env_var) {
+    Result<FileDataLoader> loader =
+        FileDataLoader::from(std::getenv(path_env_var));
+    if (!loader.ok()) {
+      return nullptr;
+    }
+    loaders_.push_back(
+        std::make_unique<FileDataLoader>(std::move(loader.get())));
+
+    Result<Program> program = Program::load(
+        loaders_.back().get(), Program::Verification::InternalConsistency);
+    if (!program.ok()) {
+      return nullptr;
+    }
+    programs_.push_back(std::make_unique<Program>(std::move(program.get())));
+
+    mmms_.push_back(std::make_unique<ManagedMemoryManager>(
+        /*planned_memory_bytes=*/32 * 1024U,
+        /*method_allocator_bytes=*/32 * 1024U));
+
+    Result<Method> method =
+        programs_.back()->load_method("forward", &mmms_.back()->get());
+    if (!method.ok()) {
+      return nullptr;
+    }
+    return std::make_unique<Method>(std::move(method.get()));
+  }
+
+  // Runs num_requests requests with inputs i and checks that they come out of
+  // the pipeline in order, with the outputs of the method.
+  void run_requests(PipelinedMethod& pipeline, int num_requests) {
+    TensorFactory<ScalarType::Float> tf;
+    std::vector<Tensor> inputs;
+    for (int i = 0; i < num_requests; ++i) {
+      inputs.push_back(tf.full({2, 2}, i));
+    }
+
+    int num_done = 0;
+    for (int step = 0; num_done < num_requests; ++step) {
+      EValue input;
+      if (step < num_requests) {
+        input = EValue(inputs[step]);
+      }
+      EValue output;
+      Result<bool> done = pipeline.step(
+          step < num_requests ? &input : nullptr,
+          step < num_requests ? 1 : 0,
+          &output,
+          1);
+      ASSERT_EQ(done.error(), Error::Ok);
+      // A request needs one step per stage.
+      const bool expect_done = step + 1 >= int(pipeline.num_stages());
+      ASSERT_EQ(done.get(), expect_done);
+      if (done.get()) {
+        ASSERT_TRUE(output.isTensor());
+        EXPECT_TENSOR_EQ(output.toTensor(), tf.full({2, 2}, 3 * num_done + 2));
+        num_done++;
+      }
+    }
+    EXPECT_EQ(pipeline.num_in_flight(), 0);
+  }
+
+ private:
+  // Must outlive the methods, but tests shouldn't need to touch them.
+  std::vector<std::unique_ptr<FileDataLoader>> loaders_;
+  std::vector<std::unique_ptr<Program>> programs_;
+  std::vector<std::unique_ptr<ManagedMemoryManager>> mmms_;
+
+ protected:
+  std::unique_ptr<Method> method_;
+};
+
+TEST_F(PipelinedMethodTest, SingleStageMatchesMethod) {
+  PipelineConfig config;
+  config.num_stages = 1;
+  Result<std::unique_ptr<PipelinedMethod>> pipeline =
+      PipelinedMethod::load(method_.get(), config);
+  ASSERT_EQ(pipeline.error(), Error::Ok);
+  EXPECT_EQ(pipeline.get()->num_stages(), 1);
+  run_requests(*pipeline.get(), 3);
+}
+
+TEST_F(PipelinedMethodTest, TwoStagesMatchMethod) {
+  PipelineConfig config;
+  config.num_stages = 2;
+  Result<std::unique_ptr<PipelinedMethod>> pipeline =
+      PipelinedMethod::load(method_.get(), config);
+  ASSERT_EQ(pipeline.error(), Error::Ok);
+  PipelinedMethod& p = *pipeline.get();
+  ASSERT_EQ(p.num_stages(), 2);
+  // One instruction per stage.
+  EXPECT_EQ(p.stage_begin(0), 0);
+  EXPECT_EQ(p.stage_end(0), 1);
+  EXPECT_EQ(p.stage_begin(1), 1);
+  EXPECT_EQ(p.stage_end(1), 2);
+  run_requests(p, 5);
+}
+
+TEST_F(PipelinedMethodTest, MeasuredCostsBalanceTheStages) {
+  TensorFactory<ScalarType::Float> tf;
+  Tensor input = tf.ones({2, 2});
+  ASSERT_EQ(method_->set_input(EValue(input), 0), Error::Ok);
+  Result<std::vector<double>> costs =
+      torch::executor::measure_instruction_costs(method_.get());
+  ASSERT_EQ(costs.error(), Error::Ok);
+  EXPECT_EQ(costs->size(), 2);
+
+  PipelineConfig config;
+  config.num_stages = 2;
+  config.instruction_costs = costs.get();
+  Result<std::unique_ptr<PipelinedMethod>> pipeline =
+      PipelinedMethod::load(method_.get(), config);
+  ASSERT_EQ(pipeline.error(), Error::Ok);
+  run_requests(*pipeline.get(), 4);
+}
+
+TEST_F(PipelinedMethodTest, RejectsBadConfigs) {
+  PipelineConfig config;
+  config.num_stages = 0;
+  EXPECT_EQ(
+      PipelinedMethod::load(method_.get(), config).error(),
+      Error::InvalidArgument);
+
+  // More stages than instructions.
+  config.num_stages = 100;
+  EXPECT_EQ(
+      PipelinedMethod::load(method_.get(), config).error(),
+      Error::InvalidArgument);
+
+  config.num_stages = 2;
+  config.instruction_costs = {1.0};
+  EXPECT_EQ(
+      PipelinedMethod::load(method_.get(), config).error(),
+      Error::InvalidArgument);
+}
+
+TEST_F(PipelinedMethodTest, StateOfTheLastStageMatchesMethod) {
+  // ModuleAccumulate adds 3 * x to a mutable buffer and returns the buffer.
+  // Only its first instruction does not use the buffer.
+  std::unique_ptr<Method> pipelined_method =
+      load_method("ET_MODULE_ACCUMULATE_PATH");
+  ASSERT_NE(pipelined_method, nullptr);
+  std::unique_ptr<Method> serial_method =
+      load_method("ET_MODULE_ACCUMULATE_PATH");
+  ASSERT_NE(serial_method, nullptr);
+
+  // A single stage holds all the instructions.
+  PipelineConfig config;
+  config.num_stages = 1;
+  Result<std::unique_ptr<PipelinedMethod>> single_stage =
+      PipelinedMethod::load(pipelined_method.get(), config);
+  ASSERT_EQ(single_stage.error(), Error::Ok);
+  const size_t num_instructions = single_stage.get()->stage_end(0);
+  single_stage.get().reset();
+
+  // Put the first instruction alone in the first stage.
+  config.num_stages = 2;
+  config.instruction_costs.assign(num_instructions, 1.0);
+  config.instruction_costs[0] = 1000.0;
+  Result<std::unique_ptr<PipelinedMethod>> pipeline =
+      PipelinedMethod::load(pipelined_method.get(), config);
+  ASSERT_EQ(pipeline.error(), Error::Ok);
+  PipelinedMethod& p = *pipeline.get();
+  ASSERT_EQ(p.stage_end(0), 1);
+
+  constexpr int kNumRequests = 5;
+  TensorFactory<ScalarType::Float> tf;
+  std::vector<Tensor> inputs;
+  std::vector<std::vector<float>> expected;
+  for (int i = 0; i < kNumRequests; ++i) {
+    inputs.push_back(tf.full({2, 2}, i + 1));
+    ASSERT_EQ(serial_method->set_input(EValue(inputs.back()), 0), Error::Ok);
+    ASSERT_EQ(serial_method->execute(), Error::Ok);
+    const Tensor out = serial_method->get_output(0).toTensor();
+    expected.emplace_back(
+        out.const_data_ptr<float>(), out.const_data_ptr<float>() + out.numel());
+  }
+
+  int num_done = 0;
+  for (int step = 0; num_done < kNumRequests; ++step) {
+    EValue input;
+    if (step < kNumRequests) {
+      input = EValue(inputs[step]);
+    }
+    EValue output;
+    Result<bool> done = p.step(
+        step < kNumRequests ? &input : nullptr,
+        step < kNumRequests ? 1 : 0,
+        &output,
+        1);
+    ASSERT_EQ(done.error(), Error::Ok);
+    if (done.get()) {
+      EXPECT_TENSOR_EQ(output.toTensor(), tf.make({2, 2}, expected[num_done]));
+      num_done++;
+    }
+  }
+  // The state accumulated every request: 3 * (1 + 2 + ... + 5).
+  EXPECT_EQ(expected.back()[0], 45.0f);
+}
@@ -0,0 +1,28 @@
+load("@fbsource//xplat/executorch/build:runtime_wrapper.bzl", "runtime")
+
+def define_common_targets(is_fbcode = False):
+    """Defines targets that should be shared between fbcode and xplat.
+
+    The directory containing this targets.bzl file should also contain both
+    TARGETS and BUCK files that call this function.
+    """
+
+    # The test reads a model file from fbcode, so it only runs there.
+    if not runtime.is_oss and is_fbcode:
+        runtime.cxx_test(
+            name = "pipelined_method_test",
+            srcs = [
+                "pipelined_method_test.cpp",
+            ],
+            deps = [
+                "//executorch/extension/pipeline:pipeline",
+                "//executorch/extension/data_loader:file_data_loader",
+                "//executorch/kernels/portable:generated_lib",
+                "//executorch/runtime/core/exec_aten/testing_util:tensor_util",
+                "//executorch/runtime/executor/test:managed_memory_manager",
+            ],
+            env = {
+                "ET_MODULE_ACCUMULATE_PATH": "$(location fbcode//executorch/test/models:exported_programs[ModuleAccumulate.pte])",
+                "ET_MODULE_LINEAR_PATH": "$(location fbcode//executorch/test/models:exported_programs[ModuleLinear.pte])",
+            },
+        )
@@ -19,6 +19,7 @@
 
 #include <executorch/extension/data_loader/buffer_data_loader.h>
 #include <executorch/extension/data_loader/mmap_data_loader.h>
+#include <executorch/extension/data_loader/shared_memory_data_loader.h>
 #include <executorch/extension/memory_allocator/malloc_memory_allocator.h>
 #include <executorch/runtime/core/data_loader.h>
 #include <executorch/runtime/executor/method.h>
@@ -80,6 +81,7 @@ namespace {
 using util::BufferDataLoader;
 using util::MallocMemoryAllocator;
 using util::MmapDataLoader;
+using util::SharedMemoryDataLoader;
 
 class Module final {
  public:
@@ -303,18 +305,31 @@ load_from_buffer(const void* ptr, size_t ptr_len, bool enable_etdump) {
 
 inline std::unique_ptr<Module> load_from_file(
     const std::string& path,
-    bool enable_etdump) {
+    bool enable_etdump,
+    bool shared_memory) {
   EXECUTORCH_SCOPE_PROF("load_from_file");
 
-  Result<MmapDataLoader> res = MmapDataLoader::from(
-      path.c_str(), MmapDataLoader::MlockConfig::UseMlockIgnoreErrors);
-  THROW_IF_ERROR(
-      res.error(),
-      "Failed to create MmapDataLoader from file %s, error: 0x:%" PRIx32,
-      path.c_str(),
-      static_cast<uint32_t>(res.error()));
+  std::unique_ptr<DataLoader> loader;
+  if (shared_memory) {
+    Result<SharedMemoryDataLoader> res =
+        SharedMemoryDataLoader::from(path.c_str());
+    THROW_IF_ERROR(
+        res.error(),
+        "Failed to create SharedMemoryDataLoader from file %s, error: 0x:%" PRIx32,
+        path.c_str(),
+        static_cast<uint32_t>(res.error()));
+    loader = std::make_unique<SharedMemoryDataLoader>(std::move(res.get()));
+  } else {
+    Result<MmapDataLoader> res = MmapDataLoader::from(
+        path.c_str(), MmapDataLoader::MlockConfig::UseMlockIgnoreErrors);
+    THROW_IF_ERROR(
+        res.error(),
+        "Failed to create MmapDataLoader from file %s, error: 0x:%" PRIx32,
+        path.c_str(),
+        static_cast<uint32_t>(res.error()));
+    loader = std::make_unique<MmapDataLoader>(std::move(res.get()));
+  }
 
-  auto loader = std::make_unique<MmapDataLoader>(std::move(res.get()));
   return std::make_unique<Module>(
       std::move(loader),
       enable_etdump ? std::make_unique<torch::executor::ETDumpGen>() : nullptr);
@@ -374,8 +389,14 @@ struct PyModule final {
       : module_(
             torch::executor::load_from_buffer(ptr, ptr_len, enable_etdump)) {}
 
-  explicit PyModule(const std::string& path, bool enable_etdump)
-      : module_(torch::executor::load_from_file(path, enable_etdump)) {}
+  explicit PyModule(
+      const std::string& path,
+      bool enable_etdump,
+      bool shared_memory)
+      : module_(torch::executor::load_from_file(
+            path,
+            enable_etdump,
+            shared_memory)) {}
 
   PyModule(const PyModule&) = delete;
   PyModule& operator=(const PyModule&) = delete;
@@ -390,8 +411,9 @@ struct PyModule final {
   }
   static std::unique_ptr<PyModule> load_from_file(
       const std::string& path,
-      bool enable_etdump) {
-    return std::make_unique<PyModule>(path, enable_etdump);
+      bool enable_etdump,
+      bool shared_memory) {
+    return std::make_unique<PyModule>(path, enable_etdump, shared_memory);
   }
 
   static std::unique_ptr<PyModule> load_from_bundled_program(
@@ -648,6 +670,7 @@ PYBIND11_MODULE(EXECUTORCH_PYTHON_MODULE_NAME, m) {
       PyModule::load_from_file,
       py::arg("path"),
       py::arg("enable_etdump") = false,
+      py::arg("shared_memory") = false,
       call_guard);
   m.def(
       "_load_for_executorch_from_buffer",
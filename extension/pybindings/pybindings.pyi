@@ -29,7 +29,7 @@ class ExecutorchModule:
 class BundledModule: ...
 
 def _load_for_executorch(
-    path: str, enable_etdump: bool = False
+    path: str, enable_etdump: bool = False, shared_memory: bool = False
 ) -> ExecutorchModule: ...
 def _load_for_executorch_from_buffer(
     buffer: bytes, enable_etdump: bool = False
@@ -0,0 +1,234 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <executorch/extension/scheduler/method_scheduler.h>
+
+#include <cinttypes>
+
+#include <executorch/runtime/platform/log.h>
+
+namespace torch::executor {
+
+MethodScheduler::MethodScheduler() {
+  thread_ = std::thread([this] { run(); });
+}
+
+MethodScheduler::~MethodScheduler() {
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    stopping_ = true;
+  }
+  changed_ = true;
+  work_ready_.notify_all();
+  thread_.join();
+
+  // The scheduler thread is gone, so the methods can be reset from here.
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    for (auto& entry : jobs_) {
+      Job& job = entry.second;
+      if (job.done) {
+        continue;
+      }
+      if (job.started) {
+        (void)job.method->experimental_abort_execution();
+      }
+      finish_locked(job, Error::Cancelled);
+    }
+  }
+  run_callbacks();
+  job_done_.notify_all();
+}
+
+Result<MethodScheduler::JobId> MethodScheduler::submit(
+    Method* method,
+    JobOptions options) {
+  ET_CHECK_OR_RETURN_ERROR(
+      method != nullptr, InvalidArgument, "Method must not be null");
+  JobId id;
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    ET_CHECK_OR_RETURN_ERROR(
+        !stopping_, InvalidState, "The scheduler is stopping");
+    for (const auto& entry : jobs_) {
+      ET_CHECK_OR_RETURN_ERROR(
+          entry.second.method != method || entry.second.done,
+          InvalidState,
+          "The method already has unfinished job %" PRIu64,
+          entry.first);
+    }
+    id = next_id_++;
+    Job& job = jobs_[id];
+    job.method = method;
+    job.detached = static_cast<bool>(options.on_done);
+    job.options = std::move(options);
+  }
+  changed_ = true;
+  work_ready_.notify_one();
+  return id;
+}
+
+Error MethodScheduler::cancel(JobId id) {
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    auto it = jobs_.find(id);
+    ET_CHECK_OR_RETURN_ERROR(
+        it != jobs_.end(), NotFound, "No job %" PRIu64, id);
+    if (it->second.done) {
+      return Error::Ok;
+    }
+    it->second.cancel_requested = true;
+  }
+  // The scheduler thread finishes the job before its next instruction.
+  changed_ = true;
+  work_ready_.notify_one();
+  return Error::Ok;
+}
+
+Error MethodScheduler::wait(JobId id) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  auto it = jobs_.find(id);
+  ET_CHECK_OR_RETURN_ERROR(it != jobs_.end(), NotFound, "No job %" PRIu64, id);
+  ET_CHECK_OR_RETURN_ERROR(
+      !it->second.detached,
+      InvalidArgument,
+      "Job %" PRIu64 " has an on_done callback",
+      id);
+  job_done_.wait(lock, [&] { return it->second.done; });
+  const Error result = it->second.result;
+  jobs_.erase(it);
+  return result;
+}
+
+Error MethodScheduler::execute(Method* method, JobOptions options) {
+  Result<JobId> id = submit(method, std::move(options));
+  if (!id.ok()) {
+    return id.error();
+  }
+  return wait(id.get());
+}
+
+size_t MethodScheduler::num_preemptions() const {
+  std::lock_guard<std::mutex> guard(mutex_);
+  return num_preemptions_;
+}
+
+MethodScheduler::JobId MethodScheduler::pick_locked() {
+  const auto now = std::chrono::steady_clock::now();
+  JobId best_id = 0;
+  Job* best = nullptr;
+  for (auto it = jobs_.begin(); it != jobs_.end();) {
+    const JobId id = it->first;
+    Job& job = it->second;
+    if (job.done) {
+      it = job.detached ? jobs_.erase(it) : std::next(it);
+      continue;
+    }
+    const bool expired =
+        job.options.cancel_at_deadline && now >= job.options.deadline;
+    if (job.cancel_requested || expired) {
+      if (job.started) {
+        (void)job.method->experimental_abort_execution();
+      }
+      finish_locked(job, Error::Cancelled);
+      // Forgotten by the next pick, in case it is the current job.
+      ++it;
+      continue;
+    }
+    ++it;
+    // jobs_ is ordered by id, so ties keep the oldest job.
+    if (best == nullptr || job.options.priority > best->options.priority ||
+        (job.options.priority == best->options.priority &&
+         job.options.deadline < best->options.deadline)) {
+      best_id = id;
+      best = &job;
+    }
+  }
+  return best_id;
+}
+
+void MethodScheduler::finish_locked(Job& job, Error result) {
+  job.done = true;
+  job.result = result;
+  if (job.options.on_done) {
+    callbacks_.emplace_back(std::move(job.options.on_done), result);
+  }
+  job_done_.notify_all();
+}
+
+void MethodScheduler::run_callbacks() {
+  std::vector<std::pair<std::function<void(Error)>, Error>> callbacks;
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    callbacks.swap(callbacks_);
+  }
+  for (auto& callback : callbacks) {
+    callback.first(callback.second);
+  }
+}
+
+void MethodScheduler::run() {
+  // Once pick_locked() finishes the current job, e.g. because it was
+  // cancelled, wait() or a later pick may erase it. So it is looked up by id
+  // under the lock before being compared to the next job.
+  JobId current_id = 0;
+  Job* current = nullptr;
+  while (true) {
+    if (current == nullptr || changed_.exchange(false)) {
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        JobId next_id = 0;
+        work_ready_.wait(lock, [&] {
+          next_id = stopping_ ? 0 : pick_locked();
+          return stopping_ || next_id != 0;
+        });
+        if (stopping_) {
+          return;
+        }
+        auto it = jobs_.find(current_id);
+        if (it != jobs_.end() && !it->second.done && next_id != current_id) {
+          num_preemptions_++;
+        }
+        current_id = next_id;
+        current = &jobs_.at(next_id);
+      }
+      run_callbacks();
+    }
+
+    Job& job = *current;
+    if (job.options.cancel_at_deadline &&
+        std::chrono::steady_clock::now() >= job.options.deadline) {
+      // Let pick_locked() cancel it.
+      changed_ = true;
+      continue;
+    }
+    Error err = job.method->experimental_step();
+    job.started = true;
+    if (err == Error::Ok) {
+      continue;
+    }
+    if (err == Error::EndOfMethod) {
+      err = job.method->experimental_reset_execution();
+    } else {
+      ET_LOG(
+          Error,
+          "Scheduled job failed: 0x%" PRIx32,
+          static_cast<uint32_t>(err));
+      (void)job.method->experimental_abort_execution();
+    }
+    {
+      std::lock_guard<std::mutex> guard(mutex_);
+      finish_locked(job, err);
+    }
+    current_id = 0;
+    current = nullptr;
+    run_callbacks();
+  }
+}
+
+} // namespace torch::executor
@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+// @nolint PATTERNLINT Ok to use stdlib for this optional library
+#include <atomic>
+// @nolint PATTERNLINT Ok to use stdlib for this optional library
+#include <chrono>
+// @nolint PATTERNLINT Ok to use stdlib for this optional library
+#include <condition_variable>
+// @nolint PATTERNLINT Ok to use stdlib for this optional library
+#include <functional>
+// @nolint PATTERNLINT Ok to use stdlib for this optional library
+#include <map>
+// @nolint PATTERNLINT Ok to use stdlib for this optional library
+#include <mutex>
+// @nolint PATTERNLINT Ok to use stdlib for this optional library
+#include <thread>
+// @nolint PATTERNLINT Ok to use stdlib for this optional library
+#include <utility>
+// @nolint PATTERNLINT Ok to use stdlib for this optional library
+#include <vector>
+
+#include <executorch/runtime/executor/method.h>
+
+namespace torch::executor {
+
+/**
+ * How a job competes with the other jobs of a MethodScheduler.
+ */
+struct JobOptions {
+  /// Jobs with a higher priority run first.
+  int32_t priority = 0;
+
+  /// Among jobs of the same priority, the one with the earliest deadline runs
+  /// first, then the one submitted first. A job that misses its deadline still
+  /// runs to completion, unless cancel_at_deadline is set.
+  std::chrono::steady_clock::time_point deadline =
+      std::chrono::steady_clock::time_point::max();
+
+  /// Cancel the job if it has not finished by its deadline.
+  bool cancel_at_deadline = false;
+
+  /// Called on the scheduler thread when the job finishes, with Error::Ok,
+  /// the error of the failed instruction, or Error::Cancelled. Jobs with a
+  /// callback are forgotten once they finish, and cannot be waited for.
+  std::function<void(Error)> on_done;
+};
+
+/**
+ * Runs several Methods on one thread, interleaved at instruction granularity,
+ * so that a latency-critical model can preempt a long-running background
+ * model on the same cores.
+ *
+ * Each submitted job executes a Method whose inputs are already set, one
+ * instruction at a time with Method::experimental_step(). Before every
+ * instruction, the scheduler switches to the most urgent runnable job: the
+ * highest priority, then the earliest deadline, then the oldest. A preempted
+ * job resumes at the instruction where it left off. The latency of a job is
+ * thus bounded by the duration of the longest instruction of the other jobs,
+ * plus its own run time.
+ *
+ * Jobs can be cancelled at any time. A cancelled job stops before its next
+ * instruction, and its Method is reset with
+ * Method::experimental_abort_execution(), so its inputs must be set again
+ * before it is submitted again.
+ *
+ * A Method may only have one unfinished job at a time, and must not be
+ * touched by anything else until the job is done. Outputs are read with
+ * Method::get_outputs() once the job finished.
+ */
+class MethodScheduler final {
+ public:
+  using JobId = uint64_t;
+
+  /// Starts the scheduler thread.
+  MethodScheduler();
+
+  /// Cancels all unfinished jobs and stops the scheduler thread.
+  ~MethodScheduler();
+
+  MethodScheduler(const MethodScheduler&) = delete;
+  MethodScheduler& operator=(const MethodScheduler&) = delete;
+  MethodScheduler(MethodScheduler&&) = delete;
+  MethodScheduler& operator=(MethodScheduler&&) = delete;
+
+  /**
+   * Queues an execution of the method.
+   *
+   * @returns The id of the job, or Error::InvalidState if the method already
+   *     has an unfinished job.
+   */
+  Result<JobId> submit(Method* method, JobOptions options = {});
+
+  /**
+   * Cancels a job. It is finished with Error::Cancelled unless it finished
+   * already.
+   *
+   * @returns Error::NotFound if there is no job with this id, or if it was
+   *     waited for already.
+   */
+  __ET_NODISCARD Error cancel(JobId job);
+
+  /**
+   * Blocks until a job is finished, and forgets it.
+   *
+   * @returns The result of the job, Error::NotFound if there is no job with
+   *     this id, or if it was waited for already, or Error::InvalidArgument if
+   *     the job has an on_done callback.
+   */
+  __ET_NODISCARD Error wait(JobId job);
+
+  /**
+   * Runs a job and waits for it. Equivalent to submit() followed by wait().
+   */
+  __ET_NODISCARD Error execute(Method* method, JobOptions options = {});
+
+  /// Returns the number of times a job was preempted by another one.
+  size_t num_preemptions() const;
+
+ private:
+  struct Job {
+    Method* method;
+    JobOptions options;
+    // Whether the job executed instructions, and must be reset if cancelled.
+    bool started = false;
+    // Whether the job has an on_done callback, and is forgotten once done.
+    bool detached = false;
+    bool cancel_requested = false;
+    bool done = false;
+    Error result = Error::Ok;
+  };
+
+  // Finishes the jobs that were cancelled or missed their deadline, forgets
+  // finished detached jobs, and returns the id of the most urgent unfinished
+  // job, or 0. Requires mutex_.
+  JobId pick_locked();
+  // Finishes a job with the given result. Requires mutex_.
+  void finish_locked(Job& job, Error result);
+  // Runs the on_done callbacks of the jobs finished since the last call.
+  // Must not hold mutex_.
+  void run_callbacks();
+  void run();
+
+  mutable std::mutex mutex_;
+  // Signaled when a job is submitted or cancelled, or when the scheduler
+  // stops.
+  std::condition_variable work_ready_;
+  // Signaled when a job finishes.
+  std::condition_variable job_done_;
+  // Jobs by id, in submission order. Finished jobs stay until waited for,
+  // unless they are detached.
+  std::map<JobId, Job> jobs_;
+  JobId next_id_ = 1;
+  // on_done callbacks to run, with their results.
+  std::vector<std::pair<std::function<void(Error)>, Error>> callbacks_;
+  size_t num_preemptions_ = 0;
+  bool stopping_ = false;
+  // Set when the set of runnable jobs changed, so that the scheduler thread
+  // only takes the lock to pick a job again when needed.
+  std::atomic<bool> changed_{false};
+  std::thread thread_;
+};
+
+} // namespace torch::executor
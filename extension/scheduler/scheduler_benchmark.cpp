@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+/**
+ * @file
+ *
+ * Measures the latency of a high-priority model that runs every
+ * --interval_us, alone and while a background model runs back to back on the
+ * same MethodScheduler, with and without priorities. All inputs are set to
+ * ones once.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cinttypes>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <gflags/gflags.h>
+
+#include <executorch/extension/data_loader/file_data_loader.h>
+#include <executorch/extension/memory_allocator/malloc_memory_allocator.h>
+#include <executorch/extension/runner_util/inputs.h>
+#include <executorch/extension/scheduler/method_scheduler.h>
+#include <executorch/runtime/executor/program.h>
+#include <executorch/runtime/platform/log.h>
+#include <executorch/runtime/platform/runtime.h>
+
+DEFINE_string(
+    model_path,
+    "model.pte",
+    "Latency-critical model, serialized in flatbuffer format.");
+DEFINE_string(
+    background_model_path,
+    "",
+    "Background model. Defaults to --model_path.");
+DEFINE_int32(num_requests, 200, "Number of high-priority requests.");
+DEFINE_int32(interval_us, 5000, "Time between high-priority requests.");
+
+using namespace torch::executor;
+using torch::executor::util::FileDataLoader;
+
+namespace {
+
+// A loaded method with the memory it needs and its inputs set to ones.
+struct LoadedMethod {
+  std::unique_ptr<FileDataLoader> loader;
+  std::unique_ptr<Program> program;
+  util::MallocMemoryAllocator method_allocator;
+  std::vector<std::vector<uint8_t>> planned_buffers;
+  std::vector<Span<uint8_t>> planned_spans;
+  std::unique_ptr<HierarchicalAllocator> planned_memory;
+  std::unique_ptr<MemoryManager> memory_manager;
+  std::unique_ptr<Method> method;
+  std::unique_ptr<util::BufferCleanup> inputs;
+};
+
+std::unique_ptr<LoadedMethod> load(const std::string& path) {
+  auto loaded = std::make_unique<LoadedMethod>();
+  Result<FileDataLoader> loader = FileDataLoader::from(path.c_str());
+  ET_CHECK_MSG(loader.ok(), "Failed to open %s", path.c_str());
+  loaded->loader = std::make_unique<FileDataLoader>(std::move(loader.get()));
+  Result<Program> program = Program::load(loaded->loader.get());
+  ET_CHECK_MSG(program.ok(), "Failed to parse %s", path.c_str());
+  loaded->program = std::make_unique<Program>(std::move(program.get()));
+
+  const char* method_name = loaded->program->get_method_name(0).get();
+  Result<MethodMeta> meta = loaded->program->method_meta(method_name);
+  ET_CHECK_MSG(meta.ok(), "Failed to get method_meta");
+  for (size_t id = 0; id < meta->num_memory_planned_buffers(); ++id) {
+    loaded->planned_buffers.emplace_back(
+        static_cast<size_t>(meta->memory_planned_buffer_size(id).get()));
+  }
+  for (auto& buffer : loaded->planned_buffers) {
+    loaded->planned_spans.emplace_back(buffer.data(), buffer.size());
+  }
+  loaded->planned_memory = std::make_unique<HierarchicalAllocator>(
+      Span<Span<uint8_t>>(
+          loaded->planned_spans.data(), loaded->planned_spans.size()));
+  loaded->memory_manager = std::make_unique<MemoryManager>(
+      &loaded->method_allocator, loaded->planned_memory.get());
+
+  Result<Method> method =
+      loaded->program->load_method(method_name, loaded->memory_manager.get());
+  ET_CHECK_MSG(
+      method.ok(),
+      "Loading of method %s failed with status 0x%" PRIx32,
+      method_name,
+      (uint32_t)method.error());
+  loaded->method = std::make_unique<Method>(std::move(method.get()));
+  auto inputs = util::prepare_input_tensors(*loaded->method);
+  ET_CHECK_MSG(inputs.ok(), "Could not prepare inputs");
+  loaded->inputs =
+      std::make_unique<util::BufferCleanup>(std::move(inputs.get()));
+  return loaded;
+}
+
+double percentile(std::vector<double> values, double p) {
+  std::sort(values.begin(), values.end());
+  return values[std::min(values.size() - 1, size_t(p * values.size()))];
+}
+
+void measure(
+    const char* label,
+    Method* method,
+    Method* background,
+    int32_t priority) {
+  MethodScheduler scheduler;
+  std::atomic<bool> stop{false};
+  std::thread background_thread;
+  if (background != nullptr) {
+    background_thread = std::thread([&] {
+      while (!stop) {
+        Error err = scheduler.execute(background);
+        ET_CHECK_MSG(err == Error::Ok, "Background job failed");
+      }
+    });
+  }
+
+  std::vector<double> latencies;
+  auto next = std::chrono::steady_clock::now();
+  for (int32_t i = 0; i < FLAGS_num_requests; ++i) {
+    next += std::chrono::microseconds(FLAGS_interval_us);
+    std::this_thread::sleep_until(next);
+    JobOptions options;
+    options.priority = priority;
+    const auto start = std::chrono::steady_clock::now();
+    Error err = scheduler.execute(method, std::move(options));
+    ET_CHECK_MSG(err == Error::Ok, "Job failed");
+    latencies.push_back(std::chrono::duration<double, std::micro>(
+                            std::chrono::steady_clock::now() - start)
+                            .count());
+  }
+  stop = true;
+  if (background_thread.joinable()) {
+    background_thread.join();
+  }
+  ET_LOG(
+      Info,
+      "%s: latency p50 %.0fus p99 %.0fus max %.0fus, %zu preemptions",
+      label,
+      percentile(latencies, 0.5),
+      percentile(latencies, 0.99),
+      percentile(latencies, 1.0),
+      scheduler.num_preemptions());
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  runtime_init();
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+
+  auto latency_critical = load(FLAGS_model_path);
+  auto background = load(
+      FLAGS_background_model_path.empty() ? FLAGS_model_path
+                                          : FLAGS_background_model_path);
+
+  measure("alone", latency_critical->method.get(), nullptr, 0);
+  measure(
+      "with background, same priority",
+      latency_critical->method.get(),
+      background->method.get(),
+      0);
+  measure(
+      "with background, higher priority",
+      latency_critical->method.get(),
+      background->method.get(),
+      1);
+  return 0;
+}
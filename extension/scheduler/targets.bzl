@@ -0,0 +1,47 @@
+load("@fbsource//xplat/executorch/build:runtime_wrapper.bzl", "runtime")
+
+def define_common_targets():
+    """Defines targets that should be shared between fbcode and xplat.
+
+    The directory containing this targets.bzl file should also contain both
+    TARGETS and BUCK files that call this function.
+    """
+
+    runtime.cxx_library(
+        name = "method_scheduler",
+        srcs = [
+            "method_scheduler.cpp",
+        ],
+        exported_headers = [
+            "method_scheduler.h",
+        ],
+        visibility = [
+            "//executorch/...",
+            "@EXECUTORCH_CLIENTS",
+        ],
+        exported_deps = [
+            "//executorch/runtime/executor:program",
+        ],
+        deps = [
+            "//executorch/runtime/platform:platform",
+        ],
+    )
+
+    # Measures the tail latency of a high-priority model while a background
+    # model keeps the scheduler busy.
+    runtime.cxx_binary(
+        name = "scheduler_benchmark",
+        srcs = [
+            "scheduler_benchmark.cpp",
+        ],
+        deps = [
+            ":method_scheduler",
+            "//executorch/extension/data_loader:file_data_loader",
+            "//executorch/extension/memory_allocator:malloc_memory_allocator",
+            "//executorch/extension/runner_util:inputs",
+            "//executorch/kernels/portable:generated_lib",
+        ],
+        external_deps = [
+            "gflags",
+        ],
+    )
@@ -0,0 +1,231 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <executorch/extension/scheduler/method_scheduler.h>
+
+#include <cstdlib>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <executorch/extension/data_loader/file_data_loader.h>
+#include <executorch/extension/runner_util/inputs.h>
+#include <executorch/runtime/executor/program.h>
+#include <executorch/runtime/executor/test/managed_memory_manager.h>
+#include <executorch/runtime/platform/runtime.h>
+#include <gtest/gtest.h>
+
+using namespace ::testing;
+using torch::executor::Error;
+using torch::executor::EValue;
+using torch::executor::JobOptions;
+using torch::executor::Method;
+using torch::executor::MethodScheduler;
+using torch::executor::Program;
+using torch::executor::Result;
+using torch::executor::testing::ManagedMemoryManager;
+using torch::executor::util::BufferCleanup;
+using torch::executor::util::FileDataLoader;
+using torch::executor::util::prepare_input_tensors;
+
+class MethodSchedulerTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    torch::executor::runtime_init();
+
+    // ModuleAdd computes x + y * alpha.
+    Result<FileDataLoader> loader =
+        FileDataLoader::from(std::getenv("ET_MODULE_ADD_PATH"));
+    ASSERT_EQ(loader.error(), Error::Ok);
+    loader_ = std::make_unique<FileDataLoader>(std::move(loader.get()));
+    Result<Program> program = Program::load(loader_.get());
+    ASSERT_EQ(program.error(), Error::Ok);
+    program_ = std::make_unique<Program>(std::move(program.get()));
+  }
+
+  // Loads another instance of the method, with its inputs set to ones.
+  Method* load_method() {
+    mmms_.push_back(std::make_unique<ManagedMemoryManager>(
+        /*planned_memory_bytes=*/32 * 1024U,
+        /*method_allocator_bytes=*/32 * 1024U));
+    Result<Method> method =
+        program_->load_method("forward", &mmms_.back()->get());
+    EXPECT_EQ(method.error(), Error::Ok);
+    methods_.push_back(std::make_unique<Method>(std::move(method.get())));
+    Result<BufferCleanup> inputs = prepare_input_tensors(*methods_.back());
+    EXPECT_EQ(inputs.error(), Error::Ok);
+    inputs_.push_back(std::make_unique<BufferCleanup>(std::move(inputs.get())));
+    return methods_.back().get();
+  }
+
+  // Checks that the method computed 1 + 1.
+  void expect_output(Method* method) {
+    EValue output;
+    ASSERT_EQ(method->get_outputs(&output, 1), Error::Ok);
+    const auto& t = output.toTensor();
+    for (size_t i = 0; i < t.numel(); ++i) {
+      EXPECT_EQ(t.const_data_ptr<float>()[i], 2.0f);
+    }
+  }
+
+ private:
+  std::unique_ptr<FileDataLoader> loader_;
+  std::unique_ptr<Program> program_;
+  std::vector<std::unique_ptr<ManagedMemoryManager>> mmms_;
+  std::vector<std::unique_ptr<Method>> methods_;
+  std::vector<std::unique_ptr<BufferCleanup>> inputs_;
+};
+
+// Keeps the scheduler thread busy in an on_done callback until released.
+class Blocker {
+ public:
+  Blocker(MethodScheduler& scheduler, Method* method) {
+    JobOptions options;
+    options.on_done = [this](Error) {
+      started_.set_value();
+      release_.get_future().wait();
+    };
+    EXPECT_TRUE(scheduler.submit(method, std::move(options)).ok());
+    started_.get_future().wait();
+  }
+
+  void release() {
+    release_.set_value();
+  }
+
+ private:
+  std::promise<void> started_;
+  std::promise<void> release_;
+};
+
+TEST_F(MethodSchedulerTest, ExecutesJobs) {
+  MethodScheduler scheduler;
+  Method* method = load_method();
+  EXPECT_EQ(scheduler.execute(method), Error::Ok);
+  expect_output(method);
+  // The method can run again once its job is done.
+  EXPECT_EQ(scheduler.execute(method), Error::Ok);
+  expect_output(method);
+}
+
+TEST_F(MethodSchedulerTest, RejectsSecondJobForAMethod) {
+  MethodScheduler scheduler;
+  Method* method = load_method();
+  Blocker blocker(scheduler, load_method());
+  Result<MethodScheduler::JobId> job = scheduler.submit(method);
+  ASSERT_TRUE(job.ok());
+  EXPECT_EQ(scheduler.submit(method).error(), Error::InvalidState);
+  blocker.release();
+  EXPECT_EQ(scheduler.wait(job.get()), Error::Ok);
+  EXPECT_EQ(scheduler.wait(job.get()), Error::NotFound);
+}
+
+TEST_F(MethodSchedulerTest, HigherPriorityRunsFirst) {
+  MethodScheduler scheduler;
+  Method* low = load_method();
+  Method* high = load_method();
+  Blocker blocker(scheduler, load_method());
+
+  std::mutex mutex;
+  std::vector<int> order;
+  std::promise<void> both_done;
+  auto record = [&](int priority) {
+    return [&, priority](Error err) {
+      EXPECT_EQ(err, Error::Ok);
+      std::lock_guard<std::mutex> guard(mutex);
+      order.push_back(priority);
+      if (order.size() == 2) {
+        both_done.set_value();
+      }
+    };
+  };
+  JobOptions low_options;
+  low_options.priority = 0;
+  low_options.on_done = record(0);
+  JobOptions high_options;
+  high_options.priority = 1;
+  high_options.on_done = record(1);
+  ASSERT_TRUE(scheduler.submit(low, std::move(low_options)).ok());
+  ASSERT_TRUE(scheduler.submit(high, std::move(high_options)).ok());
+
+  blocker.release();
+  both_done.get_future().wait();
+  EXPECT_EQ(order, (std::vector<int>{1, 0}));
+  expect_output(low);
+  expect_output(high);
+}
+
+TEST_F(MethodSchedulerTest, CancelledJobCanBeResubmitted) {
+  MethodScheduler scheduler;
+  Method* method = load_method();
+  Blocker blocker(scheduler, load_method());
+  Result<MethodScheduler::JobId> job = scheduler.submit(method);
+  ASSERT_TRUE(job.ok());
+  EXPECT_EQ(scheduler.cancel(job.get()), Error::Ok);
+  blocker.release();
+  EXPECT_EQ(scheduler.wait(job.get()), Error::Cancelled);
+
+  // The job never started, so the inputs are still there.
+  EXPECT_EQ(scheduler.execute(method), Error::Ok);
+  expect_output(method);
+}
+
+TEST_F(MethodSchedulerTest, ExpiredJobIsCancelled) {
+  MethodScheduler scheduler;
+  Method* method = load_method();
+  Blocker blocker(scheduler, load_method());
+  JobOptions options;
+  options.deadline = std::chrono::steady_clock::now();
+  options.cancel_at_deadline = true;
+  Result<MethodScheduler::JobId> job =
+      scheduler.submit(method, std::move(options));
+  ASSERT_TRUE(job.ok());
+  blocker.release();
+  EXPECT_EQ(scheduler.wait(job.get()), Error::Cancelled);
+}
+
+TEST_F(MethodSchedulerTest, CancelsRunningDetachedJob) {
+  MethodScheduler scheduler;
+  Method* method = load_method();
+  Blocker blocker(scheduler, load_method());
+
+  std::promise<Error> result;
+  JobOptions options;
+  options.on_done = [&](Error err) { result.set_value(err); };
+  Result<MethodScheduler::JobId> job =
+      scheduler.submit(method, std::move(options));
+  ASSERT_TRUE(job.ok());
+
+  // Cancelled before it starts, so that its on_done callback holds the
+  // scheduler thread right after it picked the job above.
+  std::promise<void> picked;
+  std::promise<void> release;
+  JobOptions hold_options;
+  hold_options.on_done = [&](Error) {
+    picked.set_value();
+    release.get_future().wait();
+  };
+  Result<MethodScheduler::JobId> hold =
+      scheduler.submit(load_method(), std::move(hold_options));
+  ASSERT_TRUE(hold.ok());
+  ASSERT_EQ(scheduler.cancel(hold.get()), Error::Ok);
+  blocker.release();
+  picked.get_future().wait();
+
+  EXPECT_EQ(scheduler.cancel(job.get()), Error::Ok);
+  release.set_value();
+  // Later picks forget the cancelled job, which must not be used after that.
+  Method* other = load_method();
+  EXPECT_EQ(scheduler.execute(other), Error::Ok);
+  expect_output(other);
+  EXPECT_EQ(scheduler.execute(other), Error::Ok);
+  EXPECT_EQ(result.get_future().get(), Error::Cancelled);
+  // Cancelling the current job is not a preemption.
+  EXPECT_EQ(scheduler.num_preemptions(), 0);
+}
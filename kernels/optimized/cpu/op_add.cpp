@@ -97,6 +97,85 @@ Tensor& opt_add_out(
   return out;
 }
 
+namespace {
+
+// Body of the dtype-specialized add.out kernels. These are only bound when
+// `a`, `b` and `out` all have dtype CTYPE and the same rank (see
+// `dtype_specializations` in optimized.yaml), so the dtype switch of
+// opt_add_out() is not needed. Broadcasting still goes to opt_add_out().
+template <typename CTYPE>
+Tensor& opt_add_out_specialized(
+    RuntimeContext& ctx,
+    const Tensor& a,
+    const Tensor& b,
+    const Scalar& alpha,
+    Tensor& out) {
+  if (!a.sizes().equals(b.sizes())) {
+    return opt_add_out(ctx, a, b, alpha, out);
+  }
+
+  // Resize for dynamic shape
+  auto error = resize_tensor(out, a.sizes());
+  ET_KERNEL_CHECK_MSG(
+      ctx,
+      error == Error::Ok,
+      InvalidArgument,
+      out,
+      "Failed to resize output tensor.");
+
+  CTYPE alpha_val;
+  ET_KERNEL_CHECK(
+      ctx, utils::extract_scalar(alpha, &alpha_val), InvalidArgument, out);
+
+  using Vec = executorch::vec::Vectorized<CTYPE>;
+  executorch::vec::map2<CTYPE>(
+      [alpha_val](Vec x, Vec y) { return x + Vec(alpha_val) * y; },
+      out.mutable_data_ptr<CTYPE>(),
+      a.const_data_ptr<CTYPE>(),
+      b.const_data_ptr<CTYPE>(),
+      out.numel());
+
+  return out;
+}
+
+} // namespace
+
+Tensor& opt_add_out_float(
+    RuntimeContext& ctx,
+    const Tensor& a,
+    const Tensor& b,
+    const Scalar& alpha,
+    Tensor& out) {
+  return opt_add_out_specialized<float>(ctx, a, b, alpha, out);
+}
+
+Tensor& opt_add_out_double(
+    RuntimeContext& ctx,
+    const Tensor& a,
+    const Tensor& b,
+    const Scalar& alpha,
+    Tensor& out) {
+  return opt_add_out_specialized<double>(ctx, a, b, alpha, out);
+}
+
+Tensor& opt_add_out_int(
+    RuntimeContext& ctx,
+    const Tensor& a,
+    const Tensor& b,
+    const Scalar& alpha,
+    Tensor& out) {
+  return opt_add_out_specialized<int32_t>(ctx, a, b, alpha, out);
+}
+
+Tensor& opt_add_out_long(
+    RuntimeContext& ctx,
+    const Tensor& a,
+    const Tensor& b,
+    const Scalar& alpha,
+    Tensor& out) {
+  return opt_add_out_specialized<int64_t>(ctx, a, b, alpha, out);
+}
+
 Tensor& opt_add_scalar_out(
     RuntimeContext& ctx,
     const Tensor& a,
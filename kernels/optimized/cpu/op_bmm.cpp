@@ -148,7 +148,7 @@ Tensor& opt_bmm_out(
       resize_out_tensor(self, mat2, out) == Error::Ok,
       InvalidArgument,
       out);
-  ET_KERNEL_CHECK(
+  ET_KERNEL_CHECK_ARGS(
       context, check_bmm_out_args(self, mat2, out), InvalidArgument, out);
 
 #define BMM_TENSOR(ctype, dtype)        \
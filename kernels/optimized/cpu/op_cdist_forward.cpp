@@ -0,0 +1,438 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <algorithm>
+#include <cmath>
+
+#include <executorch/kernels/optimized/blas/CPUBlas.h>
+#include <executorch/kernels/optimized/cpu/parallel_utils.h>
+#include <executorch/kernels/optimized/vec/functional.h>
+#include <executorch/kernels/optimized/vec/vec.h>
+#include <executorch/kernels/portable/cpu/util/broadcast_util.h>
+#include <executorch/kernels/portable/cpu/util/distance_util.h>
+#include <executorch/runtime/kernel/kernel_includes.h>
+
+// Distances between the rows of x1 [..., P, M] and the rows of x2 [..., R, M].
+//
+// For p = 2, like ATen, the squared distances are expanded as
+// ||x||^2 + ||y||^2 - 2 x.y, so that the bulk of the work is the matrix
+// product x1 x2^T done by cpublas::gemm. The norms are then added, the result
+// clamped at 0 to absorb rounding, and square rooted, a vector at a time.
+// This is much faster for large point sets, but less accurate when points are
+// close, so compute_mode picks it the way ATen does: always for
+// use_mm_for_euclid_dist (1), never for donot_use_mm_for_euclid_dist (2),
+// and when P or R is larger than 25 for the default mode (0).
+//
+// Other norms, and p = 2 when the matrix product is not used, compute each
+// distance directly: kRowBlock rows of x1 are compared against each row of x2
+// at once, a vector of features at a time, over tiles of kColumnTile rows of
+// x2 that stay in cache.
+//
+// Both paths split the rows of the output across threads when the threadpool
+// is available.
+namespace torch {
+namespace executor {
+namespace native {
+
+using exec_aten::optional;
+using exec_aten::Tensor;
+using executorch::vec::Vectorized;
+
+namespace {
+
+// Values of ATen's compute_mode.
+constexpr int64_t kUseMmIfNecessary = 0;
+constexpr int64_t kUseMm = 1;
+// ATen's kUseMmIfNecessary uses the matrix product when P or R is larger.
+constexpr int64_t kMmThreshold = 25;
+
+// Rows of x1 that share each load of a row of x2 in the direct kernel.
+constexpr int64_t kRowBlock = 4;
+// Rows of x2 processed together: in cache for the direct kernel, and whose
+// squared norms are kept on the stack for the matrix product.
+constexpr int64_t kColumnTile = 256;
+// Minimum number of multiply-adds per task.
+constexpr int64_t kMinTaskWork = 32768;
+
+// The norms of distance_util.h, plus their vectorized map and reduce.
+template <typename CTYPE>
+struct VecL0 : L0<CTYPE> {
+  using L0<CTYPE>::map;
+  using L0<CTYPE>::reduce;
+  static Vectorized<CTYPE> map(
+      const Vectorized<CTYPE>& diff,
+      const Vectorized<CTYPE>&) {
+    return diff.ne(Vectorized<CTYPE>(0));
+  }
+  static Vectorized<CTYPE> reduce(
+      const Vectorized<CTYPE>& agg,
+      const Vectorized<CTYPE>& up) {
+    return agg + up;
+  }
+};
+
+template <typename CTYPE>
+struct VecL1 : L1<CTYPE> {
+  using L1<CTYPE>::map;
+  using L1<CTYPE>::reduce;
+  static Vectorized<CTYPE> map(
+      const Vectorized<CTYPE>& diff,
+      const Vectorized<CTYPE>&) {
+    return diff;
+  }
+  static Vectorized<CTYPE> reduce(
+      const Vectorized<CTYPE>& agg,
+      const Vectorized<CTYPE>& up) {
+    return agg + up;
+  }
+};
+
+template <typename CTYPE>
+struct VecL2 : L2<CTYPE> {
+  using L2<CTYPE>::map;
+  using L2<CTYPE>::reduce;
+  static Vectorized<CTYPE> map(
+      const Vectorized<CTYPE>& diff,
+      const Vectorized<CTYPE>&) {
+    return diff * diff;
+  }
+  static Vectorized<CTYPE> reduce(
+      const Vectorized<CTYPE>& agg,
+      const Vectorized<CTYPE>& up) {
+    return agg + up;
+  }
+};
+
+template <typename CTYPE>
+struct VecLp : Lp<CTYPE> {
+  using Lp<CTYPE>::map;
+  using Lp<CTYPE>::reduce;
+  static Vectorized<CTYPE> map(
+      const Vectorized<CTYPE>& diff,
+      const Vectorized<CTYPE>& p) {
+    return diff.pow(p);
+  }
+  static Vectorized<CTYPE> reduce(
+      const Vectorized<CTYPE>& agg,
+      const Vectorized<CTYPE>& up) {
+    return agg + up;
+  }
+};
+
+template <typename CTYPE>
+struct VecLinf : Linf<CTYPE> {
+  using Linf<CTYPE>::map;
+  using Linf<CTYPE>::reduce;
+  static Vectorized<CTYPE> map(
+      const Vectorized<CTYPE>& diff,
+      const Vectorized<CTYPE>&) {
+    return diff;
+  }
+  static Vectorized<CTYPE> reduce(
+      const Vectorized<CTYPE>& agg,
+      const Vectorized<CTYPE>& up) {
+    return executorch::vec::maximum(agg, up);
+  }
+};
+
+// Computes the distances between the kRows rows of x1 at x1_rows and the
+// rows [j_begin, j_end) of x2, into the kRows rows of out at out_rows.
+template <typename CTYPE, typename Norm, int64_t kRows>
+void cdist_direct_block(
+    const CTYPE* x1_rows,
+    const CTYPE* x2,
+    CTYPE* out_rows,
+    int64_t j_begin,
+    int64_t j_end,
+    int64_t R,
+    int64_t M,
+    CTYPE p) {
+  using Vec = Vectorized<CTYPE>;
+  const Vec p_vec(p);
+  const auto reduce_vec = [](const Vec& a, const Vec& b) {
+    return Norm::reduce(a, b);
+  };
+
+  for (int64_t j = j_begin; j < j_end; ++j) {
+    const CTYPE* const x2_row = x2 + j * M;
+    Vec acc[kRows];
+    for (int64_t r = 0; r < kRows; ++r) {
+      acc[r] = Vec(0);
+    }
+    int64_t k = 0;
+    for (; k + Vec::size() <= M; k += Vec::size()) {
+      const Vec x2_vec = Vec::loadu(x2_row + k);
+      for (int64_t r = 0; r < kRows; ++r) {
+        const Vec diff = (Vec::loadu(x1_rows + r * M + k) - x2_vec).abs();
+        acc[r] = Norm::reduce(acc[r], Norm::map(diff, p_vec));
+      }
+    }
+    for (int64_t r = 0; r < kRows; ++r) {
+      CTYPE agg = executorch::vec::vec_reduce_all<CTYPE>(reduce_vec, acc[r]);
+      for (int64_t kk = k; kk < M; ++kk) {
+        const CTYPE diff = std::abs(x1_rows[r * M + kk] - x2_row[kk]);
+        agg = Norm::reduce(agg, Norm::map(diff, p));
+      }
+      out_rows[r * R + j] = Norm::finish(agg, p);
+    }
+  }
+}
+
+// Computes the rows [i_begin, i_end) of the P x R distances between x1 and
+// x2, directly.
+template <typename CTYPE, typename Norm>
+void cdist_direct(
+    const CTYPE* x1,
+    const CTYPE* x2,
+    CTYPE* out,
+    int64_t i_begin,
+    int64_t i_end,
+    int64_t R,
+    int64_t M,
+    CTYPE p) {
+  for (int64_t j0 = 0; j0 < R; j0 += kColumnTile) {
+    const int64_t j1 = std::min(R, j0 + kColumnTile);
+    int64_t i = i_begin;
+    for (; i + kRowBlock <= i_end; i += kRowBlock) {
+      cdist_direct_block<CTYPE, Norm, kRowBlock>(
+          x1 + i * M, x2, out + i * R, j0, j1, R, M, p);
+    }
+    for (; i < i_end; ++i) {
+      cdist_direct_block<CTYPE, Norm, 1>(
+          x1 + i * M, x2, out + i * R, j0, j1, R, M, p);
+    }
+  }
+}
+
+template <typename CTYPE>
+CTYPE squared_norm(const CTYPE* x, int64_t size) {
+  using Vec = Vectorized<CTYPE>;
+  return executorch::vec::map_reduce_all<CTYPE>(
+      [](const Vec& v) { return v * v; },
+      [](const Vec& a, const Vec& b) { return a + b; },
+      x,
+      size);
+}
+
+// Computes the rows [i_begin, i_end) of the P x R Euclidean distances between
+// x1 and x2 with a matrix product.
+template <typename CTYPE>
+void cdist_mm(
+    const CTYPE* x1,
+    const CTYPE* x2,
+    CTYPE* out,
+    int64_t i_begin,
+    int64_t i_end,
+    int64_t R,
+    int64_t M) {
+  using executorch::cpublas::TransposeType;
+  using Vec = Vectorized<CTYPE>;
+
+  // out = -2 x1 x2^T. cpublas is column major, where out is R x P and
+  // x1 and x2 are M x P and M x R: compute out = -2 x2^T x1.
+  // clang-format off
+  executorch::cpublas::gemm(
+      TransposeType::Transpose, TransposeType::NoTranspose,
+      R, i_end - i_begin, M,
+      static_cast<CTYPE>(-2),
+      x2, M,
+      x1 + i_begin * M, M,
+      static_cast<CTYPE>(0),
+      out + i_begin * R, R);
+  // clang-format on
+
+  CTYPE x2_norms[kColumnTile];
+  const Vec zero(0);
+  for (int64_t j0 = 0; j0 < R; j0 += kColumnTile) {
+    const int64_t len = std::min(kColumnTile, R - j0);
+    for (int64_t j = 0; j < len; ++j) {
+      x2_norms[j] = squared_norm(x2 + (j0 + j) * M, M);
+    }
+    for (int64_t i = i_begin; i < i_end; ++i) {
+      // Recomputed for each tile, which costs 1 / (2 * kColumnTile) of the
+      // matrix product, to not need a buffer of P norms.
+      const CTYPE x1_norm = squared_norm(x1 + i * M, M);
+      const Vec x1_norm_vec(x1_norm);
+      CTYPE* const out_row = out + i * R + j0;
+      int64_t j = 0;
+      for (; j + Vec::size() <= len; j += Vec::size()) {
+        const Vec sum = Vec::loadu(out_row + j) + x1_norm_vec +
+            Vec::loadu(x2_norms + j);
+        executorch::vec::clamp_min(sum, zero).sqrt().store(out_row + j);
+      }
+      for (; j < len; ++j) {
+        const CTYPE sum = out_row[j] + x1_norm + x2_norms[j];
+        out_row[j] = std::sqrt(std::max(sum, static_cast<CTYPE>(0)));
+      }
+    }
+  }
+}
+
+inline ArrayRef<Tensor::SizesType> get_batch_sizes(const Tensor& tensor) {
+  return {tensor.sizes().data(), tensor.sizes().size() - 2};
+}
+
+template <typename CTYPE, typename Norm>
+void cdist(
+    const Tensor& x1,
+    const Tensor& x2,
+    Tensor& out,
+    double p,
+    bool use_mm) {
+  if (out.numel() == 0) {
+    return;
+  }
+
+  CTYPE* const out_data = out.mutable_data_ptr<CTYPE>();
+
+  // If the last dimension of x1 (which is equal to the last dimension of x2)
+  // has size 0, then the output is filled with 0s.
+  if (x1.numel() == 0 || x2.numel() == 0) {
+    std::fill(out_data, out_data + out.numel(), static_cast<CTYPE>(0));
+    return;
+  }
+
+  const CTYPE* const x1_data = x1.const_data_ptr<CTYPE>();
+  const CTYPE* const x2_data = x2.const_data_ptr<CTYPE>();
+
+  const ArrayRef<Tensor::SizesType> out_batch_sizes = get_batch_sizes(out);
+  const bool x1_is_broadcasted = !out_batch_sizes.equals(get_batch_sizes(x1));
+  const bool x2_is_broadcasted = !out_batch_sizes.equals(get_batch_sizes(x2));
+
+  const int64_t P = x1.size(x1.dim() - 2);
+  const int64_t R = x2.size(x2.dim() - 2);
+  const int64_t M = x1.size(x1.dim() - 1);
+  const int64_t num_rows = out.numel() / R;
+
+  run_parallel(num_rows, R * M, kMinTaskWork, [&](int64_t begin, int64_t end) {
+    // Rows of a task may span several batches: process them a batch at a time.
+    for (int64_t row = begin; row < end;) {
+      const int64_t b = row / P;
+      const int64_t i_begin = row % P;
+      const int64_t i_end = std::min(P, i_begin + (end - row));
+
+      size_t x1_base_ix = b * P * M;
+      size_t x2_base_ix = b * R * M;
+      const size_t out_base_ix = b * P * R;
+      if (x1_is_broadcasted || x2_is_broadcasted) {
+        size_t out_base_coord[kTensorDimensionLimit];
+        delinearize_index(
+            out_base_ix, out, out_base_coord, kTensorDimensionLimit);
+        if (x1_is_broadcasted) {
+          x1_base_ix = linearize_access_indexes(out_base_coord, out.dim(), x1);
+        }
+        if (x2_is_broadcasted) {
+          x2_base_ix = linearize_access_indexes(out_base_coord, out.dim(), x2);
+        }
+      }
+
+      if (use_mm) {
+        cdist_mm<CTYPE>(
+            x1_data + x1_base_ix,
+            x2_data + x2_base_ix,
+            out_data + out_base_ix,
+            i_begin,
+            i_end,
+            R,
+            M);
+      } else {
+        cdist_direct<CTYPE, Norm>(
+            x1_data + x1_base_ix,
+            x2_data + x2_base_ix,
+            out_data + out_base_ix,
+            i_begin,
+            i_end,
+            R,
+            M,
+            static_cast<CTYPE>(p));
+      }
+      row += i_end - i_begin;
+    }
+  });
+}
+
+template <typename CTYPE>
+void cdist(
+    const Tensor& x1,
+    const Tensor& x2,
+    Tensor& out,
+    double p,
+    optional<int64_t> compute_mode) {
+  if (p == 0.0) {
+    cdist<CTYPE, VecL0<CTYPE>>(x1, x2, out, p, false);
+  } else if (p == 1.0) {
+    cdist<CTYPE, VecL1<CTYPE>>(x1, x2, out, p, false);
+  } else if (p == 2.0) {
+    const int64_t mode = compute_mode.has_value() ? compute_mode.value()
+                                                  : kUseMmIfNecessary;
+    const bool use_mm = mode == kUseMm ||
+        (mode == kUseMmIfNecessary &&
+         (x1.size(x1.dim() - 2) > kMmThreshold ||
+          x2.size(x2.dim() - 2) > kMmThreshold));
+    cdist<CTYPE, VecL2<CTYPE>>(x1, x2, out, p, use_mm);
+  } else if (p == INFINITY) {
+    cdist<CTYPE, VecLinf<CTYPE>>(x1, x2, out, p, false);
+  } else {
+    cdist<CTYPE, VecLp<CTYPE>>(x1, x2, out, p, false);
+  }
+}
+
+} // namespace
+
+Tensor& opt_cdist_forward_out(
+    RuntimeContext& ctx,
+    const Tensor& x1,
+    const Tensor& x2,
+    double p,
+    optional<int64_t> compute_mode,
+    Tensor& out) {
+  (void)ctx;
+
+  ET_KERNEL_CHECK_ARGS(
+      ctx,
+      check_cdist_args(x1, x2, p, compute_mode, out),
+      InvalidArgument,
+      out);
+
+  Tensor::SizesType target_sizes[kTensorDimensionLimit];
+  size_t target_ndim = 0;
+
+  ET_KERNEL_CHECK(
+      ctx,
+      get_broadcast_target_size(
+          {x1.sizes().data(), x1.sizes().size() - 2},
+          {x2.sizes().data(), x2.sizes().size() - 2},
+          target_sizes,
+          kTensorDimensionLimit,
+          &target_ndim) == Error::Ok,
+      InvalidArgument,
+      out);
+
+  target_ndim += 2;
+  target_sizes[target_ndim - 2] = x1.size(x1.dim() - 2);
+  target_sizes[target_ndim - 1] = x2.size(x2.dim() - 2);
+
+  ET_KERNEL_CHECK(
+      ctx,
+      resize_tensor(out, {target_sizes, target_ndim}) == Error::Ok,
+      InvalidArgument,
+      out);
+
+  ScalarType out_type = out.scalar_type();
+  constexpr auto name = "_cdist_forward.out";
+
+  ET_SWITCH_FLOAT_TYPES(out_type, ctx, name, CTYPE, [&] {
+    cdist<CTYPE>(x1, x2, out, p, compute_mode);
+  });
+
+  return out;
+}
+
+} // namespace native
+} // namespace executor
+} // namespace torch
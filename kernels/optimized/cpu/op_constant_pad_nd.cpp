@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <algorithm>
+#include <cstring>
+
+#include <executorch/kernels/optimized/cpu/padding_utils.h>
+#include <executorch/kernels/portable/cpu/scalar_utils.h>
+#include <executorch/kernels/portable/cpu/util/kernel_ops_util.h>
+#include <executorch/runtime/kernel/kernel_includes.h>
+
+// Pads a tensor with a constant value.
+//
+// The dimensions after the last padded one are merged into the elements of a
+// row along that dimension, so the output is a set of rows, indexed by the
+// leading dimensions, of the form [value * before, input row, value * after],
+// where negative padding crops the input row instead.
+// Rows that fall in the padding of a leading dimension are filled with value
+// entirely. The input row is copied with a single memcpy and the padding is
+// set with vec_fill(). The rows are split across threads when the threadpool
+// is available.
+namespace torch {
+namespace executor {
+namespace native {
+
+namespace {
+
+template <typename CTYPE>
+void constant_pad_nd_out_impl(
+    const Tensor& self,
+    IntArrayRef pad,
+    CTYPE value,
+    Tensor& out) {
+  const CTYPE* const self_data = self.const_data_ptr<CTYPE>();
+  CTYPE* const out_data = out.mutable_data_ptr<CTYPE>();
+
+  const int64_t ndim = self.dim();
+
+  if (ndim == 0) {
+    out_data[0] = self_data[0];
+    return;
+  }
+
+  // Padding before each dimension, and the last padded (or cropped)
+  // dimension.
+  int64_t pad_before[kTensorDimensionLimit];
+  int64_t last_padded_dim = 0;
+  for (int64_t i = 0; i < ndim; ++i) {
+    const int64_t pad_i = ndim - 1 - i;
+    pad_before[i] = 0;
+    if (pad_i < static_cast<int64_t>(pad.size() / 2)) {
+      pad_before[i] = pad[2 * pad_i];
+      if (pad[2 * pad_i] != 0 || pad[2 * pad_i + 1] != 0) {
+        last_padded_dim = i;
+      }
+    }
+  }
+
+  // Each row is one index of the dimensions before last_padded_dim.
+  const int64_t dim = last_padded_dim;
+  const int64_t inner = getTrailingDims(self, dim);
+  const int64_t in_row_size = self.size(dim) * inner;
+  const int64_t out_row_size = out.size(dim) * inner;
+  const int64_t num_rows = getLeadingDims(out, dim);
+  // Range of each output row copied from the input row. The padding can be
+  // negative, which crops the input instead.
+  const int64_t before = pad_before[dim] * inner;
+  const int64_t copy_begin =
+      std::min(std::max<int64_t>(0, before), out_row_size);
+  const int64_t copy_end =
+      std::max(copy_begin, std::min(out_row_size, before + in_row_size));
+
+  run_parallel(
+      num_rows,
+      out_row_size,
+      kPaddingMinTaskWork,
+      [&](int64_t begin, int64_t end) {
+        // Index of the first row along each leading dimension.
+        int64_t index[kTensorDimensionLimit];
+        int64_t remainder = begin;
+        for (int64_t d = dim - 1; d >= 0; --d) {
+          index[d] = remainder % out.size(d);
+          remainder /= out.size(d);
+        }
+
+        for (int64_t row = begin; row < end; ++row) {
+          CTYPE* const out_row = out_data + row * out_row_size;
+
+          // Find the input row, unless the output row is padding.
+          bool is_padding = false;
+          int64_t in_row = 0;
+          for (int64_t d = 0; d < dim; ++d) {
+            const int64_t in_index = index[d] - pad_before[d];
+            if (in_index < 0 || in_index >= self.size(d)) {
+              is_padding = true;
+              break;
+            }
+            in_row = in_row * self.size(d) + in_index;
+          }
+
+          if (is_padding) {
+            vec_fill(out_row, out_row_size, value);
+          } else {
+            vec_fill(out_row, copy_begin, value);
+            std::memcpy(
+                out_row + copy_begin,
+                self_data + in_row * in_row_size + copy_begin - before,
+                (copy_end - copy_begin) * sizeof(CTYPE));
+            vec_fill(out_row + copy_end, out_row_size - copy_end, value);
+          }
+
+          for (int64_t d = dim - 1; d >= 0; --d) {
+            if (++index[d] < out.size(d)) {
+              break;
+            }
+            index[d] = 0;
+          }
+        }
+      });
+}
+
+} // namespace
+
+Tensor& opt_constant_pad_nd_out(
+    RuntimeContext& ctx,
+    const Tensor& in,
+    IntArrayRef pad,
+    const Scalar& value,
+    Tensor& out) {
+  (void)ctx;
+
+  ET_KERNEL_CHECK_ARGS(
+      ctx, check_constant_pad_args(in, pad, value, out), InvalidArgument, out);
+
+  // resize out tensor for dynamic shapes
+  ET_KERNEL_CHECK_MSG(
+      ctx,
+      resize_constant_pad_output(in, pad, out) == Error::Ok,
+      InvalidArgument,
+      out,
+      "Failed to resize output tensor.");
+
+  ScalarType in_type = in.scalar_type();
+  ScalarType value_type = utils::get_scalar_dtype(value);
+
+  ET_SWITCH_REAL_TYPES_AND(
+      Bool, in_type, ctx, "constant_pad_nd.out", CTYPE, [&]() {
+        CTYPE value_v;
+        ET_SWITCH_SCALAR_OBJ_TYPES(
+            value_type, ctx, "constant_pad_nd.out", CTYPE_VALUE, [&]() {
+              CTYPE_VALUE val;
+              utils::extract_scalar(value, &val);
+              value_v = static_cast<CTYPE>(val);
+            });
+        constant_pad_nd_out_impl<CTYPE>(in, pad, value_v, out);
+      });
+
+  return out;
+}
+
+} // namespace native
+} // namespace executor
+} // namespace torch
@@ -0,0 +1,234 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <executorch/kernels/optimized/cpu/tunable_param.h>
+#include <executorch/kernels/optimized/vec/vec.h>
+#include <executorch/runtime/kernel/kernel_includes.h>
+
+#include <algorithm>
+#include <cinttypes>
+
+// Linear layer whose weight was packed ahead of time by
+// exir/passes/prepack_weights_pass.py.
+//
+// packed_weight has shape [ceil(N / kPanelWidth), K, kPanelWidth], where N is
+// out_features and K is in_features: each panel stores, for every input
+// feature k, the weights of kPanelWidth consecutive output features next to
+// each other (zero padded in the last panel). The kernel below walks a panel
+// linearly, keeping a block of ROW_BLOCK x kPanelWidth accumulators in vector
+// registers: each panel row is loaded as whole vectors and multiply-added with
+// each input row's value broadcast. The weight is read exactly once per block
+// of input rows and never needs to be transposed or repacked at runtime.
+// ROW_BLOCK is a TunableParam, see tunable_param.h.
+namespace torch {
+namespace executor {
+namespace native {
+
+using Tensor = exec_aten::Tensor;
+
+namespace {
+
+using Vec = executorch::vec::Vectorized<float>;
+
+// Must match PANEL_WIDTH in exir/passes/prepack_weights_pass.py.
+constexpr int64_t kPanelWidth = 8;
+constexpr int64_t kVecsPerPanel = kPanelWidth / Vec::size();
+static_assert(kPanelWidth % Vec::size() == 0, "Panels must fill whole vectors");
+// Default number of input rows sharing each load of a panel row.
+constexpr int64_t kDefaultRowBlock = 4;
+
+bool check_linear_packed_args(
+    const Tensor& in,
+    const Tensor& packed_weight,
+    const exec_aten::optional<Tensor>& bias,
+    int64_t out_features,
+    Tensor& out) {
+  ET_LOG_AND_RETURN_IF_FALSE(tensor_is_rank(packed_weight, 3));
+  ET_LOG_MSG_AND_RETURN_IF_FALSE(
+      packed_weight.size(2) == kPanelWidth,
+      "packed_weight.size(2) %zd != panel width %" PRId64,
+      packed_weight.size(2),
+      kPanelWidth);
+  ET_LOG_MSG_AND_RETURN_IF_FALSE(
+      out_features > 0 &&
+          packed_weight.size(0) ==
+              (out_features + kPanelWidth - 1) / kPanelWidth,
+      "packed_weight.size(0) %zd does not hold out_features %" PRId64,
+      packed_weight.size(0),
+      out_features);
+  ET_LOG_AND_RETURN_IF_FALSE(in.dim() >= 1);
+  ET_LOG_AND_RETURN_IF_FALSE(
+      tensors_have_same_size_at_dims(in, in.dim() - 1, packed_weight, 1));
+  ET_LOG_AND_RETURN_IF_FALSE(tensors_have_same_dtype(in, packed_weight, out));
+  ET_LOG_MSG_AND_RETURN_IF_FALSE(
+      in.scalar_type() == ScalarType::Float, "input dtype must be Float");
+  if (bias.has_value()) {
+    ET_LOG_AND_RETURN_IF_FALSE(tensor_is_rank(bias.value(), 1));
+    ET_LOG_AND_RETURN_IF_FALSE(bias.value().size(0) == out_features);
+    ET_LOG_AND_RETURN_IF_FALSE(tensors_have_same_dtype(in, bias.value()));
+  }
+  return true;
+}
+
+// Computes ROWS rows of out for the output features of one panel. n_valid is
+// the number of real (non padding) features in the panel.
+template <int64_t ROWS>
+inline void linear_packed_block(
+    const float* in,
+    const float* panel,
+    const float* bias,
+    float* out,
+    int64_t k_size,
+    int64_t n_size,
+    int64_t n_valid) {
+  Vec acc[ROWS][kVecsPerPanel];
+  for (int64_t r = 0; r < ROWS; ++r) {
+    for (int64_t v = 0; v < kVecsPerPanel; ++v) {
+      acc[r][v] = Vec(0.0f);
+    }
+  }
+  for (int64_t k = 0; k < k_size; ++k) {
+    Vec w[kVecsPerPanel];
+    for (int64_t v = 0; v < kVecsPerPanel; ++v) {
+      w[v] = Vec::loadu(panel + k * kPanelWidth + v * Vec::size());
+    }
+    for (int64_t r = 0; r < ROWS; ++r) {
+      const Vec a(in[r * k_size + k]);
+      for (int64_t v = 0; v < kVecsPerPanel; ++v) {
+        acc[r][v] = executorch::vec::fmadd(a, w[v], acc[r][v]);
+      }
+    }
+  }
+  for (int64_t r = 0; r < ROWS; ++r) {
+    float sums[kPanelWidth];
+    for (int64_t v = 0; v < kVecsPerPanel; ++v) {
+      acc[r][v].store(sums + v * Vec::size());
+    }
+    for (int64_t j = 0; j < n_valid; ++j) {
+      out[r * n_size + j] = sums[j] + (bias != nullptr ? bias[j] : 0.0f);
+    }
+  }
+}
+
+template <int64_t ROW_BLOCK>
+void linear_packed_kernel(
+    const float* in,
+    const float* packed_weight,
+    const float* bias,
+    float* out,
+    int64_t m_size,
+    int64_t k_size,
+    int64_t n_size) {
+  const int64_t num_panels = (n_size + kPanelWidth - 1) / kPanelWidth;
+  for (int64_t p = 0; p < num_panels; ++p) {
+    const float* panel = packed_weight + p * k_size * kPanelWidth;
+    const int64_t n_start = p * kPanelWidth;
+    const int64_t n_valid = std::min(kPanelWidth, n_size - n_start);
+    const float* panel_bias = bias != nullptr ? bias + n_start : nullptr;
+
+    int64_t m = 0;
+    for (; m + ROW_BLOCK <= m_size; m += ROW_BLOCK) {
+      linear_packed_block<ROW_BLOCK>(
+          in + m * k_size,
+          panel,
+          panel_bias,
+          out + m * n_size + n_start,
+          k_size,
+          n_size,
+          n_valid);
+    }
+    for (; m < m_size; ++m) {
+      linear_packed_block<1>(
+          in + m * k_size,
+          panel,
+          panel_bias,
+          out + m * n_size + n_start,
+          k_size,
+          n_size,
+          n_valid);
+    }
+  }
+}
+
+} // namespace
+
+Tensor& opt_prepacked_linear_out(
+    RuntimeContext& ctx,
+    const Tensor& in,
+    const Tensor& packed_weight,
+    const exec_aten::optional<Tensor>& bias,
+    int64_t out_features,
+    Tensor& out) {
+  ET_KERNEL_CHECK_ARGS(
+      ctx,
+      check_linear_packed_args(in, packed_weight, bias, out_features, out),
+      InvalidArgument,
+      out);
+
+  exec_aten::SizesType out_sizes[kTensorDimensionLimit];
+  for (size_t i = 0; i < in.dim() - 1; ++i) {
+    out_sizes[i] = in.size(i);
+  }
+  out_sizes[in.dim() - 1] = static_cast<exec_aten::SizesType>(out_features);
+  ET_KERNEL_CHECK(
+      ctx,
+      resize_tensor(out, {out_sizes, static_cast<size_t>(in.dim())}) ==
+          Error::Ok,
+      InvalidArgument,
+      out);
+
+  const int64_t k_size = packed_weight.size(1);
+  const int64_t m_size = k_size == 0 ? 0 : in.numel() / k_size;
+  if (k_size == 0) {
+    // Empty reduction: the output is just the bias.
+    float* out_data = out.mutable_data_ptr<float>();
+    for (int64_t i = 0; i < out.numel(); ++i) {
+      out_data[i] = bias.has_value()
+          ? bias.value().const_data_ptr<float>()[i % out_features]
+          : 0.0f;
+    }
+    return out;
+  }
+
+  const int64_t n_size = out_features;
+  static const tuning::TunableParam row_block_param(
+      "prepacked::linear", "row_block", {2, 4, 6, 8});
+  auto run = [&](int64_t row_block) {
+    const float* in_data = in.const_data_ptr<float>();
+    const float* weight_data = packed_weight.const_data_ptr<float>();
+    const float* bias_data =
+        bias.has_value() ? bias.value().const_data_ptr<float>() : nullptr;
+    float* out_data = out.mutable_data_ptr<float>();
+    switch (row_block) {
+      case 2:
+        linear_packed_kernel<2>(
+            in_data, weight_data, bias_data, out_data, m_size, k_size, n_size);
+        break;
+      case 6:
+        linear_packed_kernel<6>(
+            in_data, weight_data, bias_data, out_data, m_size, k_size, n_size);
+        break;
+      case 8:
+        linear_packed_kernel<8>(
+            in_data, weight_data, bias_data, out_data, m_size, k_size, n_size);
+        break;
+      default:
+        linear_packed_kernel<kDefaultRowBlock>(
+            in_data, weight_data, bias_data, out_data, m_size, k_size, n_size);
+        break;
+    }
+  };
+  run(row_block_param.select(
+      tuning::shape_bucket(m_size), kDefaultRowBlock, run));
+
+  return out;
+}
+
+} // namespace native
+} // namespace executor
+} // namespace torch
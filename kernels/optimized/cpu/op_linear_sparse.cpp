@@ -0,0 +1,601 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <executorch/kernels/optimized/cpu/parallel_utils.h>
+#include <executorch/kernels/optimized/vec/vec.h>
+#include <executorch/runtime/kernel/kernel_includes.h>
+
+#include <algorithm>
+#include <cinttypes>
+
+// Linear layers whose weight was pruned and compressed ahead of time by
+// exir/passes/sparse_weights_pass.py. The weight values are either float, or
+// int8 with one float scale per output feature.
+//
+// 2:4 sparsity: every group of 4 consecutive input features of an output
+// feature has at most 2 nonzero weights. values has shape [N, K / 2] and holds
+// the 2 kept weights of each group. metadata has shape [N, ceil(K / 8)] and
+// holds the positions of the kept weights within their group, as a nibble per
+// group (2 bits per weight), two groups per byte, the even group in the low
+// nibble. Only the kept weights are multiplied: the input rows are processed
+// Vec::size() at a time, transposed so that each kept weight is one broadcast
+// multiply-add over the rows. The remaining rows go through a scalar loop.
+//
+// Block sparsity: the output features are split into blocks of kBlockSize
+// consecutive features, and the weights of a block for one input feature are
+// either all zero or kept. The kept blocks are stored like the rows of a CSR
+// matrix: row_offsets[b] to row_offsets[b + 1] are the kept blocks of output
+// block b, col_indices holds their input feature and values their kBlockSize
+// weights. Each kept block is one broadcast multiply-add over its features.
+namespace torch {
+namespace executor {
+namespace native {
+
+using Tensor = exec_aten::Tensor;
+
+namespace {
+
+using Vec = executorch::vec::Vectorized<float>;
+
+// Must match BLOCK_SIZE in exir/passes/sparse_weights_pass.py.
+constexpr int64_t kBlockSize = 16;
+constexpr int64_t kVecsPerBlock = kBlockSize / Vec::size();
+static_assert(kBlockSize % Vec::size() == 0, "Blocks must fill whole vectors");
+// Input features of a group of the 2:4 format.
+constexpr int64_t kGroupSize = 4;
+// Input features transposed at a time by the 2:4 kernel. A multiple of 8, so
+// that tiles start on a metadata byte.
+constexpr int64_t kTileK = 512;
+// Input rows sharing each load of the weights in the scalar loops.
+constexpr int64_t kRowBlock = 4;
+// Output features interleaved by the scalar loop of the last rows.
+constexpr int64_t kFeatureBlock = 8;
+// Minimum number of multiply-adds per task.
+constexpr int64_t kSparseMinTaskWork = 65536;
+
+bool check_sparse_linear_common_args(
+    const Tensor& in,
+    const Tensor& values,
+    const exec_aten::optional<Tensor>& weight_scales,
+    const exec_aten::optional<Tensor>& bias,
+    int64_t out_features,
+    Tensor& out) {
+  ET_LOG_AND_RETURN_IF_FALSE(in.dim() >= 1);
+  ET_LOG_AND_RETURN_IF_FALSE(tensors_have_same_dtype(in, out));
+  ET_LOG_MSG_AND_RETURN_IF_FALSE(
+      in.scalar_type() == ScalarType::Float, "input dtype must be Float");
+  ET_LOG_MSG_AND_RETURN_IF_FALSE(
+      values.scalar_type() == ScalarType::Float ||
+          values.scalar_type() == ScalarType::Char,
+      "values dtype must be Float or Char");
+  if (values.scalar_type() == ScalarType::Char) {
+    ET_LOG_MSG_AND_RETURN_IF_FALSE(
+        weight_scales.has_value(), "int8 values need weight_scales");
+    ET_LOG_AND_RETURN_IF_FALSE(tensor_is_rank(weight_scales.value(), 1));
+    ET_LOG_AND_RETURN_IF_FALSE(weight_scales.value().size(0) == out_features);
+    ET_LOG_AND_RETURN_IF_FALSE(
+        tensors_have_same_dtype(in, weight_scales.value()));
+  } else {
+    ET_LOG_MSG_AND_RETURN_IF_FALSE(
+        !weight_scales.has_value(), "float values take no weight_scales");
+  }
+  if (bias.has_value()) {
+    ET_LOG_AND_RETURN_IF_FALSE(tensor_is_rank(bias.value(), 1));
+    ET_LOG_AND_RETURN_IF_FALSE(bias.value().size(0) == out_features);
+    ET_LOG_AND_RETURN_IF_FALSE(tensors_have_same_dtype(in, bias.value()));
+  }
+  return true;
+}
+
+bool check_sparse_linear_2_4_args(
+    const Tensor& in,
+    const Tensor& values,
+    const Tensor& metadata,
+    const exec_aten::optional<Tensor>& weight_scales,
+    const exec_aten::optional<Tensor>& bias,
+    Tensor& out) {
+  ET_LOG_AND_RETURN_IF_FALSE(tensor_is_rank(values, 2));
+  ET_LOG_AND_RETURN_IF_FALSE(tensor_is_rank(metadata, 2));
+  ET_LOG_AND_RETURN_IF_FALSE(metadata.scalar_type() == ScalarType::Byte);
+  ET_LOG_AND_RETURN_IF_FALSE(
+      tensors_have_same_size_at_dims(values, 0, metadata, 0));
+  const int64_t num_groups = values.size(1) / 2;
+  ET_LOG_MSG_AND_RETURN_IF_FALSE(
+      values.size(1) % 2 == 0 && metadata.size(1) == (num_groups + 1) / 2,
+      "metadata.size(1) %zd does not match values.size(1) %zd",
+      metadata.size(1),
+      values.size(1));
+  ET_LOG_MSG_AND_RETURN_IF_FALSE(
+      in.dim() >= 1 && in.size(in.dim() - 1) == num_groups * kGroupSize,
+      "input features do not match values.size(1) %zd",
+      values.size(1));
+  return check_sparse_linear_common_args(
+      in, values, weight_scales, bias, values.size(0), out);
+}
+
+bool check_sparse_linear_block_args(
+    const Tensor& in,
+    const Tensor& values,
+    const Tensor& col_indices,
+    const Tensor& row_offsets,
+    const exec_aten::optional<Tensor>& weight_scales,
+    const exec_aten::optional<Tensor>& bias,
+    int64_t out_features,
+    Tensor& out) {
+  ET_LOG_AND_RETURN_IF_FALSE(tensor_is_rank(values, 2));
+  ET_LOG_AND_RETURN_IF_FALSE(tensor_is_rank(col_indices, 1));
+  ET_LOG_AND_RETURN_IF_FALSE(tensor_is_rank(row_offsets, 1));
+  ET_LOG_AND_RETURN_IF_FALSE(col_indices.scalar_type() == ScalarType::Int);
+  ET_LOG_AND_RETURN_IF_FALSE(row_offsets.scalar_type() == ScalarType::Int);
+  ET_LOG_MSG_AND_RETURN_IF_FALSE(
+      values.size(1) == kBlockSize,
+      "values.size(1) %zd != block size %" PRId64,
+      values.size(1),
+      kBlockSize);
+  ET_LOG_AND_RETURN_IF_FALSE(
+      tensors_have_same_size_at_dims(values, 0, col_indices, 0));
+  ET_LOG_MSG_AND_RETURN_IF_FALSE(
+      out_features > 0 &&
+          row_offsets.size(0) ==
+              (out_features + kBlockSize - 1) / kBlockSize + 1,
+      "row_offsets.size(0) %zd does not hold out_features %" PRId64,
+      row_offsets.size(0),
+      out_features);
+  ET_LOG_AND_RETURN_IF_FALSE(in.dim() >= 1);
+
+  // The indices come from the program, so check that they stay in bounds.
+  // This is linear in the number of blocks, while the kernel multiplies every
+  // block with every input row.
+  const int32_t* offsets = row_offsets.const_data_ptr<int32_t>();
+  ET_LOG_MSG_AND_RETURN_IF_FALSE(
+      offsets[0] == 0 && offsets[row_offsets.size(0) - 1] == values.size(0),
+      "row_offsets must go from 0 to the number of blocks");
+  for (ssize_t b = 0; b + 1 < row_offsets.size(0); ++b) {
+    ET_LOG_MSG_AND_RETURN_IF_FALSE(
+        offsets[b] <= offsets[b + 1], "row_offsets must be non-decreasing");
+  }
+  const int32_t* cols = col_indices.const_data_ptr<int32_t>();
+  const int64_t in_features = in.size(in.dim() - 1);
+  for (ssize_t i = 0; i < col_indices.size(0); ++i) {
+    ET_LOG_MSG_AND_RETURN_IF_FALSE(
+        cols[i] >= 0 && cols[i] < in_features,
+        "col_indices[%zd] = %" PRId32 " is out of bounds for %" PRId64
+        " input features",
+        i,
+        cols[i],
+        in_features);
+  }
+  return check_sparse_linear_common_args(
+      in, values, weight_scales, bias, out_features, out);
+}
+
+Error resize_sparse_linear_out(
+    const Tensor& in,
+    int64_t out_features,
+    Tensor& out) {
+  exec_aten::SizesType out_sizes[kTensorDimensionLimit];
+  for (size_t i = 0; i < in.dim() - 1; ++i) {
+    out_sizes[i] = in.size(i);
+  }
+  out_sizes[in.dim() - 1] = static_cast<exec_aten::SizesType>(out_features);
+  return resize_tensor(out, {out_sizes, static_cast<size_t>(in.dim())});
+}
+
+// Parameters shared by the kernels. scales and bias are null when absent.
+struct SparseLinearParams {
+  const float* in;
+  const float* scales;
+  const float* bias;
+  float* out;
+  int64_t m_size;
+  int64_t k_size;
+  int64_t n_size;
+};
+
+inline float finish_output(const SparseLinearParams& p, int64_t n, float acc) {
+  return acc * (p.scales != nullptr ? p.scales[n] : 1.0f) +
+      (p.bias != nullptr ? p.bias[n] : 0.0f);
+}
+
+// Computes ROWS rows of out for output feature n of a 2:4 weight, one group
+// at a time.
+template <int64_t ROWS, typename WTYPE>
+inline void sparse_2_4_rows(
+    const SparseLinearParams& p,
+    const float* in,
+    const WTYPE* values,
+    const uint8_t* metadata,
+    float* out,
+    int64_t n) {
+  float acc[ROWS] = {};
+  const int64_t num_groups = p.k_size / kGroupSize;
+  for (int64_t g = 0; g < num_groups; ++g) {
+    const uint8_t positions = metadata[g / 2] >> ((g % 2) * 4);
+    const int64_t k0 = g * kGroupSize + (positions & 0x3);
+    const int64_t k1 = g * kGroupSize + ((positions >> 2) & 0x3);
+    const float w0 = static_cast<float>(values[2 * g]);
+    const float w1 = static_cast<float>(values[2 * g + 1]);
+    for (int64_t r = 0; r < ROWS; ++r) {
+      acc[r] += in[r * p.k_size + k0] * w0 + in[r * p.k_size + k1] * w1;
+    }
+  }
+  for (int64_t r = 0; r < ROWS; ++r) {
+    out[r * p.n_size] = finish_output(p, n, acc[r]);
+  }
+}
+
+// Computes FEATURES output features, from n, of a single row of out. The
+// features are independent sums, so interleaving them keeps several
+// multiply-adds in flight where a single feature would wait on each one.
+template <int64_t FEATURES, typename WTYPE>
+inline void sparse_2_4_features(
+    const SparseLinearParams& p,
+    const float* in,
+    const WTYPE* values,
+    const uint8_t* metadata,
+    float* out,
+    int64_t n) {
+  const int64_t values_per_row = p.k_size / 2;
+  const int64_t metadata_per_row = (p.k_size / kGroupSize + 1) / 2;
+  float acc[FEATURES] = {};
+  const int64_t num_groups = p.k_size / kGroupSize;
+  for (int64_t g = 0; g < num_groups; ++g) {
+    const float* x = in + g * kGroupSize;
+    for (int64_t f = 0; f < FEATURES; ++f) {
+      const uint8_t positions =
+          metadata[f * metadata_per_row + g / 2] >> ((g % 2) * 4);
+      const WTYPE* w = values + f * values_per_row + 2 * g;
+      acc[f] += x[positions & 0x3] * static_cast<float>(w[0]) +
+          x[(positions >> 2) & 0x3] * static_cast<float>(w[1]);
+    }
+  }
+  for (int64_t f = 0; f < FEATURES; ++f) {
+    out[f] = finish_output(p, n + f, acc[f]);
+  }
+}
+
+// Computes output features [n_begin, n_end) of a 2:4 weight.
+template <typename WTYPE>
+void sparse_linear_2_4_kernel(
+    const SparseLinearParams& p,
+    const WTYPE* values,
+    const uint8_t* metadata,
+    int64_t n_begin,
+    int64_t n_end) {
+  constexpr int64_t kLanes = Vec::size();
+  const int64_t values_per_row = p.k_size / 2;
+  const int64_t metadata_per_row = (p.k_size / kGroupSize + 1) / 2;
+
+  // Input rows m to m + kLanes, transposed: tile[k * kLanes + r] holds input
+  // feature k0 + k of row m + r.
+  float tile[kTileK * kLanes];
+  int64_t m = 0;
+  for (; m + kLanes <= p.m_size; m += kLanes) {
+    for (int64_t k0 = 0; k0 < p.k_size; k0 += kTileK) {
+      const int64_t k_len = std::min(kTileK, p.k_size - k0);
+      const bool last_tile = k0 + k_len == p.k_size;
+      for (int64_t r = 0; r < kLanes; ++r) {
+        const float* in_row = p.in + (m + r) * p.k_size + k0;
+        for (int64_t k = 0; k < k_len; ++k) {
+          tile[k * kLanes + r] = in_row[k];
+        }
+      }
+
+      for (int64_t n = n_begin; n < n_end; ++n) {
+        const WTYPE* w = values + n * values_per_row + k0 / 2;
+        const uint8_t* meta = metadata + n * metadata_per_row + k0 / 8;
+        // Two accumulators to hide the latency of the multiply-adds.
+        Vec acc0(0.0f);
+        Vec acc1(0.0f);
+        for (int64_t g = 0; g < k_len / kGroupSize; ++g) {
+          const uint8_t positions = meta[g / 2] >> ((g % 2) * 4);
+          const float* x = tile + g * kGroupSize * kLanes;
+          acc0 = executorch::vec::fmadd(
+              Vec::loadu(x + (positions & 0x3) * kLanes),
+              Vec(static_cast<float>(w[2 * g])),
+              acc0);
+          acc1 = executorch::vec::fmadd(
+              Vec::loadu(x + ((positions >> 2) & 0x3) * kLanes),
+              Vec(static_cast<float>(w[2 * g + 1])),
+              acc1);
+        }
+        float acc[kLanes];
+        (acc0 + acc1).store(acc);
+        for (int64_t r = 0; r < kLanes; ++r) {
+          float& out = p.out[(m + r) * p.n_size + n];
+          const float sum = k0 == 0 ? acc[r] : out + acc[r];
+          out = last_tile ? finish_output(p, n, sum) : sum;
+        }
+      }
+    }
+  }
+
+  for (; m + kRowBlock <= p.m_size; m += kRowBlock) {
+    for (int64_t n = n_begin; n < n_end; ++n) {
+      sparse_2_4_rows<kRowBlock>(
+          p,
+          p.in + m * p.k_size,
+          values + n * values_per_row,
+          metadata + n * metadata_per_row,
+          p.out + m * p.n_size + n,
+          n);
+    }
+  }
+  for (; m < p.m_size; ++m) {
+    int64_t n = n_begin;
+    for (; n + kFeatureBlock <= n_end; n += kFeatureBlock) {
+      sparse_2_4_features<kFeatureBlock>(
+          p,
+          p.in + m * p.k_size,
+          values + n * values_per_row,
+          metadata + n * metadata_per_row,
+          p.out + m * p.n_size + n,
+          n);
+    }
+    for (; n < n_end; ++n) {
+      sparse_2_4_features<1>(
+          p,
+          p.in + m * p.k_size,
+          values + n * values_per_row,
+          metadata + n * metadata_per_row,
+          p.out + m * p.n_size + n,
+          n);
+    }
+  }
+}
+
+inline void load_block(const float* values, Vec* w) {
+  for (int64_t v = 0; v < kVecsPerBlock; ++v) {
+    w[v] = Vec::loadu(values + v * Vec::size());
+  }
+}
+
+inline void load_block(const int8_t* values, Vec* w) {
+  float block[kBlockSize];
+  for (int64_t j = 0; j < kBlockSize; ++j) {
+    block[j] = static_cast<float>(values[j]);
+  }
+  load_block(block, w);
+}
+
+// Computes ROWS rows of out for output block b of a block sparse weight.
+template <int64_t ROWS, typename WTYPE>
+inline void sparse_block_rows(
+    const SparseLinearParams& p,
+    const float* in,
+    const WTYPE* values,
+    const int32_t* col_indices,
+    const int32_t* row_offsets,
+    float* out,
+    int64_t b) {
+  Vec acc[ROWS][kVecsPerBlock];
+  for (int64_t r = 0; r < ROWS; ++r) {
+    for (int64_t v = 0; v < kVecsPerBlock; ++v) {
+      acc[r][v] = Vec(0.0f);
+    }
+  }
+  for (int32_t i = row_offsets[b]; i < row_offsets[b + 1]; ++i) {
+    Vec w[kVecsPerBlock];
+    load_block(values + i * kBlockSize, w);
+    const int64_t k = col_indices[i];
+    for (int64_t r = 0; r < ROWS; ++r) {
+      const Vec x(in[r * p.k_size + k]);
+      for (int64_t v = 0; v < kVecsPerBlock; ++v) {
+        acc[r][v] = executorch::vec::fmadd(x, w[v], acc[r][v]);
+      }
+    }
+  }
+
+  const int64_t n_start = b * kBlockSize;
+  const int64_t n_valid = std::min(kBlockSize, p.n_size - n_start);
+  for (int64_t r = 0; r < ROWS; ++r) {
+    float sums[kBlockSize];
+    for (int64_t v = 0; v < kVecsPerBlock; ++v) {
+      acc[r][v].store(sums + v * Vec::size());
+    }
+    for (int64_t j = 0; j < n_valid; ++j) {
+      out[r * p.n_size + n_start + j] = finish_output(p, n_start + j, sums[j]);
+    }
+  }
+}
+
+// Computes output blocks [b_begin, b_end) of a block sparse weight.
+template <typename WTYPE>
+void sparse_linear_block_kernel(
+    const SparseLinearParams& p,
+    const WTYPE* values,
+    const int32_t* col_indices,
+    const int32_t* row_offsets,
+    int64_t b_begin,
+    int64_t b_end) {
+  int64_t m = 0;
+  for (; m + kRowBlock <= p.m_size; m += kRowBlock) {
+    for (int64_t b = b_begin; b < b_end; ++b) {
+      sparse_block_rows<kRowBlock>(
+          p,
+          p.in + m * p.k_size,
+          values,
+          col_indices,
+          row_offsets,
+          p.out + m * p.n_size,
+          b);
+    }
+  }
+  for (; m < p.m_size; ++m) {
+    for (int64_t b = b_begin; b < b_end; ++b) {
+      sparse_block_rows<1>(
+          p,
+          p.in + m * p.k_size,
+          values,
+          col_indices,
+          row_offsets,
+          p.out + m * p.n_size,
+          b);
+    }
+  }
+}
+
+SparseLinearParams make_params(
+    const Tensor& in,
+    const exec_aten::optional<Tensor>& weight_scales,
+    const exec_aten::optional<Tensor>& bias,
+    int64_t out_features,
+    Tensor& out) {
+  SparseLinearParams p;
+  p.in = in.const_data_ptr<float>();
+  p.scales = weight_scales.has_value()
+      ? weight_scales.value().const_data_ptr<float>()
+      : nullptr;
+  p.bias = bias.has_value() ? bias.value().const_data_ptr<float>() : nullptr;
+  p.out = out.mutable_data_ptr<float>();
+  p.k_size = in.size(in.dim() - 1);
+  p.m_size = p.k_size == 0 ? 0 : in.numel() / p.k_size;
+  p.n_size = out_features;
+  return p;
+}
+
+// Handles an empty reduction, where the output is just the bias. Returns
+// false when there is nothing to compute at all.
+bool has_work(const SparseLinearParams& p, Tensor& out) {
+  if (out.numel() == 0) {
+    return false;
+  }
+  if (p.k_size == 0) {
+    for (int64_t i = 0; i < out.numel(); ++i) {
+      p.out[i] = p.bias != nullptr ? p.bias[i % p.n_size] : 0.0f;
+    }
+    return false;
+  }
+  return true;
+}
+
+} // namespace
+
+Tensor& opt_prepacked_sparse_linear_2_4_out(
+    RuntimeContext& ctx,
+    const Tensor& in,
+    const Tensor& values,
+    const Tensor& metadata,
+    const exec_aten::optional<Tensor>& weight_scales,
+    const exec_aten::optional<Tensor>& bias,
+    Tensor& out) {
+  ET_KERNEL_CHECK_ARGS(
+      ctx,
+      check_sparse_linear_2_4_args(
+          in, values, metadata, weight_scales, bias, out),
+      InvalidArgument,
+      out);
+
+  const int64_t out_features = values.size(0);
+  ET_KERNEL_CHECK(
+      ctx,
+      resize_sparse_linear_out(in, out_features, out) == Error::Ok,
+      InvalidArgument,
+      out);
+
+  const SparseLinearParams p =
+      make_params(in, weight_scales, bias, out_features, out);
+  if (!has_work(p, out)) {
+    return out;
+  }
+
+  const uint8_t* metadata_data = metadata.const_data_ptr<uint8_t>();
+  const int64_t item_work = p.m_size * p.k_size / 2;
+  if (values.scalar_type() == ScalarType::Char) {
+    const int8_t* values_data = values.const_data_ptr<int8_t>();
+    run_parallel(
+        out_features,
+        item_work,
+        kSparseMinTaskWork,
+        [&](int64_t begin, int64_t end) {
+          sparse_linear_2_4_kernel(p, values_data, metadata_data, begin, end);
+        });
+  } else {
+    const float* values_data = values.const_data_ptr<float>();
+    run_parallel(
+        out_features,
+        item_work,
+        kSparseMinTaskWork,
+        [&](int64_t begin, int64_t end) {
+          sparse_linear_2_4_kernel(p, values_data, metadata_data, begin, end);
+        });
+  }
+  return out;
+}
+
+Tensor& opt_prepacked_sparse_linear_block_out(
+    RuntimeContext& ctx,
+    const Tensor& in,
+    const Tensor& values,
+    const Tensor& col_indices,
+    const Tensor& row_offsets,
+    const exec_aten::optional<Tensor>& weight_scales,
+    const exec_aten::optional<Tensor>& bias,
+    int64_t out_features,
+    Tensor& out) {
+  // Not ET_KERNEL_CHECK_ARGS: the check reads the index values, which are not
+  // part of what a validated call remembers.
+  ET_KERNEL_CHECK(
+      ctx,
+      check_sparse_linear_block_args(
+          in,
+          values,
+          col_indices,
+          row_offsets,
+          weight_scales,
+          bias,
+          out_features,
+          out),
+      InvalidArgument,
+      out);
+
+  ET_KERNEL_CHECK(
+      ctx,
+      resize_sparse_linear_out(in, out_features, out) == Error::Ok,
+      InvalidArgument,
+      out);
+
+  const SparseLinearParams p =
+      make_params(in, weight_scales, bias, out_features, out);
+  if (!has_work(p, out)) {
+    return out;
+  }
+
+  const int32_t* col_data = col_indices.const_data_ptr<int32_t>();
+  const int32_t* offsets_data = row_offsets.const_data_ptr<int32_t>();
+  const int64_t num_blocks = row_offsets.size(0) - 1;
+  // The average work of an output block.
+  const int64_t item_work =
+      p.m_size * kBlockSize * (values.size(0) / num_blocks + 1);
+  if (values.scalar_type() == ScalarType::Char) {
+    const int8_t* values_data = values.const_data_ptr<int8_t>();
+    run_parallel(
+        num_blocks,
+        item_work,
+        kSparseMinTaskWork,
+        [&](int64_t begin, int64_t end) {
+          sparse_linear_block_kernel(
+              p, values_data, col_data, offsets_data, begin, end);
+        });
+  } else {
+    const float* values_data = values.const_data_ptr<float>();
+    run_parallel(
+        num_blocks,
+        item_work,
+        kSparseMinTaskWork,
+        [&](int64_t begin, int64_t end) {
+          sparse_linear_block_kernel(
+              p, values_data, col_data, offsets_data, begin, end);
+        });
+  }
+  return out;
+}
+
+} // namespace native
+} // namespace executor
+} // namespace torch
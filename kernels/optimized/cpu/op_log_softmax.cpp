@@ -132,7 +132,7 @@ Tensor& opt_log_softmax_out(
     Tensor& out) {
   (void)context;
 
-  ET_KERNEL_CHECK(
+  ET_KERNEL_CHECK_ARGS(
       context,
       check_log_softmax_args(self, dim, half_to_float, out),
       InvalidArgument,
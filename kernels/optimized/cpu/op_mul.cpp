@@ -108,6 +108,76 @@ Tensor& opt_mul_out(
   return out;
 }
 
+namespace {
+
+// Body of the dtype-specialized mul.out kernels. These are only bound when
+// `a`, `b` and `out` all have dtype CTYPE and the same rank (see
+// `dtype_specializations` in optimized.yaml), so the dtype switch of
+// opt_mul_out() is not needed. Broadcasting still goes to opt_mul_out().
+template <typename CTYPE>
+Tensor& opt_mul_out_specialized(
+    RuntimeContext& ctx,
+    const Tensor& a,
+    const Tensor& b,
+    Tensor& out) {
+  if (!a.sizes().equals(b.sizes())) {
+    return opt_mul_out(ctx, a, b, out);
+  }
+
+  // Resize for dynamic shape
+  auto error = resize_tensor(out, a.sizes());
+  ET_KERNEL_CHECK_MSG(
+      ctx,
+      error == Error::Ok,
+      InvalidArgument,
+      out,
+      "Failed to resize output tensor.");
+
+  using Vec = executorch::vec::Vectorized<CTYPE>;
+  executorch::vec::map2<CTYPE>(
+      [](Vec x, Vec y) { return x * y; },
+      out.mutable_data_ptr<CTYPE>(),
+      a.const_data_ptr<CTYPE>(),
+      b.const_data_ptr<CTYPE>(),
+      out.numel());
+
+  return out;
+}
+
+} // namespace
+
+Tensor& opt_mul_out_float(
+    RuntimeContext& ctx,
+    const Tensor& a,
+    const Tensor& b,
+    Tensor& out) {
+  return opt_mul_out_specialized<float>(ctx, a, b, out);
+}
+
+Tensor& opt_mul_out_double(
+    RuntimeContext& ctx,
+    const Tensor& a,
+    const Tensor& b,
+    Tensor& out) {
+  return opt_mul_out_specialized<double>(ctx, a, b, out);
+}
+
+Tensor& opt_mul_out_int(
+    RuntimeContext& ctx,
+    const Tensor& a,
+    const Tensor& b,
+    Tensor& out) {
+  return opt_mul_out_specialized<int32_t>(ctx, a, b, out);
+}
+
+Tensor& opt_mul_out_long(
+    RuntimeContext& ctx,
+    const Tensor& a,
+    const Tensor& b,
+    Tensor& out) {
+  return opt_mul_out_specialized<int64_t>(ctx, a, b, out);
+}
+
 Tensor& opt_mul_scalar_out(
     RuntimeContext& ctx,
     const Tensor& a,
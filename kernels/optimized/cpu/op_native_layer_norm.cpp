@@ -125,7 +125,7 @@ std::tuple<Tensor&, Tensor&, Tensor&> opt_native_layer_norm_out(
 
   std::tuple<Tensor&, Tensor&, Tensor&> ret_val(out, mean_out, rstd_out);
 
-  ET_KERNEL_CHECK(
+  ET_KERNEL_CHECK_ARGS(
       ctx,
       check_layer_norm_args(
           input, normalized_shape, weight, bias, out, mean_out, rstd_out),
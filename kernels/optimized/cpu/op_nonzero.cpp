@@ -0,0 +1,245 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+
+#include <executorch/kernels/optimized/cpu/parallel_utils.h>
+#include <executorch/kernels/optimized/utils/llvmMathExtras.h>
+#include <executorch/kernels/portable/cpu/util/index_util.h>
+#include <executorch/runtime/kernel/kernel_includes.h>
+
+// Indices of the nonzero elements of a tensor, as a stream compaction.
+//
+// The input is split into at most kMaxChunks chunks. A first pass counts the
+// nonzero elements of each chunk, an exclusive prefix sum of the counts gives
+// the row of out where each chunk starts, and a second pass writes the
+// indices of each chunk from there. Both passes process the chunks in
+// parallel when the threadpool is available, and the output is the same as
+// with a serial scan.
+//
+// Bool and 8-bit inputs are read a 64-bit word at a time: a word of zeros is
+// skipped at once, and the nonzero bytes of a word are counted with a
+// popcount.
+namespace torch {
+namespace executor {
+namespace native {
+
+using Tensor = exec_aten::Tensor;
+using ScalarType = exec_aten::ScalarType;
+using SizesType = exec_aten::SizesType;
+
+namespace {
+
+// Upper bound on the number of chunks, whose counts are kept on the stack.
+constexpr int64_t kMaxChunks = 64;
+// Minimum number of elements per chunk.
+constexpr int64_t kMinChunkSize = 32768;
+
+constexpr uint64_t kLowBits = 0x0101010101010101ULL;
+
+template <typename CTYPE>
+using IsByte = std::integral_constant<
+    bool,
+    sizeof(CTYPE) == 1 && std::is_integral<CTYPE>::value>;
+
+inline uint64_t load_word(const void* data) {
+  uint64_t word;
+  std::memcpy(&word, data, sizeof(word));
+  return word;
+}
+
+// Returns a word with the low bit of each byte set if that byte of word is
+// nonzero, and all other bits clear.
+inline uint64_t nonzero_bytes(uint64_t word) {
+  word |= word >> 4;
+  word |= word >> 2;
+  word |= word >> 1;
+  return word & kLowBits;
+}
+
+template <typename CTYPE>
+typename std::enable_if<!IsByte<CTYPE>::value, int64_t>::type count_nonzero(
+    const CTYPE* data,
+    int64_t size) {
+  int64_t count = 0;
+  for (int64_t i = 0; i < size; ++i) {
+    count += data[i] != 0;
+  }
+  return count;
+}
+
+template <typename CTYPE>
+typename std::enable_if<IsByte<CTYPE>::value, int64_t>::type count_nonzero(
+    const CTYPE* data,
+    int64_t size) {
+  int64_t count = 0;
+  int64_t i = 0;
+  for (; i + 8 <= size; i += 8) {
+    count += executorch::llvm::countPopulation(
+        nonzero_bytes(load_word(data + i)));
+  }
+  for (; i < size; ++i) {
+    count += data[i] != 0;
+  }
+  return count;
+}
+
+// Returns the index of the first nonzero element of data in [begin, end), or
+// end if there is none.
+template <typename CTYPE>
+typename std::enable_if<!IsByte<CTYPE>::value, int64_t>::type find_nonzero(
+    const CTYPE* data,
+    int64_t begin,
+    int64_t end) {
+  while (begin < end && data[begin] == 0) {
+    ++begin;
+  }
+  return begin;
+}
+
+template <typename CTYPE>
+typename std::enable_if<IsByte<CTYPE>::value, int64_t>::type find_nonzero(
+    const CTYPE* data,
+    int64_t begin,
+    int64_t end) {
+  while (begin + 8 <= end && load_word(data + begin) == 0) {
+    begin += 8;
+  }
+  while (begin < end && data[begin] == 0) {
+    ++begin;
+  }
+  return begin;
+}
+
+/**
+ * Writes the indices of the nonzero elements of data in [begin, end) to out,
+ * one row of sizes.size() indices per element, in order. The elements are
+ * visited a row of the last dimension at a time, so that the indices of the
+ * other dimensions only change between rows.
+ */
+template <typename CTYPE>
+void write_nonzero_indices(
+    const CTYPE* data,
+    int64_t begin,
+    int64_t end,
+    const ArrayRef<SizesType> sizes,
+    int64_t* out) {
+  const size_t ndim = sizes.size();
+  const int64_t row_size = sizes[ndim - 1];
+
+  int64_t index[kTensorDimensionLimit];
+  int64_t remainder = begin;
+  for (size_t d = ndim; d > 0; --d) {
+    index[d - 1] = remainder % sizes[d - 1];
+    remainder /= sizes[d - 1];
+  }
+
+  int64_t row_begin = begin - index[ndim - 1];
+  while (row_begin < end) {
+    const int64_t row_end = std::min(end, row_begin + row_size);
+    for (int64_t i = find_nonzero(data, row_begin + index[ndim - 1], row_end);
+         i < row_end;
+         i = find_nonzero(data, i + 1, row_end)) {
+      for (size_t d = 0; d + 1 < ndim; ++d) {
+        *out++ = index[d];
+      }
+      *out++ = i - row_begin;
+    }
+
+    // Move to the start of the next row.
+    index[ndim - 1] = 0;
+    for (size_t d = ndim - 1; d > 0; --d) {
+      if (++index[d - 1] < sizes[d - 1]) {
+        break;
+      }
+      index[d - 1] = 0;
+    }
+    row_begin += row_size;
+  }
+}
+
+template <typename CTYPE>
+void nonzero(RuntimeContext& ctx, const Tensor& input, Tensor& output) {
+  const CTYPE* const in_data = input.const_data_ptr<CTYPE>();
+  const int64_t numel = input.numel();
+
+  const int64_t num_chunks = std::max<int64_t>(
+      1, std::min(kMaxChunks, numel / kMinChunkSize));
+  const int64_t chunk_size = (numel + num_chunks - 1) / num_chunks;
+
+  // Count the nonzero elements of each chunk, then turn the counts into the
+  // offsets of the chunks in out.
+  int64_t offsets[kMaxChunks + 1];
+  offsets[0] = 0;
+  run_parallel(
+      num_chunks, chunk_size, kMinChunkSize, [&](int64_t begin, int64_t end) {
+        for (int64_t chunk = begin; chunk < end; ++chunk) {
+          const int64_t chunk_begin = chunk * chunk_size;
+          const int64_t chunk_end = std::min(numel, chunk_begin + chunk_size);
+          offsets[chunk + 1] =
+              count_nonzero(in_data + chunk_begin, chunk_end - chunk_begin);
+        }
+      });
+  for (int64_t chunk = 0; chunk < num_chunks; ++chunk) {
+    offsets[chunk + 1] += offsets[chunk];
+  }
+  const int64_t num_nonzero = offsets[num_chunks];
+
+  SizesType out_shape[2] = {
+      static_cast<SizesType>(num_nonzero), static_cast<SizesType>(input.dim())};
+  ET_KERNEL_CHECK(
+      ctx,
+      resize_tensor(output, ArrayRef<exec_aten::SizesType>(out_shape, 2)) ==
+          Error::Ok,
+      InvalidArgument, );
+
+  // The indices of a zero-dim input have no elements.
+  if (num_nonzero == 0 || input.dim() == 0) {
+    return;
+  }
+
+  int64_t* const out_data = output.mutable_data_ptr<int64_t>();
+  run_parallel(
+      num_chunks, chunk_size, kMinChunkSize, [&](int64_t begin, int64_t end) {
+        for (int64_t chunk = begin; chunk < end; ++chunk) {
+          const int64_t chunk_begin = chunk * chunk_size;
+          const int64_t chunk_end = std::min(numel, chunk_begin + chunk_size);
+          write_nonzero_indices(
+              in_data,
+              chunk_begin,
+              chunk_end,
+              input.sizes(),
+              out_data + offsets[chunk] * input.dim());
+        }
+      });
+}
+
+} // namespace
+
+/**
+ * Determines the non zero indices of input.
+ * Out is a 2-D tensor where every row is a non zero index of the input.
+ */
+Tensor& opt_nonzero_out(RuntimeContext& ctx, const Tensor& in, Tensor& out) {
+  (void)ctx;
+
+  ET_KERNEL_CHECK_ARGS(ctx, check_nonzero_args(in, out), InvalidArgument, out);
+
+  ET_SWITCH_REAL_TYPES_AND(
+      Bool, in.scalar_type(), ctx, "nonzero.out", CTYPE, [&] {
+        nonzero<CTYPE>(ctx, in, out);
+      });
+
+  return out;
+}
+
+} // namespace native
+} // namespace executor
+} // namespace torch
@@ -0,0 +1,340 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <algorithm>
+#include <type_traits>
+
+#include <executorch/kernels/optimized/cpu/parallel_utils.h>
+#include <executorch/kernels/optimized/vec/functional.h>
+#include <executorch/kernels/optimized/vec/vec.h>
+#include <executorch/kernels/portable/cpu/util/upsample_util.h>
+#include <executorch/runtime/kernel/kernel_includes.h>
+
+// Bilinear upsampling of NCHW or NHWC (channels last) tensors.
+//
+// The source indices and weights along W only depend on the output column, so
+// they are computed once per tile of kColumnTile columns and reused by every
+// row of every plane; those along H are computed once per output row. With
+// NCHW tensors, the inner loop walks a row of output columns through the
+// precomputed indices. With NHWC tensors, it interpolates the C contiguous
+// channels of each pixel with vector loads. The work is split across threads
+// by planes (NCHW) or by output rows (NHWC) when the threadpool is available.
+namespace torch {
+namespace executor {
+namespace native {
+
+using Tensor = exec_aten::Tensor;
+using IntArrayRef = exec_aten::ArrayRef<int64_t>;
+using exec_aten::optional;
+
+namespace {
+
+// Number of output columns whose source indices and weights are kept on the
+// stack at a time.
+constexpr int64_t kColumnTile = 512;
+// Minimum number of output elements per task.
+constexpr int64_t kMinTaskWork = 32768;
+
+// Returns true if t is laid out as [N, H, W, C].
+bool is_channels_last(const Tensor& t) {
+  const auto strides = t.strides();
+  return strides[1] == 1 && strides[3] == t.size(1) &&
+      strides[2] == t.size(3) * t.size(1) &&
+      strides[0] == t.size(2) * t.size(3) * t.size(1);
+}
+
+// Source indices and weights along one axis for a range of output indices.
+template <typename opmath_t>
+struct AxisWeights {
+  int64_t index0[kColumnTile];
+  int64_t index1[kColumnTile];
+  opmath_t lambda0[kColumnTile];
+  opmath_t lambda1[kColumnTile];
+
+  void compute(
+      int64_t begin,
+      int64_t len,
+      opmath_t ratio,
+      int64_t in_size,
+      int64_t out_size,
+      bool align_corners) {
+    for (int64_t j = 0; j < len; ++j) {
+      compute_source_index_and_lambda<opmath_t>(
+          index0[j],
+          index1[j],
+          lambda0[j],
+          lambda1[j],
+          ratio,
+          begin + j,
+          in_size,
+          out_size,
+          align_corners);
+    }
+  }
+};
+
+// Interpolates the `channels` contiguous channels of one NHWC output pixel
+// from its four source pixels. Vectorized for float and double.
+template <typename CTYPE, typename opmath_t>
+typename std::enable_if<std::is_same<CTYPE, opmath_t>::value>::type
+interpolate_pixel(
+    CTYPE* out,
+    const CTYPE* in00,
+    const CTYPE* in01,
+    const CTYPE* in10,
+    const CTYPE* in11,
+    opmath_t w00,
+    opmath_t w01,
+    opmath_t w10,
+    opmath_t w11,
+    int64_t channels) {
+  using Vec = executorch::vec::Vectorized<CTYPE>;
+  const Vec v00(w00);
+  const Vec v01(w01);
+  const Vec v10(w10);
+  const Vec v11(w11);
+  int64_t c = 0;
+  for (; c + Vec::size() <= channels; c += Vec::size()) {
+    Vec sum = Vec::loadu(in00 + c) * v00;
+    sum = executorch::vec::fmadd(Vec::loadu(in01 + c), v01, sum);
+    sum = executorch::vec::fmadd(Vec::loadu(in10 + c), v10, sum);
+    sum = executorch::vec::fmadd(Vec::loadu(in11 + c), v11, sum);
+    sum.store(out + c);
+  }
+  for (; c < channels; ++c) {
+    out[c] =
+        w00 * in00[c] + w01 * in01[c] + w10 * in10[c] + w11 * in11[c];
+  }
+}
+
+template <typename CTYPE, typename opmath_t>
+typename std::enable_if<!std::is_same<CTYPE, opmath_t>::value>::type
+interpolate_pixel(
+    CTYPE* out,
+    const CTYPE* in00,
+    const CTYPE* in01,
+    const CTYPE* in10,
+    const CTYPE* in11,
+    opmath_t w00,
+    opmath_t w01,
+    opmath_t w10,
+    opmath_t w11,
+    int64_t channels) {
+  for (int64_t c = 0; c < channels; ++c) {
+    out[c] = static_cast<CTYPE>(
+        w00 * static_cast<opmath_t>(in00[c]) +
+        w01 * static_cast<opmath_t>(in01[c]) +
+        w10 * static_cast<opmath_t>(in10[c]) +
+        w11 * static_cast<opmath_t>(in11[c]));
+  }
+}
+
+template <typename CTYPE, typename opmath_t>
+void upsample_bilinear2d_channels_last(
+    const Tensor& in,
+    bool align_corners,
+    opmath_t ratio_h,
+    opmath_t ratio_w,
+    Tensor& out) {
+  const CTYPE* const in_data = in.const_data_ptr<CTYPE>();
+  CTYPE* const out_data = out.mutable_data_ptr<CTYPE>();
+  const int64_t channels = in.size(1);
+  const int64_t in_height = in.size(2);
+  const int64_t in_width = in.size(3);
+  const int64_t out_height = out.size(2);
+  const int64_t out_width = out.size(3);
+  const int64_t in_row_size = in_width * channels;
+  const int64_t out_row_size = out_width * channels;
+
+  run_parallel(
+      out.size(0) * out_height,
+      out_row_size,
+      kMinTaskWork,
+      [&](int64_t begin, int64_t end) {
+        AxisWeights<opmath_t> w;
+        for (int64_t col = 0; col < out_width; col += kColumnTile) {
+          const int64_t len = std::min(kColumnTile, out_width - col);
+          w.compute(col, len, ratio_w, in_width, out_width, align_corners);
+
+          for (int64_t row = begin; row < end; ++row) {
+            const int64_t n = row / out_height;
+            const int64_t oh = row % out_height;
+            int64_t ih0, ih1;
+            opmath_t h0lambda, h1lambda;
+            compute_source_index_and_lambda<opmath_t>(
+                ih0,
+                ih1,
+                h0lambda,
+                h1lambda,
+                ratio_h,
+                oh,
+                in_height,
+                out_height,
+                align_corners);
+            const CTYPE* const in_image =
+                in_data + n * in_height * in_row_size;
+            const CTYPE* const in_row0 = in_image + ih0 * in_row_size;
+            const CTYPE* const in_row1 = in_image + ih1 * in_row_size;
+            CTYPE* const out_row =
+                out_data + row * out_row_size + col * channels;
+
+            for (int64_t j = 0; j < len; ++j) {
+              const int64_t offset0 = w.index0[j] * channels;
+              const int64_t offset1 = w.index1[j] * channels;
+              interpolate_pixel<CTYPE, opmath_t>(
+                  out_row + j * channels,
+                  in_row0 + offset0,
+                  in_row0 + offset1,
+                  in_row1 + offset0,
+                  in_row1 + offset1,
+                  h0lambda * w.lambda0[j],
+                  h0lambda * w.lambda1[j],
+                  h1lambda * w.lambda0[j],
+                  h1lambda * w.lambda1[j],
+                  channels);
+            }
+          }
+        }
+      });
+}
+
+// Handles any strides, and is fastest when W is the innermost dimension.
+template <typename CTYPE, typename opmath_t>
+void upsample_bilinear2d_planar(
+    const Tensor& in,
+    bool align_corners,
+    opmath_t ratio_h,
+    opmath_t ratio_w,
+    Tensor& out) {
+  const CTYPE* const in_data = in.const_data_ptr<CTYPE>();
+  CTYPE* const out_data = out.mutable_data_ptr<CTYPE>();
+  const auto in_strides = in.strides();
+  const auto out_strides = out.strides();
+  const int64_t channels = in.size(1);
+  const int64_t in_height = in.size(2);
+  const int64_t in_width = in.size(3);
+  const int64_t out_height = out.size(2);
+  const int64_t out_width = out.size(3);
+  const int64_t in_col_stride = in_strides[3];
+  const int64_t out_col_stride = out_strides[3];
+
+  run_parallel(
+      out.size(0) * channels,
+      out_height * out_width,
+      kMinTaskWork,
+      [&](int64_t begin, int64_t end) {
+        AxisWeights<opmath_t> w;
+        for (int64_t col = 0; col < out_width; col += kColumnTile) {
+          const int64_t len = std::min(kColumnTile, out_width - col);
+          w.compute(col, len, ratio_w, in_width, out_width, align_corners);
+          for (int64_t j = 0; j < len; ++j) {
+            w.index0[j] *= in_col_stride;
+            w.index1[j] *= in_col_stride;
+          }
+
+          for (int64_t plane = begin; plane < end; ++plane) {
+            const int64_t n = plane / channels;
+            const int64_t c = plane % channels;
+            const CTYPE* const in_plane =
+                in_data + n * in_strides[0] + c * in_strides[1];
+            CTYPE* const out_plane = out_data + n * out_strides[0] +
+                c * out_strides[1] + col * out_col_stride;
+
+            for (int64_t oh = 0; oh < out_height; ++oh) {
+              int64_t ih0, ih1;
+              opmath_t h0lambda, h1lambda;
+              compute_source_index_and_lambda<opmath_t>(
+                  ih0,
+                  ih1,
+                  h0lambda,
+                  h1lambda,
+                  ratio_h,
+                  oh,
+                  in_height,
+                  out_height,
+                  align_corners);
+              const CTYPE* const in_row0 = in_plane + ih0 * in_strides[2];
+              const CTYPE* const in_row1 = in_plane + ih1 * in_strides[2];
+              CTYPE* const out_row = out_plane + oh * out_strides[2];
+
+              for (int64_t j = 0; j < len; ++j) {
+                const int64_t offset0 = w.index0[j];
+                const int64_t offset1 = w.index1[j];
+                const opmath_t value = h0lambda *
+                        (w.lambda0[j] *
+                             static_cast<opmath_t>(in_row0[offset0]) +
+                         w.lambda1[j] *
+                             static_cast<opmath_t>(in_row0[offset1])) +
+                    h1lambda *
+                        (w.lambda0[j] *
+                             static_cast<opmath_t>(in_row1[offset0]) +
+                         w.lambda1[j] *
+                             static_cast<opmath_t>(in_row1[offset1]));
+                out_row[j * out_col_stride] = static_cast<CTYPE>(value);
+              }
+            }
+          }
+        }
+      });
+}
+
+} // namespace
+
+Tensor& opt_upsample_bilinear2d_vec_out(
+    RuntimeContext& ctx,
+    const Tensor& in,
+    const optional<IntArrayRef> output_size,
+    bool align_corners,
+    const optional<exec_aten::ArrayRef<double>> scale_factors,
+    Tensor& out) {
+  ET_KERNEL_CHECK(
+      ctx,
+      check_upsample_bilinear2d_args(
+          in, output_size, align_corners, scale_factors, out),
+      InvalidArgument,
+      out);
+
+  optional<double> scale_h;
+  optional<double> scale_w;
+  ET_KERNEL_CHECK_MSG(
+      ctx,
+      resize_upsample_2d(
+          in, output_size, scale_factors, scale_h, scale_w, out) == Error::Ok,
+      InvalidArgument,
+      out,
+      "Failed to resize output tensor");
+
+  const bool channels_last = in.size(1) > 1 && is_channels_last(in) &&
+      is_channels_last(out);
+
+  ET_SWITCH_FLOATH_TYPES(
+      in.scalar_type(), ctx, "upsample_bilinear2d.vec_out", CTYPE, [&]() {
+        // Interpolate in float, or in double for double tensors, like ATen.
+        using opmath_t = typename std::conditional<
+            std::is_same<CTYPE, double>::value,
+            double,
+            float>::type;
+        const opmath_t ratio_h = area_pixel_compute_scale<opmath_t>(
+            in.size(2), out.size(2), align_corners, scale_h);
+        const opmath_t ratio_w = area_pixel_compute_scale<opmath_t>(
+            in.size(3), out.size(3), align_corners, scale_w);
+        if (channels_last) {
+          upsample_bilinear2d_channels_last<CTYPE, opmath_t>(
+              in, align_corners, ratio_h, ratio_w, out);
+        } else {
+          upsample_bilinear2d_planar<CTYPE, opmath_t>(
+              in, align_corners, ratio_h, ratio_w, out);
+        }
+      });
+
+  return out;
+}
+
+} // namespace native
+} // namespace executor
+} // namespace torch
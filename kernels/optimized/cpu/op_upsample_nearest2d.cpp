@@ -0,0 +1,217 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <algorithm>
+#include <cstring>
+
+#include <executorch/kernels/optimized/cpu/parallel_utils.h>
+#include <executorch/kernels/portable/cpu/util/upsample_util.h>
+#include <executorch/runtime/kernel/kernel_includes.h>
+
+// Nearest neighbor upsampling of NCHW or NHWC (channels last) tensors.
+//
+// The source column of each output column is computed once per tile of
+// kColumnTile columns and reused by every row of every plane. Output rows that
+// read the same input row as the row above them, which is most of them when
+// upsampling, are copied from that row with memcpy. With NHWC tensors each
+// output pixel is a memcpy of its C channels. The work is split across threads
+// by planes (NCHW) or by output rows (NHWC) when the threadpool is available.
+namespace torch {
+namespace executor {
+namespace native {
+
+using Tensor = exec_aten::Tensor;
+using IntArrayRef = exec_aten::ArrayRef<int64_t>;
+using exec_aten::optional;
+
+namespace {
+
+// Number of output columns whose source offsets are kept on the stack at a
+// time.
+constexpr int64_t kColumnTile = 512;
+// Minimum number of output elements per task.
+constexpr int64_t kMinTaskWork = 32768;
+
+// Returns true if t is laid out as [N, H, W, C].
+bool is_channels_last(const Tensor& t) {
+  const auto strides = t.strides();
+  return strides[1] == 1 && strides[3] == t.size(1) &&
+      strides[2] == t.size(3) * t.size(1) &&
+      strides[0] == t.size(2) * t.size(3) * t.size(1);
+}
+
+template <typename CTYPE>
+void upsample_nearest2d_channels_last(
+    const Tensor& in,
+    float ratio_h,
+    float ratio_w,
+    Tensor& out) {
+  const CTYPE* const in_data = in.const_data_ptr<CTYPE>();
+  CTYPE* const out_data = out.mutable_data_ptr<CTYPE>();
+  const int64_t channels = in.size(1);
+  const int64_t in_height = in.size(2);
+  const int64_t in_width = in.size(3);
+  const int64_t out_height = out.size(2);
+  const int64_t out_width = out.size(3);
+  const int64_t in_row_size = in_width * channels;
+  const int64_t out_row_size = out_width * channels;
+
+  run_parallel(
+      out.size(0) * out_height,
+      out_row_size,
+      kMinTaskWork,
+      [&](int64_t begin, int64_t end) {
+        int64_t in_offsets[kColumnTile];
+        for (int64_t col = 0; col < out_width; col += kColumnTile) {
+          const int64_t len = std::min(kColumnTile, out_width - col);
+          for (int64_t j = 0; j < len; ++j) {
+            const int64_t iw = nearest_neighbor_compute_source_index(
+                ratio_w, col + j, in_width, out_width);
+            in_offsets[j] = iw * channels;
+          }
+
+          int64_t prev_ih = -1;
+          for (int64_t row = begin; row < end; ++row) {
+            const int64_t n = row / out_height;
+            const int64_t oh = row % out_height;
+            const int64_t ih = nearest_neighbor_compute_source_index(
+                ratio_h, oh, in_height, out_height);
+            CTYPE* const out_row =
+                out_data + row * out_row_size + col * channels;
+            // prev_ih is only set by the previous row of this task, which is
+            // already written; oh > 0 checks that it is in the same image.
+            if (ih == prev_ih && oh > 0) {
+              std::memcpy(
+                  out_row,
+                  out_row - out_row_size,
+                  len * channels * sizeof(CTYPE));
+              continue;
+            }
+            prev_ih = ih;
+
+            const CTYPE* const in_row =
+                in_data + (n * in_height + ih) * in_row_size;
+            for (int64_t j = 0; j < len; ++j) {
+              std::memcpy(
+                  out_row + j * channels,
+                  in_row + in_offsets[j],
+                  channels * sizeof(CTYPE));
+            }
+          }
+        }
+      });
+}
+
+// Handles any strides, and is fastest when W is the innermost dimension.
+template <typename CTYPE>
+void upsample_nearest2d_planar(
+    const Tensor& in,
+    float ratio_h,
+    float ratio_w,
+    Tensor& out) {
+  const CTYPE* const in_data = in.const_data_ptr<CTYPE>();
+  CTYPE* const out_data = out.mutable_data_ptr<CTYPE>();
+  const auto in_strides = in.strides();
+  const auto out_strides = out.strides();
+  const int64_t channels = in.size(1);
+  const int64_t in_height = in.size(2);
+  const int64_t in_width = in.size(3);
+  const int64_t out_height = out.size(2);
+  const int64_t out_width = out.size(3);
+  const int64_t out_col_stride = out_strides[3];
+
+  run_parallel(
+      out.size(0) * channels,
+      out_height * out_width,
+      kMinTaskWork,
+      [&](int64_t begin, int64_t end) {
+        int64_t in_offsets[kColumnTile];
+        for (int64_t col = 0; col < out_width; col += kColumnTile) {
+          const int64_t len = std::min(kColumnTile, out_width - col);
+          for (int64_t j = 0; j < len; ++j) {
+            const int64_t iw = nearest_neighbor_compute_source_index(
+                ratio_w, col + j, in_width, out_width);
+            in_offsets[j] = iw * in_strides[3];
+          }
+
+          for (int64_t plane = begin; plane < end; ++plane) {
+            const int64_t n = plane / channels;
+            const int64_t c = plane % channels;
+            const CTYPE* const in_plane =
+                in_data + n * in_strides[0] + c * in_strides[1];
+            CTYPE* const out_plane = out_data + n * out_strides[0] +
+                c * out_strides[1] + col * out_col_stride;
+
+            int64_t prev_ih = -1;
+            for (int64_t oh = 0; oh < out_height; ++oh) {
+              const int64_t ih = nearest_neighbor_compute_source_index(
+                  ratio_h, oh, in_height, out_height);
+              CTYPE* const out_row = out_plane + oh * out_strides[2];
+              if (ih == prev_ih && out_col_stride == 1) {
+                std::memcpy(
+                    out_row, out_row - out_strides[2], len * sizeof(CTYPE));
+                continue;
+              }
+              prev_ih = ih;
+
+              const CTYPE* const in_row = in_plane + ih * in_strides[2];
+              for (int64_t j = 0; j < len; ++j) {
+                out_row[j * out_col_stride] = in_row[in_offsets[j]];
+              }
+            }
+          }
+        }
+      });
+}
+
+} // namespace
+
+Tensor& opt_upsample_nearest2d_vec_out(
+    RuntimeContext& ctx,
+    const Tensor& in,
+    const optional<IntArrayRef> output_size,
+    const optional<exec_aten::ArrayRef<double>> scale_factors,
+    Tensor& out) {
+  ET_KERNEL_CHECK(
+      ctx,
+      check_upsample_nearest2d_args(in, output_size, scale_factors, out),
+      InvalidArgument,
+      out);
+
+  optional<double> scale_h;
+  optional<double> scale_w;
+  ET_KERNEL_CHECK_MSG(
+      ctx,
+      resize_upsample_2d(
+          in, output_size, scale_factors, scale_h, scale_w, out) == Error::Ok,
+      InvalidArgument,
+      out,
+      "Failed to resize output tensor");
+
+  const float ratio_h =
+      compute_scales_value<float>(scale_h, in.size(2), out.size(2));
+  const float ratio_w =
+      compute_scales_value<float>(scale_w, in.size(3), out.size(3));
+  const bool channels_last = in.size(1) > 1 && is_channels_last(in) &&
+      is_channels_last(out);
+
+  ET_SWITCH_REALH_TYPES(
+      in.scalar_type(), ctx, "upsample_nearest2d.vec_out", CTYPE, [&]() {
+        if (channels_last) {
+          upsample_nearest2d_channels_last<CTYPE>(in, ratio_h, ratio_w, out);
+        } else {
+          upsample_nearest2d_planar<CTYPE>(in, ratio_h, ratio_w, out);
+        }
+      });
+
+  return out;
+}
+
+} // namespace native
+} // namespace executor
+} // namespace torch
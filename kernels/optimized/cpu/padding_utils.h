@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+
+#include <executorch/kernels/optimized/cpu/parallel_utils.h>
+#include <executorch/kernels/optimized/vec/vec.h>
+#include <executorch/runtime/kernel/kernel_includes.h>
+
+namespace torch {
+namespace executor {
+namespace native {
+
+// Minimum number of output elements per task of the padding kernels.
+constexpr int64_t kPaddingMinTaskWork = 32768;
+
+/**
+ * Sets the size elements at out to value, a vector at a time.
+ */
+template <typename CTYPE>
+inline void vec_fill(CTYPE* out, int64_t size, CTYPE value) {
+  using Vec = executorch::vec::Vectorized<CTYPE>;
+  const Vec value_vec(value);
+  int64_t i = 0;
+  for (; i + Vec::size() <= size; i += Vec::size()) {
+    value_vec.store(out + i);
+  }
+  for (; i < size; ++i) {
+    out[i] = value;
+  }
+}
+
+template <>
+inline void vec_fill<bool>(bool* out, int64_t size, bool value) {
+  std::memset(out, value, size);
+}
+
+/**
+ * Pads the last n dimensions of in into out, where the output element at j
+ * along a padded dimension is read from the input element at
+ * padding_ix(j, in_size, pad_before), like pad1d(), pad2d() and pad3d() of
+ * padding_util.h. padding holds the padding before and after each of the n
+ * dimensions, starting from the last one.
+ *
+ * Each row of out along the last dimension is filled from one row of in: the
+ * elements that are not padding with a single memcpy, and the few on either
+ * side through padding_ix. The rows are split across threads when the
+ * threadpool is available.
+ */
+template <typename CTYPE, typename PaddingIx>
+void pad_last_dims(
+    const PaddingIx& padding_ix,
+    int64_t n,
+    const Tensor& in,
+    Tensor& out,
+    exec_aten::ArrayRef<int64_t> padding) {
+  if (out.numel() == 0) {
+    return;
+  }
+
+  const CTYPE* const in_data = in.const_data_ptr<CTYPE>();
+  CTYPE* const out_data = out.mutable_data_ptr<CTYPE>();
+
+  const int64_t ndim = in.dim();
+  const int64_t in_width = in.size(ndim - 1);
+  const int64_t out_width = out.size(ndim - 1);
+  const int64_t pad_left = padding[0];
+  const int64_t num_rows = out.numel() / out_width;
+  // Range of each output row copied as is from the input row. The padding can
+  // be negative, which crops the input instead.
+  const int64_t copy_begin =
+      std::min(std::max<int64_t>(0, pad_left), out_width);
+  const int64_t copy_end =
+      std::max(copy_begin, std::min(out_width, pad_left + in_width));
+
+  run_parallel(
+      num_rows,
+      out_width,
+      kPaddingMinTaskWork,
+      [&](int64_t begin, int64_t end) {
+        for (int64_t row = begin; row < end; ++row) {
+          // Find the input row: map the index of each padded dimension but
+          // the last through padding_ix, and keep the leading ones.
+          int64_t remainder = row;
+          int64_t in_row = 0;
+          int64_t in_stride = 1;
+          for (int64_t k = 1; k < n; ++k) {
+            const int64_t dim = ndim - 1 - k;
+            const int64_t j = remainder % out.size(dim);
+            remainder /= out.size(dim);
+            in_row += padding_ix(j, in.size(dim), padding[2 * k]) * in_stride;
+            in_stride *= in.size(dim);
+          }
+          in_row += remainder * in_stride;
+
+          const CTYPE* const in_row_data = in_data + in_row * in_width;
+          CTYPE* const out_row_data = out_data + row * out_width;
+          for (int64_t w = 0; w < copy_begin; ++w) {
+            out_row_data[w] = in_row_data[padding_ix(w, in_width, pad_left)];
+          }
+          std::memcpy(
+              out_row_data + copy_begin,
+              in_row_data + copy_begin - pad_left,
+              (copy_end - copy_begin) * sizeof(CTYPE));
+          for (int64_t w = copy_end; w < out_width; ++w) {
+            out_row_data[w] = in_row_data[padding_ix(w, in_width, pad_left)];
+          }
+        }
+      });
+}
+
+} // namespace native
+} // namespace executor
+} // namespace torch
@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+
+#ifdef ET_USE_THREADPOOL
+#include <executorch/extension/parallel/thread_parallel.h>
+#endif
+
+namespace torch {
+namespace executor {
+namespace native {
+
+/**
+ * Calls f(begin, end) on ranges that cover [0, num_items), from the threads of
+ * the threadpool when it is available (ET_USE_THREADPOOL is defined), with at
+ * least min_work / item_work items per range. item_work is the cost of one
+ * item, e.g. the number of output elements it computes. Without the
+ * threadpool, calls f(0, num_items) on the calling thread.
+ */
+template <typename Func>
+inline void run_parallel(
+    int64_t num_items,
+    int64_t item_work,
+    int64_t min_work,
+    const Func& f) {
+#ifdef ET_USE_THREADPOOL
+  const int64_t grain_size =
+      std::max<int64_t>(1, min_work / std::max<int64_t>(1, item_work));
+  torch::executor::parallel_for(0, num_items, grain_size, f);
+#else
+  (void)item_work;
+  (void)min_work;
+  f(0, num_items);
+#endif
+}
+
+} // namespace native
+} // namespace executor
+} // namespace torch
@@ -15,6 +15,23 @@ _OPTIMIZED_ATEN_OPS = (
             "//executorch/kernels/optimized:libblas",
         ],
     ),
+    op_target(
+        name = "op_cdist_forward",
+        deps = [
+            ":parallel_utils",
+            "//executorch/kernels/optimized:libblas",
+            "//executorch/kernels/portable/cpu/util:broadcast_util",
+            "//executorch/kernels/portable/cpu/util:distance_util",
+        ],
+    ),
+    op_target(
+        name = "op_constant_pad_nd",
+        deps = [
+            ":padding_utils",
+            "//executorch/kernels/portable/cpu:scalar_utils",
+            "//executorch/kernels/portable/cpu/util:kernel_ops_util",
+        ],
+    ),
     op_target(
         name = "op_div",
         deps = [
@@ -38,6 +55,18 @@ _OPTIMIZED_ATEN_OPS = (
             "//executorch/kernels/portable/cpu:scalar_utils",
         ],
     ),
+    op_target(
+        name = "op_linear_packed",
+        deps = [
+            ":tunable_param",
+        ],
+    ),
+    op_target(
+        name = "op_linear_sparse",
+        deps = [
+            ":parallel_utils",
+        ],
+    ),
     op_target(
         name = "op_log_softmax",
         deps = select({
@@ -65,6 +94,56 @@ _OPTIMIZED_ATEN_OPS = (
         ],
     ),
     op_target(name = "op_neg"),
+    op_target(
+        name = "op_nonzero",
+        deps = [
+            ":parallel_utils",
+            "//executorch/kernels/portable/cpu/util:index_util",
+            "//executorch/kernels/portable/cpu/util:kernel_ops_util",
+        ],
+    ),
+    op_target(
+        name = "op_reflection_pad1d",
+        deps = [
+            ":padding_utils",
+            "//executorch/kernels/portable/cpu/util:padding_util",
+        ],
+    ),
+    op_target(
+        name = "op_reflection_pad2d",
+        deps = [
+            ":padding_utils",
+            "//executorch/kernels/portable/cpu/util:padding_util",
+        ],
+    ),
+    op_target(
+        name = "op_reflection_pad3d",
+        deps = [
+            ":padding_utils",
+            "//executorch/kernels/portable/cpu/util:padding_util",
+        ],
+    ),
+    op_target(
+        name = "op_replication_pad1d",
+        deps = [
+            ":padding_utils",
+            "//executorch/kernels/portable/cpu/util:padding_util",
+        ],
+    ),
+    op_target(
+        name = "op_replication_pad2d",
+        deps = [
+            ":padding_utils",
+            "//executorch/kernels/portable/cpu/util:padding_util",
+        ],
+    ),
+    op_target(
+        name = "op_replication_pad3d",
+        deps = [
+            ":padding_utils",
+            "//executorch/kernels/portable/cpu/util:padding_util",
+        ],
+    ),
     op_target(
         name = "op_sub",
         deps = [
@@ -72,6 +151,20 @@ _OPTIMIZED_ATEN_OPS = (
             "//executorch/kernels/portable/cpu/util:broadcast_util",
         ],
     ),
+    op_target(
+        name = "op_upsample_bilinear2d",
+        deps = [
+            ":parallel_utils",
+            "//executorch/kernels/portable/cpu/util:upsample_util",
+        ],
+    ),
+    op_target(
+        name = "op_upsample_nearest2d",
+        deps = [
+            ":parallel_utils",
+            "//executorch/kernels/portable/cpu/util:upsample_util",
+        ],
+    ),
 )
 
 def define_common_targets():
@@ -107,3 +200,39 @@ def define_common_targets():
             "//executorch/kernels/optimized:libutils",
         ],
     )
+
+    runtime.cxx_library(
+        name = "padding_utils",
+        srcs = [],
+        exported_headers = ["padding_utils.h"],
+        visibility = ["//executorch/kernels/optimized/..."],
+        exported_deps = [
+            ":parallel_utils",
+            "//executorch/kernels/optimized:libvec",
+        ],
+    )
+
+    runtime.cxx_library(
+        name = "tunable_param",
+        srcs = ["tunable_param.cpp"],
+        exported_headers = ["tunable_param.h"],
+        visibility = [
+            "//executorch/...",
+            "@EXECUTORCH_CLIENTS",
+        ],
+        exported_deps = [
+            "//executorch/runtime/core:core",
+            "//executorch/runtime/platform:platform",
+        ],
+    )
+
+    runtime.cxx_library(
+        name = "parallel_utils",
+        srcs = [],
+        exported_headers = ["parallel_utils.h"],
+        visibility = ["//executorch/kernels/optimized/..."],
+        exported_deps = [
+            "//executorch/backends/xnnpack/threadpool:threadpool",
+            "//executorch/extension/parallel:thread_parallel",
+        ],
+    )
@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <executorch/kernels/optimized/cpu/tunable_param.h>
+
+#include <atomic>
+
+namespace torch {
+namespace executor {
+namespace tuning {
+
+namespace {
+
+// Constant-initialized, so that tuners may register from static initializers.
+std::atomic<KernelTuner*> registered_tuner{nullptr};
+
+} // namespace
+
+void set_kernel_tuner(KernelTuner* tuner) {
+  registered_tuner.store(tuner, std::memory_order_release);
+}
+
+KernelTuner* kernel_tuner() {
+  return registered_tuner.load(std::memory_order_acquire);
+}
+
+int64_t shape_bucket(int64_t size) {
+  if (size <= 0) {
+    return 0;
+  }
+  int64_t bucket = 1;
+  while (bucket < size) {
+    bucket <<= 1;
+  }
+  return bucket;
+}
+
+int64_t combine_buckets(std::initializer_list<int64_t> parts) {
+  // boost::hash_combine, widened to 64 bits. It must not change: the results
+  // are stored in cache files.
+  uint64_t combined = 0;
+  for (const int64_t part : parts) {
+    combined ^= static_cast<uint64_t>(part) + 0x9e3779b97f4a7c15ULL +
+        (combined << 12) + (combined >> 4);
+  }
+  return static_cast<int64_t>(combined);
+}
+
+} // namespace tuning
+} // namespace executor
+} // namespace torch
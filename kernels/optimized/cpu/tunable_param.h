@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <type_traits>
+
+#include <executorch/runtime/core/array_ref.h>
+#include <executorch/runtime/platform/assert.h>
+
+namespace torch {
+namespace executor {
+namespace tuning {
+
+class TunableParam;
+
+/**
+ * Where TunableParam::select() gets tuned values from. Kernels only depend on
+ * this interface: the implementation, which keeps the values per CPU model in
+ * a cache file and runs the benchmarks, lives in extension/kernel_tuning and
+ * registers itself with set_kernel_tuner(). Without a registered tuner,
+ * select() always returns the kernel's default.
+ */
+class KernelTuner {
+ public:
+  virtual ~KernelTuner() = default;
+
+  /**
+   * Returns true if no tuning run is needed for the parameter and bucket. If
+   * a tuned value is known, sets *value to it; otherwise leaves *value alone.
+   * Called on every select(), so it should not take a lock on the common path.
+   */
+  virtual bool find_cached(
+      const TunableParam& param,
+      int64_t bucket,
+      int64_t* value) = 0;
+
+  /**
+   * Benchmarks the candidates of the parameter by calling run(context, value),
+   * remembers the fastest one for the bucket, and returns it.
+   */
+  virtual int64_t tune(
+      const TunableParam& param,
+      int64_t bucket,
+      int64_t default_value,
+      void (*run)(void* context, int64_t value),
+      void* context) = 0;
+};
+
+/**
+ * Sets the tuner used by all TunableParams, or nullptr to only use defaults.
+ * The tuner must outlive every later select().
+ */
+void set_kernel_tuner(KernelTuner* tuner);
+
+/// Returns the tuner set by set_kernel_tuner(), or nullptr.
+KernelTuner* kernel_tuner();
+
+/**
+ * A kernel parameter that does not change the result of the kernel, only how
+ * fast it runs (a block size, a split size, a parallel grain size...), along
+ * with the values it may take.
+ *
+ * Kernels declare their parameters once, usually as function-local statics,
+ * and call select() on every invocation.
+ */
+class TunableParam {
+ public:
+  /// Maximum number of candidate values of a parameter.
+  static constexpr size_t kMaxCandidates = 8;
+
+  /**
+   * @param[in] kernel Name of the kernel, e.g. "llama::sdpa".
+   * @param[in] name Name of the parameter within the kernel.
+   * @param[in] candidates Values tried by a tuning run. At most
+   *     kMaxCandidates.
+   *
+   * kernel and name must outlive the TunableParam, and must not contain tabs
+   * or newlines.
+   */
+  TunableParam(
+      const char* kernel,
+      const char* name,
+      std::initializer_list<int64_t> candidates)
+      : kernel_(kernel), name_(name), num_candidates_(candidates.size()) {
+    ET_CHECK_MSG(
+        candidates.size() <= kMaxCandidates,
+        "Too many candidates for %s %s: %zu > %zu",
+        kernel,
+        name,
+        candidates.size(),
+        kMaxCandidates);
+    size_t i = 0;
+    for (const int64_t candidate : candidates) {
+      candidates_[i++] = candidate;
+    }
+  }
+
+  /**
+   * Returns the value to use for the given shape bucket.
+   *
+   * @param[in] bucket Shape bucket of the invocation, see shape_bucket().
+   * @param[in] default_value Value used when nothing is tuned for the bucket
+   *     and no tuning run is in progress.
+   * @param[in] run Callable taking an int64_t that runs the kernel once with
+   *     the given candidate value. It is only called during a tuning run; its
+   *     outputs are overwritten by the caller's final run with the selected
+   *     value. It is taken by reference and not copied, so that selecting a
+   *     tuned value does not allocate.
+   */
+  template <typename Run>
+  int64_t select(int64_t bucket, int64_t default_value, Run&& run) const {
+    KernelTuner* tuner = kernel_tuner();
+    int64_t value = default_value;
+    if (tuner == nullptr || tuner->find_cached(*this, bucket, &value)) {
+      return value;
+    }
+    return tuner->tune(
+        *this,
+        bucket,
+        default_value,
+        [](void* context, int64_t candidate) {
+          (*static_cast<std::remove_reference_t<Run>*>(context))(candidate);
+        },
+        &run);
+  }
+
+  const char* kernel() const {
+    return kernel_;
+  }
+
+  const char* name() const {
+    return name_;
+  }
+
+  ArrayRef<int64_t> candidates() const {
+    return {candidates_, num_candidates_};
+  }
+
+ private:
+  const char* kernel_;
+  const char* name_;
+  int64_t candidates_[kMaxCandidates];
+  size_t num_candidates_;
+};
+
+/**
+ * Returns the shape bucket for a size: the smallest power of two that is >=
+ * size, or 0 for sizes <= 0. Tuned values are shared by all sizes of a bucket.
+ */
+int64_t shape_bucket(int64_t size);
+
+/**
+ * Combines several shape buckets and other values the best parameter value may
+ * depend on (a dtype, a flag) into one bucket for select(). The result is a
+ * hash: two different combinations may share a bucket, which only makes one of
+ * them use a value tuned for the other.
+ */
+int64_t combine_buckets(std::initializer_list<int64_t> parts);
+
+} // namespace tuning
+} // namespace executor
+} // namespace torch
@@ -19,6 +19,14 @@ def define_common_targets():
         ],
     )
 
+    runtime.export_file(
+        name = "prepacked.yaml",
+        visibility = [
+            "//executorch/...",
+            "@EXECUTORCH_CLIENTS",
+        ],
+    )
+
     runtime.cxx_library(
         name = "optimized_operators",
         srcs = [],
@@ -39,6 +47,14 @@ def define_common_targets():
         ],
     )
 
+    et_operator_library(
+        name = "prepacked_oplist",
+        ops_schema_yaml_target = ":prepacked.yaml",
+        visibility = [
+            "@EXECUTORCH_CLIENTS",
+        ],
+    )
+
     # Used mainly for operator testing. In practice, a generated lib specific
     # to a project should be created that contains only the required operators
     # for a particular model.
@@ -47,8 +63,11 @@ def define_common_targets():
         deps = [
             ":optimized_oplist",
             ":optimized_operators",
+            ":prepacked_oplist",
         ],
         functions_yaml_target = ":optimized.yaml",
+        custom_ops_yaml_target = ":prepacked.yaml",
+        custom_ops_requires_aot_registration = False,
         define_static_targets = True,
         visibility = [
             "//executorch/...",
@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <executorch/kernels/optimized/NativeFunctions.h> // Declares the specialized kernels
+#include <executorch/runtime/core/exec_aten/exec_aten.h>
+#include <executorch/runtime/core/exec_aten/testing_util/tensor_factory.h>
+#include <executorch/runtime/core/exec_aten/testing_util/tensor_util.h>
+#include <executorch/runtime/platform/runtime.h>
+
+#include <gtest/gtest.h>
+
+using namespace ::testing;
+using exec_aten::RuntimeContext;
+using exec_aten::Scalar;
+using exec_aten::ScalarType;
+using exec_aten::Tensor;
+using torch::executor::testing::TensorFactory;
+
+namespace native = torch::executor::native;
+
+class DtypeSpecializedKernelsTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    // Since these tests cause ET_LOG to be called, the PAL must be initialized
+    // first.
+    torch::executor::runtime_init();
+  }
+};
+
+TEST_F(DtypeSpecializedKernelsTest, AddFloatMatchesFallback) {
+  TensorFactory<ScalarType::Float> tf;
+
+  Tensor a = tf.make({2, 3}, {1, 2, 3, 4, 5, 6});
+  Tensor b = tf.make({2, 3}, {0.5, 1, 1.5, 2, 2.5, 3});
+  Tensor out = tf.zeros({2, 3});
+  Tensor expected = tf.zeros({2, 3});
+
+  RuntimeContext ctx{};
+  native::opt_add_out_float(ctx, a, b, Scalar(2.0), out);
+  native::opt_add_out(ctx, a, b, Scalar(2.0), expected);
+
+  EXPECT_EQ(ctx.failure_state(), torch::executor::Error::Ok);
+  EXPECT_TENSOR_CLOSE(out, tf.make({2, 3}, {2, 4, 6, 8, 10, 12}));
+  EXPECT_TENSOR_CLOSE(out, expected);
+}
+
+TEST_F(DtypeSpecializedKernelsTest, AddLongWithIntegralAlpha) {
+  TensorFactory<ScalarType::Long> tf;
+
+  Tensor a = tf.make({4}, {1, 2, 3, 4});
+  Tensor b = tf.make({4}, {10, 20, 30, 40});
+  Tensor out = tf.zeros({4});
+
+  RuntimeContext ctx{};
+  native::opt_add_out_long(ctx, a, b, Scalar(3), out);
+
+  EXPECT_EQ(ctx.failure_state(), torch::executor::Error::Ok);
+  EXPECT_TENSOR_EQ(out, tf.make({4}, {31, 62, 93, 124}));
+}
+
+TEST_F(DtypeSpecializedKernelsTest, AddBroadcastGoesToFallback) {
+  TensorFactory<ScalarType::Double> tf;
+
+  // Same rank, so the specialization is bound, but the shapes differ.
+  Tensor a = tf.make({2, 2}, {1, 2, 3, 4});
+  Tensor b = tf.make({1, 2}, {10, 20});
+  Tensor out = tf.zeros({2, 2});
+
+  RuntimeContext ctx{};
+  native::opt_add_out_double(ctx, a, b, Scalar(1), out);
+
+  EXPECT_EQ(ctx.failure_state(), torch::executor::Error::Ok);
+  EXPECT_TENSOR_CLOSE(out, tf.make({2, 2}, {11, 22, 13, 24}));
+}
+
+TEST_F(DtypeSpecializedKernelsTest, AddResizesOutput) {
+  TensorFactory<ScalarType::Float> tf;
+
+  Tensor a = tf.ones({3, 2});
+  Tensor b = tf.ones({3, 2});
+  Tensor out =
+      tf.zeros({4, 4}, torch::executor::TensorShapeDynamism::DYNAMIC_BOUND);
+
+  RuntimeContext ctx{};
+  native::opt_add_out_float(ctx, a, b, Scalar(1), out);
+
+  EXPECT_EQ(ctx.failure_state(), torch::executor::Error::Ok);
+  EXPECT_TENSOR_CLOSE(out, tf.full({3, 2}, 2));
+}
+
+TEST_F(DtypeSpecializedKernelsTest, MulIntMatchesFallback) {
+  TensorFactory<ScalarType::Int> tf;
+
+  Tensor a = tf.make({2, 2}, {1, -2, 3, -4});
+  Tensor b = tf.make({2, 2}, {5, 6, -7, 8});
+  Tensor out = tf.zeros({2, 2});
+  Tensor expected = tf.zeros({2, 2});
+
+  RuntimeContext ctx{};
+  native::opt_mul_out_int(ctx, a, b, out);
+  native::opt_mul_out(ctx, a, b, expected);
+
+  EXPECT_EQ(ctx.failure_state(), torch::executor::Error::Ok);
+  EXPECT_TENSOR_EQ(out, tf.make({2, 2}, {5, -12, -21, -32}));
+  EXPECT_TENSOR_EQ(out, expected);
+}
+
+TEST_F(DtypeSpecializedKernelsTest, MulBroadcastGoesToFallback) {
+  TensorFactory<ScalarType::Float> tf;
+
+  Tensor a = tf.make({2, 2}, {1, 2, 3, 4});
+  Tensor b = tf.make({2, 1}, {2, 3});
+  Tensor out = tf.zeros({2, 2});
+
+  RuntimeContext ctx{};
+  native::opt_mul_out_float(ctx, a, b, out);
+
+  EXPECT_EQ(ctx.failure_state(), torch::executor::Error::Ok);
+  EXPECT_TENSOR_CLOSE(out, tf.make({2, 2}, {2, 4, 9, 12}));
+}
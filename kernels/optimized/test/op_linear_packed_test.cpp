@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <executorch/kernels/optimized/NativeFunctions.h> // Declares the prepacked operator
+#include <executorch/runtime/core/exec_aten/exec_aten.h>
+#include <executorch/runtime/core/exec_aten/testing_util/tensor_factory.h>
+#include <executorch/runtime/core/exec_aten/testing_util/tensor_util.h>
+#include <executorch/runtime/platform/runtime.h>
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+using namespace ::testing;
+using exec_aten::optional;
+using exec_aten::RuntimeContext;
+using exec_aten::ScalarType;
+using exec_aten::Tensor;
+using torch::executor::native::opt_prepacked_linear_out;
+using torch::executor::testing::TensorFactory;
+
+namespace {
+
+// Must match PANEL_WIDTH in exir/passes/prepack_weights_pass.py.
+constexpr int32_t kPanelWidth = 8;
+
+// Same layout as pack_linear_weight() in exir/passes/prepack_weights_pass.py.
+std::vector<float>
+pack(const std::vector<float>& weight, int32_t n_size, int32_t k_size) {
+  const int32_t num_panels = (n_size + kPanelWidth - 1) / kPanelWidth;
+  std::vector<float> packed(num_panels * k_size * kPanelWidth, 0.0f);
+  for (int32_t n = 0; n < n_size; ++n) {
+    for (int32_t k = 0; k < k_size; ++k) {
+      const int32_t p = n / kPanelWidth;
+      packed[(p * k_size + k) * kPanelWidth + n % kPanelWidth] =
+          weight[n * k_size + k];
+    }
+  }
+  return packed;
+}
+
+} // namespace
+
+class OpPrepackedLinearTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    // Since these tests cause ET_LOG to be called, the PAL must be initialized
+    // first.
+    torch::executor::runtime_init();
+  }
+
+  // Compares against a naive in @ weight.T + bias for M rows, exercising both
+  // the blocked rows and the tail rows, and a partially filled last panel.
+  void
+  test_shape(int32_t m_size, int32_t k_size, int32_t n_size, bool use_bias) {
+    TensorFactory<ScalarType::Float> tf;
+
+    std::vector<float> in_data(m_size * k_size);
+    for (size_t i = 0; i < in_data.size(); ++i) {
+      in_data[i] = static_cast<float>(i % 7) - 3.0f;
+    }
+    std::vector<float> weight(n_size * k_size);
+    for (size_t i = 0; i < weight.size(); ++i) {
+      weight[i] = 0.25f * static_cast<float>(i % 5) - 0.5f;
+    }
+    std::vector<float> bias_data(n_size);
+    for (int32_t i = 0; i < n_size; ++i) {
+      bias_data[i] = 0.1f * i;
+    }
+
+    std::vector<float> expected_data(m_size * n_size);
+    for (int32_t m = 0; m < m_size; ++m) {
+      for (int32_t n = 0; n < n_size; ++n) {
+        float acc = use_bias ? bias_data[n] : 0.0f;
+        for (int32_t k = 0; k < k_size; ++k) {
+          acc += in_data[m * k_size + k] * weight[n * k_size + k];
+        }
+        expected_data[m * n_size + n] = acc;
+      }
+    }
+
+    const int32_t num_panels = (n_size + kPanelWidth - 1) / kPanelWidth;
+    Tensor in = tf.make({m_size, k_size}, in_data);
+    Tensor packed_weight = tf.make(
+        {num_panels, k_size, kPanelWidth}, pack(weight, n_size, k_size));
+    optional<Tensor> bias;
+    if (use_bias) {
+      bias = tf.make({n_size}, bias_data);
+    }
+    Tensor out = tf.zeros({m_size, n_size});
+
+    RuntimeContext ctx{};
+    opt_prepacked_linear_out(ctx, in, packed_weight, bias, n_size, out);
+
+    EXPECT_EQ(ctx.failure_state(), torch::executor::Error::Ok);
+    EXPECT_TENSOR_CLOSE(out, tf.make({m_size, n_size}, expected_data));
+  }
+};
+
+TEST_F(OpPrepackedLinearTest, SinglePanel) {
+  test_shape(/*m_size=*/4, /*k_size=*/3, /*n_size=*/8, /*use_bias=*/false);
+}
+
+TEST_F(OpPrepackedLinearTest, PartialPanelAndTailRows) {
+  test_shape(/*m_size=*/7, /*k_size=*/5, /*n_size=*/11, /*use_bias=*/true);
+}
+
+TEST_F(OpPrepackedLinearTest, SingleRow) {
+  test_shape(/*m_size=*/1, /*k_size=*/16, /*n_size=*/3, /*use_bias=*/true);
+}
+
+TEST_F(OpPrepackedLinearTest, BatchedInput) {
+  TensorFactory<ScalarType::Float> tf;
+
+  // [2, 1, 2] input against a 2x2 identity weight.
+  Tensor in = tf.make({2, 1, 2}, {1, 2, 3, 4});
+  std::vector<float> packed(1 * 2 * kPanelWidth, 0.0f);
+  packed[0 * kPanelWidth + 0] = 1;
+  packed[1 * kPanelWidth + 1] = 1;
+  Tensor packed_weight = tf.make({1, 2, kPanelWidth}, packed);
+  Tensor out = tf.zeros({2, 1, 2});
+
+  RuntimeContext ctx{};
+  opt_prepacked_linear_out(ctx, in, packed_weight, {}, 2, out);
+
+  EXPECT_TENSOR_EQ(out, tf.make({2, 1, 2}, {1, 2, 3, 4}));
+}
+
+TEST_F(OpPrepackedLinearTest, MismatchedPanelCountFails) {
+  TensorFactory<ScalarType::Float> tf;
+
+  Tensor in = tf.ones({1, 2});
+  // 9 output features need two panels.
+  Tensor packed_weight = tf.zeros({1, 2, kPanelWidth});
+  Tensor out = tf.zeros({1, 9});
+
+  RuntimeContext ctx{};
+  opt_prepacked_linear_out(ctx, in, packed_weight, {}, 9, out);
+
+  EXPECT_NE(ctx.failure_state(), torch::executor::Error::Ok);
+}
+
+TEST_F(OpPrepackedLinearTest, MismatchedInFeaturesFails) {
+  TensorFactory<ScalarType::Float> tf;
+
+  Tensor in = tf.ones({1, 3});
+  Tensor packed_weight = tf.zeros({1, 2, kPanelWidth});
+  Tensor out = tf.zeros({1, 4});
+
+  RuntimeContext ctx{};
+  opt_prepacked_linear_out(ctx, in, packed_weight, {}, 4, out);
+
+  EXPECT_NE(ctx.failure_state(), torch::executor::Error::Ok);
+}
@@ -0,0 +1,466 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <executorch/kernels/optimized/NativeFunctions.h> // Declares the prepacked operators
+#include <executorch/runtime/core/exec_aten/exec_aten.h>
+#include <executorch/runtime/core/exec_aten/testing_util/tensor_factory.h>
+#include <executorch/runtime/core/exec_aten/testing_util/tensor_util.h>
+#include <executorch/runtime/platform/runtime.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+using namespace ::testing;
+using exec_aten::optional;
+using exec_aten::RuntimeContext;
+using exec_aten::ScalarType;
+using exec_aten::Tensor;
+using torch::executor::native::opt_prepacked_sparse_linear_2_4_out;
+using torch::executor::native::opt_prepacked_sparse_linear_block_out;
+using torch::executor::testing::TensorFactory;
+
+namespace {
+
+// Must match BLOCK_SIZE in exir/passes/sparse_weights_pass.py.
+constexpr int32_t kBlockSize = 16;
+
+// Same layout as pack_2_4_weight() in exir/passes/sparse_weights_pass.py: the
+// nonzero weights of each group of 4 come first, padded with zero weights,
+// and the first two are kept in increasing position.
+void pack_2_4(
+    const std::vector<float>& weight,
+    int32_t n_size,
+    int32_t k_size,
+    std::vector<float>& values,
+    std::vector<uint8_t>& metadata) {
+  const int32_t num_groups = k_size / 4;
+  const int32_t metadata_per_row = (num_groups + 1) / 2;
+  values.assign(n_size * num_groups * 2, 0.0f);
+  metadata.assign(n_size * metadata_per_row, 0);
+  for (int32_t n = 0; n < n_size; ++n) {
+    for (int32_t g = 0; g < num_groups; ++g) {
+      const float* group = weight.data() + n * k_size + g * 4;
+      std::vector<int32_t> positions;
+      for (int32_t i = 0; i < 4; ++i) {
+        if (group[i] != 0) {
+          positions.push_back(i);
+        }
+      }
+      for (int32_t i = 0; i < 4; ++i) {
+        if (group[i] == 0) {
+          positions.push_back(i);
+        }
+      }
+      positions.resize(2);
+      std::sort(positions.begin(), positions.end());
+      values[(n * num_groups + g) * 2] = group[positions[0]];
+      values[(n * num_groups + g) * 2 + 1] = group[positions[1]];
+      metadata[n * metadata_per_row + g / 2] |=
+          (positions[0] | positions[1] << 2) << (g % 2 * 4);
+    }
+  }
+}
+
+// Same layout as pack_block_sparse_weight() in
+// exir/passes/sparse_weights_pass.py.
+void pack_block(
+    const std::vector<float>& weight,
+    int32_t n_size,
+    int32_t k_size,
+    std::vector<float>& values,
+    std::vector<int32_t>& col_indices,
+    std::vector<int32_t>& row_offsets) {
+  const int32_t num_blocks = (n_size + kBlockSize - 1) / kBlockSize;
+  values.clear();
+  col_indices.clear();
+  row_offsets.assign(1, 0);
+  for (int32_t b = 0; b < num_blocks; ++b) {
+    for (int32_t k = 0; k < k_size; ++k) {
+      std::vector<float> block(kBlockSize, 0.0f);
+      bool kept = false;
+      for (int32_t j = 0; j < kBlockSize && b * kBlockSize + j < n_size; ++j) {
+        block[j] = weight[(b * kBlockSize + j) * k_size + k];
+        kept = kept || block[j] != 0;
+      }
+      if (kept) {
+        values.insert(values.end(), block.begin(), block.end());
+        col_indices.push_back(k);
+      }
+    }
+    row_offsets.push_back(col_indices.size());
+  }
+}
+
+// A weight where each group of 4 input features keeps at most 2 weights. Some
+// groups keep fewer. Weights are small integers, so they are exact in int8.
+std::vector<float> make_2_4_weight(int32_t n_size, int32_t k_size) {
+  std::vector<float> weight(n_size * k_size, 0.0f);
+  for (int32_t n = 0; n < n_size; ++n) {
+    for (int32_t g = 0; g < k_size / 4; ++g) {
+      const int32_t kept = (n + g) % 5 == 0 ? 1 : 2;
+      for (int32_t i = 0; i < kept; ++i) {
+        const int32_t position = (n * 3 + g + i * (1 + g % 3)) % 4;
+        weight[n * k_size + g * 4 + position] =
+            static_cast<float>((n * 7 + g * 3 + i) % 9) - 4.0f;
+      }
+    }
+  }
+  return weight;
+}
+
+// A weight with about a third of its kBlockSize x 1 blocks kept.
+std::vector<float> make_block_weight(int32_t n_size, int32_t k_size) {
+  std::vector<float> weight(n_size * k_size, 0.0f);
+  for (int32_t n = 0; n < n_size; ++n) {
+    for (int32_t k = 0; k < k_size; ++k) {
+      if ((n / kBlockSize * 5 + k * 7) % 3 == 0) {
+        weight[n * k_size + k] = static_cast<float>((n + 2 * k) % 7) - 3.0f;
+      }
+    }
+  }
+  return weight;
+}
+
+} // namespace
+
+class OpSparseLinearTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    // Since these tests cause ET_LOG to be called, the PAL must be initialized
+    // first.
+    torch::executor::runtime_init();
+  }
+
+  // Returns in @ weight.T * scales + bias.
+  std::vector<float> reference(
+      const std::vector<float>& in,
+      const std::vector<float>& weight,
+      const std::vector<float>& scales,
+      const std::vector<float>& bias,
+      int32_t m_size,
+      int32_t k_size,
+      int32_t n_size) {
+    std::vector<float> out(m_size * n_size);
+    for (int32_t m = 0; m < m_size; ++m) {
+      for (int32_t n = 0; n < n_size; ++n) {
+        float acc = 0.0f;
+        for (int32_t k = 0; k < k_size; ++k) {
+          acc += in[m * k_size + k] * weight[n * k_size + k];
+        }
+        out[m * n_size + n] = acc * (scales.empty() ? 1.0f : scales[n]) +
+            (bias.empty() ? 0.0f : bias[n]);
+      }
+    }
+    return out;
+  }
+
+  void make_inputs(
+      int32_t m_size,
+      int32_t k_size,
+      int32_t n_size,
+      bool use_scales,
+      bool use_bias,
+      std::vector<float>& in,
+      std::vector<float>& scales,
+      std::vector<float>& bias) {
+    in.resize(m_size * k_size);
+    for (size_t i = 0; i < in.size(); ++i) {
+      in[i] = 0.125f * static_cast<float>(i % 11) - 0.5f;
+    }
+    scales.clear();
+    if (use_scales) {
+      for (int32_t n = 0; n < n_size; ++n) {
+        scales.push_back(0.01f * (n % 4 + 1));
+      }
+    }
+    bias.clear();
+    if (use_bias) {
+      for (int32_t n = 0; n < n_size; ++n) {
+        bias.push_back(0.1f * n);
+      }
+    }
+  }
+
+  // Checks the 2:4 kernel against a dense in @ weight.T, with float values,
+  // or with int8 values and per output feature scales.
+  void test_2_4(
+      int32_t m_size,
+      int32_t k_size,
+      int32_t n_size,
+      bool use_int8,
+      bool use_bias) {
+    TensorFactory<ScalarType::Float> tf;
+    TensorFactory<ScalarType::Char> tf_char;
+    TensorFactory<ScalarType::Byte> tf_byte;
+
+    std::vector<float> in_data, scales, bias_data;
+    make_inputs(
+        m_size, k_size, n_size, use_int8, use_bias, in_data, scales, bias_data);
+    const std::vector<float> weight = make_2_4_weight(n_size, k_size);
+    std::vector<float> values_data;
+    std::vector<uint8_t> metadata_data;
+    pack_2_4(weight, n_size, k_size, values_data, metadata_data);
+
+    Tensor in = tf.make({m_size, k_size}, in_data);
+    const int32_t num_groups = k_size / 4;
+    Tensor values = use_int8
+        ? tf_char.make(
+              {n_size, num_groups * 2},
+              std::vector<int8_t>(values_data.begin(), values_data.end()))
+        : tf.make({n_size, num_groups * 2}, values_data);
+    Tensor metadata =
+        tf_byte.make({n_size, (num_groups + 1) / 2}, metadata_data);
+    optional<Tensor> weight_scales;
+    if (use_int8) {
+      weight_scales = tf.make({n_size}, scales);
+    }
+    optional<Tensor> bias;
+    if (use_bias) {
+      bias = tf.make({n_size}, bias_data);
+    }
+    Tensor out = tf.zeros({m_size, n_size});
+
+    RuntimeContext ctx{};
+    opt_prepacked_sparse_linear_2_4_out(
+        ctx, in, values, metadata, weight_scales, bias, out);
+
+    EXPECT_EQ(ctx.failure_state(), torch::executor::Error::Ok);
+    EXPECT_TENSOR_CLOSE(
+        out,
+        tf.make(
+            {m_size, n_size},
+            reference(
+                in_data, weight, scales, bias_data, m_size, k_size, n_size)));
+  }
+
+  // Checks the block sparse kernel against a dense in @ weight.T.
+  void test_block(
+      int32_t m_size,
+      int32_t k_size,
+      int32_t n_size,
+      bool use_int8,
+      bool use_bias) {
+    TensorFactory<ScalarType::Float> tf;
+    TensorFactory<ScalarType::Char> tf_char;
+    TensorFactory<ScalarType::Int> tf_int;
+
+    std::vector<float> in_data, scales, bias_data;
+    make_inputs(
+        m_size, k_size, n_size, use_int8, use_bias, in_data, scales, bias_data);
+    const std::vector<float> weight = make_block_weight(n_size, k_size);
+    std::vector<float> values_data;
+    std::vector<int32_t> col_data, offsets_data;
+    pack_block(weight, n_size, k_size, values_data, col_data, offsets_data);
+
+    Tensor in = tf.make({m_size, k_size}, in_data);
+    const int32_t num_kept = col_data.size();
+    Tensor values = use_int8
+        ? tf_char.make(
+              {num_kept, kBlockSize},
+              std::vector<int8_t>(values_data.begin(), values_data.end()))
+        : tf.make({num_kept, kBlockSize}, values_data);
+    Tensor col_indices = tf_int.make({num_kept}, col_data);
+    Tensor row_offsets = tf_int.make(
+        {static_cast<int32_t>(offsets_data.size())}, offsets_data);
+    optional<Tensor> weight_scales;
+    if (use_int8) {
+      weight_scales = tf.make({n_size}, scales);
+    }
+    optional<Tensor> bias;
+    if (use_bias) {
+      bias = tf.make({n_size}, bias_data);
+    }
+    Tensor out = tf.zeros({m_size, n_size});
+
+    RuntimeContext ctx{};
+    opt_prepacked_sparse_linear_block_out(
+        ctx,
+        in,
+        values,
+        col_indices,
+        row_offsets,
+        weight_scales,
+        bias,
+        n_size,
+        out);
+
+    EXPECT_EQ(ctx.failure_state(), torch::executor::Error::Ok);
+    EXPECT_TENSOR_CLOSE(
+        out,
+        tf.make(
+            {m_size, n_size},
+            reference(
+                in_data, weight, scales, bias_data, m_size, k_size, n_size)));
+  }
+};
+
+TEST_F(OpSparseLinearTest, TwoFourSingleRow) {
+  test_2_4(/*m_size=*/1, /*k_size=*/16, /*n_size=*/3, false, true);
+  // 8 output features at a time, then 3 one at a time.
+  test_2_4(/*m_size=*/1, /*k_size=*/20, /*n_size=*/19, false, true);
+}
+
+TEST_F(OpSparseLinearTest, TwoFourOddGroupCountAndTailRows) {
+  // 3 groups leave the high nibble of the last metadata byte unused. 13 rows
+  // are one vector of rows, one block of 4 rows and a single row.
+  test_2_4(/*m_size=*/13, /*k_size=*/12, /*n_size=*/5, false, false);
+}
+
+TEST_F(OpSparseLinearTest, TwoFourSeveralTiles) {
+  // 1032 input features span three tiles of the vectorized kernel.
+  test_2_4(/*m_size=*/17, /*k_size=*/1032, /*n_size=*/6, false, true);
+}
+
+TEST_F(OpSparseLinearTest, TwoFourInt8) {
+  test_2_4(/*m_size=*/11, /*k_size=*/24, /*n_size=*/7, true, true);
+  test_2_4(/*m_size=*/1, /*k_size=*/24, /*n_size=*/10, true, true);
+  test_2_4(/*m_size=*/9, /*k_size=*/520, /*n_size=*/4, true, false);
+}
+
+TEST_F(OpSparseLinearTest, BlockPartialLastBlock) {
+  // 37 output features fill two blocks and part of a third.
+  test_block(/*m_size=*/6, /*k_size=*/20, /*n_size=*/37, false, true);
+}
+
+TEST_F(OpSparseLinearTest, BlockSingleRow) {
+  test_block(/*m_size=*/1, /*k_size=*/64, /*n_size=*/16, false, false);
+}
+
+TEST_F(OpSparseLinearTest, BlockInt8) {
+  test_block(/*m_size=*/9, /*k_size=*/33, /*n_size=*/40, true, true);
+}
+
+TEST_F(OpSparseLinearTest, BlockEmptyRowBlock) {
+  TensorFactory<ScalarType::Float> tf;
+  TensorFactory<ScalarType::Int> tf_int;
+
+  // The second block of output features has no kept weights, so it is just
+  // the bias.
+  Tensor in = tf.make({1, 2}, {1, 2});
+  Tensor values = tf.ones({1, kBlockSize});
+  Tensor col_indices = tf_int.make({1}, {1});
+  Tensor row_offsets = tf_int.make({3}, {0, 1, 1});
+  Tensor bias = tf.full({18}, 0.5);
+  Tensor out = tf.zeros({1, 18});
+
+  RuntimeContext ctx{};
+  opt_prepacked_sparse_linear_block_out(
+      ctx, in, values, col_indices, row_offsets, {}, bias, 18, out);
+
+  std::vector<float> expected(18, 2.5f);
+  expected[16] = expected[17] = 0.5f;
+  EXPECT_TENSOR_EQ(out, tf.make({1, 18}, expected));
+}
+
+TEST_F(OpSparseLinearTest, BatchedInput) {
+  TensorFactory<ScalarType::Float> tf;
+  TensorFactory<ScalarType::Byte> tf_byte;
+
+  // [2, 1, 4] input against a 2x4 weight that keeps positions 0 and 2 of
+  // the first feature, and 1 and 3 of the second.
+  Tensor in = tf.make({2, 1, 4}, {1, 2, 3, 4, 5, 6, 7, 8});
+  Tensor values = tf.make({2, 2}, {1, 1, 1, -1});
+  Tensor metadata = tf_byte.make({2, 1}, {0 | 2 << 2, 1 | 3 << 2});
+  Tensor out = tf.zeros({2, 1, 2});
+
+  RuntimeContext ctx{};
+  opt_prepacked_sparse_linear_2_4_out(ctx, in, values, metadata, {}, {}, out);
+
+  EXPECT_TENSOR_EQ(out, tf.make({2, 1, 2}, {4, -2, 12, -2}));
+}
+
+TEST_F(OpSparseLinearTest, TwoFourMismatchedInFeaturesFails) {
+  TensorFactory<ScalarType::Float> tf;
+  TensorFactory<ScalarType::Byte> tf_byte;
+
+  Tensor in = tf.ones({1, 8});
+  // Two values per output feature only hold 4 input features.
+  Tensor values = tf.ones({1, 2});
+  Tensor metadata = tf_byte.zeros({1, 1});
+  Tensor out = tf.zeros({1, 1});
+
+  RuntimeContext ctx{};
+  opt_prepacked_sparse_linear_2_4_out(ctx, in, values, metadata, {}, {}, out);
+
+  EXPECT_NE(ctx.failure_state(), torch::executor::Error::Ok);
+}
+
+TEST_F(OpSparseLinearTest, Int8WithoutScalesFails) {
+  TensorFactory<ScalarType::Float> tf;
+  TensorFactory<ScalarType::Char> tf_char;
+  TensorFactory<ScalarType::Byte> tf_byte;
+
+  Tensor in = tf.ones({1, 4});
+  Tensor values = tf_char.ones({1, 2});
+  Tensor metadata = tf_byte.zeros({1, 1});
+  Tensor out = tf.zeros({1, 1});
+
+  RuntimeContext ctx{};
+  opt_prepacked_sparse_linear_2_4_out(ctx, in, values, metadata, {}, {}, out);
+
+  EXPECT_NE(ctx.failure_state(), torch::executor::Error::Ok);
+}
+
+TEST_F(OpSparseLinearTest, BlockColumnOutOfBoundsFails) {
+  TensorFactory<ScalarType::Float> tf;
+  TensorFactory<ScalarType::Int> tf_int;
+
+  Tensor in = tf.ones({1, 2});
+  Tensor values = tf.ones({1, kBlockSize});
+  Tensor col_indices = tf_int.make({1}, {2});
+  Tensor row_offsets = tf_int.make({2}, {0, 1});
+  Tensor out = tf.zeros({1, kBlockSize});
+
+  RuntimeContext ctx{};
+  opt_prepacked_sparse_linear_block_out(
+      ctx, in, values, col_indices, row_offsets, {}, {}, kBlockSize, out);
+
+  EXPECT_NE(ctx.failure_state(), torch::executor::Error::Ok);
+}
+
+TEST_F(OpSparseLinearTest, BlockColumnOutOfBoundsFailsAfterValidatedCall) {
+  TensorFactory<ScalarType::Float> tf;
+  TensorFactory<ScalarType::Int> tf_int;
+
+  Tensor in = tf.ones({1, 2});
+  Tensor values = tf.ones({1, kBlockSize});
+  Tensor row_offsets = tf_int.make({2}, {0, 1});
+  Tensor out = tf.zeros({1, kBlockSize});
+
+  RuntimeContext ctx{};
+  opt_prepacked_sparse_linear_block_out(
+      ctx,
+      in,
+      values,
+      tf_int.make({1}, {1}),
+      row_offsets,
+      {},
+      {},
+      kBlockSize,
+      out);
+  EXPECT_EQ(ctx.failure_state(), torch::executor::Error::Ok);
+
+  // Same dtypes and shapes as the valid call: a validate-once Method would
+  // tell the kernel that its arguments were already validated.
+  RuntimeContext skip_ctx(
+      /*event_tracer=*/nullptr, /*skip_arg_validation=*/true);
+  opt_prepacked_sparse_linear_block_out(
+      skip_ctx,
+      in,
+      values,
+      tf_int.make({1}, {2}),
+      row_offsets,
+      {},
+      {},
+      kBlockSize,
+      out);
+  EXPECT_NE(skip_ctx.failure_state(), torch::executor::Error::Ok);
+}
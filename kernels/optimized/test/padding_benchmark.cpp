@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+/**
+ * @file
+ *
+ * Measures the padding kernels, portable against optimized, on the shapes of
+ * the CNN and audio models that pad every layer. Reports the time per call
+ * and the bandwidth, as the bytes read and written per second, of each.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <vector>
+
+#include <executorch/kernels/optimized/NativeFunctions.h>
+#include <executorch/kernels/portable/NativeFunctions.h>
+#include <executorch/runtime/core/exec_aten/exec_aten.h>
+#include <executorch/runtime/core/exec_aten/testing_util/tensor_factory.h>
+#include <executorch/runtime/platform/assert.h>
+#include <executorch/runtime/platform/runtime.h>
+
+using exec_aten::ArrayRef;
+using exec_aten::RuntimeContext;
+using exec_aten::ScalarType;
+using exec_aten::Tensor;
+using torch::executor::testing::TensorFactory;
+namespace native = torch::executor::native;
+
+namespace {
+
+constexpr int kIterations = 20;
+
+using PadFn = std::function<
+    Tensor&(RuntimeContext&, const Tensor&, ArrayRef<int64_t>, Tensor&)>;
+
+// Returns the average time of a call to fn, in ms.
+double time_ms(
+    const PadFn& fn,
+    const Tensor& in,
+    ArrayRef<int64_t> pad,
+    const std::vector<int32_t>& out_sizes) {
+  TensorFactory<ScalarType::Float> tf;
+  Tensor out = tf.zeros(out_sizes);
+  RuntimeContext ctx;
+  fn(ctx, in, pad, out);
+  ET_CHECK_MSG(ctx.failure_state() == torch::executor::Error::Ok, "Failed");
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < kIterations; ++i) {
+    fn(ctx, in, pad, out);
+  }
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::steady_clock::now() - start)
+             .count() /
+      kIterations;
+}
+
+void run(
+    const char* name,
+    const PadFn& portable,
+    const PadFn& optimized,
+    const std::vector<int32_t>& sizes,
+    const std::vector<int64_t>& pad) {
+  TensorFactory<ScalarType::Float> tf;
+  const Tensor in = tf.ones(sizes);
+  std::vector<int32_t> out_sizes = sizes;
+  int64_t out_numel = 1;
+  for (size_t d = 0; d < sizes.size(); ++d) {
+    const size_t k = sizes.size() - 1 - d;
+    if (k < pad.size() / 2) {
+      out_sizes[d] += pad[2 * k] + pad[2 * k + 1];
+    }
+    out_numel *= out_sizes[d];
+  }
+  const double mbytes = (in.numel() + out_numel) * sizeof(float) / 1e6;
+
+  const ArrayRef<int64_t> pad_ref(pad.data(), pad.size());
+  const double portable_ms = time_ms(portable, in, pad_ref, out_sizes);
+  const double optimized_ms = time_ms(optimized, in, pad_ref, out_sizes);
+  std::printf(
+      "%-40s portable %8.3f ms %7.2f GB/s  optimized %8.3f ms %7.2f GB/s"
+      "  %5.2fx\n",
+      name,
+      portable_ms,
+      mbytes / portable_ms,
+      optimized_ms,
+      mbytes / optimized_ms,
+      portable_ms / optimized_ms);
+}
+
+PadFn constant_pad(bool optimized) {
+  return [optimized](
+             RuntimeContext& ctx,
+             const Tensor& in,
+             ArrayRef<int64_t> pad,
+             Tensor& out) -> Tensor& {
+    return optimized ? native::opt_constant_pad_nd_out(ctx, in, pad, 0, out)
+                     : native::constant_pad_nd_out(ctx, in, pad, 0, out);
+  };
+}
+
+} // namespace
+
+int main() {
+  torch::executor::runtime_init();
+
+  // A 3x3 convolution input, padded by 1 on H and W.
+  run("constant_pad_nd [8, 64, 56, 56]",
+      constant_pad(false),
+      constant_pad(true),
+      {8, 64, 56, 56},
+      {1, 1, 1, 1});
+  // A causal 1-D convolution over audio frames, padded on the left.
+  run("constant_pad_nd [8, 256, 4000]",
+      constant_pad(false),
+      constant_pad(true),
+      {8, 256, 4000},
+      {2, 0});
+  // The reflection padding of an STFT over 10 s of 16 kHz audio.
+  run("reflection_pad1d [8, 1, 160000]",
+      native::reflection_pad1d_out,
+      native::opt_reflection_pad1d_out,
+      {8, 1, 160000},
+      {200, 200});
+  run("reflection_pad2d [8, 64, 56, 56]",
+      native::reflection_pad2d_out,
+      native::opt_reflection_pad2d_out,
+      {8, 64, 56, 56},
+      {1, 1, 1, 1});
+  run("replication_pad2d [8, 64, 56, 56]",
+      native::replication_pad2d_out,
+      native::opt_replication_pad2d_out,
+      {8, 64, 56, 56},
+      {1, 1, 1, 1});
+  run("replication_pad3d [2, 16, 16, 64, 64]",
+      native::replication_pad3d_out,
+      native::opt_replication_pad3d_out,
+      {2, 16, 16, 64, 64},
+      {1, 1, 1, 1, 1, 1});
+  return 0;
+}
@@ -0,0 +1,314 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+/**
+ * @file
+ *
+ * Measures the sparse linear kernels against the dense ones they replace:
+ * prepacked::linear for float weights and quantized_decomposed::mixed_linear
+ * for int8 weights. Runs 2:4 weights, and block sparse weights over a range
+ * of densities, for a single row (token by token decoding) and for batches of
+ * rows. Reports the time per call and the size of the weights of each.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include <executorch/kernels/optimized/NativeFunctions.h>
+#include <executorch/kernels/quantized/NativeFunctions.h>
+#include <executorch/runtime/core/exec_aten/exec_aten.h>
+#include <executorch/runtime/core/exec_aten/testing_util/tensor_factory.h>
+#include <executorch/runtime/platform/assert.h>
+#include <executorch/runtime/platform/runtime.h>
+
+using exec_aten::optional;
+using exec_aten::RuntimeContext;
+using exec_aten::ScalarType;
+using exec_aten::Tensor;
+using torch::executor::testing::TensorFactory;
+namespace native = torch::executor::native;
+
+namespace {
+
+constexpr int kIterations = 10;
+// Must match kPanelWidth in kernels/optimized/cpu/op_linear_packed.cpp.
+constexpr int32_t kPanelWidth = 8;
+// Must match kBlockSize in kernels/optimized/cpu/op_linear_sparse.cpp.
+constexpr int32_t kBlockSize = 16;
+
+// Returns the average time of a call to fn, in ms.
+template <typename Fn>
+double time_ms(const Fn& fn) {
+  fn();
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < kIterations; ++i) {
+    fn();
+  }
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::steady_clock::now() - start)
+             .count() /
+      kIterations;
+}
+
+double megabytes(const std::vector<Tensor>& tensors) {
+  size_t bytes = 0;
+  for (const Tensor& t : tensors) {
+    bytes += t.nbytes();
+  }
+  return bytes / 1e6;
+}
+
+// A [n, k] weight that keeps 2 random weights of each group of 4, or each
+// kBlockSize x 1 block with probability density when block is set. Weights
+// are integers in [-127, 127], so they are exact in int8.
+std::vector<float> make_weight(
+    int32_t n_size,
+    int32_t k_size,
+    bool block,
+    double density,
+    std::mt19937& rng) {
+  std::uniform_int_distribution<int> value(-127, 127);
+  std::uniform_real_distribution<double> keep(0.0, 1.0);
+  std::vector<float> weight(n_size * k_size, 0.0f);
+  if (block) {
+    for (int32_t b = 0; b * kBlockSize < n_size; ++b) {
+      for (int32_t k = 0; k < k_size; ++k) {
+        if (keep(rng) >= density) {
+          continue;
+        }
+        for (int32_t n = b * kBlockSize;
+             n < std::min(n_size, (b + 1) * kBlockSize);
+             ++n) {
+          weight[n * k_size + k] = value(rng) | 1;
+        }
+      }
+    }
+  } else {
+    for (int32_t n = 0; n < n_size; ++n) {
+      for (int32_t g = 0; g < k_size / 4; ++g) {
+        const int32_t first = rng() % 4;
+        const int32_t second = (first + 1 + rng() % 3) % 4;
+        weight[n * k_size + g * 4 + first] = value(rng) | 1;
+        weight[n * k_size + g * 4 + second] = value(rng) | 1;
+      }
+    }
+  }
+  return weight;
+}
+
+// The compressed layouts of exir/passes/sparse_weights_pass.py, for a weight
+// made by make_weight().
+void pack_2_4(
+    const std::vector<float>& weight,
+    int32_t n_size,
+    int32_t k_size,
+    std::vector<float>& values,
+    std::vector<uint8_t>& metadata) {
+  const int32_t num_groups = k_size / 4;
+  values.clear();
+  metadata.assign(n_size * ((num_groups + 1) / 2), 0);
+  for (int32_t n = 0; n < n_size; ++n) {
+    for (int32_t g = 0; g < num_groups; ++g) {
+      int32_t positions[2];
+      int32_t kept = 0;
+      for (int32_t i = 0; i < 4; ++i) {
+        if (weight[n * k_size + g * 4 + i] != 0) {
+          positions[kept++] = i;
+          values.push_back(weight[n * k_size + g * 4 + i]);
+        }
+      }
+      metadata[n * ((num_groups + 1) / 2) + g / 2] |=
+          (positions[0] | positions[1] << 2) << (g % 2 * 4);
+    }
+  }
+}
+
+void pack_block(
+    const std::vector<float>& weight,
+    int32_t n_size,
+    int32_t k_size,
+    std::vector<float>& values,
+    std::vector<int32_t>& col_indices,
+    std::vector<int32_t>& row_offsets) {
+  values.clear();
+  col_indices.clear();
+  row_offsets.assign(1, 0);
+  for (int32_t b = 0; b * kBlockSize < n_size; ++b) {
+    for (int32_t k = 0; k < k_size; ++k) {
+      if (weight[b * kBlockSize * k_size + k] == 0) {
+        continue;
+      }
+      for (int32_t j = 0; j < kBlockSize; ++j) {
+        const int32_t n = b * kBlockSize + j;
+        values.push_back(n < n_size ? weight[n * k_size + k] : 0.0f);
+      }
+      col_indices.push_back(k);
+    }
+    row_offsets.push_back(col_indices.size());
+  }
+}
+
+std::vector<float> pack_panels(
+    const std::vector<float>& weight,
+    int32_t n_size,
+    int32_t k_size) {
+  const int32_t num_panels = (n_size + kPanelWidth - 1) / kPanelWidth;
+  std::vector<float> packed(num_panels * k_size * kPanelWidth, 0.0f);
+  for (int32_t n = 0; n < n_size; ++n) {
+    for (int32_t k = 0; k < k_size; ++k) {
+      packed[(n / kPanelWidth * k_size + k) * kPanelWidth + n % kPanelWidth] =
+          weight[n * k_size + k];
+    }
+  }
+  return packed;
+}
+
+template <typename T>
+std::vector<T> convert(const std::vector<float>& v) {
+  return std::vector<T>(v.begin(), v.end());
+}
+
+// Runs one weight, as float and as int8, through the dense and the sparse
+// kernel.
+void run(
+    int32_t m_size,
+    int32_t k_size,
+    int32_t n_size,
+    bool block,
+    double density) {
+  TensorFactory<ScalarType::Float> tf;
+  TensorFactory<ScalarType::Char> tf_char;
+  TensorFactory<ScalarType::Byte> tf_byte;
+  TensorFactory<ScalarType::Int> tf_int;
+  std::mt19937 rng(m_size * 31 + n_size);
+
+  const std::vector<float> weight =
+      make_weight(n_size, k_size, block, density, rng);
+  std::vector<float> in_data(m_size * k_size);
+  for (float& x : in_data) {
+    x = std::uniform_real_distribution<float>(-1.0f, 1.0f)(rng);
+  }
+  const Tensor in = tf.make({m_size, k_size}, in_data);
+  const Tensor scales = tf.full({n_size}, 1.0f / 127);
+  Tensor out = tf.zeros({m_size, n_size});
+  RuntimeContext ctx;
+
+  // Dense.
+  const Tensor packed = tf.make(
+      {(n_size + kPanelWidth - 1) / kPanelWidth, k_size, kPanelWidth},
+      pack_panels(weight, n_size, k_size));
+  const Tensor weight_int8 =
+      tf_char.make({n_size, k_size}, convert<int8_t>(weight));
+  const double dense_ms = time_ms([&] {
+    native::opt_prepacked_linear_out(ctx, in, packed, {}, n_size, out);
+  });
+  const double dense_int8_ms = time_ms([&] {
+    native::quantized_mixed_linear_out(
+        ctx, in, weight_int8, scales, {}, {}, out);
+  });
+
+  // Sparse.
+  std::vector<float> values;
+  std::vector<Tensor> float_tensors;
+  std::vector<Tensor> int8_tensors;
+  double sparse_ms = 0;
+  double sparse_int8_ms = 0;
+  char name[64];
+  if (block) {
+    std::vector<int32_t> col_data, offsets_data;
+    pack_block(weight, n_size, k_size, values, col_data, offsets_data);
+    const int32_t num_kept = col_data.size();
+    const Tensor values_float = tf.make({num_kept, kBlockSize}, values);
+    const Tensor values_int8 =
+        tf_char.make({num_kept, kBlockSize}, convert<int8_t>(values));
+    const Tensor col_indices = tf_int.make({num_kept}, col_data);
+    const Tensor row_offsets = tf_int.make(
+        {static_cast<int32_t>(offsets_data.size())}, offsets_data);
+    sparse_ms = time_ms([&] {
+      native::opt_prepacked_sparse_linear_block_out(
+          ctx, in, values_float, col_indices, row_offsets, {}, {}, n_size, out);
+    });
+    sparse_int8_ms = time_ms([&] {
+      native::opt_prepacked_sparse_linear_block_out(
+          ctx,
+          in,
+          values_int8,
+          col_indices,
+          row_offsets,
+          scales,
+          {},
+          n_size,
+          out);
+    });
+    float_tensors = {values_float, col_indices, row_offsets};
+    int8_tensors = {values_int8, col_indices, row_offsets, scales};
+    std::snprintf(name, sizeof(name), "block %3.0f%%", density * 100);
+  } else {
+    std::vector<uint8_t> metadata_data;
+    pack_2_4(weight, n_size, k_size, values, metadata_data);
+    const Tensor values_float = tf.make({n_size, k_size / 2}, values);
+    const Tensor values_int8 =
+        tf_char.make({n_size, k_size / 2}, convert<int8_t>(values));
+    const Tensor metadata =
+        tf_byte.make({n_size, (k_size / 4 + 1) / 2}, metadata_data);
+    sparse_ms = time_ms([&] {
+      native::opt_prepacked_sparse_linear_2_4_out(
+          ctx, in, values_float, metadata, {}, {}, out);
+    });
+    sparse_int8_ms = time_ms([&] {
+      native::opt_prepacked_sparse_linear_2_4_out(
+          ctx, in, values_int8, metadata, scales, {}, out);
+    });
+    float_tensors = {values_float, metadata};
+    int8_tensors = {values_int8, metadata, scales};
+    std::snprintf(name, sizeof(name), "2:4");
+  }
+  ET_CHECK_MSG(ctx.failure_state() == torch::executor::Error::Ok, "Failed");
+
+  std::printf(
+      "[%4d x %5d x %5d] %-10s"
+      "  fp32 %8.3f -> %8.3f ms %5.2fx %6.2f -> %6.2f MB"
+      "  int8 %8.3f -> %8.3f ms %5.2fx %6.2f -> %6.2f MB\n",
+      m_size,
+      k_size,
+      n_size,
+      name,
+      dense_ms,
+      sparse_ms,
+      dense_ms / sparse_ms,
+      megabytes({packed}),
+      megabytes(float_tensors),
+      dense_int8_ms,
+      sparse_int8_ms,
+      dense_int8_ms / sparse_int8_ms,
+      megabytes({weight_int8, scales}),
+      megabytes(int8_tensors));
+}
+
+} // namespace
+
+int main() {
+  torch::executor::runtime_init();
+
+  // [rows x in_features x out_features] of the linear layers of a small
+  // transformer, for a single token and for a batch of tokens.
+  const int32_t shapes[][3] = {
+      {1, 2048, 2048},
+      {1, 2048, 8192},
+      {64, 2048, 2048},
+  };
+  for (const auto& shape : shapes) {
+    run(shape[0], shape[1], shape[2], /*block=*/false, 0.5);
+    for (const double density : {0.75, 0.5, 0.25, 0.1}) {
+      run(shape[0], shape[1], shape[2], /*block=*/true, density);
+    }
+  }
+  return 0;
+}
@@ -4,7 +4,7 @@ load(
     "get_vec_android_preprocessor_flags",
     "get_vec_cxx_preprocessor_flags",
 )
-load("@fbsource//xplat/executorch/kernels/test:util.bzl", "define_supported_features_lib")
+load("@fbsource//xplat/executorch/kernels/test:util.bzl", "define_supported_features_lib", "op_test")
 
 def _lib_test_bin(name, extra_deps = [], in_cpu = False):
     """Defines a cxx_binary() for a single test file.
@@ -40,4 +40,60 @@ def define_common_targets():
 
     _lib_test_bin("libvec_test_bin")
     _lib_test_bin("moments_utils_test_bin", in_cpu = True)
+    _lib_test_bin("tunable_param_test_bin", in_cpu = True)
     _lib_test_bin("libblas_test_bin")
+    op_test("op_linear_packed_test", kernel_name = "optimized")
+    op_test("op_linear_sparse_test", kernel_name = "optimized")
+
+    runtime.cxx_test(
+        name = "dtype_specialized_kernels_test",
+        srcs = [
+            "dtype_specialized_kernels_test.cpp",
+        ],
+        deps = [
+            "//executorch/kernels/optimized/cpu:op_add",
+            "//executorch/kernels/optimized/cpu:op_mul",
+            "//executorch/kernels/optimized:generated_lib_headers",
+            "//executorch/runtime/core/exec_aten:lib",
+            "//executorch/runtime/core/exec_aten/testing_util:tensor_util",
+        ],
+    )
+
+    # Compares the optimized padding kernels with the portable ones.
+    runtime.cxx_binary(
+        name = "padding_benchmark",
+        srcs = [
+            "padding_benchmark.cpp",
+        ],
+        deps = [
+            "//executorch/kernels/optimized/cpu:op_constant_pad_nd",
+            "//executorch/kernels/optimized/cpu:op_reflection_pad1d",
+            "//executorch/kernels/optimized/cpu:op_reflection_pad2d",
+            "//executorch/kernels/optimized/cpu:op_replication_pad2d",
+            "//executorch/kernels/optimized/cpu:op_replication_pad3d",
+            "//executorch/kernels/optimized:generated_lib_headers",
+            "//executorch/kernels/portable/cpu:op_constant_pad_nd",
+            "//executorch/kernels/portable/cpu:op_reflection_pad1d",
+            "//executorch/kernels/portable/cpu:op_reflection_pad2d",
+            "//executorch/kernels/portable/cpu:op_replication_pad2d",
+            "//executorch/kernels/portable/cpu:op_replication_pad3d",
+            "//executorch/kernels/portable:generated_lib_headers",
+            "//executorch/runtime/core/exec_aten/testing_util:tensor_util",
+        ],
+    )
+
+    # Compares the sparse linear kernels with the dense ones they replace.
+    runtime.cxx_binary(
+        name = "sparse_linear_benchmark",
+        srcs = [
+            "sparse_linear_benchmark.cpp",
+        ],
+        deps = [
+            "//executorch/kernels/optimized/cpu:op_linear_packed",
+            "//executorch/kernels/optimized/cpu:op_linear_sparse",
+            "//executorch/kernels/optimized:generated_lib_headers",
+            "//executorch/kernels/quantized/cpu:op_mixed_linear",
+            "//executorch/kernels/quantized:generated_lib_headers",
+            "//executorch/runtime/core/exec_aten/testing_util:tensor_util",
+        ],
+    )
@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+
+#include <executorch/kernels/optimized/cpu/tunable_param.h>
+
+#include <vector>
+
+using torch::executor::tuning::KernelTuner;
+using torch::executor::tuning::set_kernel_tuner;
+using torch::executor::tuning::TunableParam;
+
+namespace {
+
+// Knows the value for bucket 8 only, and "tunes" other buckets by trying
+// every candidate once and picking the last one.
+class FakeTuner : public KernelTuner {
+ public:
+  bool find_cached(
+      const TunableParam& /*param*/,
+      int64_t bucket,
+      int64_t* value) override {
+    if (bucket == 8) {
+      *value = 42;
+      return true;
+    }
+    return false;
+  }
+
+  int64_t tune(
+      const TunableParam& param,
+      int64_t /*bucket*/,
+      int64_t default_value,
+      void (*run)(void* context, int64_t value),
+      void* context) override {
+    int64_t last = default_value;
+    for (const int64_t candidate : param.candidates()) {
+      run(context, candidate);
+      last = candidate;
+    }
+    return last;
+  }
+};
+
+class TunableParamTest : public ::testing::Test {
+ protected:
+  void TearDown() override {
+    set_kernel_tuner(nullptr);
+  }
+};
+
+} // namespace
+
+TEST_F(TunableParamTest, ReturnsDefaultWithoutTuner) {
+  TunableParam param("test::kernel", "block", {1, 2, 4});
+  bool ran = false;
+  EXPECT_EQ(param.select(8, 2, [&](int64_t) { ran = true; }), 2);
+  EXPECT_FALSE(ran);
+}
+
+TEST_F(TunableParamTest, UsesRegisteredTuner) {
+  FakeTuner tuner;
+  set_kernel_tuner(&tuner);
+  TunableParam param("test::kernel", "block", {1, 2, 4});
+
+  std::vector<int64_t> tried;
+  auto run = [&](int64_t value) { tried.push_back(value); };
+  EXPECT_EQ(param.select(8, 2, run), 42);
+  EXPECT_TRUE(tried.empty());
+  EXPECT_EQ(param.select(16, 2, run), 4);
+  EXPECT_EQ(tried, (std::vector<int64_t>{1, 2, 4}));
+}
+
+TEST_F(TunableParamTest, ShapeBucketRoundsUpToPowerOfTwo) {
+  using torch::executor::tuning::shape_bucket;
+  EXPECT_EQ(shape_bucket(0), 0);
+  EXPECT_EQ(shape_bucket(-3), 0);
+  EXPECT_EQ(shape_bucket(1), 1);
+  EXPECT_EQ(shape_bucket(3), 4);
+  EXPECT_EQ(shape_bucket(64), 64);
+  EXPECT_EQ(shape_bucket(65), 128);
+}
+
+TEST_F(TunableParamTest, CombinedBucketsDependOnEveryPart) {
+  using torch::executor::tuning::combine_buckets;
+  const int64_t bucket = combine_buckets({64, 128, 6, 1});
+  EXPECT_EQ(combine_buckets({64, 128, 6, 1}), bucket);
+  EXPECT_NE(combine_buckets({128, 64, 6, 1}), bucket);
+  EXPECT_NE(combine_buckets({64, 256, 6, 1}), bucket);
+  EXPECT_NE(combine_buckets({64, 128, 7, 1}), bucket);
+  EXPECT_NE(combine_buckets({64, 128, 6, 0}), bucket);
+}
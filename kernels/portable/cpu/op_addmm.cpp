@@ -27,7 +27,7 @@ Tensor& addmm_out(
     const Scalar& beta,
     const Scalar& alpha,
     Tensor& out) {
-  ET_KERNEL_CHECK(
+  ET_KERNEL_CHECK_ARGS(
       ctx,
       check_addmm_args(in, mat1, mat2, beta, alpha, out),
       InvalidArgument,
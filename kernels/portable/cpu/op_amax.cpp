@@ -27,7 +27,7 @@ Tensor& amax_out(
     Tensor& out) {
   (void)ctx;
 
-  ET_KERNEL_CHECK(
+  ET_KERNEL_CHECK_ARGS(
       ctx,
       check_amin_amax_args(in, dim_list, keepdim, out),
       InvalidArgument,
@@ -51,7 +51,7 @@ Tensor& any_dims_out(
     Tensor& out) {
   (void)ctx;
 
-  ET_KERNEL_CHECK(
+  ET_KERNEL_CHECK_ARGS(
       ctx,
       check_reduction_args(in, dim_list, keepdim, {}, out),
       InvalidArgument,
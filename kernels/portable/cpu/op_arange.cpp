@@ -24,7 +24,7 @@ Tensor& arange_out(RuntimeContext& ctx, const Scalar& end, Tensor& out) {
   ET_KERNEL_CHECK(
       ctx, utils::extract_scalar(end, &end_val), InvalidArgument, out);
 
-  ET_KERNEL_CHECK(
+  ET_KERNEL_CHECK_ARGS(
       ctx, check_arange_args(0.0, end_val, 1.0, out), InvalidArgument, out);
 
   size_t size = static_cast<size_t>(std::ceil(end_val));
@@ -67,7 +67,7 @@ Tensor& arange_start_out(
   ET_KERNEL_CHECK(
       ctx, utils::extract_scalar(step, &d_step), InvalidArgument, out);
 
-  ET_KERNEL_CHECK(
+  ET_KERNEL_CHECK_ARGS(
       ctx,
       check_arange_args(d_start, d_end, d_step, out),
       InvalidArgument,
@@ -28,7 +28,7 @@ Tensor& argmin_out(
     Tensor& out) {
   (void)ctx;
 
-  ET_KERNEL_CHECK(
+  ET_KERNEL_CHECK_ARGS(
       ctx,
       check_argmin_argmax_args(in, dim, keepdim, out),
       InvalidArgument,
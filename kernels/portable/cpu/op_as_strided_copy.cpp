@@ -25,7 +25,7 @@ Tensor& as_strided_copy_out(
     Tensor& out) {
   (void)ctx;
 
-  ET_KERNEL_CHECK(
+  ET_KERNEL_CHECK_ARGS(
       ctx,
       check_as_strided_copy_args(in, size, stride, storage_offset, out),
       InvalidArgument,
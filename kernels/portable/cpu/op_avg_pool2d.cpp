@@ -30,7 +30,7 @@ Tensor& avg_pool2d_out(
     bool count_include_pad,
     exec_aten::optional<int64_t> divisor_override,
     Tensor& out) {
-  ET_KERNEL_CHECK(
+  ET_KERNEL_CHECK_ARGS(
       ctx,
       check_avg_pool2d_args(
           in,
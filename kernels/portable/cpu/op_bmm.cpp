@@ -21,7 +21,8 @@ Tensor& bmm_out(
     const Tensor& in,
     const Tensor& mat2,
     Tensor& out) {
-  ET_KERNEL_CHECK(ctx, check_bmm_args(in, mat2, out), InvalidArgument, out);
+  ET_KERNEL_CHECK_ARGS(
+      ctx, check_bmm_args(in, mat2, out), InvalidArgument, out);
 
   size_t output_ndim = 0;
   exec_aten::SizesType output_sizes[kTensorDimensionLimit];
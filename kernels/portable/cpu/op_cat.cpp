@@ -26,7 +26,8 @@ Tensor& cat_out(
     dim += out.dim();
   }
 
-  ET_KERNEL_CHECK(ctx, check_cat_args(tensors, dim, out), InvalidArgument, out);
+  ET_KERNEL_CHECK_ARGS(
+      ctx, check_cat_args(tensors, dim, out), InvalidArgument, out);
 
   Tensor::SizesType expected_out_size[kTensorDimensionLimit];
   size_t expected_out_dim = 0;
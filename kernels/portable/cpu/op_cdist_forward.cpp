@@ -124,7 +124,7 @@ Tensor& _cdist_forward_out(
     Tensor& out) {
   (void)ctx;
 
-  ET_KERNEL_CHECK(
+  ET_KERNEL_CHECK_ARGS(
       ctx,
       check_cdist_args(x1, x2, p, compute_mode, out),
       InvalidArgument,
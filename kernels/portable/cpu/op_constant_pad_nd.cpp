@@ -167,7 +167,7 @@ Tensor& constant_pad_nd_out(
     Tensor& out) {
   (void)ctx;
 
-  ET_KERNEL_CHECK(
+  ET_KERNEL_CHECK_ARGS(
       ctx, check_constant_pad_args(in, pad, value, out), InvalidArgument, out);
 
   // resize out tensor for dynamic shapes
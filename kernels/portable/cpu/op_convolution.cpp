@@ -278,7 +278,7 @@ Tensor& convolution_out(
     Tensor& out) {
   (void)ctx;
 
-  ET_KERNEL_CHECK(
+  ET_KERNEL_CHECK_ARGS(
       ctx,
       check_convolution_args(
           in,
@@ -87,7 +87,7 @@ Tensor& cumsum_out(
     Tensor& out) {
   (void)ctx;
 
-  ET_KERNEL_CHECK(
+  ET_KERNEL_CHECK_ARGS(
       ctx,
       check_cumsum_args(self, dim, enforced_dtype, out),
       InvalidArgument,
@@ -70,7 +70,7 @@ Tensor& diagonal_copy_out(
     Tensor& out) {
   (void)ctx;
 
-  ET_KERNEL_CHECK(
+  ET_KERNEL_CHECK_ARGS(
       ctx, check_diagonal_copy_args(in, dim1, dim2, out), InvalidArgument, out);
 
   if (dim1 < 0) {
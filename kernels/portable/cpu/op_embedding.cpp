@@ -82,7 +82,7 @@ Tensor& embedding_out(
   (void)scale_grad_by_freq;
   (void)sparse;
 
-  ET_KERNEL_CHECK(
+  ET_KERNEL_CHECK_ARGS(
       ctx, check_embedding_args(weight, indices, out), InvalidArgument, out);
 
   ET_KERNEL_CHECK(
@@ -61,7 +61,7 @@ Tensor& expand_copy_out(
     Tensor& out) {
   (void)ctx;
 
-  ET_KERNEL_CHECK(
+  ET_KERNEL_CHECK_ARGS(
       ctx,
       check_expand_copy_args(self, expand_sizes, implicit, out),
       InvalidArgument,
@@ -45,7 +45,8 @@ flip_out(RuntimeContext& ctx, const Tensor& in, IntArrayRef dims, Tensor& out) {
   ET_KERNEL_CHECK(
       ctx, resize_tensor(out, in.sizes()) == Error::Ok, InvalidArgument, out);
 
-  ET_KERNEL_CHECK(ctx, check_flip_args(in, dims, out), InvalidArgument, out);
+  ET_KERNEL_CHECK_ARGS(
+      ctx, check_flip_args(in, dims, out), InvalidArgument, out);
 
   bool flip_dim_data[kTensorDimensionLimit];
   for (size_t i = 0; i < in.dim(); i++) {
@@ -28,7 +28,7 @@ Tensor& gelu_out(
     Tensor& out) {
   (void)ctx;
 
-  ET_KERNEL_CHECK(
+  ET_KERNEL_CHECK_ARGS(
       ctx, check_gelu_args(in, approximate, out), InvalidArgument, out);
 
   ET_KERNEL_CHECK(
@@ -29,7 +29,7 @@ Tensor& index_Tensor_out(
     Tensor& out) {
   (void)ctx;
 
-  ET_KERNEL_CHECK(
+  ET_KERNEL_CHECK_ARGS(
       ctx, check_index_args(in, indices, out), InvalidArgument, out);
 
   ScalarType in_type = in.scalar_type();
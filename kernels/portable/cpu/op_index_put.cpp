@@ -27,7 +27,7 @@ Tensor& index_put_out(
     Tensor& out) {
   (void)ctx;
 
-  ET_KERNEL_CHECK(
+  ET_KERNEL_CHECK_ARGS(
       ctx, check_index_args(in, indices, out), InvalidArgument, out);
 
   ET_KERNEL_CHECK(
@@ -88,8 +88,12 @@ Tensor& index_put_out(
     return out;
   }
 
-  // To start, copy the input data into the out tensor
-  memcpy(out.mutable_data_ptr<char>(), in.const_data_ptr<char>(), in.nbytes());
+  // To start, copy the input data into the out tensor. The copy is skipped
+  // when out is the input's own storage, e.g. an in-place mutable buffer.
+  if (out.mutable_data_ptr() != in.const_data_ptr()) {
+    memcpy(
+        out.mutable_data_ptr<char>(), in.const_data_ptr<char>(), in.nbytes());
+  }
 
   // In what follows, `x = in[indices]`. This tensor is implicit, and it would
   // be much easier to be able to allocate memory, and then call index.Tensor
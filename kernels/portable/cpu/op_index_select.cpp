@@ -25,6 +25,8 @@ Tensor& index_select_out(
     int64_t dim,
     const Tensor& index,
     Tensor& out) {
+  // Not ET_KERNEL_CHECK_ARGS: the check reads the index values, which are not
+  // part of what a validated call remembers.
   ET_KERNEL_CHECK(
       ctx, check_index_select_args(in, dim, index, out), InvalidArgument, out);
 
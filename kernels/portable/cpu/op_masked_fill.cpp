@@ -27,7 +27,7 @@ Tensor& masked_fill_scalar_out(
     Tensor& out) {
   (void)ctx;
 
-  ET_KERNEL_CHECK(
+  ET_KERNEL_CHECK_ARGS(
       ctx, check_masked_fill_args(in, mask, value, out), InvalidArgument, out);
 
   ScalarType in_type = in.scalar_type();
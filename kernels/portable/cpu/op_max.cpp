@@ -31,7 +31,7 @@ std::tuple<Tensor&, Tensor&> max_out(
     Tensor& max_indices) {
   (void)ctx;
 
-  ET_KERNEL_CHECK(
+  ET_KERNEL_CHECK_ARGS(
       ctx,
       check_min_max_args(in, dim, keepdim, max, max_indices),
       InvalidArgument,
@@ -32,7 +32,7 @@ std::tuple<Tensor&, Tensor&> max_pool2d_with_indices_out(
     Tensor& indices) {
   std::tuple<Tensor&, Tensor&> ret_val(out, indices);
 
-  ET_KERNEL_CHECK(
+  ET_KERNEL_CHECK_ARGS(
       ctx,
       check_max_pool2d_with_indices_args(
           in, kernel_size, stride, padding, dilation, ceil_mode, out, indices),
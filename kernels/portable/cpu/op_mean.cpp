@@ -27,7 +27,7 @@ Tensor& mean_dim_out(
     Tensor& out) {
   (void)ctx;
 
-  ET_KERNEL_CHECK(
+  ET_KERNEL_CHECK_ARGS(
       ctx,
       check_mean_dim_args(in, dim_list, keepdim, dtype, out),
       InvalidArgument,
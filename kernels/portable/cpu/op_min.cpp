@@ -31,7 +31,7 @@ std::tuple<Tensor&, Tensor&> min_out(
     Tensor& min_indices) {
   (void)ctx;
 
-  ET_KERNEL_CHECK(
+  ET_KERNEL_CHECK_ARGS(
       ctx,
       check_min_max_args(in, dim, keepdim, min, min_indices),
       InvalidArgument,
@@ -18,7 +18,7 @@ using Tensor = exec_aten::Tensor;
 
 Tensor&
 mm_out(RuntimeContext& ctx, const Tensor& in, const Tensor& mat2, Tensor& out) {
-  ET_KERNEL_CHECK(ctx, check_mm_args(in, mat2, out), InvalidArgument, out);
+  ET_KERNEL_CHECK_ARGS(ctx, check_mm_args(in, mat2, out), InvalidArgument, out);
 
   size_t output_ndim = 0;
   exec_aten::SizesType output_sizes[kTensorDimensionLimit];
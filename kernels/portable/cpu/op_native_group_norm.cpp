@@ -129,7 +129,7 @@ std::tuple<Tensor&, Tensor&, Tensor&> native_group_norm_out(
 
   std::tuple<Tensor&, Tensor&, Tensor&> ret_val(out, mean_out, rstd_out);
 
-  ET_KERNEL_CHECK(
+  ET_KERNEL_CHECK_ARGS(
       ctx,
       check_group_norm_args(
           input, weight, bias, N, C, HxW, group, out, mean_out, rstd_out),
@@ -86,7 +86,7 @@ void nonzero(RuntimeContext& ctx, const Tensor& input, Tensor& output) {
 Tensor& nonzero_out(RuntimeContext& ctx, const Tensor& in, Tensor& out) {
   (void)ctx;
 
-  ET_KERNEL_CHECK(ctx, check_nonzero_args(in, out), InvalidArgument, out);
+  ET_KERNEL_CHECK_ARGS(ctx, check_nonzero_args(in, out), InvalidArgument, out);
 
   ET_SWITCH_REAL_TYPES_AND(
       Bool, in.scalar_type(), ctx, "nonzero.out", CTYPE, [&] {
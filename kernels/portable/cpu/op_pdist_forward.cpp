@@ -22,7 +22,7 @@ Tensor& _pdist_forward_out(
     Tensor& out) {
   (void)ctx;
 
-  ET_KERNEL_CHECK(ctx, check_pdist_args(in, p, out), InvalidArgument, out);
+  ET_KERNEL_CHECK_ARGS(ctx, check_pdist_args(in, p, out), InvalidArgument, out);
 
   Tensor::SizesType target_sizes[kTensorDimensionLimit];
   size_t target_ndim = 0;
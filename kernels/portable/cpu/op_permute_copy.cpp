@@ -43,7 +43,7 @@ Tensor& permute_copy_out(
     Tensor& out) {
   (void)ctx;
 
-  ET_KERNEL_CHECK(
+  ET_KERNEL_CHECK_ARGS(
       ctx, check_permute_copy_args(in, dims, out), InvalidArgument, out);
 
   Tensor::SizesType expected_out_size[kTensorDimensionLimit];
@@ -23,7 +23,7 @@ Tensor& pixel_shuffle_out(
     Tensor& out) {
   (void)ctx;
 
-  ET_KERNEL_CHECK(
+  ET_KERNEL_CHECK_ARGS(
       ctx,
       check_pixel_shuffle_args(in, upscale_factor, out),
       InvalidArgument,
@@ -23,7 +23,7 @@ Tensor& prod_out(
     Tensor& out) {
   (void)ctx;
 
-  ET_KERNEL_CHECK(
+  ET_KERNEL_CHECK_ARGS(
       ctx, check_prod_out_args(in, dtype, out), InvalidArgument, out);
 
   ET_KERNEL_CHECK(
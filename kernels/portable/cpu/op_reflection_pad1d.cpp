@@ -22,7 +22,7 @@ Tensor& reflection_pad1d_out(
     Tensor& out) {
   (void)ctx;
 
-  ET_KERNEL_CHECK(
+  ET_KERNEL_CHECK_ARGS(
       ctx,
       check_padding_args(1, in, padding, out, /*reflection*/ true),
       InvalidArgument,
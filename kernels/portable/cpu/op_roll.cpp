@@ -57,7 +57,7 @@ Tensor& roll_out(
   ET_KERNEL_CHECK(
       ctx, resize_tensor(out, in.sizes()) == Error::Ok, InvalidArgument, out);
 
-  ET_KERNEL_CHECK(
+  ET_KERNEL_CHECK_ARGS(
       ctx, check_roll_args(in, shifts, dims, out), InvalidArgument, out);
 
   if (in.numel() == 0) {
@@ -59,6 +59,8 @@ Tensor& scatter_add_out(
     Tensor& out) {
   (void)context;
 
+  // Not ET_KERNEL_CHECK_ARGS: the check reads the index values, which are not
+  // part of what a validated call remembers.
   ET_KERNEL_CHECK(
       context,
       check_scatter_add_args(self, dim, index, src, out),
@@ -45,7 +45,7 @@ Tensor& select_scatter_out(
   }
 
   // Check args
-  ET_KERNEL_CHECK(
+  ET_KERNEL_CHECK_ARGS(
       ctx,
       check_select_scatter_args(in, src, dim, index, out),
       InvalidArgument,
@@ -57,9 +57,12 @@ Tensor& select_scatter_out(
     return out;
   }
 
-  // To start, copy the input into the output. Input will not be empty due to
+  // To start, copy the input into the output, unless out is the input's own
+  // storage (e.g. an in-place mutable buffer). Input will not be empty due to
   // the checks performed above.
-  memcpy(out.mutable_data_ptr(), in.const_data_ptr(), in.nbytes());
+  if (out.mutable_data_ptr() != in.const_data_ptr()) {
+    memcpy(out.mutable_data_ptr(), in.const_data_ptr(), in.nbytes());
+  }
 
   // Strides to help with memory address arithmetic
   size_t leading_dims = getLeadingDims(in, dim);
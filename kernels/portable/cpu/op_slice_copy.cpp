@@ -27,7 +27,7 @@ Tensor& slice_copy_Tensor_out(
     Tensor& out) {
   (void)ctx;
 
-  ET_KERNEL_CHECK(
+  ET_KERNEL_CHECK_ARGS(
       ctx, check_slice_copy_args(in, dim, step, out), InvalidArgument, out);
 
   if (dim < 0) {
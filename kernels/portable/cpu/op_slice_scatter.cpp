@@ -58,7 +58,7 @@ Tensor& slice_scatter_out(
   int64_t num_values =
       adjust_slice_indices(input.size(dim), &start, &end, step);
 
-  ET_KERNEL_CHECK(
+  ET_KERNEL_CHECK_ARGS(
       ctx,
       check_slice_scatter_args(input, src, dim, num_values, step, out),
       InvalidArgument,
@@ -68,8 +68,11 @@ Tensor& slice_scatter_out(
   size_t leading_dims = getLeadingDims(input, dim);
   size_t trailing_dims = getTrailingDims(input, dim);
 
-  // To start, copy the input into the output
-  memcpy(out.mutable_data_ptr(), input.const_data_ptr(), input.nbytes());
+  // To start, copy the input into the output, unless out is the input's own
+  // storage (e.g. an in-place mutable buffer)
+  if (out.mutable_data_ptr() != input.const_data_ptr()) {
+    memcpy(out.mutable_data_ptr(), input.const_data_ptr(), input.nbytes());
+  }
 
   ScalarType in_type = input.scalar_type();
   ScalarType src_type = src.scalar_type();
@@ -27,7 +27,7 @@ Tensor& softmax_out(
     Tensor& out) {
   (void)ctx;
 
-  ET_KERNEL_CHECK(
+  ET_KERNEL_CHECK_ARGS(
       ctx,
       check_softmax_args(in, dim, half_to_float, out),
       InvalidArgument,
@@ -41,7 +41,7 @@ void split_copy_Tensor_out(
     dim += input.dim();
   }
 
-  ET_KERNEL_CHECK(
+  ET_KERNEL_CHECK_ARGS(
       ctx,
       check_split_copy_args(input, split_size, dim, out),
       InvalidArgument, );
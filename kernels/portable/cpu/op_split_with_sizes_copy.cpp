@@ -33,7 +33,7 @@ void split_with_sizes_copy_out(
     dim += in.dim();
   }
 
-  ET_KERNEL_CHECK(
+  ET_KERNEL_CHECK_ARGS(
       ctx,
       check_split_with_sizes_copy_args(in, split_sizes, dim, out),
       InvalidArgument, );
@@ -26,7 +26,7 @@ Tensor& squeeze_copy_dim_out(
     Tensor& out) {
   (void)ctx;
 
-  ET_KERNEL_CHECK(
+  ET_KERNEL_CHECK_ARGS(
       ctx, check_squeeze_copy_dim_args(in, dim, out), InvalidArgument, out);
 
   if (dim < 0) {
@@ -59,7 +59,7 @@ Tensor& squeeze_copy_dims_out(
     Tensor& out) {
   (void)ctx;
 
-  ET_KERNEL_CHECK(
+  ET_KERNEL_CHECK_ARGS(
       ctx, check_squeeze_copy_dims_args(in, dims, out), InvalidArgument, out);
 
   Tensor::SizesType expected_out_size[kTensorDimensionLimit];
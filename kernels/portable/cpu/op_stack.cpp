@@ -28,7 +28,7 @@ Tensor& stack_out(
     dim += out.dim();
   }
 
-  ET_KERNEL_CHECK(
+  ET_KERNEL_CHECK_ARGS(
       ctx, check_stack_args(tensors, dim, out), InvalidArgument, out);
 
   Tensor::SizesType expected_out_size[kTensorDimensionLimit];
@@ -26,7 +26,7 @@ Tensor& sum_dim_out(
     Tensor& out) {
   (void)ctx;
 
-  ET_KERNEL_CHECK(
+  ET_KERNEL_CHECK_ARGS(
       ctx,
       check_reduction_args(in, dim_list, keepdim, dtype, out),
       InvalidArgument,
@@ -27,7 +27,7 @@ using Tensor = exec_aten::Tensor;
 Tensor& t_copy_out(RuntimeContext& ctx, const Tensor& in, Tensor& out) {
   (void)ctx;
 
-  ET_KERNEL_CHECK(ctx, check_t_copy_args(in, out), InvalidArgument, out);
+  ET_KERNEL_CHECK_ARGS(ctx, check_t_copy_args(in, out), InvalidArgument, out);
 
   ScalarType in_type = in.scalar_type();
 
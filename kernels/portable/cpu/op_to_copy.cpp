@@ -34,7 +34,7 @@ Tensor& to_copy_out(
     bool non_blocking,
     exec_aten::optional<exec_aten::MemoryFormat> memory_format,
     Tensor& out) {
-  ET_KERNEL_CHECK(
+  ET_KERNEL_CHECK_ARGS(
       ctx,
       check_to_copy_args(self, non_blocking, memory_format, out),
       InvalidArgument,
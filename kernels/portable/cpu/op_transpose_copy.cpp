@@ -32,7 +32,7 @@ Tensor& transpose_copy_int_out(
     Tensor& out) {
   (void)ctx;
 
-  ET_KERNEL_CHECK(
+  ET_KERNEL_CHECK_ARGS(
       ctx,
       check_transpose_copy_args(in, dim0, dim1, out),
       InvalidArgument,
@@ -137,7 +137,7 @@ Tensor& tril_out(
     Tensor& out) {
   (void)ctx;
 
-  ET_KERNEL_CHECK(ctx, check_tril_args(self, out), InvalidArgument, out);
+  ET_KERNEL_CHECK_ARGS(ctx, check_tril_args(self, out), InvalidArgument, out);
 
   ET_KERNEL_CHECK(
       ctx,
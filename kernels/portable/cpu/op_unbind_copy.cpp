@@ -33,7 +33,7 @@ void unbind_copy_int_out(
     dim += input.dim();
   }
 
-  ET_KERNEL_CHECK(
+  ET_KERNEL_CHECK_ARGS(
       ctx, check_unbind_copy_args(input, dim, out), InvalidArgument, );
 
   if (input.numel() == 0) {
@@ -56,7 +56,7 @@ Tensor& unsqueeze_copy_out(
       InvalidArgument,
       out);
 
-  ET_KERNEL_CHECK(
+  ET_KERNEL_CHECK_ARGS(
       ctx, check_unsqueeze_copy_args(self, dim, out), InvalidArgument, out);
 
   if (self.nbytes() > 0) {
@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <type_traits>
+
+#include <executorch/kernels/portable/cpu/util/upsample_util.h>
+#include <executorch/runtime/kernel/kernel_includes.h>
+
+namespace torch {
+namespace executor {
+namespace native {
+
+using Tensor = exec_aten::Tensor;
+using ScalarType = exec_aten::ScalarType;
+using IntArrayRef = exec_aten::ArrayRef<int64_t>;
+using exec_aten::optional;
+
+namespace {
+
+template <typename CTYPE>
+void upsample_bilinear2d_kernel_impl(
+    const Tensor& in,
+    bool align_corners,
+    const optional<double>& scale_h,
+    const optional<double>& scale_w,
+    Tensor& out) {
+  // Interpolate in float, or in double for double tensors, like ATen.
+  using opmath_t = typename std::
+      conditional<std::is_same<CTYPE, double>::value, double, float>::type;
+
+  const CTYPE* const in_data = in.const_data_ptr<CTYPE>();
+  CTYPE* const out_data = out.mutable_data_ptr<CTYPE>();
+
+  // Index with the strides, to support any dim order.
+  const auto in_strides = in.strides();
+  const auto out_strides = out.strides();
+  const int64_t in_height = in.size(2);
+  const int64_t in_width = in.size(3);
+  const int64_t out_height = out.size(2);
+  const int64_t out_width = out.size(3);
+
+  const opmath_t ratio_h = area_pixel_compute_scale<opmath_t>(
+      in_height, out_height, align_corners, scale_h);
+  const opmath_t ratio_w = area_pixel_compute_scale<opmath_t>(
+      in_width, out_width, align_corners, scale_w);
+
+  for (int64_t n = 0; n < out.size(0); ++n) {
+    for (int64_t c = 0; c < out.size(1); ++c) {
+      const CTYPE* const in_plane =
+          in_data + n * in_strides[0] + c * in_strides[1];
+      CTYPE* const out_plane =
+          out_data + n * out_strides[0] + c * out_strides[1];
+
+      for (int64_t oh = 0; oh < out_height; ++oh) {
+        int64_t ih0, ih1;
+        opmath_t h0lambda, h1lambda;
+        compute_source_index_and_lambda<opmath_t>(
+            ih0,
+            ih1,
+            h0lambda,
+            h1lambda,
+            ratio_h,
+            oh,
+            in_height,
+            out_height,
+            align_corners);
+        const CTYPE* const in_row0 = in_plane + ih0 * in_strides[2];
+        const CTYPE* const in_row1 = in_plane + ih1 * in_strides[2];
+
+        for (int64_t ow = 0; ow < out_width; ++ow) {
+          int64_t iw0, iw1;
+          opmath_t w0lambda, w1lambda;
+          compute_source_index_and_lambda<opmath_t>(
+              iw0,
+              iw1,
+              w0lambda,
+              w1lambda,
+              ratio_w,
+              ow,
+              in_width,
+              out_width,
+              align_corners);
+          const int64_t offset0 = iw0 * in_strides[3];
+          const int64_t offset1 = iw1 * in_strides[3];
+
+          const opmath_t value = h0lambda *
+                  (w0lambda * static_cast<opmath_t>(in_row0[offset0]) +
+                   w1lambda * static_cast<opmath_t>(in_row0[offset1])) +
+              h1lambda *
+                  (w0lambda * static_cast<opmath_t>(in_row1[offset0]) +
+                   w1lambda * static_cast<opmath_t>(in_row1[offset1]));
+          out_plane[oh * out_strides[2] + ow * out_strides[3]] =
+              static_cast<CTYPE>(value);
+        }
+      }
+    }
+  }
+}
+
+} // namespace
+
+Tensor& upsample_bilinear2d_vec_out(
+    RuntimeContext& ctx,
+    const Tensor& in,
+    const optional<IntArrayRef> output_size,
+    bool align_corners,
+    const optional<exec_aten::ArrayRef<double>> scale_factors,
+    Tensor& out) {
+  ET_KERNEL_CHECK(
+      ctx,
+      check_upsample_bilinear2d_args(
+          in, output_size, align_corners, scale_factors, out),
+      InvalidArgument,
+      out);
+
+  optional<double> scale_h;
+  optional<double> scale_w;
+  ET_KERNEL_CHECK_MSG(
+      ctx,
+      resize_upsample_2d(
+          in, output_size, scale_factors, scale_h, scale_w, out) == Error::Ok,
+      InvalidArgument,
+      out,
+      "Failed to resize output tensor");
+
+  constexpr auto name = "upsample_bilinear2d.vec_out";
+
+  ET_SWITCH_FLOATH_TYPES(in.scalar_type(), ctx, name, CTYPE, [&]() {
+    upsample_bilinear2d_kernel_impl<CTYPE>(
+        in, align_corners, scale_h, scale_w, out);
+  });
+
+  return out;
+}
+
+} // namespace native
+} // namespace executor
+} // namespace torch
@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <executorch/kernels/portable/cpu/util/upsample_util.h>
+#include <executorch/runtime/kernel/kernel_includes.h>
+
+namespace torch {
+namespace executor {
+namespace native {
+
+using Tensor = exec_aten::Tensor;
+using ScalarType = exec_aten::ScalarType;
+using IntArrayRef = exec_aten::ArrayRef<int64_t>;
+using exec_aten::optional;
+
+namespace {
+
+template <typename CTYPE>
+void upsample_nearest2d_kernel_impl(
+    const Tensor& in,
+    const optional<double>& scale_h,
+    const optional<double>& scale_w,
+    Tensor& out) {
+  const CTYPE* const in_data = in.const_data_ptr<CTYPE>();
+  CTYPE* const out_data = out.mutable_data_ptr<CTYPE>();
+
+  // Index with the strides, to support any dim order.
+  const auto in_strides = in.strides();
+  const auto out_strides = out.strides();
+  const int64_t in_height = in.size(2);
+  const int64_t in_width = in.size(3);
+  const int64_t out_height = out.size(2);
+  const int64_t out_width = out.size(3);
+
+  const float ratio_h =
+      compute_scales_value<float>(scale_h, in_height, out_height);
+  const float ratio_w =
+      compute_scales_value<float>(scale_w, in_width, out_width);
+
+  for (int64_t n = 0; n < out.size(0); ++n) {
+    for (int64_t c = 0; c < out.size(1); ++c) {
+      const CTYPE* const in_plane =
+          in_data + n * in_strides[0] + c * in_strides[1];
+      CTYPE* const out_plane =
+          out_data + n * out_strides[0] + c * out_strides[1];
+
+      for (int64_t oh = 0; oh < out_height; ++oh) {
+        const int64_t ih = nearest_neighbor_compute_source_index(
+            ratio_h, oh, in_height, out_height);
+        const CTYPE* const in_row = in_plane + ih * in_strides[2];
+        CTYPE* const out_row = out_plane + oh * out_strides[2];
+
+        for (int64_t ow = 0; ow < out_width; ++ow) {
+          const int64_t iw = nearest_neighbor_compute_source_index(
+              ratio_w, ow, in_width, out_width);
+          out_row[ow * out_strides[3]] = in_row[iw * in_strides[3]];
+        }
+      }
+    }
+  }
+}
+
+} // namespace
+
+Tensor& upsample_nearest2d_vec_out(
+    RuntimeContext& ctx,
+    const Tensor& in,
+    const optional<IntArrayRef> output_size,
+    const optional<exec_aten::ArrayRef<double>> scale_factors,
+    Tensor& out) {
+  ET_KERNEL_CHECK(
+      ctx,
+      check_upsample_nearest2d_args(in, output_size, scale_factors, out),
+      InvalidArgument,
+      out);
+
+  optional<double> scale_h;
+  optional<double> scale_w;
+  ET_KERNEL_CHECK_MSG(
+      ctx,
+      resize_upsample_2d(
+          in, output_size, scale_factors, scale_h, scale_w, out) == Error::Ok,
+      InvalidArgument,
+      out,
+      "Failed to resize output tensor");
+
+  constexpr auto name = "upsample_nearest2d.vec_out";
+
+  ET_SWITCH_REALH_TYPES(in.scalar_type(), ctx, name, CTYPE, [&]() {
+    upsample_nearest2d_kernel_impl<CTYPE>(in, scale_h, scale_w, out);
+  });
+
+  return out;
+}
+
+} // namespace native
+} // namespace executor
+} // namespace torch
@@ -65,7 +65,7 @@ Tensor& var_out(
     Tensor& out) {
   (void)ctx;
 
-  ET_KERNEL_CHECK(
+  ET_KERNEL_CHECK_ARGS(
       ctx,
       check_reduction_args(in, dim_list, keepdim, {}, out),
       InvalidArgument,
@@ -103,7 +103,7 @@ Tensor& var_correction_out(
     Tensor& out) {
   (void)ctx;
 
-  ET_KERNEL_CHECK(
+  ET_KERNEL_CHECK_ARGS(
       ctx,
       check_reduction_args(in, dim_list, keepdim, {}, out),
       InvalidArgument,
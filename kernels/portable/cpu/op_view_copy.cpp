@@ -44,7 +44,7 @@ Tensor& view_copy_out(
       out,
       "Failed to resize output tensor.");
 
-  ET_KERNEL_CHECK(
+  ET_KERNEL_CHECK_ARGS(
       ctx, check_view_copy_args(self, size_int64_t, out), InvalidArgument, out);
 
   if (self.nbytes() > 0) {
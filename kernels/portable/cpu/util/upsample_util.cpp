@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <executorch/kernels/portable/cpu/util/upsample_util.h>
+#include <executorch/runtime/core/exec_aten/util/tensor_util.h>
+
+namespace torch {
+namespace executor {
+
+bool check_upsample_2d_common_args(
+    const Tensor& in,
+    const exec_aten::optional<exec_aten::ArrayRef<int64_t>>& output_size,
+    const exec_aten::optional<exec_aten::ArrayRef<double>>& scale_factors,
+    Tensor& out) {
+  ET_LOG_AND_RETURN_IF_FALSE(tensors_have_same_dtype(in, out));
+  ET_LOG_AND_RETURN_IF_FALSE(tensor_is_rank(in, 4));
+  ET_LOG_AND_RETURN_IF_FALSE(tensor_is_rank(out, 4));
+  ET_LOG_AND_RETURN_IF_FALSE(tensor_is_default_or_channels_last_dim_order(in));
+  ET_LOG_AND_RETURN_IF_FALSE(
+      tensor_is_default_or_channels_last_dim_order(out));
+
+  ET_LOG_MSG_AND_RETURN_IF_FALSE(
+      output_size.has_value() ^ scale_factors.has_value(),
+      "Exactly one of output_size and scale_factors must be set");
+  if (output_size.has_value()) {
+    ET_LOG_MSG_AND_RETURN_IF_FALSE(
+        output_size.value().size() == 2,
+        "output_size must have 2 elements, but has %zu",
+        output_size.value().size());
+    ET_LOG_MSG_AND_RETURN_IF_FALSE(
+        output_size.value()[0] > 0 && output_size.value()[1] > 0,
+        "output_size must be positive");
+  } else {
+    ET_LOG_MSG_AND_RETURN_IF_FALSE(
+        scale_factors.value().size() == 2,
+        "scale_factors must have 2 elements, but has %zu",
+        scale_factors.value().size());
+    ET_LOG_MSG_AND_RETURN_IF_FALSE(
+        scale_factors.value()[0] > 0 && scale_factors.value()[1] > 0,
+        "scale_factors must be positive");
+  }
+  ET_LOG_MSG_AND_RETURN_IF_FALSE(
+      in.size(2) > 0 && in.size(3) > 0,
+      "Input height and width must be positive");
+  return true;
+}
+
+bool check_upsample_bilinear2d_args(
+    const Tensor& in,
+    const exec_aten::optional<exec_aten::ArrayRef<int64_t>>& output_size,
+    __ET_UNUSED const bool align_corners,
+    const exec_aten::optional<exec_aten::ArrayRef<double>>& scale_factors,
+    Tensor& out) {
+  ET_LOG_AND_RETURN_IF_FALSE(tensor_is_floating_type(in));
+  return check_upsample_2d_common_args(in, output_size, scale_factors, out);
+}
+
+bool check_upsample_nearest2d_args(
+    const Tensor& in,
+    const exec_aten::optional<exec_aten::ArrayRef<int64_t>>& output_size,
+    const exec_aten::optional<exec_aten::ArrayRef<double>>& scale_factors,
+    Tensor& out) {
+  return check_upsample_2d_common_args(in, output_size, scale_factors, out);
+}
+
+Error resize_upsample_2d(
+    const Tensor& in,
+    const exec_aten::optional<exec_aten::ArrayRef<int64_t>>& output_size,
+    const exec_aten::optional<exec_aten::ArrayRef<double>>& scale_factors,
+    exec_aten::optional<double>& scale_h_out,
+    exec_aten::optional<double>& scale_w_out,
+    Tensor& out) {
+  Tensor::SizesType target_size[4] = {
+      static_cast<Tensor::SizesType>(in.size(0)),
+      static_cast<Tensor::SizesType>(in.size(1)),
+      0,
+      0};
+
+  if (scale_factors.has_value()) {
+    scale_h_out = scale_factors.value()[0];
+    scale_w_out = scale_factors.value()[1];
+    // Like ATen, the output size is the scaled input size, rounded down.
+    target_size[2] = static_cast<Tensor::SizesType>(
+        static_cast<double>(in.size(2)) * scale_h_out.value());
+    target_size[3] = static_cast<Tensor::SizesType>(
+        static_cast<double>(in.size(3)) * scale_w_out.value());
+  } else {
+    scale_h_out = exec_aten::nullopt;
+    scale_w_out = exec_aten::nullopt;
+    target_size[2] = static_cast<Tensor::SizesType>(output_size.value()[0]);
+    target_size[3] = static_cast<Tensor::SizesType>(output_size.value()[1]);
+  }
+
+  ET_CHECK_OR_RETURN_ERROR(
+      target_size[2] > 0 && target_size[3] > 0,
+      InvalidArgument,
+      "Upsampled height and width must be positive");
+
+  return resize_tensor(out, {target_size, 4});
+}
+
+} // namespace executor
+} // namespace torch
@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+
+#include <executorch/runtime/kernel/kernel_includes.h>
+
+namespace torch {
+namespace executor {
+
+bool check_upsample_2d_common_args(
+    const Tensor& in,
+    const exec_aten::optional<exec_aten::ArrayRef<int64_t>>& output_size,
+    const exec_aten::optional<exec_aten::ArrayRef<double>>& scale_factors,
+    Tensor& out);
+
+bool check_upsample_bilinear2d_args(
+    const Tensor& in,
+    const exec_aten::optional<exec_aten::ArrayRef<int64_t>>& output_size,
+    const bool align_corners,
+    const exec_aten::optional<exec_aten::ArrayRef<double>>& scale_factors,
+    Tensor& out);
+
+bool check_upsample_nearest2d_args(
+    const Tensor& in,
+    const exec_aten::optional<exec_aten::ArrayRef<int64_t>>& output_size,
+    const exec_aten::optional<exec_aten::ArrayRef<double>>& scale_factors,
+    Tensor& out);
+
+/**
+ * Resizes out to the [N, C, H, W] size given by output_size, or by scaling
+ * the spatial sizes of in with scale_factors. Also returns the scale factors
+ * along H and W to pass to the index helpers below, which are empty when the
+ * output size is given.
+ */
+Error resize_upsample_2d(
+    const Tensor& in,
+    const exec_aten::optional<exec_aten::ArrayRef<int64_t>>& output_size,
+    const exec_aten::optional<exec_aten::ArrayRef<double>>& scale_factors,
+    exec_aten::optional<double>& scale_h_out,
+    exec_aten::optional<double>& scale_w_out,
+    Tensor& out);
+
+/**
+ * Returns the factor that maps output to input coordinates along one axis:
+ * the inverse of the scale factor if there is one, or in_size / out_size.
+ */
+template <typename T>
+inline T compute_scales_value(
+    const exec_aten::optional<double>& scale,
+    int64_t in_size,
+    int64_t out_size) {
+  return scale.has_value() && scale.value() > 0.
+      ? static_cast<T>(1.0 / scale.value())
+      : static_cast<T>(in_size) / out_size;
+}
+
+/**
+ * Same as compute_scales_value(), for linear interpolation, where
+ * align_corners maps the first and last pixels of both axes onto each other.
+ */
+template <typename T>
+inline T area_pixel_compute_scale(
+    int64_t in_size,
+    int64_t out_size,
+    bool align_corners,
+    const exec_aten::optional<double>& scale) {
+  if (align_corners) {
+    return out_size > 1 ? static_cast<T>(in_size - 1) / (out_size - 1)
+                        : static_cast<T>(0);
+  }
+  return compute_scales_value<T>(scale, in_size, out_size);
+}
+
+/**
+ * Returns the input coordinate, possibly fractional, of the output index
+ * out_index, from the factor returned by area_pixel_compute_scale().
+ */
+template <typename T>
+inline T area_pixel_compute_source_index(
+    T scale,
+    int64_t out_index,
+    bool align_corners) {
+  if (align_corners) {
+    return scale * out_index;
+  }
+  const T src_index = scale * (out_index + static_cast<T>(0.5)) - 0.5;
+  return src_index < 0 ? static_cast<T>(0) : src_index;
+}
+
+/**
+ * Computes the two input indices that output index out_index interpolates
+ * between, and their weights, for linear interpolation.
+ */
+template <typename T>
+inline void compute_source_index_and_lambda(
+    int64_t& in_index0,
+    int64_t& in_index1,
+    T& lambda0,
+    T& lambda1,
+    T scale,
+    int64_t out_index,
+    int64_t in_size,
+    int64_t out_size,
+    bool align_corners) {
+  if (out_size == in_size) {
+    // The scale factor is 1: copy.
+    in_index0 = out_index;
+    in_index1 = out_index;
+    lambda0 = static_cast<T>(1);
+    lambda1 = static_cast<T>(0);
+    return;
+  }
+  const T real_in_index =
+      area_pixel_compute_source_index<T>(scale, out_index, align_corners);
+  in_index0 = std::min(static_cast<int64_t>(real_in_index), in_size - 1);
+  in_index1 = in_index0 + (in_index0 < in_size - 1 ? 1 : 0);
+  lambda1 = std::min(
+      std::max(real_in_index - in_index0, static_cast<T>(0)),
+      static_cast<T>(1));
+  lambda0 = static_cast<T>(1) - lambda1;
+}
+
+/**
+ * Returns the input index that output index out_index copies, for nearest
+ * neighbor interpolation, from the factor returned by compute_scales_value().
+ */
+inline int64_t nearest_neighbor_compute_source_index(
+    float scale,
+    int64_t out_index,
+    int64_t in_size,
+    int64_t out_size) {
+  if (out_size == in_size) {
+    return out_index;
+  }
+  if (out_size == 2 * in_size) {
+    return out_index >> 1;
+  }
+  return std::min(
+      static_cast<int64_t>(std::floor(out_index * scale)), in_size - 1);
+}
+
+} // namespace executor
+} // namespace torch
@@ -139,6 +139,91 @@ inline void vec_quantized_matmul_transb_int8(
   }
 }
 
+/// Returns a table of the float values of all 256 encodings of an 8-bit
+/// floating point type, like Float8_e4m3fn, to decode it with one load.
+template <typename FP8>
+inline const float* float8_to_float_table() {
+  struct Table {
+    float values[256];
+    Table() {
+      for (int i = 0; i < 256; ++i) {
+        values[i] = static_cast<float>(
+            FP8(static_cast<uint8_t>(i), FP8::from_bits()));
+      }
+    }
+  };
+  static const Table table;
+  return table.values;
+}
+
+/// x: m * n, y: n * p (8-bit floats decoded with `table`), z: m * p, s: n
+/// z[i][j] = sum(x[i][k] * y[k][j] * s[k])
+template <typename T, typename U = T>
+inline void vec_quantized_matmul_float8(
+    T* __restrict__ z,
+    const U* __restrict__ x,
+    const uint8_t* __restrict__ y,
+    const float* __restrict__ table,
+    const U* __restrict__ s,
+    int64_t m,
+    int64_t n,
+    int64_t p) {
+  for (size_t i = 0; i < m; ++i) {
+    for (size_t j = 0; j < p; ++j) {
+      T sum = 0;
+      for (size_t k = 0; k < n; ++k) {
+        sum += x[i * n + k] * table[y[k * p + j]] * s[k];
+      }
+      z[i * p + j] = sum;
+    }
+  }
+}
+
+/// x: m * n, y: p * n (8-bit floats decoded with `table`), z: m * p,
+/// s: p * groups
+/// z[i][j] = sum(x[i][k] * y[j][k] * s[j][k/g])
+///
+/// Rows of y are decoded to float a block at a time, so that the products
+/// with x are a plain float dot product.
+template <typename T, typename U = T, typename V = U>
+inline void vec_quantized_matmul_transb_float8(
+    T* __restrict__ z,
+    const U* __restrict__ x,
+    const uint8_t* __restrict__ y,
+    const float* __restrict__ table,
+    const V* __restrict__ s,
+    int64_t m,
+    int64_t n,
+    int64_t p,
+    int64_t g) {
+  constexpr size_t kBlock = 64;
+  float block[kBlock];
+  int64_t n_over_g = (n + g - 1) / g;
+
+  for (size_t i = 0; i < m; ++i) {
+    const U* x_row = x + i * n;
+    for (size_t j = 0; j < p; ++j) {
+      const uint8_t* y_row = y + j * n;
+      float sum = 0;
+      for (size_t k = 0; k < n; k += g) {
+        float psum = 0;
+        const size_t group_end = bounds_min(k + g, n);
+        for (size_t k2 = k; k2 < group_end; k2 += kBlock) {
+          const size_t len = bounds_min(kBlock, group_end - k2);
+          for (size_t b = 0; b < len; ++b) {
+            block[b] = table[y_row[k2 + b]];
+          }
+          for (size_t b = 0; b < len; ++b) {
+            psum += static_cast<float>(x_row[k2 + b]) * block[b];
+          }
+        }
+        sum += psum * static_cast<float>(s[j * n_over_g + k / g]);
+      }
+      z[i * p + j] = static_cast<T>(sum);
+    }
+  }
+}
+
 // mat1 (m x n), mat2 (n x p), out (m, p), self (m x p)
 // z[i][j] = sum(x[i][k] * y[k][j]), for k in range(n)
 // T for tensor dtype, U for scalar type
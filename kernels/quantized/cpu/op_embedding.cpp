@@ -60,10 +60,16 @@ void check_embedding_byte_args(
 
   ET_CHECK_MSG(
       weight.scalar_type() == ScalarType::Byte ||
-          weight.scalar_type() == ScalarType::Char,
+          weight.scalar_type() == ScalarType::Char ||
+          isFloat8Type(weight.scalar_type()),
       "weight.scalar_type() %" PRId8 " is not supported:",
       static_cast<int8_t>(weight.scalar_type()));
 
+  ET_CHECK_MSG(
+      !isFloat8Type(weight.scalar_type()) ||
+          !opt_weight_zero_points.has_value(),
+      "float8 weights do not support zero points");
+
   ET_CHECK_MSG(
       out.scalar_type() == ScalarType::Float ||
           out.scalar_type() == ScalarType::Half,
@@ -179,6 +185,27 @@ void embedding_byte_per_channel(
   }
 }
 
+/**
+ * Same as embedding_byte_per_channel(), for 8-bit floating point weights,
+ * which have no zero points.
+ */
+template <typename CTYPE_PARAMS, typename CTYPE_OUT>
+void embedding_float8_per_channel(
+    const Tensor& weight,
+    const Tensor& weight_scales,
+    const Tensor& indices,
+    Tensor& out) {
+  if (weight.scalar_type() == ScalarType::Float8_e4m3fn) {
+    embedding_byte_per_channel<
+        exec_aten::Float8_e4m3fn,
+        CTYPE_PARAMS,
+        CTYPE_OUT>(weight, weight_scales, exec_aten::nullopt, indices, out);
+  } else {
+    embedding_byte_per_channel<exec_aten::Float8_e5m2, CTYPE_PARAMS, CTYPE_OUT>(
+        weight, weight_scales, exec_aten::nullopt, indices, out);
+  }
+}
+
 void resize_out_tensor(
     const Tensor& weight,
     const Tensor& indices,
@@ -239,6 +266,13 @@ Tensor& quantized_embedding_byte_out(
       out);
 
   constexpr auto name = "quantized_decomposed::embedding_byte.out";
+  if (isFloat8Type(w_type)) {
+    ET_SWITCH_TWO_TYPES(Float, Half, out_type, ctx, name, CTYPE_OUT, [&]() {
+      embedding_float8_per_channel<CTYPE_OUT, CTYPE_OUT>(
+          weight, weight_scales, indices, out);
+    });
+    return out;
+  }
   ET_SWITCH_TWO_TYPES(Byte, Char, w_type, ctx, name, CTYPE_W, [&]() {
     ET_SWITCH_TWO_TYPES(Float, Half, out_type, ctx, name, CTYPE_OUT, [&]() {
       embedding_byte_per_channel<CTYPE_W, CTYPE_OUT, CTYPE_OUT>(
@@ -300,6 +334,15 @@ Tensor& quantized_embedding_byte_dtype_out(
   ScalarType out_type = out.scalar_type();
 
   constexpr auto name = "quantized_decomposed::embedding_byte.dtype_out";
+  if (isFloat8Type(weight_type)) {
+    ET_SWITCH_TWO_TYPES(Float, Half, params_type, ctx, name, CTYPE_P, [&]() {
+      ET_SWITCH_TWO_TYPES(Float, Half, out_type, ctx, name, CTYPE_OUT, [&]() {
+        embedding_float8_per_channel<CTYPE_P, CTYPE_OUT>(
+            weight, weight_scales, indices, out);
+      });
+    });
+    return out;
+  }
   ET_SWITCH_TWO_TYPES(Byte, Char, weight_type, ctx, name, CTYPE_W, [&]() {
     ET_SWITCH_TWO_TYPES(Float, Half, params_type, ctx, name, CTYPE_P, [&]() {
       ET_SWITCH_TWO_TYPES(Float, Half, out_type, ctx, name, CTYPE_OUT, [&]() {
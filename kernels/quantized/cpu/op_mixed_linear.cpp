@@ -41,7 +41,9 @@ bool check_quantized_mixed_linear_args(
         "dtype must be Float or Half");
   }
   ET_LOG_MSG_AND_RETURN_IF_FALSE(
-      weight.scalar_type() == ScalarType::Char, "weight dtype must be int8");
+      weight.scalar_type() == ScalarType::Char ||
+          isFloat8Type(weight.scalar_type()),
+      "weight dtype must be int8 or float8");
   ET_LOG_MSG_AND_RETURN_IF_FALSE(
       in.scalar_type() == ScalarType::Float ||
           in.scalar_type() == ScalarType::Half,
@@ -94,6 +96,27 @@ Tensor& quantized_mixed_linear_out(
         g = (n + weight_scales.size(1) - 1) / weight_scales.size(1);
       };
 
+      if (isFloat8Type(weight.scalar_type())) {
+        // Float8 weights are decoded with a table inside the blocked loop,
+        // so they are never materialized as floats.
+        const float* table =
+            weight.scalar_type() == ScalarType::Float8_e4m3fn
+            ? float8_to_float_table<exec_aten::Float8_e4m3fn>()
+            : float8_to_float_table<exec_aten::Float8_e5m2>();
+        vec_quantized_matmul_transb_float8<
+            CTYPE_OUT, // T *z
+            CTYPE>( // U *x, U *s
+            out.mutable_data_ptr<CTYPE_OUT>(),
+            in.const_data_ptr<CTYPE>(),
+            static_cast<const uint8_t*>(weight.const_data_ptr()),
+            table,
+            weight_scales.const_data_ptr<CTYPE>(),
+            m,
+            n,
+            p,
+            g);
+        return;
+      }
       // FIXME: this currently ignores dtype
       vec_quantized_matmul_transb_int8<
           CTYPE_OUT, // T *z
@@ -32,7 +32,9 @@ bool check_quantized_mixed_mm_args(
 
   ET_LOG_AND_RETURN_IF_FALSE(tensors_have_same_dtype(in, weight_scales, out));
   ET_LOG_MSG_AND_RETURN_IF_FALSE(
-      weight.scalar_type() == ScalarType::Char, "weight dtype must be int8");
+      weight.scalar_type() == ScalarType::Char ||
+          isFloat8Type(weight.scalar_type()),
+      "weight dtype must be int8 or float8");
   ET_LOG_MSG_AND_RETURN_IF_FALSE(
       in.scalar_type() == ScalarType::Float ||
           in.scalar_type() == ScalarType::Half,
@@ -74,6 +76,21 @@ Tensor& quantized_mixed_mm_out(
     size_t n = in.size(1);
     size_t p = weight.size(1);
 
+    if (isFloat8Type(weight.scalar_type())) {
+      const float* table = weight.scalar_type() == ScalarType::Float8_e4m3fn
+          ? float8_to_float_table<exec_aten::Float8_e4m3fn>()
+          : float8_to_float_table<exec_aten::Float8_e5m2>();
+      vec_quantized_matmul_float8<CTYPE>(
+          out.mutable_data_ptr<CTYPE>(),
+          in.const_data_ptr<CTYPE>(),
+          static_cast<const uint8_t*>(weight.const_data_ptr()),
+          table,
+          weight_scales.const_data_ptr<CTYPE>(),
+          m,
+          n,
+          p);
+      return;
+    }
     vec_quantized_matmul_int8<CTYPE>(
         out.mutable_data_ptr<CTYPE>(),
         in.const_data_ptr<CTYPE>(),
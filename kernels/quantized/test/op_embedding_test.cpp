@@ -227,6 +227,44 @@ TEST(OpQuantizedEmbeddingTest, TestGroupWiseQuantizedEmbedding) {
   EXPECT_TENSOR_EQ(out, expected);
 }
 
+template <ScalarType DTYPE_WEIGHT>
+void test_float8_weight() {
+  TensorFactory<ScalarType::Float> tf;
+  TensorFactory<ScalarType::Long> tf_l;
+  TensorFactory<DTYPE_WEIGHT> tfo;
+
+  // Float8 weights have no zero points, and ignore the quant range.
+  Tensor weight_scales = tf.make({3, 2}, {0.5, 1.0, 1.5, 2.0, 2.5, 3.0});
+  // clang-format off
+  Tensor qweight = tfo.make({3, 4}, {1, -2, 3, 0.5,
+                                     4, 6, -1, 1.5,
+                                     8, 3, 2, -4});
+  // clang-format on
+
+  Tensor indices = tf_l.make({3}, {0, 2, 1});
+
+  Tensor out = tf.zeros({3, 4});
+  Tensor expected =
+      tf.make({3, 4}, {0.5, -1, 3, 0.5, 20, 7.5, 6, -12, 6, 9, -2, 3});
+
+  quantized_embedding_byte_out(
+      qweight,
+      weight_scales,
+      optional<Tensor>(),
+      /*weight_quant_min=*/0,
+      /*weight_quant_max=*/0,
+      indices,
+      out);
+
+  EXPECT_TENSOR_EQ(out, expected);
+}
+
+TEST(OpQuantizedEmbeddingTest, Float8Weights) {
+  et_pal_init();
+  test_float8_weight<ScalarType::Float8_e4m3fn>();
+  test_float8_weight<ScalarType::Float8_e5m2>();
+}
+
 TEST(OpQuantizedEmbeddingTest, TestGroupWiseQuantizedEmbeddingDeath1) {
   et_pal_init();
   TensorFactory<ScalarType::Float> tf;
@@ -140,3 +140,57 @@ TEST_F(OpQuantizedMixedDtypeLinearTest, HalfInputHalfOutput_Partials) {
   test_dtype_partials<ScalarType::Half, ScalarType::Half>();
 }
 #endif
+
+template <ScalarType DTYPE_WEIGHT>
+void test_float8_weight() {
+  TensorFactory<ScalarType::Float> tf;
+  TensorFactory<DTYPE_WEIGHT> tf_weight;
+
+  // Rows longer than the blocks the kernel decodes at a time, in two groups of
+  // 75. All the weights are exact in both float8 formats.
+  constexpr int n = 150;
+  std::vector<float> input_data(n);
+  std::vector<typename TensorFactory<DTYPE_WEIGHT>::ctype> weight_data;
+  for (int k = 0; k < n; ++k) {
+    input_data[k] = (k % 7) * 0.25f;
+  }
+  for (int k = 0; k < n; ++k) {
+    weight_data.push_back((k % 5) - 2.0f);
+  }
+  for (int k = 0; k < n; ++k) {
+    weight_data.push_back((k % 3) * 0.5f);
+  }
+  const std::vector<float> scales = {0.5, 0.25, 2, 1};
+
+  std::vector<float> expected_data(2, 0.0f);
+  for (int j = 0; j < 2; ++j) {
+    for (int k = 0; k < n; ++k) {
+      expected_data[j] += input_data[k] *
+          static_cast<float>(weight_data[j * n + k]) * scales[j * 2 + k / 75];
+    }
+  }
+
+  Tensor input = tf.make(/*sizes=*/{1, n}, input_data);
+  Tensor weight = tf_weight.make(/*sizes=*/{2, n}, weight_data);
+  Tensor weight_scales = tf.make(/*sizes=*/{2, 2}, scales);
+  const optional<Tensor> opt_weight_zp{};
+  const optional<ScalarType> opt_dtype_out{};
+
+  Tensor out = tf.zeros({1, 2});
+  Tensor expected = tf.make(/*sizes=*/{1, 2}, expected_data);
+
+  RuntimeContext ctx{};
+
+  quantized_mixed_linear_out(
+      ctx, input, weight, weight_scales, opt_weight_zp, opt_dtype_out, out);
+
+  EXPECT_TENSOR_CLOSE(out, expected);
+}
+
+TEST_F(OpQuantizedMixedDtypeLinearTest, Float8E4M3FNWeight) {
+  test_float8_weight<ScalarType::Float8_e4m3fn>();
+}
+
+TEST_F(OpQuantizedMixedDtypeLinearTest, Float8E5M2Weight) {
+  test_float8_weight<ScalarType::Float8_e5m2>();
+}
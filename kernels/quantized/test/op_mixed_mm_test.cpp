@@ -69,3 +69,41 @@ TEST_F(OpQuantizedMixedMMTest, FloatInput) {
 TEST_F(OpQuantizedMixedMMTest, HalfInput) {
   test_dtype<ScalarType::Half>();
 }
+
+template <ScalarType DTYPE_WEIGHT>
+void test_float8_weight() {
+  TensorFactory<ScalarType::Float> tf;
+  TensorFactory<DTYPE_WEIGHT> tf_weight;
+
+  Tensor input = tf.make(
+      /*sizes=*/{1, 3},
+      /*data=*/{1.0, 1.5, 2.0});
+  // Exact in both float8 formats.
+  Tensor weight = tf_weight.make(
+      /*sizes=*/{3, 2},
+      /*data=*/{5, 4, 3, 2, 1, 1});
+  Tensor weight_scales = tf.make(
+      /*sizes=*/{3},
+      /*data=*/{0.2, 0.4, 0.5});
+  const optional<Tensor> opt_weight_zp{};
+
+  Tensor out = tf.zeros({1, 2});
+
+  Tensor expected = tf.make(
+      /*sizes=*/{1, 2},
+      /*data=*/{3.8, 3.0});
+
+  RuntimeContext ctx{};
+
+  quantized_mixed_mm_out(ctx, input, weight, weight_scales, opt_weight_zp, out);
+
+  EXPECT_TENSOR_CLOSE(out, expected);
+}
+
+TEST_F(OpQuantizedMixedMMTest, Float8E4M3FNWeight) {
+  test_float8_weight<ScalarType::Float8_e4m3fn>();
+}
+
+TEST_F(OpQuantizedMixedMMTest, Float8E5M2Weight) {
+  test_float8_weight<ScalarType::Float8_e5m2>();
+}
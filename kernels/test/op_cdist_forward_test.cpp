@@ -6,6 +6,10 @@
  * LICENSE file in the root directory of this source tree.
  */
 
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
 #include <executorch/kernels/test/FunctionHeaderWrapper.h> // Declares the operator
 #include <executorch/kernels/test/TestUtil.h>
 #include <executorch/runtime/core/exec_aten/exec_aten.h>
@@ -126,3 +130,95 @@ TEST_F(OpCdistForwardOutTest, SmokeTest) {
   op_cdist_forward_out(x1, x2, INFINITY, compute_mode, out);
   EXPECT_TENSOR_CLOSE(out, linf);
 }
+
+namespace {
+
+// Returns the distances between x1[b][i][k] = b * P + i and
+// x2[j][k] = (k % 2 ? j : -j), for the inputs of LargePointSets below. Over
+// the M = 19 features, 9 of the absolute differences are |g - j| and 10 are
+// g + j, where g = b * P + i.
+template <typename CTYPE>
+std::vector<CTYPE>
+expected_large_cdist(int32_t B, int32_t P, int32_t R, double p) {
+  std::vector<CTYPE> expected;
+  for (int32_t g = 0; g < B * P; ++g) {
+    for (int32_t j = 0; j < R; ++j) {
+      const double d_odd = std::abs(g - j);
+      const double d_even = g + j;
+      double dist;
+      if (p == 0.0) {
+        dist = (d_odd != 0 ? 9 : 0) + (d_even != 0 ? 10 : 0);
+      } else if (p == INFINITY) {
+        dist = std::max(d_odd, d_even);
+      } else {
+        dist = std::pow(
+            9 * std::pow(d_odd, p) + 10 * std::pow(d_even, p), 1.0 / p);
+      }
+      expected.push_back(static_cast<CTYPE>(dist));
+    }
+  }
+  return expected;
+}
+
+} // namespace
+
+TEST_F(OpCdistForwardOutTest, LargePointSets) {
+  TensorFactory<ScalarType::Float> tf;
+
+  // Large enough for the default compute_mode to use the matrix product for
+  // p = 2, with more features than a vector and a number of x1 rows that is
+  // not a multiple of the row blocks of the optimized kernel. x2 is
+  // broadcasted over the batch of x1.
+  constexpr int32_t B = 2, P = 37, R = 29, M = 19;
+  std::vector<float> x1_data;
+  for (int32_t g = 0; g < B * P; ++g) {
+    x1_data.insert(x1_data.end(), M, static_cast<float>(g));
+  }
+  std::vector<float> x2_data;
+  for (int32_t j = 0; j < R; ++j) {
+    for (int32_t k = 0; k < M; ++k) {
+      x2_data.push_back(static_cast<float>(k % 2 ? j : -j));
+    }
+  }
+  Tensor x1 = tf.make({B, P, M}, x1_data);
+  Tensor x2 = tf.make({R, M}, x2_data);
+  Tensor out = tf.zeros({B, P, R});
+
+  for (const double p : {0.0, 1.0, 2.0, 3.0, (double)INFINITY}) {
+    Tensor expected =
+        tf.make({B, P, R}, expected_large_cdist<float>(B, P, R, p));
+    // compute_mode 1 and 2 force and disable the matrix product for p = 2,
+    // and are ignored for other values of p.
+    for (const optional<int64_t>& compute_mode :
+         {optional<int64_t>(), optional<int64_t>(1), optional<int64_t>(2)}) {
+      op_cdist_forward_out(x1, x2, p, compute_mode, out);
+      EXPECT_TENSOR_CLOSE(out, expected);
+    }
+  }
+}
+
+TEST_F(OpCdistForwardOutTest, LargePointSetsDouble) {
+  TensorFactory<ScalarType::Double> tf;
+
+  constexpr int32_t B = 1, P = 37, R = 29, M = 19;
+  std::vector<double> x1_data;
+  for (int32_t g = 0; g < B * P; ++g) {
+    x1_data.insert(x1_data.end(), M, static_cast<double>(g));
+  }
+  std::vector<double> x2_data;
+  for (int32_t j = 0; j < R; ++j) {
+    for (int32_t k = 0; k < M; ++k) {
+      x2_data.push_back(static_cast<double>(k % 2 ? j : -j));
+    }
+  }
+  Tensor out = tf.zeros({P, R});
+
+  op_cdist_forward_out(
+      tf.make({P, M}, x1_data),
+      tf.make({R, M}, x2_data),
+      2.0,
+      optional<int64_t>(),
+      out);
+  EXPECT_TENSOR_CLOSE(
+      out, tf.make({P, R}, expected_large_cdist<double>(B, P, R, 2.0)));
+}
@@ -397,6 +397,39 @@ TEST_F(OpConstantPadNDOutTest, TestPadDim0And1And2) {
 #undef TEST_ENTRY
 }
 
+TEST_F(OpConstantPadNDOutTest, LargeInputPadDim1And3) {
+  TensorFactory<ScalarType::Float> tf;
+
+  // Large enough to be split across threads in the optimized kernel. Dim 2 is
+  // not padded, so each output row along dim 1 holds a whole [7, 305] block.
+  constexpr int32_t N = 3, C = 5, H = 7, W = 300;
+  constexpr int32_t OC = C + 3, OW = W + 5;
+  const std::vector<int64_t> padding = {2, 3, 0, 0, 1, 2};
+  std::vector<float> data(N * C * H * W);
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<float>(i % 251);
+  }
+  std::vector<float> expected(N * OC * H * OW, 7);
+  for (int32_t n = 0; n < N; ++n) {
+    for (int32_t c = 0; c < C; ++c) {
+      for (int32_t h = 0; h < H; ++h) {
+        for (int32_t w = 0; w < W; ++w) {
+          expected[((n * OC + c + 1) * H + h) * OW + w + 2] =
+              data[((n * C + c) * H + h) * W + w];
+        }
+      }
+    }
+  }
+
+  Tensor out = tf.zeros({N, OC, H, OW});
+  op_constant_pad_nd_out(
+      tf.make({N, C, H, W}, data),
+      IntArrayRef(padding.data(), padding.size()),
+      7,
+      out);
+  EXPECT_TENSOR_EQ(out, tf.make({N, OC, H, OW}, expected));
+}
+
 TEST_F(OpConstantPadNDOutTest, DifferentInputOutputTypesFail) {
   TensorFactory<ScalarType::Float> tf;
   TensorFactory<ScalarType::Double> tf_out;
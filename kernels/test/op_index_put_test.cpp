@@ -550,6 +550,28 @@ TEST_F(OpIndexPutOutTest, PutTwoValuesAtSameIndex) {
   run_test_cases(x, /*indices=*/indices, values, expected, expected_accum);
 }
 
+TEST_F(OpIndexPutOutTest, OutAliasesInput) {
+  if (torch::executor::testing::SupportedFeatures::get()->is_aten) {
+    GTEST_SKIP() << "ATen kernel rejects out overlapping self";
+  }
+  TensorFactory<ScalarType::Float> tf;
+  TensorFactory<ScalarType::Long> tfl;
+
+  // A KV cache style update, writing rows in place of the input.
+  Tensor x = tf.make({3, 2}, {1., 2., 3., 4., 5., 6.});
+  optional<Tensor> indices[] = {optional<Tensor>(tfl.make({1}, {2}))};
+  Tensor values = tf.make({1, 2}, {7., 8.});
+  Tensor expected = tf.make({3, 2}, {1., 2., 3., 4., 7., 8.});
+
+  Tensor ret = op_index_put_out(x, indices, values, /*accumulate=*/false, x);
+  EXPECT_TENSOR_EQ(ret, x);
+  EXPECT_TENSOR_EQ(x, expected);
+
+  Tensor expected_accum = tf.make({3, 2}, {1., 2., 3., 4., 14., 16.});
+  op_index_put_out(x, indices, values, /*accumulate=*/true, x);
+  EXPECT_TENSOR_EQ(x, expected_accum);
+}
+
 TEST_F(OpIndexPutOutTest, IndicesFewerThanInputDimSupported) {
   TensorFactory<ScalarType::Double> tf;
   TensorFactory<ScalarType::Int> tfi;
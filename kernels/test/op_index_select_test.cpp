@@ -437,6 +437,23 @@ TEST_F(OpIndexSelectOutTest, IndexWithInvalidDimDies) {
 }
 
 #if !defined(USE_ATEN_LIB)
+TEST_F(OpIndexSelectOutTest, OutOfRangeIndexFailsAfterValidatedCall) {
+  TensorFactory<ScalarType::Float> tf;
+  TensorFactory<ScalarType::Long> tfl;
+  Tensor x = tf.ones({3, 2});
+  Tensor out = tf.zeros({2, 2});
+
+  op_index_select_out(x, 0, tfl.make({2}, {0, 2}), out);
+  EXPECT_EQ(context_.failure_state(), torch::executor::Error::Ok);
+
+  // Same dtypes and shapes as the valid call: a validate-once Method would
+  // tell the kernel that its arguments were already validated.
+  context_ = exec_aten::RuntimeContext(
+      /*event_tracer=*/nullptr, /*skip_arg_validation=*/true);
+  ET_EXPECT_KERNEL_FAILURE(
+      context_, op_index_select_out(x, 0, tfl.make({2}, {0, 3}), out));
+}
+
 TEST_F(OpIndexSelectOutTest, UpperBoundOutTensor) {
   TensorFactory<ScalarType::Double> tf;
   TensorFactory<ScalarType::Long> tfl;
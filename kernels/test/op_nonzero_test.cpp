@@ -13,6 +13,8 @@
 #include <executorch/runtime/core/exec_aten/testing_util/tensor_util.h>
 #include <gtest/gtest.h>
 
+#include <vector>
+
 using namespace ::testing;
 using exec_aten::ScalarType;
 using exec_aten::Tensor;
@@ -41,6 +43,33 @@ class OpNonzeroTest : public OperatorTest {
                                                 1, 1}));
     // clang-format on
   }
+
+  // Checks nonzero on an input large enough to be split into several chunks
+  // in the optimized kernel, whose rows straddle the chunk boundaries. Every
+  // 7th element and a run of elements in the middle are nonzero.
+  template <exec_aten::ScalarType DTYPE>
+  void test_large_input() {
+    TensorFactory<DTYPE> tf_input;
+    TensorFactory<ScalarType::Long> tf_long;
+
+    const std::vector<int32_t> sizes = {3, 37, 1021};
+    const int64_t numel = 3 * 37 * 1021;
+    std::vector<typename TensorFactory<DTYPE>::ctype> data(numel, 0);
+    std::vector<int64_t> expected;
+    for (int64_t i = 0; i < numel; ++i) {
+      if (i % 7 == 3 || (i >= 50000 && i < 50100)) {
+        data[i] = 1;
+        expected.push_back(i / (37 * 1021));
+        expected.push_back(i / 1021 % 37);
+        expected.push_back(i % 1021);
+      }
+    }
+    const int32_t num_nonzero = expected.size() / 3;
+
+    Tensor out = tf_long.zeros({num_nonzero, 3});
+    op_nonzero_out(tf_input.make(sizes, data), out);
+    EXPECT_TENSOR_EQ(out, tf_long.make({num_nonzero, 3}, expected));
+  }
 };
 
 TEST_F(OpNonzeroTest, AllDtypesSupported) {
@@ -49,6 +78,22 @@ TEST_F(OpNonzeroTest, AllDtypesSupported) {
 #undef TEST_ENTRY
 }
 
+TEST_F(OpNonzeroTest, LargeInput) {
+  test_large_input<ScalarType::Bool>();
+  test_large_input<ScalarType::Byte>();
+  test_large_input<ScalarType::Float>();
+  test_large_input<ScalarType::Long>();
+}
+
+TEST_F(OpNonzeroTest, AllZeros) {
+  TensorFactory<ScalarType::Bool> tf_input;
+  TensorFactory<ScalarType::Long> tf_long;
+
+  Tensor out = tf_long.zeros({0, 2});
+  op_nonzero_out(tf_input.zeros({300, 301}), out);
+  EXPECT_TENSOR_EQ(out, tf_long.zeros({0, 2}));
+}
+
 #if !defined(USE_ATEN_LIB)
 TEST_F(OpNonzeroTest, StaticShapeInconsistentSize) {
   TensorFactory<ScalarType::Float> tf_input;
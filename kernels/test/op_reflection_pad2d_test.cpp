@@ -15,6 +15,8 @@
 
 #include <gtest/gtest.h>
 
+#include <vector>
+
 using namespace ::testing;
 using exec_aten::ArrayRef;
 using exec_aten::ScalarType;
@@ -93,3 +95,35 @@ TEST_F(OpReflectionPad2DOutTest, SmokeTestNegBottomPad) {
   op_reflection_pad2d_out(self, padding, out);
   EXPECT_TENSOR_CLOSE(out, out_expected);
 }
+
+TEST_F(OpReflectionPad2DOutTest, LargeInput) {
+  TensorFactory<ScalarType::Float> tfFloat;
+
+  // Large enough to be split across threads in the optimized kernel.
+  constexpr int64_t C = 6, H = 20, W = 300;
+  constexpr int64_t OH = H + 5, OW = W + 7;
+  int64_t padding_data[4] = {4, 3, 2, 3};
+  std::vector<float> data(C * H * W);
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<float>(i % 251);
+  }
+  // Reflect j, an index into the padded size + pad_before + pad_after.
+  const auto reflect = [](int64_t j, int64_t size, int64_t pad_before) {
+    j -= pad_before;
+    return j < 0 ? -j : j >= size ? 2 * (size - 1) - j : j;
+  };
+  std::vector<float> expected(C * OH * OW);
+  for (int64_t c = 0; c < C; ++c) {
+    for (int64_t h = 0; h < OH; ++h) {
+      for (int64_t w = 0; w < OW; ++w) {
+        expected[(c * OH + h) * OW + w] =
+            data[(c * H + reflect(h, H, 2)) * W + reflect(w, W, 4)];
+      }
+    }
+  }
+
+  Tensor out = tfFloat.zeros({C, OH, OW});
+  op_reflection_pad2d_out(
+      tfFloat.make({C, H, W}, data), ArrayRef<int64_t>(padding_data, 4), out);
+  EXPECT_TENSOR_EQ(out, tfFloat.make({C, OH, OW}, expected));
+}
@@ -15,6 +15,8 @@
 
 #include <gtest/gtest.h>
 
+#include <vector>
+
 using namespace ::testing;
 using exec_aten::ArrayRef;
 using exec_aten::ScalarType;
@@ -113,3 +115,41 @@ TEST_F(OpReplicationPad3DOutTest, SmokeTestNegBackPad) {
   op_replication_pad3d_out(self, padding, out);
   EXPECT_TENSOR_CLOSE(out, out_expected);
 }
+
+TEST_F(OpReplicationPad3DOutTest, LargeInput) {
+  TensorFactory<ScalarType::Float> tfFloat;
+
+  // Large enough to be split across threads in the optimized kernel, with
+  // the input cropped on the right.
+  constexpr int64_t C = 3, D = 4, H = 10, W = 300;
+  constexpr int64_t OD = D + 3, OH = H + 2, OW = W - 3;
+  int64_t padding_data[6] = {2, -5, 1, 1, 2, 1};
+  std::vector<float> data(C * D * H * W);
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<float>(i % 251);
+  }
+  // Clamp j, an index into the padded size + pad_before + pad_after.
+  const auto clamp = [](int64_t j, int64_t size, int64_t pad_before) {
+    j -= pad_before;
+    return j < 0 ? 0 : j >= size ? size - 1 : j;
+  };
+  std::vector<float> expected(C * OD * OH * OW);
+  for (int64_t c = 0; c < C; ++c) {
+    for (int64_t d = 0; d < OD; ++d) {
+      for (int64_t h = 0; h < OH; ++h) {
+        for (int64_t w = 0; w < OW; ++w) {
+          expected[((c * OD + d) * OH + h) * OW + w] =
+              data[((c * D + clamp(d, D, 2)) * H + clamp(h, H, 1)) * W +
+                   clamp(w, W, 2)];
+        }
+      }
+    }
+  }
+
+  Tensor out = tfFloat.zeros({C, OD, OH, OW});
+  op_replication_pad3d_out(
+      tfFloat.make({C, D, H, W}, data),
+      ArrayRef<int64_t>(padding_data, 6),
+      out);
+  EXPECT_TENSOR_EQ(out, tfFloat.make({C, OD, OH, OW}, expected));
+}
@@ -382,6 +382,25 @@ TEST_F(OpScatterAddOutTest, MismatchedInputDtypesDies) {
       context_, op_scatter_add_out(self, 0, index, src, out));
 }
 
+TEST_F(OpScatterAddOutTest, OutOfRangeIndexFailsAfterValidatedCall) {
+  TensorFactory<ScalarType::Float> tf;
+  TensorFactory<ScalarType::Long> tf_index;
+  Tensor self = tf.zeros({2, 3});
+  Tensor src = tf.ones({2, 3});
+  Tensor out = tf.zeros({2, 3});
+
+  op_scatter_add_out(self, 1, tf_index.make({2, 1}, {0, 2}), src, out);
+  EXPECT_EQ(context_.failure_state(), torch::executor::Error::Ok);
+
+  // Same dtypes and shapes as the valid call: a validate-once Method would
+  // tell the kernel that its arguments were already validated.
+  context_ = exec_aten::RuntimeContext(
+      /*event_tracer=*/nullptr, /*skip_arg_validation=*/true);
+  ET_EXPECT_KERNEL_FAILURE(
+      context_,
+      op_scatter_add_out(self, 1, tf_index.make({2, 1}, {0, 3}), src, out));
+}
+
 TEST_F(OpScatterAddOutTest, DynamicShapeUpperBoundSameAsExpected) {
   test_dynamic_shape(
       {2, 3, 4}, torch::executor::TensorShapeDynamism::DYNAMIC_BOUND);
@@ -697,6 +697,24 @@ TEST_F(OpSliceCopyTensorOutTest, EmptyInputSupported) {
   }
 }
 
+TEST_F(OpSliceCopyTensorOutTest, OutAliasesInput) {
+  if (torch::executor::testing::SupportedFeatures::get()->is_aten) {
+    GTEST_SKIP() << "ATen kernel rejects out overlapping self";
+  }
+  TensorFactory<ScalarType::Float> tf;
+
+  // Writing the slice in place, as done for mutable buffers, must keep the
+  // rest of the input intact.
+  Tensor input = tf.make({3, 2}, {1., 2., 3., 4., 5., 6.});
+  Tensor src = tf.make({1, 2}, {7., 8.});
+  Tensor expect = tf.make({3, 2}, {1., 2., 7., 8., 5., 6.});
+
+  Tensor ret = op_slice_scatter_out(
+      input, src, /*dim=*/0, /*start=*/1, /*end=*/2, /*step=*/1, input);
+  EXPECT_TENSOR_EQ(ret, input);
+  EXPECT_TENSOR_EQ(input, expect);
+}
+
 TEST_F(OpSliceCopyTensorOutTest, EmptySizeInputDies) {
   TensorFactory<ScalarType::Int> tf;
 
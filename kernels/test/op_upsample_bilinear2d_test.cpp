@@ -0,0 +1,271 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <executorch/kernels/test/FunctionHeaderWrapper.h> // Declares the operator
+#include <executorch/kernels/test/TestUtil.h>
+#include <executorch/kernels/test/supported_features.h>
+#include <executorch/runtime/core/exec_aten/exec_aten.h>
+#include <executorch/runtime/core/exec_aten/testing_util/tensor_factory.h>
+#include <executorch/runtime/core/exec_aten/testing_util/tensor_util.h>
+
+#include <gtest/gtest.h>
+
+using namespace ::testing;
+using exec_aten::ArrayRef;
+using exec_aten::nullopt;
+using exec_aten::optional;
+using exec_aten::ScalarType;
+using exec_aten::Tensor;
+using torch::executor::testing::TensorFactory;
+
+class OpUpsampleBilinear2dOutTest : public OperatorTest {
+ protected:
+  Tensor& op_upsample_bilinear2d_out(
+      const Tensor& in,
+      optional<ArrayRef<int64_t>> output_size,
+      bool align_corners,
+      optional<ArrayRef<double>> scale_factors,
+      Tensor& out) {
+    return torch::executor::aten::upsample_bilinear2d_outf(
+        context_, in, output_size, align_corners, scale_factors, out);
+  }
+
+  template <ScalarType DTYPE>
+  void test_upsample_2x() {
+    TensorFactory<DTYPE> tf;
+
+    Tensor in = tf.make({1, 1, 2, 2}, {1, 2, 3, 4});
+    Tensor out = tf.zeros({1, 1, 4, 4});
+    int64_t output_size[] = {4, 4};
+
+    op_upsample_bilinear2d_out(
+        in,
+        optional<ArrayRef<int64_t>>({output_size, 2}),
+        /*align_corners=*/false,
+        nullopt,
+        out);
+
+    // Output pixels sample the input at -0.25 (clamped to 0), 0.25, 0.75 and
+    // 1.25 along each axis.
+    // clang-format off
+    EXPECT_TENSOR_CLOSE(out, tf.make({1, 1, 4, 4}, {
+        1,   1.25, 1.75, 2,
+        1.5, 1.75, 2.25, 2.5,
+        2.5, 2.75, 3.25, 3.5,
+        3,   3.25, 3.75, 4}));
+    // clang-format on
+  }
+};
+
+TEST_F(OpUpsampleBilinear2dOutTest, AllFloatDtypesSupported) {
+#define TEST_ENTRY(ctype, dtype) test_upsample_2x<ScalarType::dtype>();
+  ET_FORALL_FLOATH_TYPES(TEST_ENTRY);
+#undef TEST_ENTRY
+}
+
+TEST_F(OpUpsampleBilinear2dOutTest, AlignCorners) {
+  TensorFactory<ScalarType::Float> tf;
+
+  Tensor in = tf.make({1, 1, 2, 2}, {1, 2, 3, 4});
+  Tensor out = tf.zeros({1, 1, 3, 3});
+  int64_t output_size[] = {3, 3};
+
+  op_upsample_bilinear2d_out(
+      in,
+      optional<ArrayRef<int64_t>>({output_size, 2}),
+      /*align_corners=*/true,
+      nullopt,
+      out);
+
+  // The corners of the output are the corners of the input.
+  // clang-format off
+  EXPECT_TENSOR_CLOSE(out, tf.make({1, 1, 3, 3}, {
+      1, 1.5, 2,
+      2, 2.5, 3,
+      3, 3.5, 4}));
+  // clang-format on
+}
+
+TEST_F(OpUpsampleBilinear2dOutTest, NonIntegerOutputSize) {
+  TensorFactory<ScalarType::Float> tf;
+
+  Tensor in = tf.make({1, 1, 2, 3}, {0, 1, 2, 3, 4, 5});
+  Tensor out = tf.zeros({1, 1, 3, 5});
+  int64_t output_size[] = {3, 5};
+
+  op_upsample_bilinear2d_out(
+      in,
+      optional<ArrayRef<int64_t>>({output_size, 2}),
+      /*align_corners=*/false,
+      nullopt,
+      out);
+
+  // clang-format off
+  EXPECT_TENSOR_CLOSE(out, tf.make({1, 1, 3, 5}, {
+      0,   0.4, 1,   1.6, 2,
+      1.5, 1.9, 2.5, 3.1, 3.5,
+      3,   3.4, 4,   4.6, 5}));
+  // clang-format on
+}
+
+TEST_F(OpUpsampleBilinear2dOutTest, ScaleFactors) {
+  TensorFactory<ScalarType::Float> tf;
+
+  Tensor in = tf.make({1, 1, 2, 3}, {0, 1, 2, 3, 4, 5});
+  Tensor out = tf.zeros({1, 1, 3, 4});
+  double scales[] = {1.5, 1.5};
+
+  op_upsample_bilinear2d_out(
+      in,
+      nullopt,
+      /*align_corners=*/false,
+      optional<ArrayRef<double>>({scales, 2}),
+      out);
+
+  // The output width is floor(3 * 1.5) = 4, but the source coordinates use the
+  // scale factor, 1.5, and not the ratio of the widths, 4 / 3.
+  // clang-format off
+  EXPECT_TENSOR_CLOSE(out, tf.make({1, 1, 3, 4}, {
+      0,   0.5, 1.166667, 1.833333,
+      1.5, 2,   2.666667, 3.333333,
+      3,   3.5, 4.166667, 4.833333}));
+  // clang-format on
+}
+
+TEST_F(OpUpsampleBilinear2dOutTest, ChannelsLast) {
+  TensorFactory<ScalarType::Float> tf;
+
+  // Nine channels, to cover both full vectors and the remainder in the
+  // optimized kernel. Channel c holds {c, c + 9, c + 18, c + 27} in NCHW.
+  // clang-format off
+  Tensor in = tf.make_channels_last({1, 9, 2, 2}, {
+      0, 4, 8, 12, 16, 20, 24, 28, 32,
+      1, 5, 9, 13, 17, 21, 25, 29, 33,
+      2, 6, 10, 14, 18, 22, 26, 30, 34,
+      3, 7, 11, 15, 19, 23, 27, 31, 35});
+  // clang-format on
+  Tensor out = tf.full_channels_last({1, 9, 3, 3}, 0);
+  int64_t output_size[] = {3, 3};
+
+  op_upsample_bilinear2d_out(
+      in,
+      optional<ArrayRef<int64_t>>({output_size, 2}),
+      /*align_corners=*/false,
+      nullopt,
+      out);
+
+  // clang-format off
+  EXPECT_TENSOR_CLOSE(out, tf.make_channels_last({1, 9, 3, 3}, {
+      0,   4,   8,   12,   16,   20,   24,   28,   32,
+      0.5, 4.5, 8.5, 12.5, 16.5, 20.5, 24.5, 28.5, 32.5,
+      1,   5,   9,   13,   17,   21,   25,   29,   33,
+      1,   5,   9,   13,   17,   21,   25,   29,   33,
+      1.5, 5.5, 9.5, 13.5, 17.5, 21.5, 25.5, 29.5, 33.5,
+      2,   6,   10,  14,   18,   22,   26,   30,   34,
+      2,   6,   10,  14,   18,   22,   26,   30,   34,
+      2.5, 6.5, 10.5, 14.5, 18.5, 22.5, 26.5, 30.5, 34.5,
+      3,   7,   11,  15,   19,   23,   27,   31,   35}));
+  // clang-format on
+}
+
+TEST_F(OpUpsampleBilinear2dOutTest, ChannelsLastMatchesContiguous) {
+  TensorFactory<ScalarType::Float> tf;
+
+  // Wide enough to span several column tiles in the optimized kernel.
+  constexpr int32_t N = 2, C = 11, H = 3, W = 700;
+  constexpr int32_t OH = 7, OW = 1500;
+  std::vector<float> data(N * C * H * W);
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<float>(i % 1013) / 8;
+  }
+  std::vector<float> data_cl(data.size());
+  for (int32_t n = 0; n < N; ++n) {
+    for (int32_t c = 0; c < C; ++c) {
+      for (int32_t hw = 0; hw < H * W; ++hw) {
+        data_cl[(n * H * W + hw) * C + c] = data[(n * C + c) * H * W + hw];
+      }
+    }
+  }
+  int64_t output_size[] = {OH, OW};
+
+  for (const bool align_corners : {false, true}) {
+    Tensor out = tf.zeros({N, C, OH, OW});
+    op_upsample_bilinear2d_out(
+        tf.make({N, C, H, W}, data),
+        optional<ArrayRef<int64_t>>({output_size, 2}),
+        align_corners,
+        nullopt,
+        out);
+    Tensor out_cl = tf.full_channels_last({N, C, OH, OW}, 0);
+    op_upsample_bilinear2d_out(
+        tf.make_channels_last({N, C, H, W}, data_cl),
+        optional<ArrayRef<int64_t>>({output_size, 2}),
+        align_corners,
+        nullopt,
+        out_cl);
+
+    const float* const out_data = out.const_data_ptr<float>();
+    std::vector<float> expected(out.numel());
+    for (int32_t n = 0; n < N; ++n) {
+      for (int32_t c = 0; c < C; ++c) {
+        for (int32_t hw = 0; hw < OH * OW; ++hw) {
+          expected[(n * OH * OW + hw) * C + c] =
+              out_data[(n * C + c) * OH * OW + hw];
+        }
+      }
+    }
+    EXPECT_TENSOR_CLOSE(
+        out_cl, tf.make_channels_last({N, C, OH, OW}, expected));
+  }
+}
+
+TEST_F(OpUpsampleBilinear2dOutTest, IntegerInputDies) {
+  TensorFactory<ScalarType::Int> tf;
+
+  Tensor in = tf.ones({1, 1, 2, 2});
+  Tensor out = tf.zeros({1, 1, 4, 4});
+  int64_t output_size[] = {4, 4};
+
+  ET_EXPECT_KERNEL_FAILURE(
+      context_,
+      op_upsample_bilinear2d_out(
+          in,
+          optional<ArrayRef<int64_t>>({output_size, 2}),
+          /*align_corners=*/false,
+          nullopt,
+          out));
+}
+
+TEST_F(OpUpsampleBilinear2dOutTest, MissingOutputSizeAndScalesDies) {
+  TensorFactory<ScalarType::Float> tf;
+
+  Tensor in = tf.ones({1, 1, 2, 2});
+  Tensor out = tf.zeros({1, 1, 4, 4});
+
+  ET_EXPECT_KERNEL_FAILURE(
+      context_,
+      op_upsample_bilinear2d_out(
+          in, nullopt, /*align_corners=*/false, nullopt, out));
+}
+
+TEST_F(OpUpsampleBilinear2dOutTest, WrongScaleFactorsLengthDies) {
+  TensorFactory<ScalarType::Float> tf;
+
+  Tensor in = tf.ones({1, 1, 2, 2});
+  Tensor out = tf.zeros({1, 1, 4, 4});
+  double scales[] = {2};
+
+  ET_EXPECT_KERNEL_FAILURE(
+      context_,
+      op_upsample_bilinear2d_out(
+          in,
+          nullopt,
+          /*align_corners=*/false,
+          optional<ArrayRef<double>>({scales, 1}),
+          out));
+}
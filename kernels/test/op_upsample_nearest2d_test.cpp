@@ -0,0 +1,221 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <executorch/kernels/test/FunctionHeaderWrapper.h> // Declares the operator
+#include <executorch/kernels/test/TestUtil.h>
+#include <executorch/kernels/test/supported_features.h>
+#include <executorch/runtime/core/exec_aten/exec_aten.h>
+#include <executorch/runtime/core/exec_aten/testing_util/tensor_factory.h>
+#include <executorch/runtime/core/exec_aten/testing_util/tensor_util.h>
+
+#include <gtest/gtest.h>
+
+using namespace ::testing;
+using exec_aten::ArrayRef;
+using exec_aten::nullopt;
+using exec_aten::optional;
+using exec_aten::ScalarType;
+using exec_aten::Tensor;
+using torch::executor::testing::TensorFactory;
+
+class OpUpsampleNearest2dOutTest : public OperatorTest {
+ protected:
+  Tensor& op_upsample_nearest2d_out(
+      const Tensor& in,
+      optional<ArrayRef<int64_t>> output_size,
+      optional<ArrayRef<double>> scale_factors,
+      Tensor& out) {
+    return torch::executor::aten::upsample_nearest2d_outf(
+        context_, in, output_size, scale_factors, out);
+  }
+
+  template <ScalarType DTYPE>
+  void test_upsample_2x() {
+    TensorFactory<DTYPE> tf;
+
+    Tensor in = tf.make({1, 1, 2, 2}, {1, 2, 3, 4});
+    Tensor out = tf.zeros({1, 1, 4, 4});
+    double scales[] = {2, 2};
+
+    op_upsample_nearest2d_out(
+        in, nullopt, optional<ArrayRef<double>>({scales, 2}), out);
+
+    // clang-format off
+    EXPECT_TENSOR_EQ(out, tf.make({1, 1, 4, 4}, {
+        1, 1, 2, 2,
+        1, 1, 2, 2,
+        3, 3, 4, 4,
+        3, 3, 4, 4}));
+    // clang-format on
+  }
+};
+
+TEST_F(OpUpsampleNearest2dOutTest, AllRealHDtypesSupported) {
+#define TEST_ENTRY(ctype, dtype) test_upsample_2x<ScalarType::dtype>();
+  ET_FORALL_REALH_TYPES(TEST_ENTRY);
+#undef TEST_ENTRY
+}
+
+TEST_F(OpUpsampleNearest2dOutTest, OutputSize) {
+  TensorFactory<ScalarType::Float> tf;
+
+  // clang-format off
+  Tensor in = tf.make({1, 2, 2, 3}, {
+      0, 1, 2,
+      3, 4, 5,
+
+      6, 7, 8,
+      9, 10, 11});
+  // clang-format on
+  Tensor out = tf.zeros({1, 2, 3, 5});
+  int64_t output_size[] = {3, 5};
+
+  op_upsample_nearest2d_out(
+      in, optional<ArrayRef<int64_t>>({output_size, 2}), nullopt, out);
+
+  // Rows are read from input rows {0, 0, 1}, and columns from input columns
+  // {0, 0, 1, 1, 2}.
+  // clang-format off
+  EXPECT_TENSOR_EQ(out, tf.make({1, 2, 3, 5}, {
+      0, 0, 1, 1, 2,
+      0, 0, 1, 1, 2,
+      3, 3, 4, 4, 5,
+
+      6, 6, 7, 7, 8,
+      6, 6, 7, 7, 8,
+      9, 9, 10, 10, 11}));
+  // clang-format on
+}
+
+TEST_F(OpUpsampleNearest2dOutTest, Downsample) {
+  TensorFactory<ScalarType::Int> tf;
+
+  // clang-format off
+  Tensor in = tf.make({1, 1, 4, 4}, {
+      0, 1, 2, 3,
+      4, 5, 6, 7,
+      8, 9, 10, 11,
+      12, 13, 14, 15});
+  // clang-format on
+  Tensor out = tf.zeros({1, 1, 2, 2});
+  int64_t output_size[] = {2, 2};
+
+  op_upsample_nearest2d_out(
+      in, optional<ArrayRef<int64_t>>({output_size, 2}), nullopt, out);
+
+  EXPECT_TENSOR_EQ(out, tf.make({1, 1, 2, 2}, {0, 2, 8, 10}));
+}
+
+TEST_F(OpUpsampleNearest2dOutTest, ChannelsLast) {
+  TensorFactory<ScalarType::Float> tf;
+
+  // Two pixels of three channels each.
+  Tensor in = tf.make_channels_last({1, 3, 1, 2}, {1, 2, 3, 4, 5, 6});
+  Tensor out = tf.full_channels_last({1, 3, 2, 3}, 0);
+  int64_t output_size[] = {2, 3};
+
+  op_upsample_nearest2d_out(
+      in, optional<ArrayRef<int64_t>>({output_size, 2}), nullopt, out);
+
+  // Columns are read from input columns {0, 0, 1}.
+  // clang-format off
+  EXPECT_TENSOR_EQ(out, tf.make_channels_last({1, 3, 2, 3}, {
+      1, 2, 3, 1, 2, 3, 4, 5, 6,
+      1, 2, 3, 1, 2, 3, 4, 5, 6}));
+  // clang-format on
+}
+
+TEST_F(OpUpsampleNearest2dOutTest, ChannelsLastMatchesContiguous) {
+  TensorFactory<ScalarType::Float> tf;
+
+  // Wide enough to span several column tiles in the optimized kernel.
+  constexpr int32_t N = 2, C = 5, H = 3, W = 700;
+  constexpr int32_t OH = 7, OW = 1500;
+  std::vector<float> data(N * C * H * W);
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<float>(i % 1013);
+  }
+  std::vector<float> data_cl(data.size());
+  for (int32_t n = 0; n < N; ++n) {
+    for (int32_t c = 0; c < C; ++c) {
+      for (int32_t hw = 0; hw < H * W; ++hw) {
+        data_cl[(n * H * W + hw) * C + c] = data[(n * C + c) * H * W + hw];
+      }
+    }
+  }
+  int64_t output_size[] = {OH, OW};
+
+  Tensor out = tf.zeros({N, C, OH, OW});
+  op_upsample_nearest2d_out(
+      tf.make({N, C, H, W}, data),
+      optional<ArrayRef<int64_t>>({output_size, 2}),
+      nullopt,
+      out);
+  Tensor out_cl = tf.full_channels_last({N, C, OH, OW}, 0);
+  op_upsample_nearest2d_out(
+      tf.make_channels_last({N, C, H, W}, data_cl),
+      optional<ArrayRef<int64_t>>({output_size, 2}),
+      nullopt,
+      out_cl);
+
+  const float* const out_data = out.const_data_ptr<float>();
+  std::vector<float> expected(out.numel());
+  for (int32_t n = 0; n < N; ++n) {
+    for (int32_t c = 0; c < C; ++c) {
+      for (int32_t hw = 0; hw < OH * OW; ++hw) {
+        expected[(n * OH * OW + hw) * C + c] =
+            out_data[(n * C + c) * OH * OW + hw];
+      }
+    }
+  }
+  EXPECT_TENSOR_EQ(out_cl, tf.make_channels_last({N, C, OH, OW}, expected));
+}
+
+TEST_F(OpUpsampleNearest2dOutTest, BothOutputSizeAndScalesDies) {
+  TensorFactory<ScalarType::Float> tf;
+
+  Tensor in = tf.ones({1, 1, 2, 2});
+  Tensor out = tf.zeros({1, 1, 4, 4});
+  int64_t output_size[] = {4, 4};
+  double scales[] = {2, 2};
+
+  ET_EXPECT_KERNEL_FAILURE(
+      context_,
+      op_upsample_nearest2d_out(
+          in,
+          optional<ArrayRef<int64_t>>({output_size, 2}),
+          optional<ArrayRef<double>>({scales, 2}),
+          out));
+}
+
+TEST_F(OpUpsampleNearest2dOutTest, WrongInputRankDies) {
+  TensorFactory<ScalarType::Float> tf;
+
+  Tensor in = tf.ones({1, 2, 2});
+  Tensor out = tf.zeros({1, 4, 4});
+  int64_t output_size[] = {4, 4};
+
+  ET_EXPECT_KERNEL_FAILURE(
+      context_,
+      op_upsample_nearest2d_out(
+          in, optional<ArrayRef<int64_t>>({output_size, 2}), nullopt, out));
+}
+
+TEST_F(OpUpsampleNearest2dOutTest, MismatchedDtypeDies) {
+  TensorFactory<ScalarType::Float> tf;
+  TensorFactory<ScalarType::Int> tf_int;
+
+  Tensor in = tf.ones({1, 1, 2, 2});
+  Tensor out = tf_int.zeros({1, 1, 4, 4});
+  int64_t output_size[] = {4, 4};
+
+  ET_EXPECT_KERNEL_FAILURE(
+      context_,
+      op_upsample_nearest2d_out(
+          in, optional<ArrayRef<int64_t>>({output_size, 2}), nullopt, out));
+}
@@ -183,11 +183,11 @@ def define_common_targets(is_fbcode = False):
     _common_op_test("op_bitwise_xor_test", ["aten", "portable"])
     _common_op_test("op_bmm_test", ["aten", "portable", "optimized"])
     _common_op_test("op_cat_test", ["aten", "portable"])
-    _common_op_test("op_cdist_forward_test", ["aten", "portable"])
+    _common_op_test("op_cdist_forward_test", ["aten", "portable", "optimized"])
     _common_op_test("op_ceil_test", ["aten", "portable"])
     _common_op_test("op_clamp_test", ["aten", "portable"])
     _common_op_test("op_clone_test", ["aten", "portable"])
-    _common_op_test("op_constant_pad_nd_test", ["aten", "portable"])
+    _common_op_test("op_constant_pad_nd_test", ["aten", "portable", "optimized"])
     _common_op_test("op_convolution_test", ["aten", "portable"])
     _common_op_test("op_copy_test", ["aten", "portable"])
     _common_op_test("op_cos_test", ["aten", "portable"])
@@ -249,7 +249,7 @@ def define_common_targets(is_fbcode = False):
     _common_op_test("op_native_layer_norm_test", ["aten", "portable", "optimized"])
     _common_op_test("op_ne_test", ["aten", "portable"])
     _common_op_test("op_neg_test", ["aten", "portable", "optimized"])
-    _common_op_test("op_nonzero_test", ["aten", "portable"])
+    _common_op_test("op_nonzero_test", ["aten", "portable", "optimized"])
     _common_op_test("op_ones_test", ["aten", "portable"])
     _common_op_test("op_pdist_forward_test", ["aten", "portable"])
     _common_op_test("op_permute_copy_test", ["aten", "portable"])
@@ -259,12 +259,12 @@ def define_common_targets(is_fbcode = False):
     _common_op_test("op_relu_test", ["aten", "portable"])
     _common_op_test("op_remainder_test", ["aten", "portable"])
     _common_op_test("op_repeat_test", ["aten", "portable"])
-    _common_op_test("op_reflection_pad1d_test", ["aten", "portable"])
-    _common_op_test("op_reflection_pad2d_test", ["aten", "portable"])
-    _common_op_test("op_reflection_pad3d_test", ["aten", "portable"])
-    _common_op_test("op_replication_pad1d_test", ["aten", "portable"])
-    _common_op_test("op_replication_pad2d_test", ["aten", "portable"])
-    _common_op_test("op_replication_pad3d_test", ["aten", "portable"])
+    _common_op_test("op_reflection_pad1d_test", ["aten", "portable", "optimized"])
+    _common_op_test("op_reflection_pad2d_test", ["aten", "portable", "optimized"])
+    _common_op_test("op_reflection_pad3d_test", ["aten", "portable", "optimized"])
+    _common_op_test("op_replication_pad1d_test", ["aten", "portable", "optimized"])
+    _common_op_test("op_replication_pad2d_test", ["aten", "portable", "optimized"])
+    _common_op_test("op_replication_pad3d_test", ["aten", "portable", "optimized"])
     _common_op_test("op_roll_test", ["aten", "portable"])
     _common_op_test("op_round_test", ["aten", "portable"])
     _common_op_test("op_rsqrt_test", ["aten", "portable"])
@@ -296,6 +296,8 @@ def define_common_targets(is_fbcode = False):
     _common_op_test("op_trunc_test", ["aten", "portable"])
     _common_op_test("op_unbind_copy_test", ["aten", "portable"])
     _common_op_test("op_unsqueeze_copy_test", ["aten", "portable"])
+    _common_op_test("op_upsample_bilinear2d_test", ["aten", "portable", "optimized"])
+    _common_op_test("op_upsample_nearest2d_test", ["aten", "portable", "optimized"])
     _common_op_test("op_var_test", ["aten", "portable"])
     _common_op_test("op_view_copy_test", ["aten", "portable"])
     _common_op_test("op_where_test", ["aten", "portable"])
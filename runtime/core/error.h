@@ -44,6 +44,9 @@ enum class Error : error_code_t {
   /// Status indicating there are no more steps of execution to run
   EndOfMethod = 0x03,
 
+  /// Status indicating an operation was cancelled before it completed
+  Cancelled = 0x04,
+
   /*
    * Logical errors.
    */
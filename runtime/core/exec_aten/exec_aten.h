@@ -18,6 +18,8 @@
 #include <c10/core/Scalar.h> // @manual
 #include <c10/util/ArrayRef.h> // @manual
 #include <c10/util/BFloat16.h> // @manual
+#include <c10/util/Float8_e4m3fn.h> // @manual
+#include <c10/util/Float8_e5m2.h> // @manual
 #include <c10/util/Half.h> // @manual
 #include <c10/util/Optional.h> // @manual
 #include <c10/util/complex.h> // @manual
@@ -33,6 +35,7 @@
 #include <executorch/runtime/core/portable_type/bfloat16.h> // @manual
 #include <executorch/runtime/core/portable_type/complex.h> // @manual
 #include <executorch/runtime/core/portable_type/device.h> // @manual
+#include <executorch/runtime/core/portable_type/float8.h> // @manual
 #include <executorch/runtime/core/portable_type/half.h> // @manual
 #include <executorch/runtime/core/portable_type/optional.h> // @manual
 #include <executorch/runtime/core/portable_type/qint_types.h> // @manual
@@ -80,6 +83,8 @@ using qint32 = c10::qint32;
 using BFloat16 = c10::BFloat16;
 using quint4x2 = c10::quint4x2;
 using quint2x4 = c10::quint2x4;
+using Float8_e5m2 = c10::Float8_e5m2;
+using Float8_e4m3fn = c10::Float8_e4m3fn;
 using IntArrayRef = at::IntArrayRef;
 
 #else // Use executor types
@@ -115,6 +120,8 @@ using qint32 = torch::executor::qint32;
 using BFloat16 = torch::executor::BFloat16;
 using quint4x2 = torch::executor::quint4x2;
 using quint2x4 = torch::executor::quint2x4;
+using Float8_e5m2 = torch::executor::Float8_e5m2;
+using Float8_e4m3fn = torch::executor::Float8_e4m3fn;
 
 using IntArrayRef = torch::executor::IntArrayRef;
 
@@ -34,6 +34,9 @@ def define_common_targets():
                 "//executorch/util/...",
                 "//executorch/backends/fb/qnnpack/test/...",
                 "//executorch/extension/kernel_util/test/...",
+                "//executorch/extension/batching/test/...",
+                "//executorch/extension/hot_swap/test/...",
+                "//executorch/extension/pipeline/test/...",
                 "@EXECUTORCH_CLIENTS",
             ],
             compiler_flags = ["-Wno-unneeded-internal-declaration"],
@@ -394,6 +394,11 @@ inline bool isBitsType(exec_aten::ScalarType t) {
       t == exec_aten::ScalarType::Bits8 || t == exec_aten::ScalarType::Bits16;
 }
 
+inline bool isFloat8Type(exec_aten::ScalarType t) {
+  return t == exec_aten::ScalarType::Float8_e5m2 ||
+      t == exec_aten::ScalarType::Float8_e4m3fn;
+}
+
 inline bool isQIntType(exec_aten::ScalarType t) {
   // Don't forget to extend this when adding new QInt types
   return t == exec_aten::ScalarType::QInt8 ||
@@ -589,6 +594,14 @@ inline exec_aten::ScalarType promoteTypes(
     ET_CHECK_MSG(false, "promoteTypes not valid for bits dtypes");
   }
 
+  // Float8 types are only meant for storage, so only allow exact match
+  if (torch::executor::isFloat8Type(a) && a == b) {
+    return a;
+  }
+  if (torch::executor::isFloat8Type(a) || torch::executor::isFloat8Type(b)) {
+    ET_CHECK_MSG(false, "promoteTypes not valid for float8 dtypes");
+  }
+
   // 12 types are handled by this function, see the constexpr definitions above
   const int NUM_PROMOTE_TYPES = 12;
 
@@ -703,7 +716,11 @@ inline exec_aten::ScalarType promoteTypes(
   ET_INTERNAL_SWITCH_CASE(                                            \
       exec_aten::ScalarType::Bits8, CTYPE_ALIAS, __VA_ARGS__)         \
   ET_INTERNAL_SWITCH_CASE(                                            \
-      exec_aten::ScalarType::Bits16, CTYPE_ALIAS, __VA_ARGS__)
+      exec_aten::ScalarType::Bits16, CTYPE_ALIAS, __VA_ARGS__)        \
+  ET_INTERNAL_SWITCH_CASE(                                            \
+      exec_aten::ScalarType::Float8_e5m2, CTYPE_ALIAS, __VA_ARGS__)   \
+  ET_INTERNAL_SWITCH_CASE(                                            \
+      exec_aten::ScalarType::Float8_e4m3fn, CTYPE_ALIAS, __VA_ARGS__)
 
 #define ET_INTERNAL_SWITCH_CASE_REAL_TYPES(CTYPE_ALIAS, ...)  \
   ET_INTERNAL_SWITCH_CASE(                                    \
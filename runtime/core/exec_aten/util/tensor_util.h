@@ -371,6 +371,30 @@
     }                                                 \
   } while (false)
 
+/**
+ * Like ET_KERNEL_CHECK, but for argument validation checks (e.g. the
+ * `check_*_args()` helpers) whose result only depends on the dtypes, shapes
+ * and scalar values of the kernel arguments. `cond` is not evaluated when the
+ * runtime context says that the same arguments were already validated by a
+ * previous execution of this instruction.
+ *
+ * Checks with side effects, like resizing the output tensor, and checks that
+ * read tensor data, like index bounds, must keep using ET_KERNEL_CHECK.
+ *
+ * @param[in] context the runtime context
+ * @param[in] cond the condition to check
+ * @param[in] error torch::executor::Error enum value (e.g `InvalidArgument`)
+ * @param[in] retval return value of the kernel to allow for early exit
+ */
+#define ET_KERNEL_CHECK_ARGS(context, cond, error, retval) \
+  do {                                                     \
+    if (!context.skip_arg_validation() && !(cond)) {       \
+      ET_LOG(Error, "Check failed (%s): ", #cond);         \
+      context.fail(torch::executor::Error::error);         \
+      return retval;                                       \
+    }                                                      \
+  } while (false)
+
 /**
  * If `cond` is false, log `message` and return from the kernel with a failure
  * state set.
@@ -63,6 +63,8 @@ TEST(ScalarTypeUtilTest, ElementSize) {
       {ScalarType::BFloat16, sizeof(::exec_aten::BFloat16)},
       {ScalarType::QUInt4x2, sizeof(::exec_aten::quint4x2)},
       {ScalarType::QUInt2x4, sizeof(::exec_aten::quint2x4)},
+      {ScalarType::Float8_e5m2, sizeof(::exec_aten::Float8_e5m2)},
+      {ScalarType::Float8_e4m3fn, sizeof(::exec_aten::Float8_e4m3fn)},
   };
   for (const auto& test_case : test_cases) {
     EXPECT_EQ(
@@ -76,6 +78,7 @@ TEST(ScalarTypeUtilTest, IsValidTrue) {
   EXPECT_TRUE(torch::executor::isValid(ScalarType::Float));
   EXPECT_TRUE(torch::executor::isValid(ScalarType::ComplexFloat));
   EXPECT_TRUE(torch::executor::isValid(ScalarType::Bits16));
+  EXPECT_TRUE(torch::executor::isValid(ScalarType::Float8_e4m3fn));
 }
 
 TEST(ScalarTypeUtilTest, IsValidFalse) {
@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include <executorch/runtime/core/portable_type/half.h>
+
+namespace torch {
+namespace executor {
+
+namespace internal {
+
+/*
+ * Convert an 8-bit floating-point number in e5m2 format (1 sign bit, 5
+ * exponent bits and 2 mantissa bits, with infinities and NaNs like IEEE half
+ * precision), in bit representation, to a 32-bit floating-point number.
+ *
+ * e5m2 is the upper byte of an IEEE half, so this widens it to one.
+ */
+inline float fp8e5m2_to_fp32_value(uint8_t input) {
+  return fp16_ieee_to_fp32_value(static_cast<uint16_t>(input) << 8);
+}
+
+/*
+ * Convert an 8-bit floating-point number in e4m3fn format (1 sign bit, 4
+ * exponent bits and 3 mantissa bits, finite with a single NaN encoding), in
+ * bit representation, to a 32-bit floating-point number.
+ *
+ * @note The implementation doesn't use any floating-point operations other
+ * than the scaling of subnormals.
+ */
+inline float fp8e4m3fn_to_fp32_value(uint8_t input) {
+  const uint32_t sign = static_cast<uint32_t>(input & 0x80) << 24;
+  const uint32_t exponent = (input >> 3) & 0xF;
+  const uint32_t mantissa = input & 0x7;
+  if (exponent == 0xF && mantissa == 0x7) {
+    return fp32_from_bits(sign | UINT32_C(0x7FC00000));
+  }
+  if (exponent == 0) {
+    // Subnormal: mantissa * 2^-9.
+    const float value = static_cast<float>(mantissa) * (1.0f / 512.0f);
+    return fp32_from_bits(sign | fp32_to_bits(value));
+  }
+  // Rebias the exponent from 7 to 127.
+  return fp32_from_bits(sign | ((exponent + 120) << 23) | (mantissa << 20));
+}
+
+/*
+ * Convert a 32-bit floating-point number to an 8-bit floating-point number in
+ * e5m2 format, in bit representation. Rounds to nearest even, and overflows
+ * to infinity, like c10/util/Float8_e5m2.h.
+ */
+inline uint8_t fp8e5m2_from_fp32_value(float f) {
+  constexpr uint32_t fp32_inf = UINT32_C(255) << 23;
+  constexpr uint32_t fp8_max = UINT32_C(143) << 23;
+  constexpr uint32_t denorm_mask = UINT32_C(134) << 23;
+
+  uint32_t f_bits = fp32_to_bits(f);
+  uint8_t result = 0u;
+  const uint32_t sign = f_bits & UINT32_C(0x80000000);
+  f_bits ^= sign;
+
+  if (f_bits >= fp8_max) {
+    // Infinity if the magnitude is too large, NaN if it is a NaN.
+    result = f_bits > fp32_inf ? UINT8_C(0x7F) : UINT8_C(0x7C);
+  } else if (f_bits < (UINT32_C(113) << 23)) {
+    // Subnormal, or zero. Adding the denormal mask lets the FPU do the
+    // rounding.
+    f_bits = fp32_to_bits(fp32_from_bits(f_bits) + fp32_from_bits(denorm_mask));
+    result = static_cast<uint8_t>(f_bits - denorm_mask);
+  } else {
+    const uint32_t mant_odd = (f_bits >> 21) & 1;
+    // Rebias the exponent, and round to nearest even.
+    f_bits += (static_cast<uint32_t>(15 - 127) << 23) + UINT32_C(0xFFFFF);
+    f_bits += mant_odd;
+    result = static_cast<uint8_t>(f_bits >> 21);
+  }
+
+  result |= static_cast<uint8_t>(sign >> 24);
+  return result;
+}
+
+/*
+ * Convert a 32-bit floating-point number to an 8-bit floating-point number in
+ * e4m3fn format, in bit representation. Rounds to nearest even. Magnitudes
+ * that round above 448, the largest finite value, become NaN, like
+ * c10/util/Float8_e4m3fn.h: clamp values first to saturate them instead.
+ */
+inline uint8_t fp8e4m3fn_from_fp32_value(float f) {
+  // 480 = 448 + half of the distance to the next value, which does not exist.
+  constexpr uint32_t fp8_max = UINT32_C(1087) << 20;
+  constexpr uint32_t denorm_mask = UINT32_C(141) << 23;
+
+  uint32_t f_bits = fp32_to_bits(f);
+  uint8_t result = 0u;
+  const uint32_t sign = f_bits & UINT32_C(0x80000000);
+  f_bits ^= sign;
+
+  if (f_bits >= fp8_max) {
+    result = 0x7F;
+  } else if (f_bits < (UINT32_C(121) << 23)) {
+    f_bits = fp32_to_bits(fp32_from_bits(f_bits) + fp32_from_bits(denorm_mask));
+    result = static_cast<uint8_t>(f_bits - denorm_mask);
+  } else {
+    const uint8_t mant_odd = (f_bits >> 20) & 1;
+    f_bits += (static_cast<uint32_t>(7 - 127) << 23) + UINT32_C(0x7FFFF);
+    f_bits += mant_odd;
+    result = static_cast<uint8_t>(f_bits >> 20);
+  }
+
+  result |= static_cast<uint8_t>(sign >> 24);
+  return result;
+}
+
+} // namespace internal
+
+/**
+ * An 8-bit floating point type with 5 exponent and 2 mantissa bits,
+ * compatible with c10/util/Float8_e5m2.h from pytorch core. Meant for
+ * storage: convert to float to compute.
+ */
+struct alignas(1) Float8_e5m2 {
+  uint8_t x;
+
+  struct from_bits_t {};
+  static constexpr from_bits_t from_bits() {
+    return from_bits_t();
+  }
+
+  Float8_e5m2() = default;
+
+  constexpr Float8_e5m2(uint8_t bits, from_bits_t) : x(bits) {}
+  /* implicit */ Float8_e5m2(float value)
+      : x(internal::fp8e5m2_from_fp32_value(value)) {}
+  operator float() const {
+    return internal::fp8e5m2_to_fp32_value(x);
+  }
+};
+
+/**
+ * An 8-bit floating point type with 4 exponent and 3 mantissa bits, no
+ * infinities and a single NaN, compatible with c10/util/Float8_e4m3fn.h from
+ * pytorch core. Meant for storage: convert to float to compute.
+ */
+struct alignas(1) Float8_e4m3fn {
+  uint8_t x;
+
+  struct from_bits_t {};
+  static constexpr from_bits_t from_bits() {
+    return from_bits_t();
+  }
+
+  Float8_e4m3fn() = default;
+
+  constexpr Float8_e4m3fn(uint8_t bits, from_bits_t) : x(bits) {}
+  /* implicit */ Float8_e4m3fn(float value)
+      : x(internal::fp8e4m3fn_from_fp32_value(value)) {}
+  operator float() const {
+    return internal::fp8e4m3fn_to_fp32_value(x);
+  }
+};
+
+} // namespace executor
+} // namespace torch
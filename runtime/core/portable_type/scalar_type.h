@@ -40,6 +40,7 @@
 #include <executorch/runtime/core/portable_type/bfloat16.h>
 #include <executorch/runtime/core/portable_type/bits_types.h>
 #include <executorch/runtime/core/portable_type/complex.h>
+#include <executorch/runtime/core/portable_type/float8.h>
 #include <executorch/runtime/core/portable_type/half.h>
 #include <executorch/runtime/core/portable_type/qint_types.h>
 
@@ -81,7 +82,9 @@ namespace executor {
   _(::torch::executor::bits2x4, Bits2x4) /* 19 */                             \
   _(::torch::executor::bits4x2, Bits4x2) /* 20 */                             \
   _(::torch::executor::bits8, Bits8) /* 21 */                                 \
-  _(::torch::executor::bits16, Bits16) /* 22 */
+  _(::torch::executor::bits16, Bits16) /* 22 */                               \
+  _(::torch::executor::Float8_e5m2, Float8_e5m2) /* 23 */                     \
+  _(::torch::executor::Float8_e4m3fn, Float8_e4m3fn) /* 24 */
 
 /**
  * Data types (dtypes) that can be used as element types in ETensors.
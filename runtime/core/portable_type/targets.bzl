@@ -43,6 +43,7 @@ def define_common_targets():
         exported_headers = [
             "bfloat16.h",
             "complex.h",
+            "float8.h",
             "half.h",
             "scalar_type.h",
             "qint_types.h",
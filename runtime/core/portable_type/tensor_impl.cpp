@@ -125,6 +125,12 @@ Error TensorImpl::internal_resize_contiguous(ArrayRef<SizesType> new_sizes) {
     return Error::Ok;
   }
 
+  // For the same reason, most resizes ask for the sizes the tensor already
+  // has. Skip recomputing numel and strides in that case.
+  if (std::memcmp(sizes_, new_sizes.data(), sizeof(SizesType) * dim_) == 0) {
+    return Error::Ok;
+  }
+
   // Can only resize a StaticShape Tensor to the same size
   if (shape_dynamism_ == TensorShapeDynamism::STATIC) {
     for (int i = 0; i < new_sizes.size(); i++) {
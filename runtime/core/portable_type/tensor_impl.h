@@ -145,6 +145,11 @@ class TensorImpl {
   /// Returns the strides of the tensor at each dimension.
   const ArrayRef<StridesType> strides() const;
 
+  /// Returns whether and how the shape of the tensor may change.
+  TensorShapeDynamism shape_dynamism() const {
+    return shape_dynamism_;
+  }
+
   /// Returns a pointer of type T to the constant underlying data blob.
   template <typename T>
   inline const T* data() const {
@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <executorch/runtime/core/portable_type/float8.h>
+#include <gtest/gtest.h>
+#include <cmath>
+
+namespace torch {
+namespace executor {
+
+TEST(Float8Test, E4M3FNDecodesAllValues) {
+  for (int bits = 0; bits < 256; ++bits) {
+    Float8_e4m3fn value(static_cast<uint8_t>(bits), Float8_e4m3fn::from_bits());
+    const float f = value;
+    const bool negative = bits & 0x80;
+    const int exponent = (bits >> 3) & 0xF;
+    const int mantissa = bits & 0x7;
+    if (exponent == 0xF && mantissa == 0x7) {
+      EXPECT_TRUE(std::isnan(f)) << bits;
+      continue;
+    }
+    const float magnitude = exponent == 0
+        ? std::ldexp(mantissa / 8.0f, -6)
+        : std::ldexp(1.0f + mantissa / 8.0f, exponent - 7);
+    EXPECT_EQ(f, negative ? -magnitude : magnitude) << bits;
+    EXPECT_EQ(std::signbit(f), negative) << bits;
+  }
+}
+
+TEST(Float8Test, E5M2DecodesAllValues) {
+  for (int bits = 0; bits < 256; ++bits) {
+    Float8_e5m2 value(static_cast<uint8_t>(bits), Float8_e5m2::from_bits());
+    const float f = value;
+    const bool negative = bits & 0x80;
+    const int exponent = (bits >> 2) & 0x1F;
+    const int mantissa = bits & 0x3;
+    if (exponent == 0x1F) {
+      EXPECT_TRUE(mantissa == 0 ? std::isinf(f) : std::isnan(f)) << bits;
+      continue;
+    }
+    const float magnitude = exponent == 0
+        ? std::ldexp(mantissa / 4.0f, -14)
+        : std::ldexp(1.0f + mantissa / 4.0f, exponent - 15);
+    EXPECT_EQ(f, negative ? -magnitude : magnitude) << bits;
+  }
+}
+
+TEST(Float8Test, RoundTripsAllValues) {
+  for (int bits = 0; bits < 256; ++bits) {
+    const uint8_t b = static_cast<uint8_t>(bits);
+    const float e4m3 = Float8_e4m3fn(b, Float8_e4m3fn::from_bits());
+    if (!std::isnan(e4m3)) {
+      EXPECT_EQ(Float8_e4m3fn(e4m3).x, b);
+    }
+    const float e5m2 = Float8_e5m2(b, Float8_e5m2::from_bits());
+    if (!std::isnan(e5m2)) {
+      EXPECT_EQ(Float8_e5m2(e5m2).x, b);
+    }
+  }
+}
+
+TEST(Float8Test, RoundsToNearestEven) {
+  // 1.0625 is halfway between 1.0 and 1.125 in e4m3fn: rounds to the even
+  // mantissa, 1.0. 1.1875 is halfway between 1.125 and 1.25: rounds to 1.25.
+  EXPECT_EQ(static_cast<float>(Float8_e4m3fn(1.0625f)), 1.0f);
+  EXPECT_EQ(static_cast<float>(Float8_e4m3fn(1.1875f)), 1.25f);
+  EXPECT_EQ(static_cast<float>(Float8_e4m3fn(1.07f)), 1.125f);
+  // Same for e5m2, whose steps are 0.25 above 1.
+  EXPECT_EQ(static_cast<float>(Float8_e5m2(1.125f)), 1.0f);
+  EXPECT_EQ(static_cast<float>(Float8_e5m2(1.375f)), 1.5f);
+  // Subnormals.
+  EXPECT_EQ(static_cast<float>(Float8_e4m3fn(0.0019f)), std::ldexp(1.0f, -9));
+  EXPECT_EQ(static_cast<float>(Float8_e4m3fn(-0.0001f)), 0.0f);
+}
+
+TEST(Float8Test, HandlesOverflow) {
+  EXPECT_EQ(static_cast<float>(Float8_e4m3fn(448.0f)), 448.0f);
+  EXPECT_EQ(static_cast<float>(Float8_e4m3fn(-460.0f)), -448.0f);
+  EXPECT_TRUE(std::isnan(static_cast<float>(Float8_e4m3fn(500.0f))));
+  EXPECT_TRUE(std::isnan(static_cast<float>(Float8_e4m3fn(NAN))));
+
+  EXPECT_EQ(static_cast<float>(Float8_e5m2(57344.0f)), 57344.0f);
+  EXPECT_TRUE(std::isinf(static_cast<float>(Float8_e5m2(70000.0f))));
+  EXPECT_TRUE(std::isinf(static_cast<float>(Float8_e5m2(INFINITY))));
+  EXPECT_TRUE(std::isnan(static_cast<float>(Float8_e5m2(NAN))));
+}
+
+} // namespace executor
+} // namespace torch
@@ -22,6 +22,14 @@ def define_common_targets():
         ],
     )
 
+    runtime.cxx_test(
+        name = "float8_test",
+        srcs = ["float8_test.cpp"],
+        deps = [
+            "//executorch/runtime/core/portable_type:portable_type",
+        ],
+    )
+
     runtime.cxx_test(
         name = "half_test",
         srcs = ["half_test.cpp"],
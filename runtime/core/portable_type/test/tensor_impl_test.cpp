@@ -51,6 +51,7 @@ TEST_F(TensorImplTest, TestCtorAndGetters) {
   EXPECT_EQ(t.sizes().size(), 2);
   EXPECT_EQ(t.strides().data(), strides);
   EXPECT_EQ(t.strides().size(), 2);
+  EXPECT_EQ(t.shape_dynamism(), TensorShapeDynamism::STATIC);
 }
 
 // Verify that contig means stride[0] >= stride[1] >= ... stride[size-1] == 1
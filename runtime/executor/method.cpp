@@ -8,9 +8,11 @@
 
 #include <executorch/runtime/executor/method.h>
 
+#include <algorithm>
 #include <cinttypes> // @donotremove
 #include <cstdint>
 #include <cstdio>
+#include <cstring>
 
 #include <executorch/runtime/backend/interface.h>
 #include <executorch/runtime/core/event_tracer_hooks.h>
@@ -198,6 +200,20 @@ class BackendDelegate final {
   DelegateHandle* handle_;
 };
 
+/**
+ * Exact record of everything that kernel argument validation can depend on,
+ * from the last validated call of an instruction.
+ */
+struct ValidatedArgs {
+  /// Words produced by for_each_arg_word() for the arguments.
+  uint64_t* words;
+  /// Number of words allocated.
+  size_t capacity;
+  /// Number of words recorded, or 0 if the instruction has not been
+  /// validated.
+  size_t size;
+};
+
 /**
  * Runtime state for a chain of instructions.
  */
@@ -209,6 +225,9 @@ struct Chain {
   Span<InstructionArgs> argument_lists_;
   /// Each instruction will have one kernel (not for delegate).
   OpFunction* kernels_;
+  /// Arguments of the last validated call of each instruction. Only allocated
+  /// when validate-once execution is enabled.
+  ValidatedArgs* validated_args_;
 };
 
 namespace {
@@ -234,6 +253,126 @@ Result<InstructionArgs> gen_instruction_arguments(
   return InstructionArgs(arg_list, num_args);
 }
 
+inline uint64_t double_bits(double d) {
+  uint64_t bits;
+  memcpy(&bits, &d, sizeof(bits));
+  return bits;
+}
+
+template <typename Fn>
+void for_each_tensor_word(const exec_aten::Tensor& t, Fn& fn) {
+  fn(static_cast<uint64_t>(t.scalar_type()));
+  fn(static_cast<uint64_t>(t.dim()));
+  for (auto size : t.sizes()) {
+    fn(static_cast<uint64_t>(size));
+  }
+}
+
+/**
+ * Calls fn(uint64_t) with a sequence of words that describes everything that
+ * kernel argument validation can depend on: the type of each argument, the
+ * dtypes and shapes of tensors, and the values of every other kind of
+ * argument. Lists start with their length, so two different sets of
+ * arguments of an instruction never produce the same sequence.
+ */
+template <typename Fn>
+void for_each_arg_word(InstructionArgs args, Fn& fn) {
+  for (size_t i = 0; i < args.size(); ++i) {
+    const EValue& arg = *args[i];
+    fn(static_cast<uint64_t>(arg.tag));
+    if (arg.isTensor()) {
+      for_each_tensor_word(arg.toTensor(), fn);
+    } else if (arg.isTensorList()) {
+      fn(arg.toTensorList().size());
+      for (const auto& t : arg.toTensorList()) {
+        for_each_tensor_word(t, fn);
+      }
+    } else if (arg.isListOptionalTensor()) {
+      fn(arg.toListOptionalTensor().size());
+      for (const auto& t : arg.toListOptionalTensor()) {
+        fn(t.has_value());
+        if (t.has_value()) {
+          for_each_tensor_word(t.value(), fn);
+        }
+      }
+    } else if (arg.isInt()) {
+      fn(static_cast<uint64_t>(arg.toInt()));
+    } else if (arg.isBool()) {
+      fn(arg.toBool());
+    } else if (arg.isDouble()) {
+      fn(double_bits(arg.toDouble()));
+    } else if (arg.isIntList()) {
+      fn(arg.toIntList().size());
+      for (auto v : arg.toIntList()) {
+        fn(static_cast<uint64_t>(v));
+      }
+    } else if (arg.isBoolList()) {
+      fn(arg.toBoolList().size());
+      for (auto v : arg.toBoolList()) {
+        fn(v);
+      }
+    } else if (arg.isDoubleList()) {
+      fn(arg.toDoubleList().size());
+      for (auto v : arg.toDoubleList()) {
+        fn(double_bits(v));
+      }
+    } else if (arg.isString()) {
+      const exec_aten::string_view str = arg.toString();
+      fn(str.size());
+      for (size_t pos = 0; pos < str.size(); pos += sizeof(uint64_t)) {
+        uint64_t word = 0;
+        memcpy(
+            &word,
+            str.data() + pos,
+            std::min(sizeof(uint64_t), str.size() - pos));
+        fn(word);
+      }
+    }
+  }
+}
+
+size_t count_arg_words(InstructionArgs args) {
+  size_t count = 0;
+  auto fn = [&count](uint64_t) { ++count; };
+  for_each_arg_word(args, fn);
+  return count;
+}
+
+/**
+ * Returns true if `args` are exactly the arguments recorded in `validated`.
+ */
+bool matches_validated_args(
+    const ValidatedArgs& validated,
+    InstructionArgs args) {
+  if (validated.size == 0) {
+    return false;
+  }
+  size_t pos = 0;
+  bool match = true;
+  auto fn = [&](uint64_t word) {
+    match = match && pos < validated.size && validated.words[pos] == word;
+    ++pos;
+  };
+  for_each_arg_word(args, fn);
+  return match && pos == validated.size;
+}
+
+/**
+ * Records `args` in `validated`. If they do not fit, leaves `validated` empty
+ * so that the instruction is always validated.
+ */
+void record_validated_args(ValidatedArgs& validated, InstructionArgs args) {
+  size_t pos = 0;
+  auto fn = [&](uint64_t word) {
+    if (pos < validated.capacity) {
+      validated.words[pos] = word;
+    }
+    ++pos;
+  };
+  for_each_arg_word(args, fn);
+  validated.size = pos <= validated.capacity ? pos : 0;
+}
+
 Result<bool> parse_cond_value(const EValue& cond_value) {
   // The cond value attached to the JF instruction at the beginning of an
   // if/else branch is a Tensor which we parse and decide whether to continue
@@ -714,6 +853,7 @@ Error Method::init(executorch_flatbuffer::ExecutionPlan* s_plan) {
           s_chain,
           Span<InstructionArgs>(chain_instruction_arg_lists, num_instructions),
           chain_instruction_kernels,
+          /*validated_args_=*/nullptr,
       };
     }
     ET_CHECK_OR_RETURN_ERROR(
@@ -970,6 +1110,29 @@ Method::set_output_data_ptr(void* buffer, size_t size, size_t output_idx) {
   return internal::set_tensor_data(t, buffer, size);
 }
 
+__ET_NODISCARD Error
+Method::get_inputs(EValue* input_evalues, size_t length) {
+  ET_CHECK_OR_RETURN_ERROR(
+      initialized(),
+      InvalidState,
+      "Inputs can not be retrieved until method has been initialized.");
+
+  ET_CHECK_OR_RETURN_ERROR(
+      length >= inputs_size(),
+      InvalidArgument,
+      "The given array is not large enough to hold all inputs.");
+
+  for (size_t i = 0; i < inputs_size(); i++) {
+    input_evalues[i] = values_[get_input_index(i)];
+  }
+
+  for (size_t i = inputs_size(); i < length; i++) {
+    input_evalues[i] = EValue();
+  }
+
+  return Error::Ok;
+}
+
 __ET_NODISCARD Error
 Method::get_outputs(EValue* output_evalues, size_t length) {
   ET_CHECK_OR_RETURN_ERROR(
@@ -1005,20 +1168,78 @@ Error Method::execute_instruction() {
       step_state_.chain_idx,
       (size_t)instructions->size());
 
-  auto instruction = instructions->Get(step_state_.instr_idx);
   size_t next_instr_idx = step_state_.instr_idx + 1;
+  Error err = experimental_execute_instruction(
+      step_state_.chain_idx,
+      step_state_.instr_idx,
+      chain.argument_lists_[step_state_.instr_idx],
+      &next_instr_idx);
+  // Reset the temp allocator for every instruction.
+  if (memory_manager_->temp_allocator() != nullptr) {
+    memory_manager_->temp_allocator()->reset();
+  }
+  if (err == Error::Ok) {
+    step_state_.instr_idx = next_instr_idx;
+  }
+  return err;
+}
+
+const executorch_flatbuffer::ExecutionPlan* Method::experimental_execution_plan()
+    const {
+  return serialization_plan_;
+}
+
+EValue* Method::experimental_values() {
+  return values_;
+}
+
+HierarchicalAllocator* Method::experimental_planned_memory() {
+  return memory_manager_->planned_memory();
+}
+
+InstructionArgs Method::experimental_instruction_args(
+    size_t chain_idx,
+    size_t instr_idx) const {
+  return chains_[chain_idx].argument_lists_[instr_idx];
+}
+
+Error Method::experimental_execute_instruction(
+    size_t chain_idx,
+    size_t instr_idx,
+    InstructionArgs args,
+    size_t* next_instr_idx) {
+  auto& chain = chains_[chain_idx];
+  auto instruction = chain.s_chain_->instructions()->Get(instr_idx);
   Error err = Error::Ok;
   switch (instruction->instr_args_type()) {
     case executorch_flatbuffer::InstructionArguments::KernelCall: {
       EXECUTORCH_SCOPE_PROF("OPERATOR_CALL");
       internal::EventTracerProfileScope event_tracer_scope =
           internal::EventTracerProfileScope(event_tracer_, "OPERATOR_CALL");
+      // In validate-once mode, only let the kernel skip its argument checks if
+      // the arguments are exactly the ones of the last validated call. This
+      // compares the recorded arguments rather than a hash of them, so that a
+      // collision can never skip a check.
+      ValidatedArgs* validated_args = nullptr;
+      bool skip_arg_validation = false;
+      if (validate_once_) {
+        validated_args = &chain.validated_args_[instr_idx];
+        skip_arg_validation = matches_validated_args(*validated_args, args);
+      }
       // TODO(T147221312): Also expose the temp allocator and tensor resizer
       // via the context.
-      KernelRuntimeContext context(event_tracer_);
-      auto args = chain.argument_lists_[step_state_.instr_idx];
-      chain.kernels_[step_state_.instr_idx](context, args.data());
+      KernelRuntimeContext context(event_tracer_, skip_arg_validation);
+      chain.kernels_[instr_idx](context, args.data());
       err = context.failure_state();
+      if (validated_args != nullptr) {
+        // Record the post-call arguments, which include any output resizing
+        // done by the kernel, since that is what the next call will see.
+        if (err != Error::Ok) {
+          validated_args->size = 0;
+        } else if (!skip_arg_validation) {
+          record_validated_args(*validated_args, args);
+        }
+      }
       if (err != Error::Ok) {
         // We know that instr_args_as_KernelCall is non-null because it was
         // checked at init time.
@@ -1027,8 +1248,8 @@ Error Method::execute_instruction() {
         ET_LOG(
             Error,
             "KernelCall failed at instruction %zu:%zu in operator %s.%s: 0x%x",
-            step_state_.chain_idx,
-            step_state_.instr_idx,
+            chain_idx,
+            instr_idx,
             op->name()->c_str(),
             op->overload()->c_str(),
             (unsigned int)err);
@@ -1059,16 +1280,15 @@ Error Method::execute_instruction() {
           " >= num delegates %zu at instruction %zu",
           delegate_idx,
           n_delegate_,
-          step_state_.instr_idx);
+          instr_idx);
       BackendExecutionContext backend_execution_context(event_tracer_);
       err = delegates_[delegate_idx].Execute(
-          backend_execution_context,
-          chain.argument_lists_[step_state_.instr_idx].data());
+          backend_execution_context, args.data());
       if (err != Error::Ok) {
         ET_LOG(
             Error,
             "CALL_DELEGATE execute failed at instruction %zu: 0x%" PRIx32,
-            step_state_.instr_idx,
+            instr_idx,
             static_cast<uint32_t>(err));
       }
 
@@ -1078,10 +1298,8 @@ Error Method::execute_instruction() {
       // log everything. This will be changed in the future when the inputs and
       // ouputs are separate lists.
 #ifdef ET_EVENT_TRACER_ENABLED
-      for (size_t i = 0;
-           i < chain.argument_lists_[step_state_.instr_idx].size();
-           i++) {
-        EValue* arg = chain.argument_lists_[step_state_.instr_idx].data()[i];
+      for (size_t i = 0; i < args.size(); i++) {
+        EValue* arg = args.data()[i];
         internal::event_tracer_log_evalue(event_tracer_, *arg);
       }
 #endif
@@ -1099,7 +1317,7 @@ Error Method::execute_instruction() {
       Result<bool> jf_result = parse_cond_value(values_[index]);
       if (jf_result.ok()) {
         if (!jf_result.get()) {
-          next_instr_idx = jf_call->destination_instruction();
+          *next_instr_idx = jf_call->destination_instruction();
         }
       } else {
         err = jf_result.error();
@@ -1131,13 +1349,6 @@ Error Method::execute_instruction() {
           static_cast<uint8_t>(instruction->instr_args_type()));
       err = Error::InvalidProgram;
   }
-  // Reset the temp allocator for every instruction.
-  if (memory_manager_->temp_allocator() != nullptr) {
-    memory_manager_->temp_allocator()->reset();
-  }
-  if (err == Error::Ok) {
-    step_state_.instr_idx = next_instr_idx;
-  }
   return err;
 }
 
@@ -1150,6 +1361,65 @@ Error Method::experimental_reset_execution() {
   return Error::Ok;
 }
 
+Error Method::experimental_abort_execution() {
+  ET_CHECK_OR_RETURN_ERROR(
+      initialized(),
+      InvalidState,
+      "Cannot abort execution until method has been initialized.");
+  if (memory_manager_->temp_allocator() != nullptr) {
+    memory_manager_->temp_allocator()->reset();
+  }
+  step_state_ = StepState{0, 0};
+  return Error::Ok;
+}
+
+Error Method::experimental_set_validate_once(bool enabled) {
+  ET_CHECK_OR_RETURN_ERROR(
+      initialized(),
+      InvalidState,
+      "Validate-once can not be set until method has been initialized.");
+  ET_CHECK_OR_RETURN_ERROR(
+      step_state_.instr_idx == 0 && step_state_.chain_idx == 0,
+      InvalidState,
+      "Validate-once can not be set mid execution.");
+
+  if (enabled) {
+    for (size_t i = 0; i < n_chains_; ++i) {
+      Chain& chain = chains_[i];
+      size_t num_instructions = chain.argument_lists_.size();
+      if (num_instructions == 0) {
+        continue;
+      }
+      if (chain.validated_args_ == nullptr) {
+        chain.validated_args_ = ET_ALLOCATE_LIST_OR_RETURN_ERROR(
+            memory_manager_->method_allocator(),
+            ValidatedArgs,
+            num_instructions);
+        // The kinds of the arguments, the ranks of tensors and the lengths of
+        // lists are fixed, so the record of an instruction always has the
+        // same size.
+        for (size_t j = 0; j < num_instructions; ++j) {
+          ValidatedArgs& validated = chain.validated_args_[j];
+          validated.capacity = count_arg_words(chain.argument_lists_[j]);
+          validated.words = nullptr;
+          if (validated.capacity > 0) {
+            validated.words = ET_ALLOCATE_LIST_OR_RETURN_ERROR(
+                memory_manager_->method_allocator(),
+                uint64_t,
+                validated.capacity);
+          }
+        }
+      }
+      // Arguments may have changed while the mode was off, so start over.
+      for (size_t j = 0; j < num_instructions; ++j) {
+        chain.validated_args_[j].size = 0;
+      }
+    }
+  }
+  validate_once_ = enabled;
+  return Error::Ok;
+}
+
 // Log all the outputs of this method to the event tracer.
 void Method::log_outputs() {
 #ifdef ET_EVENT_TRACER_ENABLED
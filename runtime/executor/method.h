@@ -66,7 +66,8 @@ class Method final {
         chains_(rhs.chains_),
         init_state_(rhs.init_state_),
         pre_allocated_input_(rhs.pre_allocated_input_),
-        pre_allocated_output_(rhs.pre_allocated_output_) {
+        pre_allocated_output_(rhs.pre_allocated_output_),
+        validate_once_(rhs.validate_once_) {
     // Required: clear out fields that the dtor looks at, so that we don't free
     // anything twice.
     rhs.n_value_ = 0;
@@ -86,6 +87,7 @@ class Method final {
     rhs.chains_ = nullptr;
     rhs.pre_allocated_input_ = false;
     rhs.pre_allocated_output_ = false;
+    rhs.validate_once_ = false;
   }
 
   /**
@@ -164,6 +166,23 @@ class Method final {
    */
   __ET_NODISCARD Error get_outputs(EValue* output_evalues, size_t length);
 
+  /**
+   * Copies the method's inputs into the provided array.
+   *
+   * WARNING: The input contains shallow copies of internal tensor inputs.
+   * Please do not mutate returned Tensor elements; use set_input() to update
+   * the inputs.
+   *
+   * @param[in] input_evalues The array to copy the inputs into. The first
+   *     `inputs_size()` elements will be set to the corresponding input
+   *     values. The rest of the array will be set to the EValue value None.
+   * @param[in] length The size of the `input_evalues` array in elements. Must
+   *     be greater than or equal to `inputs_size()`.
+   *
+   * @returns Error::Ok on success, non-Ok on failure.
+   */
+  __ET_NODISCARD Error get_inputs(EValue* input_evalues, size_t length);
+
   /**
    * Execute the method.
    *
@@ -198,6 +217,94 @@ class Method final {
    */
   __ET_NODISCARD Error experimental_reset_execution();
 
+  /**
+   * Abandons a step-based execution that is in progress, or that failed, and
+   * resets execution state to the start of the Method.
+   *
+   * Instructions that already ran may have overwritten the inputs, since
+   * their memory can be reused once they are no longer needed, so the inputs
+   * must be set again before the next execution.
+   *
+   * NOTE: Prototype API; subject to change.
+   *
+   * @retval Error:Ok on success
+   * @retval Error::InvalidState if the method is not initialized.
+   */
+  __ET_NODISCARD Error experimental_abort_execution();
+
+  /**
+   * Enables or disables validate-once execution. When enabled, each kernel
+   * instruction fully validates its arguments the first time it runs, and
+   * again whenever the dtypes or shapes of its tensors, or the values of its
+   * other arguments, differ from the last validated call. Each instruction
+   * keeps an exact copy of these, allocated from the method allocator, to
+   * compare against. Otherwise the kernel is told through its
+   * KernelRuntimeContext that it may skip its argument checks.
+   *
+   * This is useful for models with static shapes, where kernel argument
+   * validation would produce the same result on every execution.
+   *
+   * NOTE: Prototype API; subject to change.
+   *
+   * @param[in] enabled Whether to enable validate-once execution.
+   *
+   * @retval Error::Ok on success.
+   * @retval Error::InvalidState if the Method is not initialized, or is in the
+   *     middle of a step-based execution.
+   * @retval Error::MemoryAllocationFailed if the per-instruction validation
+   *     state could not be allocated from the method allocator.
+   */
+  __ET_NODISCARD Error experimental_set_validate_once(bool enabled);
+
+  /**
+   * Returns the serialized plan that the Method was loaded from. Together with
+   * the accessors below, lets an executor outside of Method, like
+   * PipelinedMethod, run the instructions of the Method on its own copies of
+   * the values.
+   *
+   * NOTE: Prototype API; subject to change.
+   */
+  const executorch_flatbuffer::ExecutionPlan* experimental_execution_plan()
+      const;
+
+  /**
+   * Returns the values of the Method, indexed like the values of
+   * experimental_execution_plan().
+   *
+   * NOTE: Prototype API; subject to change.
+   */
+  EValue* experimental_values();
+
+  /**
+   * Returns the planned memory of the Method.
+   *
+   * NOTE: Prototype API; subject to change.
+   */
+  HierarchicalAllocator* experimental_planned_memory();
+
+  /**
+   * Returns the argument list of instruction instr_idx of chain chain_idx,
+   * pointing into experimental_values().
+   *
+   * NOTE: Prototype API; subject to change.
+   */
+  InstructionArgs experimental_instruction_args(
+      size_t chain_idx,
+      size_t instr_idx) const;
+
+  /**
+   * Executes instruction instr_idx of chain chain_idx with the given argument
+   * list, and updates next_instr_idx if the instruction jumps. Does not change
+   * the state of step-based execution.
+   *
+   * NOTE: Prototype API; subject to change.
+   */
+  __ET_NODISCARD Error experimental_execute_instruction(
+      size_t chain_idx,
+      size_t instr_idx,
+      InstructionArgs args,
+      size_t* next_instr_idx);
+
   /**
    * Returns the MethodMeta that corresponds to the calling Method.
    */
@@ -272,7 +379,8 @@ class Method final {
         chains_(nullptr),
         init_state_(InitializationState::Uninitialized),
         pre_allocated_input_(false),
-        pre_allocated_output_(false) {}
+        pre_allocated_output_(false),
+        validate_once_(false) {}
 
   /// Static factory used by Program.
   __ET_NODISCARD static Result<Method> load(
@@ -319,6 +427,7 @@ class Method final {
   InitializationState init_state_;
   bool pre_allocated_input_;
   bool pre_allocated_output_;
+  bool validate_once_;
 
   /**
    * Parses the elements of the values_ array. On error, n_value_ will be set to
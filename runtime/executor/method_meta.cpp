@@ -196,5 +196,26 @@ Result<int64_t> MethodMeta::memory_planned_buffer_size(size_t index) const {
   return s_plan_->non_const_buffer_sizes()->Get(index + 1);
 }
 
+Result<bool> MethodMeta::memory_planned_buffer_is_shared(size_t index) const {
+  auto num_buffers = this->num_memory_planned_buffers();
+  ET_CHECK_OR_RETURN_ERROR(
+      index >= 0 && index < num_buffers,
+      InvalidArgument,
+      "index %zu out of range. num_buffers: %zu",
+      index,
+      num_buffers);
+  const auto shared_ids = s_plan_->shared_non_const_buffer_ids();
+  if (shared_ids == nullptr) {
+    return false;
+  }
+  // The ids index non_const_buffer_sizes, whose first entry is hidden.
+  for (int32_t id : *shared_ids) {
+    if (id > 0 && static_cast<size_t>(id) == index + 1) {
+      return true;
+    }
+  }
+  return false;
+}
+
 } // namespace executor
 } // namespace torch
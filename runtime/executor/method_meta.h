@@ -176,6 +176,17 @@ class MethodMeta final {
    */
   Result<int64_t> memory_planned_buffer_size(size_t index) const;
 
+  /**
+   * Check whether the specified memory-planned buffer holds state shared with
+   * other methods of the program, e.g. a KV cache used by both a prefill and a
+   * decode method. A shared buffer has the same size and layout in every
+   * method that shares it, so a single allocation can back all of them.
+   *
+   * @param[in] index The index of the buffer to look up.
+   * @returns Whether the buffer is shared on success, or an error on failure.
+   */
+  Result<bool> memory_planned_buffer_is_shared(size_t index) const;
+
   /**
    * DEPRECATED: Use num_memory_planned_buffers() instead.
    */
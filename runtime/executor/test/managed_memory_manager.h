@@ -28,7 +28,8 @@ class ManagedMemoryManager {
   ManagedMemoryManager(
       size_t planned_memory_bytes,
       size_t method_allocator_bytes)
-      : planned_memory_buffer_(new uint8_t[planned_memory_bytes]),
+      // Zeroed, so that mutable buffers start out the same in every method.
+      : planned_memory_buffer_(new uint8_t[planned_memory_bytes]()),
         planned_memory_span_(
             planned_memory_buffer_.get(),
             planned_memory_bytes),
@@ -8,6 +8,7 @@
 
 #include <cstdlib>
 #include <filesystem>
+#include <vector>
 
 #include <executorch/extension/data_loader/file_data_loader.h>
 #include <executorch/runtime/core/exec_aten/exec_aten.h>
@@ -116,6 +117,28 @@ TEST_F(MethodTest, GetInputTests) {
   ET_EXPECT_DEATH(method->get_input(num_inputs + 1), "");
 }
 
+TEST_F(MethodTest, GetInputsTest) {
+  ManagedMemoryManager mmm(kDefaultNonConstMemBytes, kDefaultRuntimeMemBytes);
+  Result<Method> method = programs_["add"]->load_method("forward", &mmm.get());
+  ASSERT_EQ(method.error(), Error::Ok);
+
+  size_t num_inputs = method->inputs_size();
+  ASSERT_GT(num_inputs, 0);
+
+  // Extra elements are set to None.
+  std::vector<EValue> inputs(num_inputs + 1);
+  ASSERT_EQ(method->get_inputs(inputs.data(), inputs.size()), Error::Ok);
+  for (size_t i = 0; i < num_inputs; ++i) {
+    EXPECT_EQ(inputs[i].tag, method->get_input(i).tag);
+  }
+  EXPECT_TRUE(inputs[num_inputs].isNone());
+
+  // An array that is too small is rejected.
+  EXPECT_EQ(
+      method->get_inputs(inputs.data(), num_inputs - 1),
+      Error::InvalidArgument);
+}
+
 TEST_F(MethodTest, MutableInputTests) {
   ManagedMemoryManager mmm(kDefaultNonConstMemBytes, kDefaultRuntimeMemBytes);
   Result<Method> method = programs_["add"]->load_method("forward", &mmm.get());
@@ -193,6 +216,74 @@ TEST_F(MethodTest, SetPrimInputTest) {
   torch::executor::util::FreeInputs(inputs);
 }
 
+TEST_F(MethodTest, AbortExecutionTest) {
+  ManagedMemoryManager mmm(kDefaultNonConstMemBytes, kDefaultRuntimeMemBytes);
+  Result<Method> method = programs_["add"]->load_method("forward", &mmm.get());
+  ASSERT_EQ(method.error(), Error::Ok);
+
+  exec_aten::ArrayRef<void*> inputs =
+      torch::executor::util::PrepareInputTensors(*method);
+
+  // Inputs can't be set once step-based execution started.
+  ASSERT_EQ(method->experimental_step(), Error::Ok);
+  EXPECT_EQ(method->set_input(EValue(1.0), 2), Error::InvalidState);
+
+  // Aborting goes back to the start of the method, wherever execution is.
+  ASSERT_EQ(method->experimental_abort_execution(), Error::Ok);
+  EXPECT_EQ(method->set_input(EValue(1.0), 2), Error::Ok);
+  EXPECT_EQ(method->experimental_abort_execution(), Error::Ok);
+
+  Error err = method->execute();
+  EXPECT_EQ(err, Error::Ok);
+
+  torch::executor::util::FreeInputs(inputs);
+}
+
+TEST_F(MethodTest, ValidateOnceTest) {
+  ManagedMemoryManager mmm(kDefaultNonConstMemBytes, kDefaultRuntimeMemBytes);
+  Result<Method> method = programs_["cat"]->load_method("forward", &mmm.get());
+  ASSERT_EQ(method.error(), Error::Ok);
+
+  Error err = method->experimental_set_validate_once(true);
+  ASSERT_EQ(err, Error::Ok);
+
+  float buffer[16] = {0.f};
+  int32_t sizes[2] = {2, 4};
+  uint8_t dim_order[2] = {0, 1};
+  int32_t strides[2] = {4, 1};
+  torch::executor::TensorImpl impl(
+      torch::executor::ScalarType::Float, 2, sizes, buffer, dim_order, strides);
+  err = method->set_input(EValue(torch::executor::Tensor(&impl)), 0);
+  ASSERT_EQ(err, Error::Ok);
+  float out_buffer[16];
+  err = method->set_output_data_ptr(out_buffer, sizeof(out_buffer), 0);
+  ASSERT_EQ(err, Error::Ok);
+
+  // The first execution validates, the later ones reuse the validated state
+  // and must still produce the same result.
+  for (int i = 0; i < 3; ++i) {
+    err = method->execute();
+    ASSERT_EQ(err, Error::Ok);
+    EXPECT_EQ(method->get_output(0).toTensor().sizes()[0], 3);
+  }
+
+  // Changing the input shape invalidates the cached validation state.
+  sizes[0] = 3;
+  torch::executor::TensorImpl impl_2(
+      torch::executor::ScalarType::Float, 2, sizes, buffer, dim_order, strides);
+  err = method->set_input(EValue(torch::executor::Tensor(&impl_2)), 0);
+  ASSERT_EQ(err, Error::Ok);
+  err = method->execute();
+  ASSERT_EQ(err, Error::Ok);
+  EXPECT_EQ(method->get_output(0).toTensor().sizes()[0], 4);
+
+  // Can be turned off again.
+  err = method->experimental_set_validate_once(false);
+  ASSERT_EQ(err, Error::Ok);
+  err = method->execute();
+  ASSERT_EQ(err, Error::Ok);
+}
+
 TEST_F(MethodTest, MethodMetaTest) {
   ManagedMemoryManager mmm(kDefaultNonConstMemBytes, kDefaultRuntimeMemBytes);
   Result<Method> method = programs_["add"]->load_method("forward", &mmm.get());
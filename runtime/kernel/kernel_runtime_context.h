@@ -25,9 +25,17 @@ class KernelRuntimeContext {
  public:
   /**
    * Construct a new kernel runtime context along with an optional event tracer.
+   *
+   * @param[in] event_tracer The event tracer to log kernel events to.
+   * @param[in] skip_arg_validation If true, the kernel's arguments are known
+   *     to match a previously-validated call of the same instruction, so
+   *     argument checks written with ET_KERNEL_CHECK_ARGS() may be skipped.
    */
-  KernelRuntimeContext(EventTracer* event_tracer = nullptr)
-      : event_tracer_(event_tracer) {}
+  KernelRuntimeContext(
+      EventTracer* event_tracer = nullptr,
+      bool skip_arg_validation = false)
+      : event_tracer_(event_tracer),
+        skip_arg_validation_(skip_arg_validation) {}
   /**
    * Tells the runtime that the kernel call has failed. Prefer this over
    * ET_CHECK_*(), which fatally panics the process/system.
@@ -49,6 +57,16 @@ class KernelRuntimeContext {
     return failure_state_;
   }
 
+  /**
+   * Returns true if the kernel may skip validating its arguments, because the
+   * runtime has already validated arguments with the same dtypes, shapes and
+   * scalar values for this instruction. Prefer using ET_KERNEL_CHECK_ARGS()
+   * over calling this directly.
+   */
+  bool skip_arg_validation() const {
+    return skip_arg_validation_;
+  }
+
   /**
    * INTERNAL ONLY
    *
@@ -66,6 +84,7 @@ class KernelRuntimeContext {
 
  private:
   EventTracer* event_tracer_ = nullptr;
+  bool skip_arg_validation_ = false;
   Error failure_state_ = Error::Ok;
 };
 
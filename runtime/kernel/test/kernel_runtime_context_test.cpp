@@ -9,6 +9,7 @@
 #include <executorch/runtime/kernel/kernel_runtime_context.h>
 
 #include <executorch/runtime/core/error.h>
+#include <executorch/runtime/core/exec_aten/util/tensor_util.h>
 #include <executorch/runtime/platform/runtime.h>
 #include <gtest/gtest.h>
 
@@ -47,3 +48,33 @@ TEST_F(KernelRuntimeContextTest, FailureStateReflectsFailure) {
   context.fail(Error::Ok);
   EXPECT_EQ(context.failure_state(), Error::Ok);
 }
+
+TEST_F(KernelRuntimeContextTest, SkipArgValidationDefaultsToFalse) {
+  KernelRuntimeContext context;
+
+  EXPECT_FALSE(context.skip_arg_validation());
+}
+
+TEST_F(KernelRuntimeContextTest, SkipArgValidationSkipsArgChecks) {
+  int num_checks = 0;
+  auto check = [&num_checks]() {
+    num_checks++;
+    return false;
+  };
+  auto kernel = [&check](KernelRuntimeContext& context) {
+    ET_KERNEL_CHECK_ARGS(context, check(), InvalidArgument, );
+  };
+
+  // Arg checks run and fail the kernel by default.
+  KernelRuntimeContext validating_context;
+  kernel(validating_context);
+  EXPECT_EQ(num_checks, 1);
+  EXPECT_EQ(validating_context.failure_state(), Error::InvalidArgument);
+
+  // Arg checks are not evaluated when the runtime says they can be skipped.
+  KernelRuntimeContext skipping_context(
+      /*event_tracer=*/nullptr, /*skip_arg_validation=*/true);
+  kernel(skipping_context);
+  EXPECT_EQ(num_checks, 1);
+  EXPECT_EQ(skipping_context.failure_state(), Error::Ok);
+}
@@ -109,6 +109,7 @@ def define_common_targets():
                 "kernel_runtime_context_test.cpp",
             ],
             deps = [
+                "//executorch/runtime/core/exec_aten/util:tensor_util" + aten_suffix,
                 "//executorch/runtime/kernel:kernel_runtime_context" + aten_suffix,
                 ":specialized_kernel_generated_lib",
             ],
@@ -28,7 +28,11 @@ namespace executor {
  */
 inline uint64_t ticks_to_ns(et_timestamp_t ticks) {
   et_tick_ratio_t ratio = et_pal_ticks_to_ns_multiplier();
-  return static_cast<uint64_t>(ticks) * ratio.numerator / ratio.denominator;
+  // Split the multiplication so that it does not overflow for large tick
+  // counts, e.g. from cycle counters.
+  const uint64_t t = static_cast<uint64_t>(ticks);
+  return t / ratio.denominator * ratio.numerator +
+      t % ratio.denominator * ratio.numerator / ratio.denominator;
 }
 
 } // namespace executor
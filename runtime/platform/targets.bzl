@@ -30,6 +30,18 @@ def get_profiling_flags():
         profiling_flags += ["-DMAX_PROFILE_BLOCKS={}".format(num_prof_blocks)]
     return profiling_flags
 
+def get_tick_source_flags():
+    """Returns the flags that select the tick source of the Posix PAL, from the
+    `executorch.pal_ticks` build config value: `steady_clock` (the default) or
+    `cycle_counter`.
+    """
+    pal_ticks = native.read_config("executorch", "pal_ticks", "steady_clock")
+    if pal_ticks == "cycle_counter":
+        return ["-DET_USE_CYCLE_COUNTER_TICKS"]
+    if pal_ticks != "steady_clock":
+        fail("Unknown executorch.pal_ticks value '{}'".format(pal_ticks))
+    return []
+
 def define_common_targets():
     """Defines targets that should be shared between fbcode and xplat.
 
@@ -48,6 +60,7 @@ def define_common_targets():
         deps = [
             ":pal_interface",
         ],
+        preprocessor_flags = get_tick_source_flags(),
         visibility = [
             "//executorch/core/...",
         ],
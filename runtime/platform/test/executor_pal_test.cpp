@@ -8,6 +8,10 @@
 
 #include <gtest/gtest.h>
 
+#include <chrono>
+#include <thread>
+
+#include <executorch/runtime/platform/clock.h>
 #include <executorch/runtime/platform/platform.h>
 
 TEST(ExecutorPalTest, Initialization) {
@@ -33,3 +37,20 @@ TEST(ExecutorPalTest, TickRateRatioSanity) {
   ASSERT_TRUE(tick_ns_ratio.numerator > 0);
   ASSERT_TRUE(tick_ns_ratio.denominator > 0);
 }
+
+TEST(ExecutorPalTest, TicksMeasureElapsedTime) {
+  et_pal_init();
+
+  // Holds for every tick source, including cycle counters.
+  const auto start = std::chrono::steady_clock::now();
+  const et_timestamp_t ticks_start = et_pal_current_ticks();
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  const et_timestamp_t ticks_end = et_pal_current_ticks();
+  const auto end = std::chrono::steady_clock::now();
+
+  const double elapsed_ns =
+      std::chrono::duration<double, std::nano>(end - start).count();
+  const double ticks_ns =
+      torch::executor::ticks_to_ns(ticks_end - ticks_start);
+  EXPECT_NEAR(ticks_ns / elapsed_ns, 1.0, 0.01);
+}
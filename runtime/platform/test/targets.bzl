@@ -93,3 +93,15 @@ def define_common_targets():
             "//executorch/runtime/platform:platform",
         ],
     )
+
+    # Measures the cost of reading the tick source. Build with
+    # -c executorch.pal_ticks=cycle_counter to compare the tick sources.
+    runtime.cxx_binary(
+        name = "tick_benchmark",
+        srcs = [
+            "tick_benchmark.cpp",
+        ],
+        deps = [
+            "//executorch/runtime/platform:platform",
+        ],
+    )
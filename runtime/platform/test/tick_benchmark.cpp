@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+/**
+ * @file
+ *
+ * Measures the cost of et_pal_current_ticks(), and of the two reads that
+ * every profiling event makes, for the tick source the PAL was built with.
+ * Build with ET_USE_CYCLE_COUNTER_TICKS and without to compare.
+ */
+
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+
+#include <executorch/runtime/platform/clock.h>
+#include <executorch/runtime/platform/platform.h>
+#include <executorch/runtime/platform/runtime.h>
+
+namespace {
+
+constexpr int kIterations = 10000000;
+
+double ns_per_iteration(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double, std::nano>(
+             std::chrono::steady_clock::now() - start)
+             .count() /
+      kIterations;
+}
+
+} // namespace
+
+int main() {
+  torch::executor::runtime_init();
+  const et_tick_ratio_t ratio = et_pal_ticks_to_ns_multiplier();
+  std::printf(
+      "ticks to ns: %" PRIu64 "/%" PRIu64 "\n",
+      ratio.numerator,
+      ratio.denominator);
+
+  // Sum the ticks so that the reads are not optimized away.
+  uint64_t sum = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < kIterations; ++i) {
+    sum += et_pal_current_ticks();
+  }
+  std::printf("et_pal_current_ticks(): %.1fns\n", ns_per_iteration(start));
+
+  // What a profiling event records: a start, an end, and their difference.
+  uint64_t total = 0;
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < kIterations; ++i) {
+    const et_timestamp_t begin = et_pal_current_ticks();
+    total += et_pal_current_ticks() - begin;
+  }
+  std::printf(
+      "begin/end pair: %.1fns, measuring %.1fns on average\n",
+      ns_per_iteration(start),
+      double(torch::executor::ticks_to_ns(total)) / kIterations);
+  return sum == 0 ? 1 : 0;
+}
@@ -0,0 +1,421 @@
+# Copyright (c) Meta Platforms, Inc. and affiliates.
+# All rights reserved.
+#
+# This source code is licensed under the BSD-style license found in the
+# LICENSE file in the root directory of this source tree.
+
+"""
+Analytical cost models of operators, computed from the shapes and dtypes that
+export records in node.meta["val"].
+
+A cost is the number of floating point (or integer multiply-accumulate)
+operations of an op, and the number of bytes it has to move between memory
+and the core at least once: its tensor inputs and outputs. Neither counts
+what a particular kernel does on top, such as the im2col buffer of a
+convolution or re-reading a tile that did not stay in cache, so the costs are
+lower bounds, which is what a roofline compares against.
+"""
+
+import math
+from dataclasses import dataclass
+from typing import Any, Callable, Dict, Iterable, List, Optional, Sequence
+
+import torch
+
+
+@dataclass
+class OpCost:
+    flops: int
+    bytes: int
+
+    @property
+    def arithmetic_intensity(self) -> float:
+        """FLOPs per byte moved."""
+        return self.flops / self.bytes if self.bytes > 0 else math.inf
+
+    def __add__(self, other: "OpCost") -> "OpCost":
+        return OpCost(self.flops + other.flops, self.bytes + other.bytes)
+
+
+CostModel = Callable[[torch.fx.Node], OpCost]
+
+# Keyed by op name without the overload, e.g. "aten.mm" or
+# "quantized_decomposed.dequantize_per_tensor".
+_COST_MODELS: Dict[str, CostModel] = {}
+
+
+def register_cost_model(*op_names: str) -> Callable[[CostModel], CostModel]:
+    """
+    Registers a cost model for the given ops, replacing any existing one. Can
+    be used by backends and custom ops to make their ops show up in the
+    roofline report.
+    """
+
+    def wrapper(fn: CostModel) -> CostModel:
+        for op_name in op_names:
+            _COST_MODELS[op_name] = fn
+        return fn
+
+    return wrapper
+
+
+def get_op_name(node: torch.fx.Node) -> Optional[str]:
+    """
+    Returns the name of the op a call_function node runs, without the
+    overload, or None for other nodes.
+    """
+    if node.op != "call_function":
+        return None
+    name = getattr(node.target, "__name__", None)
+    if name is None:
+        return None
+    # Edge ops are named like "aten.mm.default", and out variants like
+    # "aten.mm.out". Drop the overload.
+    parts = name.split(".")
+    if len(parts) >= 3:
+        parts = parts[:-1]
+    return ".".join(parts)
+
+
+def estimate_node_cost(node: torch.fx.Node) -> Optional[OpCost]:
+    """
+    Returns the cost of a node, or None if its op has no cost model, or its
+    shapes are not known statically.
+    """
+    op_name = get_op_name(node)
+    if op_name is None or op_name not in _COST_MODELS:
+        return None
+    try:
+        return _COST_MODELS[op_name](node)
+    except _UnknownShapeError:
+        return None
+
+
+class _UnknownShapeError(Exception):
+    pass
+
+
+def _int(value: Any) -> int:
+    try:
+        return int(value)
+    except Exception:
+        # A symbolic size without a hint.
+        raise _UnknownShapeError()
+
+
+def _val(arg: Any) -> Any:
+    return arg.meta.get("val") if isinstance(arg, torch.fx.Node) else None
+
+
+def _tensor(arg: Any) -> torch.Tensor:
+    val = _val(arg)
+    if not isinstance(val, torch.Tensor):
+        raise _UnknownShapeError()
+    return val
+
+
+def _output(node: torch.fx.Node, index: int = 0) -> torch.Tensor:
+    val = node.meta.get("val")
+    if isinstance(val, (list, tuple)):
+        val = val[index]
+    if not isinstance(val, torch.Tensor):
+        raise _UnknownShapeError()
+    return val
+
+
+def _shape(tensor: torch.Tensor) -> List[int]:
+    return [_int(size) for size in tensor.shape]
+
+
+def _numel(tensor: torch.Tensor) -> int:
+    return math.prod(_shape(tensor))
+
+
+def _nbytes(tensor: torch.Tensor) -> int:
+    return _numel(tensor) * tensor.element_size()
+
+
+def _tensors_of(values: Iterable[Any]) -> List[torch.Tensor]:
+    tensors = []
+    for value in values:
+        if isinstance(value, (list, tuple)):
+            tensors += _tensors_of(value)
+        elif isinstance(value, torch.Tensor):
+            tensors.append(value)
+    return tensors
+
+
+def _io_bytes(node: torch.fx.Node) -> int:
+    """Bytes of all tensor arguments and outputs of the node."""
+    args = [
+        [_val(a) for a in arg] if isinstance(arg, (list, tuple)) else _val(arg)
+        for arg in list(node.args) + list(node.kwargs.values())
+    ]
+    tensors = _tensors_of(args) + _tensors_of([node.meta.get("val")])
+    return sum(_nbytes(t) for t in tensors)
+
+
+def _arg(node: torch.fx.Node, index: int, name: str, default: Any = None) -> Any:
+    if len(node.args) > index:
+        return node.args[index]
+    return node.kwargs.get(name, default)
+
+
+def _elementwise(flops_per_element: int) -> CostModel:
+    def cost(node: torch.fx.Node) -> OpCost:
+        return OpCost(flops_per_element * _numel(_output(node)), _io_bytes(node))
+
+    return cost
+
+
+def _reduction(flops_per_element: int) -> CostModel:
+    # Reductions do their work per input element, not per output element.
+    def cost(node: torch.fx.Node) -> OpCost:
+        return OpCost(
+            flops_per_element * _numel(_tensor(node.args[0])), _io_bytes(node)
+        )
+
+    return cost
+
+
+def _data_movement(node: torch.fx.Node) -> OpCost:
+    return OpCost(0, _io_bytes(node))
+
+
+# Matrix multiplications. A multiply-accumulate counts as two FLOPs.
+
+
+@register_cost_model("aten.mm", "aten.bmm", "aten.matmul")
+def _matmul_cost(node: torch.fx.Node) -> OpCost:
+    k = _shape(_tensor(node.args[0]))[-1]
+    return OpCost(2 * _numel(_output(node)) * k, _io_bytes(node))
+
+
+@register_cost_model("aten.addmm", "aten.baddbmm")
+def _addmm_cost(node: torch.fx.Node) -> OpCost:
+    k = _shape(_tensor(node.args[1]))[-1]
+    out = _numel(_output(node))
+    return OpCost(2 * out * k + out, _io_bytes(node))
+
+
+@register_cost_model("aten.linear")
+def _linear_cost(node: torch.fx.Node) -> OpCost:
+    k = _shape(_tensor(node.args[0]))[-1]
+    out = _numel(_output(node))
+    has_bias = _arg(node, 2, "bias") is not None
+    return OpCost(2 * out * k + (out if has_bias else 0), _io_bytes(node))
+
+
+@register_cost_model("aten.convolution")
+def _convolution_cost(node: torch.fx.Node) -> OpCost:
+    weight = _shape(_tensor(node.args[1]))
+    transposed = bool(_arg(node, 6, "transposed", False))
+    # The weight is [out, in / groups, *kernel], or [in, out / groups,
+    # *kernel] when transposed. Either way, every element of the
+    # non-transposed output, or of the transposed input, accumulates over
+    # weight[1:].
+    per_element = math.prod(weight[1:])
+    if transposed:
+        macs = _numel(_tensor(node.args[0])) * per_element
+    else:
+        macs = _numel(_output(node)) * per_element
+    bias = _numel(_output(node)) if _arg(node, 2, "bias") is not None else 0
+    return OpCost(2 * macs + bias, _io_bytes(node))
+
+
+# Normalizations and softmax, with the FLOPs of a straightforward kernel.
+
+
+@register_cost_model("aten._softmax", "aten._log_softmax")
+def _softmax_cost(node: torch.fx.Node) -> OpCost:
+    # max, subtract, exp, sum, and divide (or log and subtract).
+    return OpCost(5 * _numel(_output(node)), _io_bytes(node))
+
+
+@register_cost_model("aten.native_layer_norm")
+def _layer_norm_cost(node: torch.fx.Node) -> OpCost:
+    # mean, variance (subtract, square, sum), normalize, then scale and
+    # shift.
+    return OpCost(8 * _numel(_output(node)), _io_bytes(node))
+
+
+@register_cost_model(
+    "aten._native_batch_norm_legit_no_training", "aten.native_group_norm"
+)
+def _batch_norm_cost(node: torch.fx.Node) -> OpCost:
+    return OpCost(4 * _numel(_output(node)), _io_bytes(node))
+
+
+# Pooling and upsampling.
+
+
+@register_cost_model(
+    "aten.avg_pool2d", "aten.max_pool2d", "aten.max_pool2d_with_indices"
+)
+def _pool_cost(node: torch.fx.Node) -> OpCost:
+    kernel_size: Sequence[int] = node.args[1]
+    return OpCost(
+        _numel(_output(node)) * math.prod(kernel_size), _io_bytes(node)
+    )
+
+
+register_cost_model("aten._adaptive_avg_pool2d")(_reduction(1))
+register_cost_model("aten.upsample_bilinear2d")(_elementwise(11))
+register_cost_model("aten.upsample_nearest2d")(_data_movement)
+
+
+# Elementwise ops, counted as one FLOP per output element. Transcendental
+# functions cost more than that in practice, but there is no portable way to
+# weigh them.
+
+register_cost_model(
+    "aten.add",
+    "aten.sub",
+    "aten.mul",
+    "aten.div",
+    "aten.rsub",
+    "aten.pow",
+    "aten.neg",
+    "aten.abs",
+    "aten.relu",
+    "aten.hardtanh",
+    "aten.clamp",
+    "aten.leaky_relu",
+    "aten.sigmoid",
+    "aten.tanh",
+    "aten.exp",
+    "aten.log",
+    "aten.sqrt",
+    "aten.rsqrt",
+    "aten.sin",
+    "aten.cos",
+    "aten.gelu",
+    "aten.hardswish",
+    "aten.hardsigmoid",
+    "aten.minimum",
+    "aten.maximum",
+    "aten.where",
+    "aten.eq",
+    "aten.ne",
+    "aten.lt",
+    "aten.le",
+    "aten.gt",
+    "aten.ge",
+    "aten.logical_and",
+    "aten.logical_or",
+    "aten.logical_not",
+    "aten.bitwise_and",
+    "aten.bitwise_or",
+    "aten.masked_fill",
+    "aten._to_copy",
+)(_elementwise(1))
+
+register_cost_model(
+    "aten.amax",
+    "aten.amin",
+    "aten.max",
+    "aten.min",
+    "aten.argmax",
+    "aten.argmin",
+    "aten.mean",
+    "aten.sum",
+    "aten.var",
+    "aten.cumsum",
+)(_reduction(1))
+
+register_cost_model(
+    "aten.view_copy",
+    "aten._unsafe_view",
+    "aten.clone",
+    "aten.permute_copy",
+    "aten.transpose_copy",
+    "aten.t_copy",
+    "aten.expand_copy",
+    "aten.squeeze_copy",
+    "aten.unsqueeze_copy",
+    "aten.slice_copy",
+    "aten.select_copy",
+    "aten.split_copy",
+    "aten.split_with_sizes_copy",
+    "aten.unbind_copy",
+    "aten.cat",
+    "aten.stack",
+    "aten.constant_pad_nd",
+    "aten.reflection_pad2d",
+    "aten.replication_pad2d",
+    "aten.repeat",
+    "aten.full",
+    "aten.full_like",
+    "aten.zeros_like",
+    "aten.ones_like",
+    "aten.index",
+    "aten.index_select",
+    "aten.index_put",
+    "aten.gather",
+    "aten.pixel_shuffle",
+)(_data_movement)
+
+
+def _gather_bytes(weight: torch.Tensor, indices: torch.Tensor, out: int) -> int:
+    # Only the rows that are looked up are read, not the whole table.
+    shape = _shape(weight)
+    if len(shape) == 0:
+        return _nbytes(weight) + _nbytes(indices) + out
+    row_bytes = _nbytes(weight) // shape[0] if shape[0] > 0 else 0
+    return _numel(indices) * row_bytes + _nbytes(indices) + out
+
+
+@register_cost_model("aten.embedding")
+def _embedding_cost(node: torch.fx.Node) -> OpCost:
+    weight = _tensor(node.args[0])
+    indices = _tensor(node.args[1])
+    return OpCost(0, _gather_bytes(weight, indices, _nbytes(_output(node))))
+
+
+# Quantized ops, from kernels/quantized.
+
+
+register_cost_model(
+    "quantized_decomposed.quantize_per_tensor",
+    "quantized_decomposed.dequantize_per_tensor",
+    "quantized_decomposed.quantize_per_channel",
+    "quantized_decomposed.dequantize_per_channel",
+    "quantized_decomposed.quantize_per_token",
+    "quantized_decomposed.dequantize_per_token",
+)(_elementwise(2))
+
+register_cost_model("quantized_decomposed.choose_qparams")(_reduction(2))
+
+
+@register_cost_model("quantized_decomposed.add")
+def _quantized_add_cost(node: torch.fx.Node) -> OpCost:
+    # Dequantize both inputs, add, and requantize.
+    return OpCost(7 * _numel(_output(node)), _io_bytes(node))
+
+
+@register_cost_model(
+    "quantized_decomposed.mixed_mm", "quantized_decomposed.mixed_linear"
+)
+def _mixed_mm_cost(node: torch.fx.Node) -> OpCost:
+    # A float matmul with a weight that is dequantized on the fly, at two
+    # FLOPs per weight element.
+    k = _shape(_tensor(node.args[0]))[-1]
+    weight = _numel(_tensor(node.args[1]))
+    return OpCost(2 * _numel(_output(node)) * k + 2 * weight, _io_bytes(node))
+
+
+@register_cost_model(
+    "quantized_decomposed.embedding_byte",
+    "quantized_decomposed.embedding_4bit",
+)
+def _quantized_embedding_cost(node: torch.fx.Node) -> OpCost:
+    weight = _tensor(node.args[0])
+    scales = _tensor(node.args[1])
+    indices = _tensor(node.args[5])
+    out = _output(node)
+    # The scales of the gathered rows are read too.
+    scale_bytes = _gather_bytes(scales, indices, 0) - _nbytes(indices)
+    return OpCost(
+        2 * _numel(out),
+        _gather_bytes(weight, indices, _nbytes(out)) + scale_bytes,
+    )
@@ -0,0 +1,402 @@
+# Copyright (c) Meta Platforms, Inc. and affiliates.
+# All rights reserved.
+#
+# This source code is licensed under the BSD-style license found in the
+# LICENSE file in the root directory of this source tree.
+
+"""
+Combines the per-op timings of an ETDump with the cost models of cost_model.py
+to report, for every op that ran, the GFLOP/s and GB/s it achieved, and how
+far it is from the roofline of the machine: min(peak GFLOP/s, arithmetic
+intensity * peak GB/s). Ops are ranked by the time they lose against the
+roofline, so the first rows are the kernels most worth optimizing.
+
+Usage:
+    python -m executorch.sdk.roofline_tool.roofline_tool \\
+        --etdump_path etdump.etdp --etrecord_path etrecord.bin \\
+        --peak_gflops 120 --peak_gbps 25
+
+Peaks are those of the machine that produced the ETDump. When it is this
+machine, leave them out to measure them with torch.
+"""
+
+import argparse
+import json
+import sys
+import time
+from dataclasses import asdict, dataclass
+from typing import Dict, IO, List, Optional, Sequence
+
+import torch
+
+from executorch.exir.lowered_backend_module import LoweredBackendModule
+from executorch.sdk import Inspector
+from executorch.sdk.inspector import Event, TimeScale
+from executorch.sdk.inspector._inspector_utils import TIME_SCALE_DICT
+from executorch.sdk.roofline_tool.cost_model import (
+    estimate_node_cost,
+    get_op_name,
+    OpCost,
+)
+from tabulate import tabulate
+
+
+@dataclass
+class MachinePeak:
+    gflops: float
+    gbps: float
+
+    @property
+    def ridge_point(self) -> float:
+        """The arithmetic intensity, in FLOPs per byte, above which an op is
+        compute bound."""
+        return self.gflops / self.gbps
+
+
+@dataclass
+class OpRooflineData:
+    event_name: str
+    op_names: List[str]
+    # Median over the runs in the ETDump.
+    time_us: float
+    flops: int
+    bytes: int
+    arithmetic_intensity: float
+    achieved_gflops: float
+    achieved_gbps: float
+    # "compute" or "memory", from the arithmetic intensity.
+    bound: str
+    # Achieved over attainable throughput, at most about 1.
+    roofline_fraction: float
+    # Time above the roofline, i.e. time_us minus the time the op would take
+    # at the attainable throughput.
+    lost_time_us: float
+    flagged: bool = False
+
+
+def measure_machine_peak(
+    matmul_size: int = 1024, copy_mb: int = 256, iterations: int = 10
+) -> MachinePeak:
+    """
+    Measures the peak throughput of this machine with torch: a float matmul
+    for compute, and a copy much larger than the caches for bandwidth. Takes
+    the best iteration of each. Uses the threads torch uses by default, so
+    compare against ETDumps of runs with as many threads.
+    """
+    a = torch.rand(matmul_size, matmul_size)
+    b = torch.rand(matmul_size, matmul_size)
+    out = torch.empty(matmul_size, matmul_size)
+    torch.mm(a, b, out=out)
+    best_mm = float("inf")
+    for _ in range(iterations):
+        start = time.perf_counter()
+        torch.mm(a, b, out=out)
+        best_mm = min(best_mm, time.perf_counter() - start)
+
+    src = torch.empty(copy_mb * 1024 * 1024, dtype=torch.uint8)
+    dst = torch.empty_like(src)
+    dst.copy_(src)
+    best_copy = float("inf")
+    for _ in range(iterations):
+        start = time.perf_counter()
+        dst.copy_(src)
+        best_copy = min(best_copy, time.perf_counter() - start)
+
+    return MachinePeak(
+        gflops=2 * matmul_size**3 / best_mm / 1e9,
+        # A copy reads and writes every byte.
+        gbps=2 * src.numel() / best_copy / 1e9,
+    )
+
+
+def _collect_nodes(
+    graph_module: torch.fx.GraphModule, nodes: Dict[int, torch.fx.Node]
+) -> None:
+    for node in graph_module.graph.nodes:
+        debug_handle = node.meta.get("debug_handle")
+        if debug_handle is not None:
+            nodes.setdefault(debug_handle, node)
+        if node.op == "get_attr":
+            attr = getattr(node.graph.owning_module, node.target)
+            # The debug handles of delegate events point into the graph that
+            # was lowered.
+            if isinstance(attr, LoweredBackendModule):
+                _collect_nodes(attr.original_module.graph_module, nodes)
+            elif isinstance(attr, torch.fx.GraphModule):
+                _collect_nodes(attr, nodes)
+
+
+def create_debug_handle_to_node_map(
+    graph_module: torch.fx.GraphModule,
+) -> Dict[int, torch.fx.Node]:
+    """
+    Maps the debug handles of a program, including the ones of delegated
+    subgraphs, to their nodes.
+    """
+    nodes: Dict[int, torch.fx.Node] = {}
+    _collect_nodes(graph_module, nodes)
+    return nodes
+
+
+def _event_cost(
+    event: Event, nodes: Dict[int, torch.fx.Node]
+) -> Optional[OpCost]:
+    handles = event.debug_handles
+    if handles is None:
+        return None
+    if isinstance(handles, int):
+        handles = [handles]
+    # A delegate event can cover several nodes. Only report it if all of them
+    # have a cost model, since a partial cost would look like a slow kernel.
+    total = OpCost(0, 0)
+    for handle in handles:
+        node = nodes.get(handle)
+        cost = estimate_node_cost(node) if node is not None else None
+        if cost is None:
+            return None
+        total = total + cost
+    return total if len(handles) > 0 else None
+
+
+def _op_names(event: Event, nodes: Dict[int, torch.fx.Node]) -> List[str]:
+    handles = event.debug_handles
+    if isinstance(handles, int):
+        handles = [handles]
+    names = []
+    for handle in handles or []:
+        node = nodes.get(handle)
+        name = get_op_name(node) if node is not None else None
+        if name is not None and name not in names:
+            names.append(name)
+    return names
+
+
+def compute_roofline(
+    event_name: str,
+    op_names: List[str],
+    cost: OpCost,
+    time_s: float,
+    peak: MachinePeak,
+) -> OpRooflineData:
+    """Places an op with the given cost and time on the roofline of peak."""
+    achieved_gflops = cost.flops / time_s / 1e9
+    achieved_gbps = cost.bytes / time_s / 1e9
+    intensity = cost.arithmetic_intensity
+    compute_bound = intensity >= peak.ridge_point
+    # Ideal time at the roofline: whichever of compute and memory is slower.
+    ideal_s = max(cost.flops / (peak.gflops * 1e9), cost.bytes / (peak.gbps * 1e9))
+    return OpRooflineData(
+        event_name=event_name,
+        op_names=op_names,
+        time_us=time_s * 1e6,
+        flops=cost.flops,
+        bytes=cost.bytes,
+        arithmetic_intensity=intensity,
+        achieved_gflops=achieved_gflops,
+        achieved_gbps=achieved_gbps,
+        bound="compute" if compute_bound else "memory",
+        roofline_fraction=ideal_s / time_s,
+        lost_time_us=max(0.0, time_s - ideal_s) * 1e6,
+    )
+
+
+def generate_roofline_report(
+    inspector: Inspector,
+    nodes: Dict[int, torch.fx.Node],
+    peak: MachinePeak,
+    num_flagged: int = 5,
+    flag_below_fraction: float = 0.5,
+    time_scale: TimeScale = TimeScale.S,
+) -> List[OpRooflineData]:
+    """
+    Returns the roofline data of every op event of the inspector with a cost
+    model, sorted by decreasing lost time. Flags the first num_flagged ops
+    that reach less than flag_below_fraction of the roofline.
+
+    Args:
+        inspector: The inspector of the ETDump and ETRecord.
+        nodes: The nodes of the ETRecord, from create_debug_handle_to_node_map.
+        peak: The peak throughput of the machine that produced the ETDump.
+        time_scale: The target time scale the inspector was created with.
+    """
+    if time_scale == TimeScale.CYCLES:
+        raise ValueError(
+            "Convert cycles to time to compute a roofline: pass the source "
+            "time scale of the cycle counter to the Inspector."
+        )
+    seconds_per_unit = 1.0 / TIME_SCALE_DICT[time_scale]
+
+    report: List[OpRooflineData] = []
+    for event_block in inspector.event_blocks:
+        for event in event_block.events:
+            if event.perf_data is None:
+                continue
+            cost = _event_cost(event, nodes)
+            if cost is None:
+                continue
+            time_s = float(event.perf_data.p50) * seconds_per_unit
+            if time_s <= 0:
+                continue
+            report.append(
+                compute_roofline(
+                    event.name, _op_names(event, nodes), cost, time_s, peak
+                )
+            )
+
+    report.sort(key=lambda data: data.lost_time_us, reverse=True)
+    flagged = 0
+    for data in report:
+        if flagged >= num_flagged:
+            break
+        if data.roofline_fraction < flag_below_fraction:
+            data.flagged = True
+            flagged += 1
+    return report
+
+
+def print_roofline_report(
+    report: Sequence[OpRooflineData],
+    peak: MachinePeak,
+    file: IO[str] = sys.stdout,
+) -> None:
+    print(
+        f"Machine peak: {peak.gflops:.1f} GFLOP/s, {peak.gbps:.1f} GB/s, "
+        f"ridge point {peak.ridge_point:.1f} FLOP/B",
+        file=file,
+    )
+    total_us = sum(data.time_us for data in report)
+    lost_us = sum(data.lost_time_us for data in report)
+    print(
+        f"{len(report)} ops with a cost model: {total_us:.1f} us, of which "
+        f"{lost_us:.1f} us above the roofline",
+        file=file,
+    )
+    rows = [
+        [
+            "*" if data.flagged else "",
+            data.event_name,
+            ", ".join(data.op_names),
+            f"{data.time_us:.1f}",
+            f"{data.flops / 1e6:.3f}",
+            f"{data.bytes / 1e6:.3f}",
+            f"{data.arithmetic_intensity:.2f}",
+            f"{data.achieved_gflops:.2f}",
+            f"{data.achieved_gbps:.2f}",
+            data.bound,
+            f"{100 * data.roofline_fraction:.1f}%",
+            f"{data.lost_time_us:.1f}",
+        ]
+        for data in report
+    ]
+    print(
+        tabulate(
+            rows,
+            headers=[
+                "",
+                "event",
+                "ops",
+                "p50 (us)",
+                "MFLOP",
+                "MB",
+                "FLOP/B",
+                "GFLOP/s",
+                "GB/s",
+                "bound",
+                "of roofline",
+                "lost (us)",
+            ],
+        ),
+        file=file,
+    )
+
+
+def parse_args():
+    parser = argparse.ArgumentParser()
+
+    parser.add_argument(
+        "--etdump_path",
+        required=True,
+        help="The path to the ETDump of the runs to analyze",
+    )
+
+    parser.add_argument(
+        "--etrecord_path",
+        required=True,
+        help="The path to the ETRecord of the program that ran",
+    )
+
+    parser.add_argument(
+        "--source_time_scale",
+        default="ns",
+        choices=[scale.value for scale in TimeScale if scale != TimeScale.CYCLES],
+        help="The time scale of the ETDump timestamps",
+    )
+
+    parser.add_argument(
+        "--peak_gflops",
+        type=float,
+        help="Peak GFLOP/s of the machine that ran the program. Measured on "
+        "this machine if left out",
+    )
+
+    parser.add_argument(
+        "--peak_gbps",
+        type=float,
+        help="Peak memory bandwidth in GB/s of the machine that ran the "
+        "program. Measured on this machine if left out",
+    )
+
+    parser.add_argument(
+        "--num_flagged",
+        type=int,
+        default=5,
+        help="How many of the ops losing the most time to flag",
+    )
+
+    parser.add_argument(
+        "--output_path",
+        help="Optional path to also write the report to, as a json file",
+    )
+
+    args = parser.parse_args()
+    return args
+
+
+def main():
+    args = parse_args()
+
+    if args.peak_gflops is None or args.peak_gbps is None:
+        measured = measure_machine_peak()
+        peak = MachinePeak(
+            gflops=args.peak_gflops or measured.gflops,
+            gbps=args.peak_gbps or measured.gbps,
+        )
+    else:
+        peak = MachinePeak(gflops=args.peak_gflops, gbps=args.peak_gbps)
+
+    inspector = Inspector(
+        etdump_path=args.etdump_path,
+        etrecord=args.etrecord_path,
+        source_time_scale=TimeScale(args.source_time_scale),
+        target_time_scale=TimeScale.S,
+    )
+    edge_program = inspector.get_exported_program()
+    assert edge_program is not None, "The ETRecord has no edge dialect program"
+    nodes = create_debug_handle_to_node_map(edge_program.graph_module)
+
+    report = generate_roofline_report(
+        inspector, nodes, peak, num_flagged=args.num_flagged
+    )
+    print_roofline_report(report, peak)
+
+    if args.output_path is not None:
+        with open(args.output_path, "w") as f:
+            f.write(
+                json.dumps(
+                    {"peak": asdict(peak), "ops": [asdict(data) for data in report]}
+                )
+            )
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,131 @@
+# Copyright (c) Meta Platforms, Inc. and affiliates.
+# All rights reserved.
+#
+# This source code is licensed under the BSD-style license found in the
+# LICENSE file in the root directory of this source tree.
+
+import io
+import unittest
+from types import SimpleNamespace
+from typing import Dict
+
+import torch
+from executorch.exir import to_edge
+from executorch.sdk.inspector import Event, EventBlock, PerfData, TimeScale
+from executorch.sdk.roofline_tool.cost_model import (
+    estimate_node_cost,
+    get_op_name,
+)
+from executorch.sdk.roofline_tool.roofline_tool import (
+    compute_roofline,
+    create_debug_handle_to_node_map,
+    generate_roofline_report,
+    MachinePeak,
+    print_roofline_report,
+)
+from torch.export import export
+
+
+class MyModel(torch.nn.Module):
+    def __init__(self):
+        super().__init__()
+        self.conv = torch.nn.Conv2d(in_channels=3, out_channels=4, kernel_size=3)
+        self.linear = torch.nn.Linear(16, 8)
+
+    def forward(self, x, y):
+        x = self.conv(x)
+        y = torch.relu(self.linear(y))
+        return x, y
+
+
+def _nodes_by_op(graph_module: torch.fx.GraphModule) -> Dict[str, torch.fx.Node]:
+    return {
+        get_op_name(node): node
+        for node in graph_module.graph.nodes
+        if get_op_name(node) is not None
+    }
+
+
+class RooflineToolTest(unittest.TestCase):
+    def setUp(self):
+        edge_program = to_edge(
+            export(MyModel(), (torch.randn(1, 3, 10, 10), torch.randn(4, 16)))
+        )
+        self.graph_module = edge_program.exported_program().graph_module
+
+    def test_cost_models(self):
+        nodes = _nodes_by_op(self.graph_module)
+
+        # [1, 4, 8, 8] output, each accumulating over 3 * 3 * 3 weights, plus
+        # the bias.
+        conv = estimate_node_cost(nodes["aten.convolution"])
+        self.assertEqual(conv.flops, 2 * 256 * 27 + 256)
+        self.assertEqual(conv.bytes, 4 * (300 + 108 + 4 + 256))
+
+        # The linear is decomposed into a transpose and an addmm.
+        addmm = estimate_node_cost(nodes["aten.addmm"])
+        self.assertEqual(addmm.flops, 2 * 32 * 16 + 32)
+        self.assertEqual(addmm.bytes, 4 * (8 + 64 + 128 + 32))
+
+        relu = estimate_node_cost(nodes["aten.relu"])
+        self.assertEqual(relu.flops, 32)
+        self.assertEqual(relu.bytes, 4 * (32 + 32))
+
+        permute = estimate_node_cost(nodes["aten.permute_copy"])
+        self.assertEqual(permute.flops, 0)
+        self.assertEqual(permute.bytes, 4 * (128 + 128))
+
+    def test_compute_roofline(self):
+        peak = MachinePeak(gflops=100, gbps=10)
+        self.assertEqual(peak.ridge_point, 10)
+
+        cost = estimate_node_cost(_nodes_by_op(self.graph_module)["aten.addmm"])
+        # The addmm moves 928 bytes, which take 92.8 ns at 10 GB/s, and is
+        # below the ridge point.
+        data = compute_roofline("addmm", ["aten.addmm"], cost, 185.6e-9, peak)
+        self.assertEqual(data.bound, "memory")
+        self.assertAlmostEqual(data.achieved_gbps, 5.0)
+        self.assertAlmostEqual(data.roofline_fraction, 0.5)
+        self.assertAlmostEqual(data.lost_time_us, 0.0928)
+
+    def test_generate_roofline_report(self):
+        nodes = create_debug_handle_to_node_map(self.graph_module)
+        handles = {get_op_name(node): handle for handle, node in nodes.items()}
+
+        def make_event(op_name: str, time_ns: float) -> Event:
+            return Event(
+                name=op_name,
+                perf_data=PerfData([time_ns, time_ns, time_ns]),
+                debug_handles=handles[op_name],
+            )
+
+        inspector = SimpleNamespace(
+            event_blocks=[
+                EventBlock(
+                    name="Execute",
+                    events=[
+                        make_event("aten.convolution", 1000.0),
+                        make_event("aten.addmm", 1000.0),
+                        make_event("aten.relu", 10.0),
+                        # Framework events have no cost.
+                        Event(name="Method::execute", perf_data=PerfData([5e3])),
+                    ],
+                )
+            ]
+        )
+        peak = MachinePeak(gflops=100, gbps=10)
+        report = generate_roofline_report(
+            inspector, nodes, peak, num_flagged=1, time_scale=TimeScale.NS
+        )
+
+        self.assertEqual(
+            [data.event_name for data in report],
+            ["aten.addmm", "aten.convolution", "aten.relu"],
+        )
+        # Only the op losing the most time is flagged.
+        self.assertEqual([data.flagged for data in report], [True, False, False])
+        self.assertAlmostEqual(report[0].time_us, 1.0)
+
+        output = io.StringIO()
+        print_roofline_report(report, peak, file=output)
+        self.assertIn("aten.convolution", output.getvalue())
@@ -8,7 +8,7 @@
 
 import functools
 import inspect
-from typing import Callable, Sequence, Type
+from typing import Callable, Optional, Sequence, Type
 
 import executorch.exir as exir
 import torch
@@ -65,6 +65,7 @@ class ExportedModule:
         capture_config=None,
         extract_constant_segment: bool = True,
         skip_type_promotion: bool = False,
+        shared_mutable_buffer_mem_id: Optional[int] = None,
     ) -> "ExportedModule":
         """
         Creates a new ExportedModule for the specified module class.
@@ -76,6 +77,8 @@ class ExportedModule:
                 functional op does not have an out variant.
             dynamic_memory_planning_mode: The dynamic memory planning mode to
                 use.
+            shared_mutable_buffer_mem_id: If set, the memory-planned buffer id
+                in which the mutable buffers of all methods are shared.
         """
 
         def get_inputs_adapter(
@@ -187,6 +190,7 @@ class ExportedModule:
                 memory_planning_pass=memory_planning_pass,
                 to_out_var_pass=ToOutVarPass(ignore_to_out_var_failure),
                 extract_constant_segment=extract_constant_segment,
+                shared_mutable_buffer_mem_id=shared_mutable_buffer_mem_id,
             )
         )
 
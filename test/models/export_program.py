@@ -163,6 +163,48 @@ class ModuleMultipleEntry(torch.nn.Module):
         return ["forward", "forward2"]
 
 
+class ModuleSharedState(torch.nn.Module):
+    def __init__(self):
+        super().__init__()
+        self.register_buffer("state", torch.zeros(2, 2, dtype=torch.float))
+
+    def forward(self, x: torch.Tensor):
+        self.state.add_(x)
+        return self.state.clone()
+
+    def forward2(self, x: torch.Tensor):
+        self.state.add_(x)
+        return self.state.clone()
+
+    def get_random_inputs(self):
+        return (torch.ones(2, 2, dtype=torch.float),)
+
+    @staticmethod
+    def get_method_names_to_export() -> List[str]:
+        return ["forward", "forward2"]
+
+    @staticmethod
+    def get_export_kwargs() -> Dict[str, Any]:
+        # Both methods accumulate into the same state buffer.
+        return {"shared_mutable_buffer_mem_id": 2}
+
+
+class ModuleAccumulate(torch.nn.Module):
+    def __init__(self):
+        super().__init__()
+        self.register_buffer("state", torch.zeros(2, 2, dtype=torch.float))
+
+    def forward(self, x: torch.Tensor):
+        # The state is only used after the first instruction, so a pipeline
+        # can keep it in its last stage.
+        y = torch.mul(x, 3)
+        self.state.add_(y)
+        return self.state.clone()
+
+    def get_random_inputs(self):
+        return (torch.ones(2, 2, dtype=torch.float),)
+
+
 #
 # Main logic.
 #
@@ -59,11 +59,13 @@ def define_common_targets():
 
     # Class names of nn.Modules for :exported_programs to export.
     MODULES_TO_EXPORT = [
+        "ModuleAccumulate",
         "ModuleAdd",
         "ModuleAddHalf",
         "ModuleBasic",
         "ModuleLinear",
         "ModuleMultipleEntry",
+        "ModuleSharedState",
         "ModuleIndex",
         "ModuleDynamicCatUnallocatedIO",
     ]